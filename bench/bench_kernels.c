@@ -0,0 +1,1048 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Kernel benchmark: sweeps the processing entry points (SOS cascades in f32
+ * and f64, SVF and lattice cascades, batches, FIR engines, FFT plans, the
+ * resampler, gain, meters, conversions and a graph chain) over ISA levels,
+ * channel counts, stage counts, block sizes and every layout each one
+ * accepts, and reports ns/sample and cycles/sample as JSON and/or CSV. Run
+ * through `meson benchmark`, or directly:
+ *   bench_kernels [--json FILE] [--csv FILE] [--quick]
+ *                 [--min-time-ms N] [--kernel NAME] [--isa NAME]
+ */
+
+#include "spark/block.h"
+#include "spark/convert.h"
+#include "spark/dispatch.h"
+#include "spark/fft.h"
+#include "spark/fir_filter.h"
+#include "spark/gain.h"
+#include "spark/graph.h"
+#include "spark/iir_filter.h"
+#include "spark/iir_topology.h"
+#include "spark/meter.h"
+#include "spark/resample.h"
+#include "spark/version.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define BENCH_HAVE_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAVE_TSC 1
+#else
+#define BENCH_HAVE_TSC 0
+#endif
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+
+static const uint32_t full_channels[] = {1, 2, 4, 8, 16, 32, 64};
+static const uint32_t full_stages[] = {1, 2, 4, 8, 16};
+static const uint32_t full_blocks[] = {16, 64, 256, 1024, 4096, 8192};
+
+static const uint32_t quick_channels[] = {1, 8, 64};
+static const uint32_t quick_stages[] = {1, 4, 16};
+static const uint32_t quick_blocks[] = {16, 256, 8192};
+
+#define BENCH_MAX_CHANNELS 64 /* Largest entry of full_channels. */
+
+static const uint32_t layouts[] = {SPARK_LAYOUT_PLANAR, SPARK_LAYOUT_INTERLEAVED,
+                                   SPARK_LAYOUT_PLANAR_PTR, SPARK_LAYOUT_STRIDED};
+static const char *const layout_names[] = {"planar", "interleaved", "planar_ptr",
+                                           "strided"};
+
+/* Bits of bench_kernel_t::layouts, one per entry of layouts[]. */
+#define BENCH_PLANAR (1u << 0)
+#define BENCH_INTERLEAVED (1u << 1)
+#define BENCH_PLANAR_PTR (1u << 2)
+#define BENCH_STRIDED (1u << 3)
+#define BENCH_FRAMES (BENCH_PLANAR | BENCH_INTERLEAVED)
+#define BENCH_ANY (BENCH_FRAMES | BENCH_PLANAR_PTR | BENCH_STRIDED)
+
+/*
+ * Plane-pointer and strided buffers are padded planes, this many samples
+ * longer than the block, so neither reduces to the planar case.
+ */
+#define BENCH_PLANE_PAD 16
+
+/**
+ * @brief Buffers and kernel objects for one benchmark case.
+ */
+typedef struct bench_ctx {
+  uint32_t n_chan;
+  uint32_t n_stages;
+  uint32_t n_samples;
+  uint32_t layout;
+
+  size_t n_buf;     /**< Capacity of buf_a and buf_b, in doubles. */
+  void *buf_a;      /**< Input; never written. */
+  void *buf_b;      /**< Output. Filtering in place would decay the input
+                         into subnormals over many iterations. */
+  void *planes_a[BENCH_MAX_CHANNELS]; /**< Plane pointers into buf_a. */
+  void *planes_b[BENCH_MAX_CHANNELS]; /**< Plane pointers into buf_b. */
+  float *coeff_f32; /**< Per-channel coefficients: SOS, SVF or lattice. */
+  float *target_f32;
+  double *coeff_f64;
+  float *states_f32;
+  double *states_f64;
+  float *taps;
+  spark_sosfilt_f32_t *filters;
+  void *arena;
+
+  spark_sosfilt_f32_t sos_f32;
+  spark_sosfilt_f64_t sos_f64;
+  spark_sosfilt_f32_plan_t plan_f32;
+  spark_sosfilt_f32_packed_t packed_f32;
+  spark_sosfilt_f32_batch_t batch_f32;
+  spark_svf_f32_t svf_f32;
+  spark_lattice_f32_t lattice_f32;
+  spark_fir_f32_engine_t fir_f32;
+  spark_fft_f32_t fft_f32;
+  spark_resample_f32_engine_t resample_f32;
+  spark_gain_f32_t gain_f32;
+  spark_meter_f32_engine_t meter_f32;
+  spark_convert_t convert;
+  spark_convert_t convert_out;
+  spark_graph_node_t nodes[4];
+  spark_graph_t graph;
+} bench_ctx_t;
+
+/**
+ * @brief A benchmarked entry point.
+ */
+typedef struct bench_kernel {
+  const char *name;
+  bool uses_stages; /**< False: swept at a single stage count, reported as 0. */
+  uint32_t layouts; /**< BENCH_* bits: the layouts the kernel is swept over. */
+  int (*setup)(bench_ctx_t *ctx);
+  void (*run)(bench_ctx_t *ctx);
+} bench_kernel_t;
+
+/**
+ * @brief Results of one case.
+ */
+typedef struct bench_result {
+  double ns_per_sample;
+  double cycles_per_sample; /**< NAN when no cycle counter is available. */
+  uint64_t iterations;
+} bench_result_t;
+
+static uint64_t now_ns(void)
+{
+#if defined(_WIN32)
+  LARGE_INTEGER freq, count;
+  QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&count);
+  return (uint64_t)((double)count.QuadPart * 1e9 / (double)freq.QuadPart);
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static uint64_t now_cycles(void)
+{
+#if BENCH_HAVE_TSC
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+static uint32_t rng_state = 0x12345678u;
+
+static float frand(void)
+{
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return (float)(rng_state >> 8) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+/** Fill @p n sections with stable, mildly resonant coefficients. */
+static void fill_sos(float *c, size_t n)
+{
+  for (size_t i = 0; i < n; ++i) {
+    const float r = 0.5f + 0.45f * fabsf(frand());
+    const float theta = 3.0f * fabsf(frand());
+    c[5 * i + 0] = 0.2f;
+    c[5 * i + 1] = 0.1f * frand();
+    c[5 * i + 2] = 0.1f * frand();
+    c[5 * i + 3] = 2.0f * r * cosf(theta);
+    c[5 * i + 4] = -r * r;
+  }
+}
+
+/** Fill @p n SVF stages: cutoffs across the band, Q from 0.5 to 2. */
+static void fill_svf(float *c, size_t n)
+{
+  for (size_t i = 0; i < n; ++i) {
+    c[SPARK_SVF_COEFFS * i + 0] = tanf(1.5f * fabsf(frand()) + 0.01f);
+    c[SPARK_SVF_COEFFS * i + 1] = 1.25f + 0.75f * frand();
+    c[SPARK_SVF_COEFFS * i + 2] = 0.5f * frand();
+    c[SPARK_SVF_COEFFS * i + 3] = 0.5f * frand();
+    c[SPARK_SVF_COEFFS * i + 4] = 0.5f * frand();
+  }
+}
+
+/** Fill @p n lattice stages with reflections inside (-0.95, 0.95). */
+static void fill_lattice(float *c, size_t n)
+{
+  for (size_t i = 0; i < n; ++i) {
+    const float k1 = 0.95f * frand();
+    const float k2 = 0.95f * frand();
+    c[SPARK_LATTICE_COEFFS * i + 0] = k1;
+    c[SPARK_LATTICE_COEFFS * i + 1] = sqrtf(1.0f - k1 * k1);
+    c[SPARK_LATTICE_COEFFS * i + 2] = k2;
+    c[SPARK_LATTICE_COEFFS * i + 3] = sqrtf(1.0f - k2 * k2);
+    c[SPARK_LATTICE_COEFFS * i + 4] = 0.2f * frand();
+    c[SPARK_LATTICE_COEFFS * i + 5] = 0.2f * frand();
+    c[SPARK_LATTICE_COEFFS * i + 6] = 0.2f * frand();
+  }
+}
+
+/**
+ * @brief Describe @p base in the format and layout of @p flags.
+ *
+ * Planar planes are contiguous; plane-pointer and strided planes are
+ * BENCH_PLANE_PAD samples apart, @p planes receiving the pointers.
+ */
+static spark_buffer_t make_buffer(const bench_ctx_t *ctx, void *base, void **planes,
+                                  uint32_t flags)
+{
+  spark_buffer_t buf = {.base = base,
+                        .channels = ctx->n_chan,
+                        .samples = ctx->n_samples,
+                        .flags = flags};
+  const size_t stride = (size_t)ctx->n_samples + BENCH_PLANE_PAD;
+  const size_t size = spark_buffer_bytes_per_sample(&buf);
+
+  switch (spark_buffer_get_layout(flags)) {
+  case SPARK_LAYOUT_PLANAR_PTR:
+    for (uint32_t k = 0; k < ctx->n_chan; ++k)
+      planes[k] = (unsigned char *)base + k * stride * size;
+    buf.base = planes;
+    break;
+  case SPARK_LAYOUT_STRIDED:
+    buf.channel_stride = (uint32_t)stride;
+    buf.sample_stride = 1;
+    break;
+  default:
+    break;
+  }
+  return buf;
+}
+
+/** Header reading buf_a as @p in_flags and writing buf_b as @p out_flags. */
+static spark_block_t make_header(bench_ctx_t *ctx, uint32_t in_flags, uint32_t out_flags)
+{
+  return (spark_block_t){
+      .abi_version = SPARK_ABI_VERSION,
+      .struct_size = sizeof(spark_block_t),
+      .input = make_buffer(ctx, ctx->buf_a, ctx->planes_a, in_flags),
+      .output = make_buffer(ctx, ctx->buf_b, ctx->planes_b, out_flags),
+  };
+}
+
+/** Allocate @p size bytes of arena aligned to @p align. */
+static void *alloc_arena(bench_ctx_t *ctx, size_t size, size_t align)
+{
+  ctx->arena = malloc(size + align - 1);
+  if (!ctx->arena)
+    return NULL;
+  return (void *)(((uintptr_t)ctx->arena + align - 1) & ~(uintptr_t)(align - 1));
+}
+
+static void init_sos_f32(bench_ctx_t *ctx, uint32_t flags)
+{
+  const uint32_t io = SPARK_FMT_F32 | ctx->layout;
+
+  ctx->sos_f32 = (spark_sosfilt_f32_t){
+      .header = make_header(ctx, io, io),
+      .coefficients = ctx->coeff_f32,
+      .states = ctx->states_f32,
+      .n_stages = ctx->n_stages,
+      .flags = flags,
+  };
+}
+
+static void init_sos_f64(bench_ctx_t *ctx, uint32_t fmt)
+{
+  ctx->sos_f64 = (spark_sosfilt_f64_t){
+      .header = make_header(ctx, fmt | ctx->layout, fmt | ctx->layout),
+      .coefficients = ctx->coeff_f64,
+      .states = ctx->states_f64,
+      .n_stages = ctx->n_stages,
+      .flags = SPARK_SOSFILT_INDEPENDENT_SOS,
+  };
+}
+
+static int setup_sosfilt_f32(bench_ctx_t *ctx)
+{
+  init_sos_f32(ctx, SPARK_SOSFILT_INDEPENDENT_SOS);
+  return SPARK_NOERROR;
+}
+
+static void run_sosfilt_f32(bench_ctx_t *ctx)
+{
+  spark_sosfilt_f32(&ctx->sos_f32);
+}
+
+static int setup_sosfilt_f32_shared(bench_ctx_t *ctx)
+{
+  init_sos_f32(ctx, SPARK_SOSFILT_SHARE_SOS);
+  return SPARK_NOERROR;
+}
+
+static int setup_sosfilt_f32_execute(bench_ctx_t *ctx)
+{
+  init_sos_f32(ctx, SPARK_SOSFILT_INDEPENDENT_SOS);
+  return spark_sosfilt_f32_prepare(&ctx->sos_f32, &ctx->plan_f32);
+}
+
+/** Run @p plan through the entry point of its layout. */
+static void execute_f32(bench_ctx_t *ctx, const spark_sosfilt_f32_plan_t *plan)
+{
+  if (plan->planes)
+    spark_sosfilt_f32_execute_planes(plan, (const float *const *)ctx->planes_a,
+                                     (float *const *)ctx->planes_b);
+  else
+    spark_sosfilt_f32_execute(plan, ctx->buf_a, ctx->buf_b);
+}
+
+static void run_sosfilt_f32_execute(bench_ctx_t *ctx)
+{
+  execute_f32(ctx, &ctx->plan_f32);
+}
+
+static int setup_sosfilt_f32_ramp(bench_ctx_t *ctx)
+{
+  return setup_sosfilt_f32_execute(ctx);
+}
+
+static void run_sosfilt_f32_ramp(bench_ctx_t *ctx)
+{
+  spark_sosfilt_f32_execute_ramp(&ctx->plan_f32, ctx->target_f32, ctx->buf_a, ctx->buf_b);
+}
+
+static int setup_sosfilt_f32_packed(bench_ctx_t *ctx)
+{
+  init_sos_f32(ctx, SPARK_SOSFILT_INDEPENDENT_SOS);
+  const size_t size = spark_sosfilt_f32_packed_size(ctx->n_chan, ctx->n_stages);
+  ctx->arena = malloc(size);
+  if (!ctx->arena)
+    return SPARK_ERR_INVALID_SIZE;
+  return spark_sosfilt_f32_packed_init(&ctx->packed_f32, &ctx->sos_f32, ctx->arena, size);
+}
+
+static void run_sosfilt_f32_packed(bench_ctx_t *ctx)
+{
+  execute_f32(ctx, &ctx->packed_f32.plan);
+}
+
+/* One mono filter per swept channel, each with its own planes and cascade. */
+static int setup_sosfilt_f32_batch(bench_ctx_t *ctx)
+{
+  const uint32_t n = ctx->n_samples;
+  const uint32_t io = SPARK_FMT_F32 | SPARK_LAYOUT_PLANAR;
+
+  ctx->filters = malloc(ctx->n_chan * sizeof(*ctx->filters));
+  if (!ctx->filters)
+    return SPARK_ERR_INVALID_SIZE;
+
+  for (uint32_t k = 0; k < ctx->n_chan; ++k) {
+    const size_t offset = (size_t)k * n;
+    const spark_buffer_t in = {
+        .base = (float *)ctx->buf_a + offset, .channels = 1, .samples = n, .flags = io};
+    const spark_buffer_t out = {
+        .base = (float *)ctx->buf_b + offset, .channels = 1, .samples = n, .flags = io};
+    ctx->filters[k] = (spark_sosfilt_f32_t){
+        .header = {.abi_version = SPARK_ABI_VERSION,
+                   .struct_size = sizeof(spark_block_t),
+                   .input = in,
+                   .output = out},
+        .coefficients = ctx->coeff_f32 + (size_t)k * ctx->n_stages * 5,
+        .states = ctx->states_f32 + (size_t)k * ctx->n_stages * 2,
+        .n_stages = ctx->n_stages,
+        .flags = SPARK_SOSFILT_INDEPENDENT_SOS,
+    };
+  }
+
+  const size_t size = spark_sosfilt_f32_batch_size(ctx->filters, ctx->n_chan);
+  ctx->arena = malloc(size);
+  if (!ctx->arena)
+    return SPARK_ERR_INVALID_SIZE;
+  return spark_sosfilt_f32_batch_init(&ctx->batch_f32, ctx->filters, ctx->n_chan,
+                                      ctx->arena, size);
+}
+
+static void run_sosfilt_f32_batch(bench_ctx_t *ctx)
+{
+  spark_sosfilt_f32_batch_execute(&ctx->batch_f32);
+}
+
+static int setup_sosfilt_f64(bench_ctx_t *ctx)
+{
+  /* The shared fill is float noise; store it as doubles for F64 I/O. */
+  for (size_t i = 0; i < ctx->n_buf; ++i)
+    ((double *)ctx->buf_a)[i] = 0.5 * frand();
+
+  init_sos_f64(ctx, SPARK_FMT_F64);
+  return SPARK_NOERROR;
+}
+
+static int setup_sosfilt_f64_mixed(bench_ctx_t *ctx)
+{
+  init_sos_f64(ctx, SPARK_FMT_F32);
+  return SPARK_NOERROR;
+}
+
+static void run_sosfilt_f64(bench_ctx_t *ctx)
+{
+  spark_sosfilt_f64(&ctx->sos_f64);
+}
+
+static int setup_svf_f32(bench_ctx_t *ctx)
+{
+  const uint32_t io = SPARK_FMT_F32 | ctx->layout;
+  const size_t n_sos = (size_t)ctx->n_chan * ctx->n_stages;
+
+  fill_svf(ctx->coeff_f32, n_sos);
+  fill_svf(ctx->target_f32, n_sos);
+  ctx->svf_f32 = (spark_svf_f32_t){
+      .header = make_header(ctx, io, io),
+      .coefficients = ctx->coeff_f32,
+      .states = ctx->states_f32,
+      .n_stages = ctx->n_stages,
+      .flags = SPARK_SOSFILT_INDEPENDENT_SOS,
+  };
+  return SPARK_NOERROR;
+}
+
+static void run_svf_f32(bench_ctx_t *ctx)
+{
+  spark_svf_f32(&ctx->svf_f32);
+}
+
+static void run_svf_f32_ramp(bench_ctx_t *ctx)
+{
+  spark_svf_f32_ramp(&ctx->svf_f32, ctx->target_f32);
+}
+
+static int setup_lattice_f32(bench_ctx_t *ctx)
+{
+  const uint32_t io = SPARK_FMT_F32 | ctx->layout;
+  const size_t n_sos = (size_t)ctx->n_chan * ctx->n_stages;
+
+  fill_lattice(ctx->coeff_f32, n_sos);
+  fill_lattice(ctx->target_f32, n_sos);
+  ctx->lattice_f32 = (spark_lattice_f32_t){
+      .header = make_header(ctx, io, io),
+      .coefficients = ctx->coeff_f32,
+      .states = ctx->states_f32,
+      .n_stages = ctx->n_stages,
+      .flags = SPARK_SOSFILT_INDEPENDENT_SOS,
+  };
+  return SPARK_NOERROR;
+}
+
+static void run_lattice_f32(bench_ctx_t *ctx)
+{
+  spark_lattice_f32(&ctx->lattice_f32);
+}
+
+static void run_lattice_f32_ramp(bench_ctx_t *ctx)
+{
+  spark_lattice_f32_ramp(&ctx->lattice_f32, ctx->target_f32);
+}
+
+/* Taps shared by every channel: short ones run direct, long ones partitioned. */
+static int setup_fir_f32(bench_ctx_t *ctx, uint32_t method, uint32_t n_taps)
+{
+  const uint32_t io = SPARK_FMT_F32 | ctx->layout;
+
+  ctx->taps = malloc(n_taps * sizeof(float));
+  if (!ctx->taps)
+    return SPARK_ERR_INVALID_SIZE;
+  for (uint32_t i = 0; i < n_taps; ++i)
+    ctx->taps[i] = 0.1f * frand() * expf(-4.0f * (float)i / (float)n_taps);
+
+  const spark_fir_f32_t desc = {
+      .header = make_header(ctx, io, io),
+      .taps = ctx->taps,
+      .n_taps = n_taps,
+      .flags = SPARK_FIR_SHARE_TAPS,
+      .method = method,
+  };
+  const size_t size = spark_fir_f32_size(&desc);
+  if (size == 0)
+    return SPARK_ERR_INVALID_PARAM;
+  ctx->arena = malloc(size);
+  if (!ctx->arena)
+    return SPARK_ERR_INVALID_SIZE;
+  return spark_fir_f32_init(&ctx->fir_f32, &desc, ctx->arena, size);
+}
+
+static int setup_fir_f32_direct(bench_ctx_t *ctx)
+{
+  return setup_fir_f32(ctx, SPARK_FIR_DIRECT, 64);
+}
+
+static int setup_fir_f32_uniform(bench_ctx_t *ctx)
+{
+  return setup_fir_f32(ctx, SPARK_FIR_UNIFORM, 1024);
+}
+
+static int setup_fir_f32_nonuniform(bench_ctx_t *ctx)
+{
+  return setup_fir_f32(ctx, SPARK_FIR_NONUNIFORM, 16384);
+}
+
+static void run_fir_f32(bench_ctx_t *ctx)
+{
+  spark_fir_f32_execute(&ctx->fir_f32, ctx->buf_a, ctx->buf_b);
+}
+
+/* One transform of `samples` points per channel, planes taken from buf_a. */
+static int setup_fft_f32(bench_ctx_t *ctx, uint32_t type)
+{
+  const size_t size = spark_fft_f32_size(type, ctx->n_samples);
+  if (size == 0)
+    return SPARK_ERR_INVALID_PARAM;
+  ctx->arena = malloc(size);
+  if (!ctx->arena)
+    return SPARK_ERR_INVALID_SIZE;
+  return spark_fft_f32_init(&ctx->fft_f32, type, ctx->n_samples, ctx->arena, size);
+}
+
+static int setup_fft_f32_complex(bench_ctx_t *ctx)
+{
+  return setup_fft_f32(ctx, SPARK_FFT_COMPLEX);
+}
+
+static int setup_fft_f32_real(bench_ctx_t *ctx)
+{
+  return setup_fft_f32(ctx, SPARK_FFT_REAL);
+}
+
+/* Channel k's real parts are plane k of a buffer, its imaginary parts plane
+ * n_chan + k: both fit in the double-sized buffers. */
+static void run_fft_f32_forward(bench_ctx_t *ctx)
+{
+  const size_t n = ctx->n_samples, im = (size_t)ctx->n_chan * n;
+  const float *a = ctx->buf_a;
+  float *b = ctx->buf_b;
+
+  for (size_t k = 0; k < ctx->n_chan; ++k)
+    spark_fft_f32_forward(&ctx->fft_f32, a + k * n, a + im + k * n, b + k * n,
+                          b + im + k * n);
+}
+
+static void run_fft_f32_inverse(bench_ctx_t *ctx)
+{
+  const size_t n = ctx->n_samples, im = (size_t)ctx->n_chan * n;
+  const float *a = ctx->buf_a;
+  float *b = ctx->buf_b;
+
+  for (size_t k = 0; k < ctx->n_chan; ++k)
+    spark_fft_f32_inverse(&ctx->fft_f32, a + k * n, a + im + k * n, b + k * n,
+                          b + im + k * n);
+}
+
+/* `samples` input frames per call; the output planes hold the largest result. */
+static int setup_resample_f32(bench_ctx_t *ctx, uint32_t in_rate, uint32_t out_rate)
+{
+  const uint32_t io = SPARK_FMT_F32 | ctx->layout;
+
+  spark_resample_f32_t desc = {
+      .header = make_header(ctx, io, io),
+      .in_rate = in_rate,
+      .out_rate = out_rate,
+      .quality = SPARK_RESAMPLE_MEDIUM,
+  };
+  desc.header.output.samples = spark_resample_f32_max_output(&desc);
+  if ((size_t)ctx->n_chan * desc.header.output.samples > 2 * ctx->n_buf)
+    return SPARK_ERR_INVALID_SIZE;
+
+  const size_t size = spark_resample_f32_size(&desc);
+  if (size == 0)
+    return SPARK_ERR_INVALID_PARAM;
+  ctx->arena = malloc(size);
+  if (!ctx->arena)
+    return SPARK_ERR_INVALID_SIZE;
+  return spark_resample_f32_init(&ctx->resample_f32, &desc, ctx->arena, size);
+}
+
+static int setup_resample_f32_up(bench_ctx_t *ctx)
+{
+  return setup_resample_f32(ctx, 44100, 48000);
+}
+
+static int setup_resample_f32_down(bench_ctx_t *ctx)
+{
+  return setup_resample_f32(ctx, 48000, 44100);
+}
+
+static void run_resample_f32(bench_ctx_t *ctx)
+{
+  spark_resample_f32_execute(&ctx->resample_f32, ctx->buf_a, ctx->buf_b);
+}
+
+static int setup_gain_f32(bench_ctx_t *ctx)
+{
+  const uint32_t io = SPARK_FMT_F32 | ctx->layout;
+
+  ctx->gain_f32 = (spark_gain_f32_t){
+      .header = make_header(ctx, io, io), .gain = 0.5f, .target = 0.5f};
+  return SPARK_NOERROR;
+}
+
+static void run_gain_f32(bench_ctx_t *ctx)
+{
+  spark_gain_f32(&ctx->gain_f32);
+}
+
+/* Each call glides from the same start, since the gain ends on its target. */
+static void run_gain_f32_ramp(bench_ctx_t *ctx)
+{
+  ctx->gain_f32.gain = 0.25f;
+  spark_gain_f32(&ctx->gain_f32);
+}
+
+static int setup_meter_f32(bench_ctx_t *ctx, uint32_t flags)
+{
+  const uint32_t io = SPARK_FMT_F32 | ctx->layout;
+
+  const spark_meter_f32_t desc = {
+      .header = make_header(ctx, io, io), .flags = flags, .sample_rate = 48000.0f};
+  const size_t size = spark_meter_f32_size(&desc);
+  if (size == 0)
+    return SPARK_ERR_INVALID_PARAM;
+  ctx->arena = malloc(size);
+  if (!ctx->arena)
+    return SPARK_ERR_INVALID_SIZE;
+  return spark_meter_f32_init(&ctx->meter_f32, &desc, ctx->arena, size);
+}
+
+static int setup_meter_f32_peak_rms(bench_ctx_t *ctx)
+{
+  return setup_meter_f32(ctx, SPARK_METER_PEAK | SPARK_METER_RMS);
+}
+
+static int setup_meter_f32_loudness(bench_ctx_t *ctx)
+{
+  return setup_meter_f32(ctx, SPARK_METER_ALL);
+}
+
+static void run_meter_f32(bench_ctx_t *ctx)
+{
+  if (ctx->layout == SPARK_LAYOUT_PLANAR_PTR)
+    spark_meter_f32_execute_planes(&ctx->meter_f32, (const float *const *)ctx->planes_a);
+  else
+    spark_meter_f32_execute(&ctx->meter_f32, ctx->buf_a);
+}
+
+/* Conversions read the swept layout and write planar (a deinterleave when
+ * the sweep is interleaved), or the reverse for encoders. */
+static int setup_convert_i16_f32(bench_ctx_t *ctx)
+{
+  ctx->convert = (spark_convert_t){
+      .header = make_header(ctx, SPARK_FMT_I16 | ctx->layout,
+                            SPARK_FMT_F32 | SPARK_LAYOUT_PLANAR)};
+  return SPARK_NOERROR;
+}
+
+static int setup_convert_f32_i16(bench_ctx_t *ctx)
+{
+  ctx->convert = (spark_convert_t){
+      .header = make_header(ctx, SPARK_FMT_F32 | SPARK_LAYOUT_PLANAR,
+                            SPARK_FMT_I16 | ctx->layout),
+      .flags = SPARK_CONVERT_DITHER_TPDF,
+  };
+  return SPARK_NOERROR;
+}
+
+static void run_convert(bench_ctx_t *ctx)
+{
+  spark_convert(&ctx->convert);
+}
+
+/*
+ * A host-style chain on I16 in the swept layout: decode to planar F32,
+ * filter, apply gain and encode back with dither, through graph scratch.
+ */
+static int setup_graph(bench_ctx_t *ctx)
+{
+  const uint32_t host = SPARK_FMT_I16 | ctx->layout;
+  const uint32_t edge = SPARK_FMT_F32 | SPARK_LAYOUT_PLANAR;
+
+  init_sos_f32(ctx, SPARK_SOSFILT_INDEPENDENT_SOS);
+  ctx->sos_f32.header = make_header(ctx, edge, edge);
+  ctx->gain_f32 = (spark_gain_f32_t){
+      .header = make_header(ctx, edge, edge), .gain = 0.5f, .target = 0.5f};
+  ctx->convert = (spark_convert_t){.header = make_header(ctx, host, edge)};
+  ctx->convert_out = (spark_convert_t){.header = make_header(ctx, edge, host),
+                                       .flags = SPARK_CONVERT_DITHER_TPDF};
+
+  ctx->nodes[0] = spark_graph_node_convert(&ctx->convert);
+  ctx->nodes[1] = spark_graph_node_sosfilt_f32(&ctx->sos_f32);
+  ctx->nodes[2] = spark_graph_node_gain_f32(&ctx->gain_f32);
+  ctx->nodes[3] = spark_graph_node_convert(&ctx->convert_out);
+  ctx->graph = (spark_graph_t){.header = make_header(ctx, host, host),
+                               .nodes = ctx->nodes,
+                               .n_nodes = ARRAY_SIZE(ctx->nodes)};
+
+  const int status = spark_graph_init(&ctx->graph, NULL, 0);
+  if (status != SPARK_NOERROR || ctx->graph.scratch_size == 0)
+    return status;
+
+  void *scratch = alloc_arena(ctx, ctx->graph.scratch_size, SPARK_GRAPH_ALIGN);
+  if (!scratch)
+    return SPARK_ERR_INVALID_SIZE;
+  return spark_graph_init(&ctx->graph, scratch, ctx->graph.scratch_size);
+}
+
+static void run_graph(bench_ctx_t *ctx)
+{
+  spark_graph_run(&ctx->graph);
+}
+
+static const bench_kernel_t kernels[] = {
+    {"sosfilt_f32", true, BENCH_ANY, setup_sosfilt_f32, run_sosfilt_f32},
+    {"sosfilt_f32_shared", true, BENCH_ANY, setup_sosfilt_f32_shared, run_sosfilt_f32},
+    {"sosfilt_f32_execute", true, BENCH_ANY, setup_sosfilt_f32_execute,
+     run_sosfilt_f32_execute},
+    {"sosfilt_f32_ramp", true, BENCH_FRAMES | BENCH_STRIDED, setup_sosfilt_f32_ramp,
+     run_sosfilt_f32_ramp},
+    {"sosfilt_f32_packed", true, BENCH_ANY, setup_sosfilt_f32_packed,
+     run_sosfilt_f32_packed},
+    {"sosfilt_f32_batch", true, BENCH_PLANAR, setup_sosfilt_f32_batch,
+     run_sosfilt_f32_batch},
+    {"sosfilt_f64", true, BENCH_ANY, setup_sosfilt_f64, run_sosfilt_f64},
+    {"sosfilt_f64_mixed", true, BENCH_ANY, setup_sosfilt_f64_mixed, run_sosfilt_f64},
+    {"svf_f32", true, BENCH_ANY, setup_svf_f32, run_svf_f32},
+    {"svf_f32_ramp", true, BENCH_ANY, setup_svf_f32, run_svf_f32_ramp},
+    {"lattice_f32", true, BENCH_ANY, setup_lattice_f32, run_lattice_f32},
+    {"lattice_f32_ramp", true, BENCH_ANY, setup_lattice_f32, run_lattice_f32_ramp},
+    {"fir_f32_direct", false, BENCH_FRAMES, setup_fir_f32_direct, run_fir_f32},
+    {"fir_f32_uniform", false, BENCH_FRAMES, setup_fir_f32_uniform, run_fir_f32},
+    {"fir_f32_nonuniform", false, BENCH_FRAMES, setup_fir_f32_nonuniform, run_fir_f32},
+    {"fft_f32_complex", false, BENCH_PLANAR, setup_fft_f32_complex, run_fft_f32_forward},
+    {"fft_f32_real", false, BENCH_PLANAR, setup_fft_f32_real, run_fft_f32_forward},
+    {"fft_f32_real_inverse", false, BENCH_PLANAR, setup_fft_f32_real,
+     run_fft_f32_inverse},
+    {"resample_f32_up", false, BENCH_FRAMES, setup_resample_f32_up, run_resample_f32},
+    {"resample_f32_down", false, BENCH_FRAMES, setup_resample_f32_down,
+     run_resample_f32},
+    {"gain_f32", false, BENCH_ANY, setup_gain_f32, run_gain_f32},
+    {"gain_f32_ramp", false, BENCH_ANY, setup_gain_f32, run_gain_f32_ramp},
+    {"meter_f32_peak_rms", false, BENCH_ANY, setup_meter_f32_peak_rms, run_meter_f32},
+    {"meter_f32_loudness", false, BENCH_ANY, setup_meter_f32_loudness, run_meter_f32},
+    {"convert_i16_f32", false, BENCH_ANY, setup_convert_i16_f32, run_convert},
+    {"convert_f32_i16_tpdf", false, BENCH_ANY, setup_convert_f32_i16, run_convert},
+    {"graph", true, BENCH_ANY, setup_graph, run_graph},
+};
+
+static bool ctx_alloc(bench_ctx_t *ctx)
+{
+  const size_t n_sos = (size_t)ctx->n_chan * ctx->n_stages;
+
+  /* Room for the padded planes of plane-pointer and strided buffers. */
+  ctx->n_buf = (size_t)ctx->n_chan * (ctx->n_samples + BENCH_PLANE_PAD);
+  memset(&ctx->sos_f32, 0, sizeof(*ctx) - offsetof(bench_ctx_t, sos_f32));
+  ctx->buf_a = malloc(ctx->n_buf * sizeof(double));
+  ctx->buf_b = malloc(ctx->n_buf * sizeof(double));
+  ctx->coeff_f32 = malloc(n_sos * SPARK_LATTICE_COEFFS * sizeof(float));
+  ctx->target_f32 = malloc(n_sos * SPARK_LATTICE_COEFFS * sizeof(float));
+  ctx->coeff_f64 = malloc(n_sos * 5 * sizeof(double));
+  ctx->states_f32 = calloc(n_sos * 2, sizeof(float));
+  ctx->states_f64 = calloc(n_sos * 2, sizeof(double));
+  ctx->taps = NULL;
+  ctx->filters = NULL;
+  ctx->arena = NULL;
+
+  if (!ctx->buf_a || !ctx->buf_b || !ctx->coeff_f32 || !ctx->target_f32 ||
+      !ctx->coeff_f64 || !ctx->states_f32 || !ctx->states_f64)
+    return false;
+
+  fill_sos(ctx->coeff_f32, n_sos);
+  fill_sos(ctx->target_f32, n_sos);
+  for (size_t i = 0; i < n_sos * 5; ++i)
+    ctx->coeff_f64[i] = ctx->coeff_f32[i];
+
+  /* Noise keeps the recursions out of the subnormal range. */
+  float *f = (float *)ctx->buf_a;
+  for (size_t i = 0; i < 2 * ctx->n_buf; ++i)
+    f[i] = 0.5f * frand();
+  memset(ctx->buf_b, 0, ctx->n_buf * sizeof(double));
+  return true;
+}
+
+static void ctx_free(bench_ctx_t *ctx)
+{
+  free(ctx->buf_a);
+  free(ctx->buf_b);
+  free(ctx->coeff_f32);
+  free(ctx->target_f32);
+  free(ctx->coeff_f64);
+  free(ctx->states_f32);
+  free(ctx->states_f64);
+  free(ctx->taps);
+  free(ctx->filters);
+  free(ctx->arena);
+}
+
+/**
+ * @brief Time one case: calibrate to @p min_ns per run, keep the best of 3.
+ */
+static bench_result_t measure(const bench_kernel_t *k, bench_ctx_t *ctx, uint64_t min_ns)
+{
+  const double samples = (double)ctx->n_chan * ctx->n_samples;
+  uint64_t iters = 1;
+
+  /* Warm up caches and branch predictors, then grow until long enough. */
+  for (;;) {
+    const uint64_t t0 = now_ns();
+    for (uint64_t i = 0; i < iters; ++i)
+      k->run(ctx);
+    const uint64_t dt = now_ns() - t0;
+    if (dt >= min_ns / 4 || iters >= (1u << 30))
+      break;
+    iters *= 2;
+  }
+  iters *= 4;
+
+  bench_result_t best = {INFINITY, INFINITY, iters};
+  for (int rep = 0; rep < 3; ++rep) {
+    const uint64_t c0 = now_cycles();
+    const uint64_t t0 = now_ns();
+    for (uint64_t i = 0; i < iters; ++i)
+      k->run(ctx);
+    const uint64_t t1 = now_ns();
+    const uint64_t c1 = now_cycles();
+
+    const double ns = (double)(t1 - t0) / ((double)iters * samples);
+    const double cyc = (double)(c1 - c0) / ((double)iters * samples);
+    if (ns < best.ns_per_sample) {
+      best.ns_per_sample = ns;
+      best.cycles_per_sample = BENCH_HAVE_TSC ? cyc : NAN;
+    }
+  }
+  return best;
+}
+
+typedef struct bench_opts {
+  const char *json_path;
+  const char *csv_path;
+  const char *kernel;
+  int isa; /**< SPARK_ISA_AUTO: every supported level. */
+  bool quick;
+  uint64_t min_ns;
+} bench_opts_t;
+
+static int parse_args(int argc, char **argv, bench_opts_t *opts)
+{
+  opts->json_path = NULL;
+  opts->csv_path = NULL;
+  opts->kernel = NULL;
+  opts->isa = SPARK_ISA_AUTO;
+  opts->quick = false;
+  opts->min_ns = 2000000;
+
+  for (int i = 1; i < argc; ++i) {
+    const char *arg = argv[i];
+    const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+    if (strcmp(arg, "--quick") == 0) {
+      opts->quick = true;
+    } else if (strcmp(arg, "--json") == 0 && val) {
+      opts->json_path = val;
+      ++i;
+    } else if (strcmp(arg, "--csv") == 0 && val) {
+      opts->csv_path = val;
+      ++i;
+    } else if (strcmp(arg, "--kernel") == 0 && val) {
+      opts->kernel = val;
+      ++i;
+    } else if (strcmp(arg, "--min-time-ms") == 0 && val) {
+      opts->min_ns = (uint64_t)strtoul(val, NULL, 10) * 1000000u;
+      ++i;
+    } else if (strcmp(arg, "--isa") == 0 && val) {
+      opts->isa = SPARK_ISA_COUNT;
+      for (int isa = 0; isa < SPARK_ISA_COUNT; ++isa) {
+        if (strcmp(val, spark_dispatch_isa_name(isa)) == 0)
+          opts->isa = isa;
+      }
+      if (opts->isa == SPARK_ISA_COUNT) {
+        fprintf(stderr, "unknown ISA '%s'\n", val);
+        return 1;
+      }
+      ++i;
+    } else {
+      fprintf(stderr,
+              "usage: %s [--json FILE] [--csv FILE] [--quick] [--min-time-ms N]\n"
+              "          [--kernel NAME] [--isa NAME]\n",
+              argv[0]);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static FILE *open_output(const char *path)
+{
+  if (!path)
+    return NULL;
+  FILE *f = fopen(path, "w");
+  if (!f)
+    fprintf(stderr, "cannot write '%s'\n", path);
+  return f;
+}
+
+int main(int argc, char **argv)
+{
+  bench_opts_t opts;
+  if (parse_args(argc, argv, &opts) != 0)
+    return 1;
+
+  FILE *json = open_output(opts.json_path);
+  FILE *csv = open_output(opts.csv_path);
+  if ((opts.json_path && !json) || (opts.csv_path && !csv))
+    return 1;
+
+  /* Without files, CSV goes to stdout. */
+  if (!json && !csv)
+    csv = stdout;
+
+  const uint32_t *chans = opts.quick ? quick_channels : full_channels;
+  const uint32_t *stages = opts.quick ? quick_stages : full_stages;
+  const uint32_t *blocks = opts.quick ? quick_blocks : full_blocks;
+  const size_t n_chans = opts.quick ? ARRAY_SIZE(quick_channels) : ARRAY_SIZE(full_channels);
+  const size_t n_stages = opts.quick ? ARRAY_SIZE(quick_stages) : ARRAY_SIZE(full_stages);
+  const size_t n_blocks = opts.quick ? ARRAY_SIZE(quick_blocks) : ARRAY_SIZE(full_blocks);
+
+  if (json)
+    fprintf(json, "{\n  \"library\": \"libspark\",\n  \"version\": \"%s\",\n"
+                  "  \"results\": [",
+            SPARK_VERSION_STR);
+  if (csv)
+    fprintf(csv, "kernel,isa,layout,channels,stages,samples,ns_per_sample,"
+                 "cycles_per_sample,iterations\n");
+
+  const uint32_t supported = spark_dispatch_supported();
+  const int initial_isa = spark_dispatch_get_isa();
+  bool first = true;
+  int status = 0;
+
+  for (int isa = 0; isa < SPARK_ISA_COUNT; ++isa) {
+    if (!(supported & (1u << isa)) || (opts.isa != SPARK_ISA_AUTO && opts.isa != isa))
+      continue;
+    spark_dispatch_set_isa(isa);
+
+    for (size_t ki = 0; ki < ARRAY_SIZE(kernels); ++ki) {
+      const bench_kernel_t *k = &kernels[ki];
+      if (opts.kernel && strcmp(opts.kernel, k->name) != 0)
+        continue;
+
+      for (size_t li = 0; li < ARRAY_SIZE(layouts); ++li) {
+        if (!(k->layouts & (1u << li)))
+          continue;
+        for (size_t ci = 0; ci < n_chans; ++ci) {
+          for (size_t si = 0; si < (k->uses_stages ? n_stages : 1); ++si) {
+            for (size_t bi = 0; bi < n_blocks; ++bi) {
+              bench_ctx_t ctx;
+              ctx.n_chan = chans[ci];
+              ctx.n_stages = k->uses_stages ? stages[si] : 1;
+              ctx.n_samples = blocks[bi];
+              ctx.layout = layouts[li];
+
+              if (!ctx_alloc(&ctx) || k->setup(&ctx) != SPARK_NOERROR) {
+                fprintf(stderr, "%s: setup failed\n", k->name);
+                ctx_free(&ctx);
+                status = 1;
+                continue;
+              }
+
+              const bench_result_t r = measure(k, &ctx, opts.min_ns);
+              const char *layout = layout_names[li];
+              const uint32_t rep_stages = k->uses_stages ? ctx.n_stages : 0;
+
+              if (json) {
+                fprintf(json,
+                        "%s\n    {\"kernel\": \"%s\", \"isa\": \"%s\", \"layout\": \"%s\", "
+                        "\"channels\": %u, \"stages\": %u, \"samples\": %u, "
+                        "\"ns_per_sample\": %.4f, ",
+                        first ? "" : ",", k->name, spark_dispatch_isa_name(isa), layout,
+                        ctx.n_chan, rep_stages, ctx.n_samples, r.ns_per_sample);
+                if (isnan(r.cycles_per_sample))
+                  fprintf(json, "\"cycles_per_sample\": null, ");
+                else
+                  fprintf(json, "\"cycles_per_sample\": %.4f, ", r.cycles_per_sample);
+                fprintf(json, "\"iterations\": %llu}", (unsigned long long)r.iterations);
+              }
+              if (csv) {
+                fprintf(csv, "%s,%s,%s,%u,%u,%u,%.4f,", k->name,
+                        spark_dispatch_isa_name(isa), layout, ctx.n_chan, rep_stages,
+                        ctx.n_samples, r.ns_per_sample);
+                if (!isnan(r.cycles_per_sample))
+                  fprintf(csv, "%.4f", r.cycles_per_sample);
+                fprintf(csv, ",%llu\n", (unsigned long long)r.iterations);
+              }
+              first = false;
+              ctx_free(&ctx);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  spark_dispatch_set_isa(initial_isa);
+
+  if (json) {
+    fprintf(json, "\n  ]\n}\n");
+    fclose(json);
+  }
+  if (csv && csv != stdout)
+    fclose(csv);
+
+  return status;
+}
@@ -52,6 +52,12 @@ extern "C" {
  * - @ref SPARK_LAYOUT_PLANAR:
  *     `base` points to channel-major **contiguous planes** (not ptr-to-ptr):
  *     channel k starts at `((T*)base) + k * samples`. Each plane has `samples` samples.
+ * - @ref SPARK_LAYOUT_PLANAR_PTR:
+ *     `base` points to an array of `channels` plane pointers (`T *const *`, as
+ *     the `float **` of VST3/AU/CLAP hosts): channel k starts at `((T**)base)[k]`.
+ * - @ref SPARK_LAYOUT_STRIDED:
+ *     `base` points to sample 0 of channel 0; sample n of channel k is at
+ *     `((T*)base) + k * channel_stride + n * sample_stride` (see ::spark_buffer_t).
  *
  * @note Use `spark_buffer_get_format(flags)` / `spark_buffer_get_layout(flags)`
  *       to extract fields, and `spark_buffer_bytes_per_sample()` for element size.
@@ -71,6 +77,10 @@ enum spark_buffer_flags {
                                             frame-major: [L,R,L,R,...]. */
   SPARK_LAYOUT_PLANAR = 0x2u << 4,      /**< Single buffer;
                                              channel planes: [L(0..N-1)][R(0..N-1)]… */
+  SPARK_LAYOUT_PLANAR_PTR = 0x3u << 4,  /**< Array of channel pointers;
+                                             one plane per channel, anywhere. */
+  SPARK_LAYOUT_STRIDED = 0x4u << 4,     /**< Single buffer; channel and sample
+                                             strides given in the descriptor. */
   SPARK_LAYOUT_MASK = 0x0Fu << 4        /**< Mask for layout bits. */
 };
 
@@ -143,6 +153,9 @@ enum spark_block_type {
  *   where required).
  * - Return @ref SPARK_ERR_INVALID_BLOCK for cross-buffer or block-type problems
  *   (e.g., PROCESS requires input/output similarity and both bases present).
+ * - Return @ref SPARK_ERR_NO_MEMORY when an allocator could not supply memory
+ *   (only setup calls that take a ::spark_allocator_t allocate at all).
+ * - Return @ref SPARK_ERR_IO when reading or writing a stream fails.
  */
 enum spark_block_error {
   SPARK_NOERROR = 0, /**< Success. */
@@ -159,6 +172,9 @@ enum spark_block_error {
 
   SPARK_ERR_INVALID_BLOCK = 6, /**< Block-level constraint violated: e.g., PROCESS
                                   similarity, required bases/layouts. */
+
+  SPARK_ERR_NO_MEMORY = 7, /**< An allocator failed or ignored a required hint. */
+  SPARK_ERR_IO = 8,        /**< A stream read or write failed (see `errno`). */
 };
 
 /**
@@ -178,8 +194,18 @@ enum spark_block_error {
  *   `base` points to *channel-major contiguous planes* (not pointer-to-pointer):
  *   channel k starts at `((T*)base) + k * samples`, each plane holds `samples` samples.
  *
- * This type does **not** model pointer-to-pointer planar or custom strides. If you
- * need those, add a separate descriptor or pack into a contiguous view.
+ * - @ref SPARK_LAYOUT_PLANAR_PTR
+ *   `base` points to `channels` plane pointers (`T *const *`); channel k starts
+ *   at `((T**)base)[k]`. Planes need not be adjacent or ordered.
+ *
+ * - @ref SPARK_LAYOUT_STRIDED
+ *   `base` points to the first sample of channel 0, and sample n of channel k
+ *   is at `((T*)base) + k * channel_stride + n * sample_stride`. Covers padded
+ *   planes (`sample_stride == 1`) and a subset of the channels of a wider
+ *   interleaved buffer (`channel_stride == 1`).
+ *
+ * Every layout reduces to a start pointer per channel and a sample stride:
+ * see @ref spark_buffer_channel and @ref spark_buffer_sample_stride.
  *
  * @note
  * - @ref samples is the number of samples **per channel**.
@@ -196,6 +222,14 @@ typedef struct spark_buffer {
   uint32_t channels; /**< The number of audio channels */
   uint32_t samples;   /**< Number of samples per channel */
   uint32_t flags;    /**< Combined flags: one SPARK_FMT_* and one SPARK_LAYOUT_*. */
+
+  /**
+   * Strides of a @ref SPARK_LAYOUT_STRIDED buffer, in samples: between the
+   * first samples of channels k and k+1, and between samples n and n+1 of
+   * one channel. Ignored (leave 0) for the other layouts.
+   */
+  uint32_t channel_stride;
+  uint32_t sample_stride;
 } spark_buffer_t;
 
 /**
@@ -212,7 +246,8 @@ typedef struct spark_buffer {
  * - For interleaved layouts, `buffer.base` points to samples × channels samples
  *   in frame-major order. For planar layouts, `buffer.base` points to
  *   channel-major contiguous planes (channel k starts at
- *   `base + k * samples`). Pointer-to-pointer planar is not represented.
+ *   `base + k * samples`). Pointer-to-pointer planar and strided buffers use
+ *   @ref SPARK_LAYOUT_PLANAR_PTR and @ref SPARK_LAYOUT_STRIDED.
  * - Whether input/output bases may alias is kernel-dependent; validate with
  *   @ref spark_block_validate for a specific operation (PROCESS/CONVERT/SOURCE/SINK).
  *
@@ -295,11 +330,60 @@ static inline size_t spark_buffer_bytes_per_sample(const spark_buffer_t *buf)
   }
 }
 
+/**
+ * @brief Distance, in samples, between consecutive samples of one channel.
+ *
+ * @param[in] buf Buffer descriptor.
+ * @return `channels` for interleaved, `sample_stride` for strided, 1 otherwise.
+ */
+static inline size_t spark_buffer_sample_stride(const spark_buffer_t *buf)
+{
+  switch (spark_buffer_get_layout(buf->flags)) {
+  case SPARK_LAYOUT_INTERLEAVED:
+    return buf->channels;
+  case SPARK_LAYOUT_STRIDED:
+    return buf->sample_stride;
+  default:
+    return 1;
+  }
+}
+
+/**
+ * @brief Pointer to the first sample of channel @p k, in any layout.
+ *
+ * Together with spark_buffer_sample_stride() this addresses every sample:
+ * sample n of channel k is `spark_buffer_channel(buf, k) + n * stride`
+ * elements of spark_buffer_bytes_per_sample() bytes.
+ *
+ * @param[in] buf Buffer descriptor with a non-NULL base and a valid format.
+ * @param[in] k   Channel index, below `buf->channels`.
+ * @return Start of channel @p k.
+ */
+static inline void *spark_buffer_channel(const spark_buffer_t *buf, uint32_t k)
+{
+  const size_t bps = spark_buffer_bytes_per_sample(buf);
+  unsigned char *base = (unsigned char *)buf->base;
+
+  switch (spark_buffer_get_layout(buf->flags)) {
+  case SPARK_LAYOUT_INTERLEAVED:
+    return base + (size_t)k * bps;
+  case SPARK_LAYOUT_PLANAR:
+    return base + (size_t)k * buf->samples * bps;
+  case SPARK_LAYOUT_PLANAR_PTR:
+    return ((void *const *)buf->base)[k];
+  case SPARK_LAYOUT_STRIDED:
+    return base + (size_t)k * buf->channel_stride * bps;
+  default:
+    return NULL;
+  }
+}
+
 /**
  * @brief Compare two buffers for *metadata* equivalence.
  *
  * Returns `true` iff @p a and @p b describe the **same format, layout,
- * channel count, and frame count**. The underlying data pointers are
+ * channel count, and frame count** (and, for @ref SPARK_LAYOUT_STRIDED, the
+ * same strides). The underlying data pointers are
  * **not** compared—this is intentionally a shape/flags comparison.
  *
  * Special cases:
@@ -312,7 +396,7 @@ static inline size_t spark_buffer_bytes_per_sample(const spark_buffer_t *buf)
  *
  * @param[in] a  First buffer descriptor (may be NULL).
  * @param[in] b  Second buffer descriptor (may be NULL).
- * @retval true  If format, layout, channels, and samples all match.
+ * @retval true  If format, layout, channels, samples (and strides) all match.
  * @retval false Otherwise, or if either pointer is NULL (and not identical).
  */
 static inline bool spark_buffer_is_similar(const spark_buffer_t *a,
@@ -323,16 +407,24 @@ static inline bool spark_buffer_is_similar(const spark_buffer_t *a,
   if (!a || !b)
     return false;
 
+  const bool strided = (spark_buffer_get_layout(a->flags) == SPARK_LAYOUT_STRIDED);
+
   return (spark_buffer_get_format(a->flags) == spark_buffer_get_format(b->flags)) &&
          (spark_buffer_get_layout(a->flags) == spark_buffer_get_layout(b->flags)) &&
-         (a->channels == b->channels) && (a->samples == b->samples);
+         (a->channels == b->channels) && (a->samples == b->samples) &&
+         (!strided || (a->channel_stride == b->channel_stride &&
+                       a->sample_stride == b->sample_stride));
 }
 
 /**
  * @brief Check if a buffer descriptor points to a valid, non-empty buffer.
  *
  * This is a convenience function to verify that the buffer pointer itself is not NULL,
- * its base data pointer is not NULL, and its dimensions are non-zero.
+ * its base data pointer is not NULL, and its dimensions are non-zero. A
+ * @ref SPARK_LAYOUT_STRIDED buffer also needs a non-zero sample stride, and a
+ * non-zero channel stride when it has more than one channel. The plane
+ * pointers of a @ref SPARK_LAYOUT_PLANAR_PTR buffer are not dereferenced
+ * here; they must all be valid.
  *
  * @param[in] buf  The buffer descriptor to check.
  * @retval true   If the buffer appears to be valid for processing.
@@ -340,7 +432,13 @@ static inline bool spark_buffer_is_similar(const spark_buffer_t *a,
  */
 static inline bool spark_buffer_is_valid(const spark_buffer_t *buf)
 {
-  return (buf) && (buf->base) && (buf->channels > 0) && (buf->samples > 0);
+  if (!buf || !buf->base || buf->channels == 0 || buf->samples == 0)
+    return false;
+
+  if (spark_buffer_get_layout(buf->flags) == SPARK_LAYOUT_STRIDED)
+    return (buf->sample_stride > 0) && (buf->channel_stride > 0 || buf->channels == 1);
+
+  return true;
 }
 
 /**
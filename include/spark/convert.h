@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_CONVERT_H_
+#define LIBSPARK_CONVERT_H_
+
+#include "spark/block.h"
+#include "spark/libspark_api.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Options for ::spark_convert_t.
+ */
+enum spark_convert_flags {
+  /** Plain conversion: scale, round to nearest, saturate. */
+  SPARK_CONVERT_DEFAULT = 0,
+
+  /**
+   * Add triangular (TPDF) dither of ±1 LSB before rounding whenever the
+   * output is an integer format and the input has a different format.
+   */
+  SPARK_CONVERT_DITHER_TPDF = 1,
+};
+
+/**
+ * @brief Parameters for a format and/or layout conversion (CONVERT block).
+ *
+ * Converts between any `SPARK_FMT_*` × `SPARK_LAYOUT_*` pair described in
+ * the header's input and output buffers. Channel and frame counts must match.
+ *
+ * Integer samples map to the float range [-1, 1) by `x / 2^(bits-1)`; float
+ * to integer multiplies back, rounds to nearest and saturates.
+ */
+typedef struct spark_convert {
+  /**
+   * @param[in,out] header Block header; input and output may differ in
+   * format and layout.
+   */
+  spark_block_t header;
+
+  /**
+   * @param[in] flags A combination of ::spark_convert_flags values.
+   */
+  uint32_t flags;
+
+  /**
+   * @param[in,out] dither_state Dither generator state, advanced by every call
+   * with dither enabled. Any value works as a seed; 0 selects a default.
+   */
+  uint32_t dither_state;
+
+} spark_convert_t;
+
+
+/** Public API functions **/
+LIBSPARK_API void spark_convert(spark_convert_t *self);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LIBSPARK_CONVERT_H_ */
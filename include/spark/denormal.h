@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_DENORMAL_H_
+#define LIBSPARK_DENORMAL_H_
+
+#include "spark/libspark_api.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Magnitude below which spark_sosfilt_f32 states are flushed to zero.
+ *
+ * About -300 dB below full scale: far under any audible or 24-bit signal, and
+ * far enough above the smallest normal float (~1.2e-38) that a decaying state
+ * is caught long before its arithmetic turns subnormal.
+ */
+#define SPARK_DENORMAL_THRESHOLD_F32 1e-15f
+
+/** As ::SPARK_DENORMAL_THRESHOLD_F32, for double-precision states. */
+#define SPARK_DENORMAL_THRESHOLD_F64 1e-30
+
+/**
+ * @brief Floating-point control state saved by spark_fpmode_enter().
+ */
+typedef struct spark_fpmode {
+  /**
+   * @param[out] saved Control register (MXCSR or FPCR) before entering.
+   */
+  uint64_t saved;
+
+  /**
+   * @param[out] changed The register was written and must be restored.
+   */
+  bool changed;
+
+} spark_fpmode_t;
+
+/** Public API functions **/
+LIBSPARK_API bool spark_fpmode_supported(void);
+LIBSPARK_API void spark_fpmode_enter(spark_fpmode_t *mode);
+LIBSPARK_API void spark_fpmode_leave(const spark_fpmode_t *mode);
+LIBSPARK_API uint64_t spark_denormal_count(void);
+LIBSPARK_API void spark_denormal_reset(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LIBSPARK_DENORMAL_H_ */
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_DISPATCH_H_
+#define LIBSPARK_DISPATCH_H_
+
+#include "spark/libspark_api.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Instruction-set levels a kernel table can be built for.
+ *
+ * The library compiles its vector kernels once per level supported by the
+ * toolchain and, on first use, binds the best level the running CPU (and OS)
+ * supports. Use @ref spark_dispatch_set_isa to override the choice, e.g. to
+ * A/B test kernels in production.
+ */
+enum spark_isa {
+  SPARK_ISA_AUTO = -1,  /**< Best available level (only valid as a request). */
+  SPARK_ISA_SCALAR = 0, /**< Portable C, one lane. Always available. */
+  SPARK_ISA_SSE2 = 1,   /**< x86 SSE2, 4 x f32 lanes. */
+  SPARK_ISA_AVX2 = 2,   /**< x86 AVX2 + FMA, 8 x f32 lanes. */
+  SPARK_ISA_AVX512 = 3, /**< x86 AVX-512 F/BW/DQ/VL, 16 x f32 lanes. */
+  SPARK_ISA_NEON = 4,   /**< Arm Advanced SIMD, 4 x f32 lanes. */
+  SPARK_ISA_COUNT = 5   /**< Number of levels; not a level itself. */
+};
+
+/** Public API functions **/
+LIBSPARK_API uint32_t spark_dispatch_supported(void);
+LIBSPARK_API int spark_dispatch_get_isa(void);
+LIBSPARK_API int spark_dispatch_set_isa(int isa);
+LIBSPARK_API const char *spark_dispatch_isa_name(int isa);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LIBSPARK_DISPATCH_H_ */
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_EXECUTOR_H_
+#define LIBSPARK_EXECUTOR_H_
+
+#include "spark/libspark_api.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief One unit of parallel work: process task @p index of a split.
+ */
+typedef void (*spark_task_fn)(void *arg, uint32_t index);
+
+/**
+ * @brief Caller-supplied thread pool, used by the `*_parallel` entry points.
+ *
+ * libspark never creates threads or allocates on the call path: it splits a
+ * call into independent tasks and hands them to @ref parallel_for, which may
+ * run them on any threads, in any order (a work-stealing scheduler is fine).
+ * The split depends only on @ref n_workers and the block shape, never on
+ * timing, and tasks write disjoint memory, so results are bit-identical to a
+ * serial call.
+ */
+typedef struct spark_executor {
+  /**
+   * @param[in] parallel_for Run `fn(arg, i)` once for every i in
+   * `[0, n_tasks)` and return only when all have finished.
+   */
+  void (*parallel_for)(void *pool, spark_task_fn fn, void *arg, uint32_t n_tasks);
+
+  /**
+   * @param[in] pool Opaque pointer passed back to @ref parallel_for.
+   */
+  void *pool;
+
+  /**
+   * @param[in] n_workers Maximum number of tasks to split a call into
+   * (typically the number of worker threads). 0 or 1 runs serially.
+   */
+  uint32_t n_workers;
+
+} spark_executor_t;
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LIBSPARK_EXECUTOR_H_ */
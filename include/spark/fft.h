@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_FFT_H_
+#define LIBSPARK_FFT_H_
+
+#include "spark/libspark_api.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Transform kind of a ::spark_fft_f32_t plan.
+ */
+enum spark_fft_type {
+  /**
+   * Complex to complex: `n` planar samples (re, im) to `n` planar bins.
+   */
+  SPARK_FFT_COMPLEX = 0,
+
+  /**
+   * Real to complex: `n` real samples to the `n / 2 + 1` non-negative
+   * frequency bins (planar re, im); the inverse goes back to `n` reals.
+   * `n` must be even.
+   */
+  SPARK_FFT_REAL = 1,
+};
+
+/** Alignment of the storage carved by spark_fft_f32_init(). */
+#define SPARK_FFT_ALIGN 64
+
+/* Internal plan storage, carved from the caller's arena. */
+struct spark_fft_f32_state;
+
+/**
+ * @brief Library-owned FFT plan: factorization, twiddles and scratch in a caller arena.
+ *
+ * Sizes are products of 2, 3 and 5 (for ::SPARK_FFT_REAL, `n / 2` must be).
+ * Transforms are unnormalized, `X[k] = sum_t x[t] e^(-2 pi i k t / n)`, so
+ * an inverse after a forward transform scales by `n`. A plan holds its own
+ * scratch: one plan must not run two transforms at once. Treat the fields
+ * as read-only.
+ */
+typedef struct spark_fft_f32 {
+  /**
+   * @param[out] type A value from ::spark_fft_type.
+   */
+  uint32_t type;
+
+  /**
+   * @param[out] n Transform size (real samples for ::SPARK_FFT_REAL).
+   */
+  uint32_t n;
+
+  /**
+   * @param[out] state Plan storage inside the arena.
+   */
+  struct spark_fft_f32_state *state;
+
+} spark_fft_f32_t;
+
+/** Public API functions **/
+LIBSPARK_API size_t spark_fft_f32_size(uint32_t type, uint32_t n);
+LIBSPARK_API int spark_fft_f32_init(spark_fft_f32_t *self, uint32_t type, uint32_t n,
+                                    void *arena, size_t arena_size);
+LIBSPARK_API void spark_fft_f32_forward(spark_fft_f32_t *self, const float *in_re,
+                                        const float *in_im, float *out_re, float *out_im);
+LIBSPARK_API void spark_fft_f32_inverse(spark_fft_f32_t *self, const float *in_re,
+                                        const float *in_im, float *out_re, float *out_im);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LIBSPARK_FFT_H_ */
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_FILTER_DESIGN_H_
+#define LIBSPARK_FILTER_DESIGN_H_
+
+#include "spark/libspark_api.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Highest order accepted by spark_design_prototype_init(). */
+#define SPARK_DESIGN_MAX_ORDER 32
+
+/** Second-order sections of a prototype of ::SPARK_DESIGN_MAX_ORDER. */
+#define SPARK_DESIGN_MAX_STAGES (SPARK_DESIGN_MAX_ORDER / 2)
+
+/**
+ * @brief Options of the design functions.
+ */
+enum spark_design_flags {
+  /** Exact design: double-precision `tan`, `pow` and `sqrt`. */
+  SPARK_DESIGN_EXACT = 0,
+
+  /**
+   * Replace `tan` and `pow` with branch-free single-precision rational and
+   * polynomial approximations, within float rounding across (0, 0.5)
+   * cycles/sample; the section arithmetic is unchanged. Meant for redesigns
+   * on every block (parameter automation), where the libm calls dominate.
+   */
+  SPARK_DESIGN_FAST = 1,
+};
+
+/**
+ * @brief Analog prototype families for spark_design_prototype_init().
+ */
+enum spark_design_family {
+  /** Maximally flat; `freq` is the -3 dB point. */
+  SPARK_DESIGN_BUTTERWORTH = 0,
+
+  /** Equiripple passband of `ripple_db`; `freq` is the passband edge. */
+  SPARK_DESIGN_CHEBYSHEV1 = 1,
+
+  /**
+   * Equiripple passband of `ripple_db` and stopband `atten_db` down; `freq`
+   * is the passband edge. The stopband edge follows from the order.
+   */
+  SPARK_DESIGN_ELLIPTIC = 2,
+};
+
+/**
+ * @brief Responses mapped from a prototype by spark_design_iir_f32().
+ */
+enum spark_design_response {
+  SPARK_DESIGN_LOWPASS = 0,  /**< Unity gain at DC. */
+  SPARK_DESIGN_HIGHPASS = 1, /**< Unity gain at Nyquist. */
+};
+
+/**
+ * @brief Single-section types of spark_design_biquad_f32() (RBJ cookbook)
+ * and its SVF and lattice counterparts.
+ */
+enum spark_biquad_type {
+  SPARK_BIQUAD_LOWPASS = 0,   /**< 2nd-order lowpass, resonance set by `q`. */
+  SPARK_BIQUAD_HIGHPASS = 1,  /**< 2nd-order highpass, resonance set by `q`. */
+  SPARK_BIQUAD_BANDPASS = 2,  /**< Bandpass with 0 dB peak gain. */
+  SPARK_BIQUAD_NOTCH = 3,     /**< Band-reject. */
+  SPARK_BIQUAD_ALLPASS = 4,   /**< 2nd-order allpass (phase only). */
+  SPARK_BIQUAD_PEAKING = 5,   /**< Peaking EQ of `gain_db`. */
+  SPARK_BIQUAD_LOWSHELF = 6,  /**< Low shelf of `gain_db`, slope set by `q`. */
+  SPARK_BIQUAD_HIGHSHELF = 7, /**< High shelf of `gain_db`, slope set by `q`. */
+};
+
+/**
+ * @brief Parameters of one section for spark_design_biquad_f32() and its SVF
+ * and lattice counterparts.
+ */
+typedef struct spark_biquad_band {
+  /**
+   * @param[in] type A value from ::spark_biquad_type.
+   */
+  uint32_t type;
+
+  /**
+   * @param[in] freq Center or corner frequency in cycles/sample (`f / fs`),
+   * in (0, 0.5).
+   */
+  float freq;
+
+  /**
+   * @param[in] q Quality factor (> 0); `1/sqrt(2)` gives a Butterworth pass
+   * section or the steepest shelf without overshoot.
+   */
+  float q;
+
+  /**
+   * @param[in] gain_db Gain in dB (peaking and shelves; ignored otherwise).
+   */
+  float gain_db;
+
+} spark_biquad_band_t;
+
+/**
+ * @brief Normalized analog prototype (passband edge at 1 rad/s).
+ *
+ * Holds everything that does not depend on the cutoff, so the trigonometry
+ * and elliptic functions run once; each spark_design_iir_f32() call then
+ * costs one `tan` per filter and a few operations per section. Treat the
+ * fields as read-only.
+ */
+typedef struct spark_design_prototype {
+  /**
+   * @param[out] family A value from ::spark_design_family.
+   */
+  uint32_t family;
+
+  /**
+   * @param[out] order Filter order.
+   */
+  uint32_t order;
+
+  /**
+   * @param[out] n_stages Sections per designed filter, `(order + 1) / 2`.
+   */
+  uint32_t n_stages;
+
+  /**
+   * @param[out] gain Passband gain at DC: 1, or `10^(-ripple_db / 20)` for
+   * even-order ripple designs.
+   */
+  double gain;
+
+  /**
+   * @param[out] pole_re Real part of each section's pole (upper half plane).
+   */
+  double pole_re[SPARK_DESIGN_MAX_STAGES];
+
+  /**
+   * @param[out] pole_im Imaginary part of each section's pole; 0 for the
+   * real pole of an odd order, which is always the last section.
+   */
+  double pole_im[SPARK_DESIGN_MAX_STAGES];
+
+  /**
+   * @param[out] zero_im Each section's zero `j * zero_im` on the imaginary
+   * axis, or 0 for zeros at infinity (all-pole families).
+   */
+  double zero_im[SPARK_DESIGN_MAX_STAGES];
+
+} spark_design_prototype_t;
+
+/** Public API functions **/
+LIBSPARK_API int spark_design_biquad_f32(const spark_biquad_band_t *bands,
+                                         uint32_t n_bands, float *coefficients,
+                                         uint32_t flags);
+LIBSPARK_API int spark_design_svf_f32(const spark_biquad_band_t *bands, uint32_t n_bands,
+                                      float *coefficients, uint32_t flags);
+LIBSPARK_API int spark_design_lattice_f32(const spark_biquad_band_t *bands,
+                                          uint32_t n_bands, float *coefficients,
+                                          uint32_t flags);
+LIBSPARK_API int spark_lattice_f32_from_sos(const float *sos, uint32_t n_sections,
+                                            float *lattice);
+LIBSPARK_API int spark_design_prototype_init(spark_design_prototype_t *proto,
+                                             uint32_t family, uint32_t order,
+                                             double ripple_db, double atten_db);
+LIBSPARK_API int spark_design_iir_f32(const spark_design_prototype_t *proto,
+                                      uint32_t response, const float *freq,
+                                      uint32_t n_filters, float *coefficients,
+                                      uint32_t flags);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LIBSPARK_FILTER_DESIGN_H_ */
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_FIR_FILTER_H_
+#define LIBSPARK_FIR_FILTER_H_
+
+#include "spark/block.h"
+#include "spark/libspark_api.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Defines how FIR taps are applied across channels.
+ */
+enum spark_fir_flags {
+  /**
+   * Each channel has its own taps: `taps` holds `n_channels` runs of
+   * `n_taps` values, channel 0 first.
+   */
+  SPARK_FIR_INDEPENDENT_TAPS = 0,
+
+  /** All channels share one run of `n_taps` values. */
+  SPARK_FIR_SHARE_TAPS = 1,
+};
+
+/**
+ * @brief Convolution algorithm of a ::spark_fir_f32_engine_t.
+ */
+enum spark_fir_method {
+  /** Pick from the tap count and block size (see spark_fir_f32_init()). */
+  SPARK_FIR_AUTO = 0,
+
+  /** Direct form, SIMD across consecutive outputs. */
+  SPARK_FIR_DIRECT = 1,
+
+  /** Uniformly partitioned overlap-save FFT convolution, one block per partition. */
+  SPARK_FIR_UNIFORM = 2,
+
+  /**
+   * Non-uniformly partitioned FFT convolution: block-sized partitions for
+   * the head of the response, doubling partitions for the tail.
+   */
+  SPARK_FIR_NONUNIFORM = 3,
+};
+
+/** Alignment of the storage carved by spark_fir_f32_init(). */
+#define SPARK_FIR_ALIGN 64
+
+/** Largest FFT partition used for the tail of a non-uniform engine, in samples. */
+#define SPARK_FIR_MAX_PARTITION 8192
+
+/**
+ * @brief Description of a FIR filter (PROCESS block).
+ *
+ * The header gives the shape every call will have: F32 samples, planar or
+ * interleaved, and the block size in `samples`.
+ */
+typedef struct spark_fir_f32 {
+  /**
+   * @param[in] header Block header structure (shape only; bases are unused)
+   */
+  spark_block_t header;
+
+  /**
+   * @param[in] taps Impulse response, laid out per `flags`. Copied (or
+   * transformed) at init and not referenced afterwards.
+   */
+  const float *taps;
+
+  /**
+   * @param[in] n_taps Length of the impulse response.
+   */
+  uint32_t n_taps;
+
+  /**
+   * @param[in] flags A flag from the ::spark_fir_flags enum.
+   */
+  uint32_t flags;
+
+  /**
+   * @param[in] method A value from ::spark_fir_method; usually ::SPARK_FIR_AUTO.
+   */
+  uint32_t method;
+
+} spark_fir_f32_t;
+
+/* Internal engine storage, carved from the caller's arena. */
+struct spark_fir_f32_state;
+
+/**
+ * @brief Library-owned FIR engine: taps, history and FFT buffers in a caller arena.
+ *
+ * Every method has zero latency: output sample t depends on input samples
+ * up to t. Treat the fields as read-only.
+ */
+typedef struct spark_fir_f32_engine {
+  /**
+   * @param[out] method The resolved ::spark_fir_method (never AUTO).
+   */
+  uint32_t method;
+
+  /**
+   * @param[out] n_chan Number of channels.
+   */
+  uint32_t n_chan;
+
+  /**
+   * @param[out] n_taps Length of the impulse response.
+   */
+  uint32_t n_taps;
+
+  /**
+   * @param[out] block Samples per channel per call.
+   */
+  uint32_t block;
+
+  /**
+   * @param[out] partition Smallest FFT partition (0 for the direct method).
+   */
+  uint32_t partition;
+
+  /**
+   * @param[out] state Engine storage inside the arena.
+   */
+  struct spark_fir_f32_state *state;
+
+} spark_fir_f32_engine_t;
+
+/** Public API functions **/
+LIBSPARK_API size_t spark_fir_f32_size(const spark_fir_f32_t *desc);
+LIBSPARK_API int spark_fir_f32_init(spark_fir_f32_engine_t *self,
+                                    const spark_fir_f32_t *desc, void *arena,
+                                    size_t arena_size);
+LIBSPARK_API void spark_fir_f32_execute(spark_fir_f32_engine_t *self, const float *input,
+                                        float *output);
+LIBSPARK_API void spark_fir_f32_reset(spark_fir_f32_engine_t *self);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LIBSPARK_FIR_FILTER_H_ */
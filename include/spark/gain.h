@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_GAIN_H_
+#define LIBSPARK_GAIN_H_
+
+#include "spark/block.h"
+#include "spark/libspark_api.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Options for ::spark_gain_f32_t.
+ */
+enum spark_gain_flags {
+  /** Write the scaled input to the output. */
+  SPARK_GAIN_DEFAULT = 0,
+
+  /** Add the scaled input to what the output already holds (mix bus). */
+  SPARK_GAIN_MIX = 1,
+};
+
+/**
+ * @brief Gain, gain ramp or mix-add over a single-precision block (PROCESS block).
+ *
+ * Every channel is scaled by the same gain. When @ref target differs from
+ * @ref gain the gain glides linearly across the block, sample t (t = 0 …
+ * N-1) using `gain + (t + 1) / N * (target - gain)`, and @ref gain is set to
+ * @ref target on return so consecutive blocks join without a step.
+ */
+typedef struct spark_gain_f32 {
+  /**
+   * @param[in,out] header Block header; input and output must be F32 with the
+   * same shape and layout, and may be the same buffer.
+   */
+  spark_block_t header;
+
+  /**
+   * @param[in,out] gain Linear gain at the start of the block; equal to
+   * @ref target after every call.
+   */
+  float gain;
+
+  /**
+   * @param[in] target Linear gain reached on the last sample of the block.
+   */
+  float target;
+
+  /**
+   * @param[in] flags A combination of ::spark_gain_flags values.
+   */
+  uint32_t flags;
+
+} spark_gain_f32_t;
+
+
+/** Public API functions **/
+LIBSPARK_API void spark_gain_f32(spark_gain_f32_t *self);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LIBSPARK_GAIN_H_ */
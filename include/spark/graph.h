@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_GRAPH_H_
+#define LIBSPARK_GRAPH_H_
+
+#include "spark/block.h"
+#include "spark/convert.h"
+#include "spark/gain.h"
+#include "spark/iir_filter.h"
+#include "spark/libspark_api.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Alignment, in bytes, of every intermediate buffer carved from graph scratch. */
+#define SPARK_GRAPH_ALIGN 64
+
+/**
+ * @brief Entry point of a graph node: runs the block it is given.
+ *
+ * @p block points to a struct whose first member is a ::spark_block_t.
+ */
+typedef void (*spark_graph_fn)(void *block);
+
+/**
+ * @brief Per-node options.
+ */
+enum spark_graph_node_flags {
+  /** The node needs distinct input and output buffers. */
+  SPARK_GRAPH_NODE_DEFAULT = 0,
+
+  /** The node may run with `input.base == output.base`. */
+  SPARK_GRAPH_NODE_INPLACE = 1,
+};
+
+/**
+ * @brief One operation in a ::spark_graph_t chain.
+ *
+ * The block's header describes the node's input and output shape and format;
+ * its `base` pointers are owned by the graph and rewritten by
+ * ::spark_graph_init and ::spark_graph_run.
+ */
+typedef struct spark_graph_node {
+  /**
+   * @param[in,out] block Block to run; must start with a ::spark_block_t.
+   */
+  void *block;
+
+  /**
+   * @param[in] run Function that processes @ref block.
+   */
+  spark_graph_fn run;
+
+  /**
+   * @param[in] flags A combination of ::spark_graph_node_flags values.
+   */
+  uint32_t flags;
+
+  /**
+   * @param[out] in_slot Buffer read by this node; planned by ::spark_graph_init.
+   */
+  uint32_t in_slot;
+
+  /**
+   * @param[out] out_slot Buffer written by this node; planned by ::spark_graph_init.
+   */
+  uint32_t out_slot;
+
+} spark_graph_node_t;
+
+/**
+ * @brief A linear chain of blocks run back to back on fixed memory.
+ *
+ * `header.input` is read by the first node and `header.output` is written by
+ * the last one. Intermediate results live in caller-provided scratch, or in
+ * the output buffer itself when it is large enough, and in-place nodes reuse
+ * their input buffer. Node `k`'s output must have the same format, layout
+ * and shape as node `k + 1`'s input, and these internal edges must be
+ * interleaved or planar; plane-pointer and strided buffers can only be the
+ * graph's own input and output.
+ */
+typedef struct spark_graph {
+  /**
+   * @param[in,out] header Block header: chain input and final output. Bases
+   * may change between calls to ::spark_graph_run; shapes may not.
+   */
+  spark_block_t header;
+
+  /**
+   * @param[in,out] nodes Array of @ref n_nodes nodes, in execution order.
+   */
+  spark_graph_node_t *nodes;
+
+  /**
+   * @param[in] n_nodes The number of nodes in the chain.
+   */
+  uint32_t n_nodes;
+
+  /**
+   * @param[out] scratch_size Scratch bytes the plan needs (set by
+   * ::spark_graph_init).
+   */
+  size_t scratch_size;
+
+  /**
+   * @param[out] scratch Scratch memory bound by ::spark_graph_init.
+   */
+  void *scratch;
+
+  /**
+   * @param[out] scratch_offset_b Byte offset of the second scratch buffer.
+   */
+  size_t scratch_offset_b;
+
+} spark_graph_t;
+
+
+/** Public API functions **/
+LIBSPARK_API int spark_graph_init(spark_graph_t *self, void *scratch, size_t scratch_size);
+LIBSPARK_API void spark_graph_run(spark_graph_t *self);
+
+LIBSPARK_API spark_graph_node_t spark_graph_node_sosfilt_f32(spark_sosfilt_f32_t *block);
+LIBSPARK_API spark_graph_node_t spark_graph_node_sosfilt_f64(spark_sosfilt_f64_t *block);
+LIBSPARK_API spark_graph_node_t spark_graph_node_convert(spark_convert_t *block);
+LIBSPARK_API spark_graph_node_t spark_graph_node_gain_f32(spark_gain_f32_t *block);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LIBSPARK_GRAPH_H_ */
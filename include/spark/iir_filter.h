@@ -29,8 +29,11 @@
 #define LIBSPARK_IIR_FILTER_H_
 
 #include "spark/block.h"
+#include "spark/denormal.h"
+#include "spark/executor.h"
 #include "spark/libspark_api.h"
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -48,15 +51,45 @@ enum spark_sosfilt_flags {
   /**
    * Each channel uses a unique set of SOS coefficients. The coefficients
    * array must be structured as `[channel0_sos, channel1_sos, ...]`,
-   * where each `channel_sos` block contains `n_stages * 6` values.
+   * where each `channel_sos` block contains `n_stages * 5` values
+   * (`{b0, b1, b2, -a1, -a2}` per stage, a0 normalized to 1).
    */
   SPARK_SOSFILT_INDEPENDENT_SOS = 0,
 
   /**
    * All channels share the same set of SOS coefficients. The coefficients
-   * array should contain only one set of `n_stages * 6` values.
+   * array should contain only one set of `n_stages * 5` values.
    */
   SPARK_SOSFILT_SHARE_SOS = 1,
+
+  /**
+   * Run each call with flush-to-zero arithmetic on the calling thread
+   * (MXCSR FTZ/DAZ on x86, FPCR FZ on ARM; see spark_fpmode_enter()). The
+   * previous mode is restored before returning. No per-sample cost; no
+   * effect on targets without such a mode (see spark_fpmode_supported()).
+   */
+  SPARK_SOSFILT_FTZ = 2,
+
+  /**
+   * After each call, zero the states whose magnitude fell below
+   * ::SPARK_DENORMAL_THRESHOLD_F32 (or ::SPARK_DENORMAL_THRESHOLD_F64), so
+   * a filter fed silence settles to exact zero instead of decaying into
+   * subnormals. Portable and independent of the FP mode; costs one pass
+   * over the states per block. Calls that flush are counted by
+   * spark_denormal_count().
+   */
+  SPARK_SOSFILT_FLUSH_DENORMALS = 4,
+};
+
+/**
+ * @brief Options for spark_sosfilt_f32_zi().
+ */
+enum spark_sosfilt_zi_flags {
+  /** Steady state for a unit step. */
+  SPARK_SOSFILT_ZI_UNIT = 0,
+
+  /** Scale each channel's steady state by its first input sample. */
+  SPARK_SOSFILT_ZI_FIRST_SAMPLE = 1,
 };
 
 /**
@@ -81,7 +114,8 @@ typedef struct spark_sosfilt_f32 {
   /**
    * @param[in,out] states Pointer to the filter's state memory. This array
    * is read from and written to during processing. Its size must be at least
-   * `io.n_channels * n_stages * 2`.
+   * `io.n_channels * n_stages * 2`. Zero it for a cold start, or load the
+   * step-response steady state with spark_sosfilt_f32_zi().
    */
   float *states;
 
@@ -91,16 +125,348 @@ typedef struct spark_sosfilt_f32 {
   uint32_t n_stages;
 
   /**
-   * @param[in] flags A flag from the ::spark_sosfilt_flags enum that
-   * defines how coefficients are shared across channels.
+   * @param[in] flags A combination of ::spark_sosfilt_flags: how
+   * coefficients are shared across channels, and denormal handling.
    */
   uint32_t flags;
 
 } spark_sosfilt_f32_t;
 
+/**
+ * @brief Parameters for a double-precision cascaded SOS filter.
+ *
+ * Same layout and semantics as ::spark_sosfilt_f32_t, with coefficients and
+ * state held in double. The buffers in `header` may be `SPARK_FMT_F64`, or
+ * `SPARK_FMT_F32` for mixed precision: f32 I/O filtered with f64 state and
+ * arithmetic, for low-frequency or high-Q sections that misbehave in float.
+ */
+typedef struct spark_sosfilt_f64 {
+  /**
+   * @param[in,out] header Block header structure (F32 or F64 buffers)
+   */
+  spark_block_t header;
+
+  /**
+   * @param[in] coefficients Pointer to the biquad filter coefficients,
+   * 5 doubles per stage. The layout is determined by the `flags` field.
+   */
+  const double *coefficients;
+
+  /**
+   * @param[in,out] states Pointer to the filter's state memory. Its size must
+   * be at least `io.n_channels * n_stages * 2` doubles.
+   */
+  double *states;
+
+  /**
+   * @param[in] n_stages The number of second-order sections in the cascade.
+   */
+  uint32_t n_stages;
+
+  /**
+   * @param[in] flags A combination of ::spark_sosfilt_flags: how
+   * coefficients are shared across channels, and denormal handling.
+   */
+  uint32_t flags;
+
+} spark_sosfilt_f64_t;
+
+/* Internal kernel argument packs, referenced by the plans below. */
+struct sosfilt_f32_args;
+struct sosfilt_f64_args;
+
+/**
+ * @brief Validated, resolved form of a ::spark_sosfilt_f32_t.
+ *
+ * Filled by spark_sosfilt_f32_prepare() and consumed by
+ * spark_sosfilt_f32_execute(). Treat the fields as read-only: they are
+ * derived from the filter and the active dispatch level.
+ */
+typedef struct spark_sosfilt_f32_plan {
+  const float *coefficients; /**< Coefficients, as in the filter. */
+  size_t coeff_stride;       /**< Floats between channel sets; 0 if shared. */
+  float *states;             /**< States, as in the filter. */
+  size_t chan_stride;        /**< Samples between channel k and k+1 (0 for planes). */
+  size_t sample_stride;      /**< Samples between frame n and n+1. */
+  uint32_t n_chan;           /**< Number of channels. */
+  uint32_t n_samples;        /**< Samples per channel. */
+  uint32_t n_stages;         /**< Sections in the cascade. */
+  bool planes;               /**< Buffers are channel pointer arrays (PLANAR_PTR). */
+  uint32_t group;            /**< Channels per kernel group (vector width, or 1). */
+  bool packed;               /**< Storage is lane-packed (see ::spark_sosfilt_f32_packed_t). */
+  uint32_t denormals;        /**< FTZ / FLUSH_DENORMALS bits of the filter's flags. */
+
+  /** Dispatched cross-channel kernel, or NULL for the per-channel path. */
+  void (*lanes)(const struct sosfilt_f32_args *args);
+} spark_sosfilt_f32_plan_t;
+
+/**
+ * @brief Validated, resolved form of a ::spark_sosfilt_f64_t.
+ *
+ * See ::spark_sosfilt_f32_plan_t.
+ */
+typedef struct spark_sosfilt_f64_plan {
+  const double *coefficients; /**< Coefficients, as in the filter. */
+  size_t coeff_stride;        /**< Doubles between channel sets; 0 if shared. */
+  double *states;             /**< States, as in the filter. */
+  size_t chan_stride;         /**< Samples between channel k and k+1 (0 for planes). */
+  size_t sample_stride;       /**< Samples between frame n and n+1. */
+  uint32_t n_chan;            /**< Number of channels. */
+  uint32_t n_samples;         /**< Samples per channel. */
+  uint32_t n_stages;          /**< Sections in the cascade. */
+  bool planes;                /**< Buffers are channel pointer arrays (PLANAR_PTR). */
+  bool io_f32;                /**< Buffers hold float (mixed precision). */
+  uint32_t denormals;         /**< FTZ / FLUSH_DENORMALS bits of the filter's flags. */
+
+  /** Dispatched cross-channel kernel, or NULL for the per-channel path. */
+  void (*lanes)(const struct sosfilt_f64_args *args);
+} spark_sosfilt_f64_plan_t;
+
+/** Alignment of the storage carved by spark_sosfilt_f32_packed_init(). */
+#define SPARK_SOSFILT_ALIGN 64
+
+/**
+ * @brief Library-owned SOS filter with SIMD-packed coefficient and state storage.
+ *
+ * Coefficients and states live in a caller-provided arena, aligned to
+ * ::SPARK_SOSFILT_ALIGN and transposed per group of `lanes` channels (the
+ * width of the kernel selected at init): every vector the kernel needs is
+ * one aligned load, with no per-call gather or shuffle. The footprint is
+ * fixed at init and reported by spark_sosfilt_f32_packed_size().
+ *
+ * Run it with spark_sosfilt_f32_execute() on @ref plan.
+ */
+typedef struct spark_sosfilt_f32_packed {
+  /**
+   * @param[out] plan Plan over the packed storage.
+   */
+  spark_sosfilt_f32_plan_t plan;
+
+  /**
+   * @param[out] lanes Channels per packed group.
+   */
+  uint32_t lanes;
+
+  /**
+   * @param[out] flags The ::spark_sosfilt_flags given at init.
+   */
+  uint32_t flags;
+
+} spark_sosfilt_f32_packed_t;
+
+/* Internal slot storage, carved from the caller's arena. */
+struct spark_sosfilt_f32_slot_state;
+
+/**
+ * @brief Wait-free coefficient handover from a control thread to the audio
+ * thread of one filter.
+ *
+ * Four coefficient sets in a caller arena: one being written by the control
+ * thread, one in flight, the audio thread's current set and the one before
+ * it (the start of a ramp). Sets change hands by atomic index exchange only,
+ * so neither side ever blocks, allocates or sees a half-written set. One
+ * control thread and one audio thread per slot. Treat the fields as
+ * read-only.
+ */
+typedef struct spark_sosfilt_f32_slot {
+  /**
+   * @param[out] n_coeffs Floats per coefficient set.
+   */
+  size_t n_coeffs;
+
+  /**
+   * @param[out] state Slot storage inside the arena.
+   */
+  struct spark_sosfilt_f32_slot_state *state;
+
+} spark_sosfilt_f32_slot_t;
+
+/* Internal batch storage, carved from the caller's arena. */
+struct spark_sosfilt_f32_batch_state;
+
+/**
+ * @brief Many independent filters run as one call, channels packed into
+ * SIMD lanes across filter boundaries.
+ *
+ * Built by spark_sosfilt_f32_batch_init() over an array of filter
+ * descriptions; run with spark_sosfilt_f32_batch_execute(). Treat the
+ * fields as read-only.
+ */
+typedef struct spark_sosfilt_f32_batch {
+  /**
+   * @param[out] filters The filter descriptions, read on every call.
+   */
+  const spark_sosfilt_f32_t *filters;
+
+  /**
+   * @param[out] n_filters Number of filters.
+   */
+  uint32_t n_filters;
+
+  /**
+   * @param[out] n_lanes Channels across all filters.
+   */
+  uint32_t n_lanes;
+
+  /**
+   * @param[out] n_runs Runs of consecutive filters with one block length.
+   */
+  uint32_t n_runs;
+
+  /**
+   * @param[out] state Batch storage inside the arena.
+   */
+  struct spark_sosfilt_f32_batch_state *state;
+
+} spark_sosfilt_f32_batch_t;
+
+/**
+ * @brief Edge extension used by spark_sosfiltfilt_f32() (as scipy's `padtype`).
+ */
+enum spark_sosfiltfilt_pad {
+  /** Point reflection about the edge sample: `2 * x[0] - x[k]` (default). */
+  SPARK_SOSFILTFILT_PAD_ODD = 0,
+
+  /** Mirror reflection about the edge sample: `x[k]`. */
+  SPARK_SOSFILTFILT_PAD_EVEN = 1,
+
+  /** The edge sample repeated. */
+  SPARK_SOSFILTFILT_PAD_CONSTANT = 2,
+
+  /** No extension; @ref spark_sosfiltfilt_f32_t::pad_len is ignored. */
+  SPARK_SOSFILTFILT_PAD_NONE = 3,
+};
+
+/** Longest edge extension spark_sosfiltfilt_f32() accepts, in samples. */
+#define SPARK_SOSFILTFILT_MAX_PAD 2048
+
+/**
+ * @brief Parameters for zero-phase (forward-backward) SOS filtering.
+ *
+ * Coefficients, sharing flags and stage count are as for
+ * ::spark_sosfilt_f32_t. The whole signal is one block: there is no state
+ * carried from call to call.
+ */
+typedef struct spark_sosfiltfilt_f32 {
+  /**
+   * @param[in,out] header Block header structure
+   */
+  spark_block_t header;
+
+  /**
+   * @param[in] coefficients Pointer to the biquad filter coefficients.
+   * The layout is determined by the `flags` field.
+   */
+  const float *coefficients;
+
+  /**
+   * @param[out] states Scratch state memory of at least
+   * `io.n_channels * n_stages * 2` floats, overwritten by the call.
+   */
+  float *states;
+
+  /**
+   * @param[in] n_stages The number of second-order sections in the cascade.
+   */
+  uint32_t n_stages;
+
+  /**
+   * @param[in] flags A combination of ::spark_sosfilt_flags.
+   */
+  uint32_t flags;
+
+  /**
+   * @param[in] pad_type Edge extension, one of ::spark_sosfiltfilt_pad.
+   */
+  uint32_t pad_type;
+
+  /**
+   * @param[in] pad_len Samples added at each edge, below `io.samples` and at
+   * most ::SPARK_SOSFILTFILT_MAX_PAD; 0 selects scipy's default of
+   * `3 * (2 * n_stages + 1)`, shortened to fit the block.
+   */
+  uint32_t pad_len;
+
+} spark_sosfiltfilt_f32_t;
 
 /** Public API functions **/
 LIBSPARK_API void spark_sosfilt_f32(spark_sosfilt_f32_t *self);
+LIBSPARK_API void spark_sosfilt_f64(spark_sosfilt_f64_t *self);
+
+LIBSPARK_API int spark_sosfilt_f32_prepare(const spark_sosfilt_f32_t *self,
+                                           spark_sosfilt_f32_plan_t *plan);
+LIBSPARK_API void spark_sosfilt_f32_execute(const spark_sosfilt_f32_plan_t *plan,
+                                            const float *input, float *output);
+LIBSPARK_API void spark_sosfilt_f32_execute_planes(const spark_sosfilt_f32_plan_t *plan,
+                                                   const float *const *input,
+                                                   float *const *output);
+LIBSPARK_API void spark_sosfilt_f32_execute_range(const spark_sosfilt_f32_plan_t *plan,
+                                                  const float *input, float *output,
+                                                  uint32_t first, uint32_t count);
+LIBSPARK_API void
+spark_sosfilt_f32_execute_planes_range(const spark_sosfilt_f32_plan_t *plan,
+                                       const float *const *input, float *const *output,
+                                       uint32_t first, uint32_t count);
+LIBSPARK_API void spark_sosfilt_f32_execute_parallel(const spark_sosfilt_f32_plan_t *plan,
+                                                     const spark_executor_t *executor,
+                                                     const float *target, const float *input,
+                                                     float *output);
+LIBSPARK_API void
+spark_sosfilt_f32_execute_time_parallel(const spark_sosfilt_f32_plan_t *plan,
+                                        const spark_executor_t *executor,
+                                        const float *input, float *output);
+LIBSPARK_API int spark_sosfilt_f32_zi(spark_sosfilt_f32_t *self, uint32_t zi_flags);
+LIBSPARK_API int spark_sosfiltfilt_f32(spark_sosfiltfilt_f32_t *self);
+LIBSPARK_API void spark_sosfilt_f32_ramp(spark_sosfilt_f32_t *self, const float *target);
+LIBSPARK_API void spark_sosfilt_f32_execute_ramp(const spark_sosfilt_f32_plan_t *plan,
+                                                 const float *target, const float *input,
+                                                 float *output);
+LIBSPARK_API void
+spark_sosfilt_f32_execute_ramp_range(const spark_sosfilt_f32_plan_t *plan,
+                                     const float *target, const float *input,
+                                     float *output, uint32_t first, uint32_t count);
+
+LIBSPARK_API size_t spark_sosfilt_f32_packed_size(uint32_t n_chan, uint32_t n_stages);
+LIBSPARK_API int spark_sosfilt_f32_packed_init(spark_sosfilt_f32_packed_t *self,
+                                               const spark_sosfilt_f32_t *desc, void *arena,
+                                               size_t arena_size);
+LIBSPARK_API void spark_sosfilt_f32_packed_set_coefficients(spark_sosfilt_f32_packed_t *self,
+                                                            const float *coefficients);
+LIBSPARK_API void spark_sosfilt_f32_packed_reset(spark_sosfilt_f32_packed_t *self);
+
+LIBSPARK_API size_t spark_sosfilt_f32_slot_size(const spark_sosfilt_f32_t *desc);
+LIBSPARK_API int spark_sosfilt_f32_slot_init(spark_sosfilt_f32_slot_t *slot,
+                                             spark_sosfilt_f32_t *filter, void *arena,
+                                             size_t arena_size);
+LIBSPARK_API float *spark_sosfilt_f32_slot_begin(spark_sosfilt_f32_slot_t *slot);
+LIBSPARK_API void spark_sosfilt_f32_slot_publish(spark_sosfilt_f32_slot_t *slot);
+LIBSPARK_API void spark_sosfilt_f32_slot_store(spark_sosfilt_f32_slot_t *slot,
+                                               const float *coefficients);
+LIBSPARK_API bool spark_sosfilt_f32_slot_acquire(spark_sosfilt_f32_slot_t *slot,
+                                                 const float **coefficients);
+
+LIBSPARK_API size_t spark_sosfilt_f32_batch_size(const spark_sosfilt_f32_t *filters,
+                                                 uint32_t n_filters);
+LIBSPARK_API int spark_sosfilt_f32_batch_init(spark_sosfilt_f32_batch_t *self,
+                                              const spark_sosfilt_f32_t *filters,
+                                              uint32_t n_filters, void *arena,
+                                              size_t arena_size);
+LIBSPARK_API void spark_sosfilt_f32_batch_execute(spark_sosfilt_f32_batch_t *self);
+
+LIBSPARK_API int spark_sosfilt_f64_prepare(const spark_sosfilt_f64_t *self,
+                                           spark_sosfilt_f64_plan_t *plan);
+LIBSPARK_API void spark_sosfilt_f64_execute(const spark_sosfilt_f64_plan_t *plan,
+                                            const void *input, void *output);
+LIBSPARK_API void spark_sosfilt_f64_execute_range(const spark_sosfilt_f64_plan_t *plan,
+                                                  const void *input, void *output,
+                                                  uint32_t first, uint32_t count);
+LIBSPARK_API void spark_sosfilt_f64_execute_planes(const spark_sosfilt_f64_plan_t *plan,
+                                                   const void *const *input,
+                                                   void *const *output);
+LIBSPARK_API void
+spark_sosfilt_f64_execute_planes_range(const spark_sosfilt_f64_plan_t *plan,
+                                       const void *const *input, void *const *output,
+                                       uint32_t first, uint32_t count);
 
 
 #ifdef __cplusplus
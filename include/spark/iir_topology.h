@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_IIR_TOPOLOGY_H_
+#define LIBSPARK_IIR_TOPOLOGY_H_
+
+#include "spark/block.h"
+#include "spark/iir_filter.h"
+#include "spark/libspark_api.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Floats per stage of a ::spark_svf_f32_t: `{g, k, m0, m1, m2}`.
+ *
+ * `g = tan(pi * fc / fs)` and `k = 1 / Q` set the trapezoidal integrators;
+ * the output mixes the input, band-pass and low-pass taps as
+ * `y = m0 * x + m1 * bp + m2 * lp`. spark_design_svf_f32() fills them
+ * from ::spark_biquad_band_t descriptions.
+ */
+#define SPARK_SVF_COEFFS 5
+
+/**
+ * Floats per stage of a ::spark_lattice_f32_t:
+ * `{k1, c1, k2, c2, t0, t1, t2}`.
+ *
+ * Two normalized rotations (reflection `k`, `c = sqrt(1 - k^2)`) followed by
+ * a tap ladder `t`. spark_design_lattice_f32() designs them and
+ * spark_lattice_f32_from_sos() converts existing SOS sections.
+ */
+#define SPARK_LATTICE_COEFFS 7
+
+/**
+ * @brief Cascade of trapezoidal (zero-delay feedback) state-variable filters.
+ *
+ * A drop-in for ::spark_sosfilt_f32_t where the response is modulated every
+ * block: any g > 0 and k > 0 is stable, the state stays bounded when they
+ * change, and the f32 rounding of low-frequency poles is far milder than in
+ * direct form. The header, state and flag semantics are those of
+ * ::spark_sosfilt_f32_t.
+ */
+typedef struct spark_svf_f32 {
+  /**
+   * @param[in,out] header Block header structure
+   */
+  spark_block_t header;
+
+  /**
+   * @param[in] coefficients ::SPARK_SVF_COEFFS floats per stage; one set
+   * per channel, or one set in total with ::SPARK_SOSFILT_SHARE_SOS.
+   */
+  const float *coefficients;
+
+  /**
+   * @param[in,out] states `{ic1eq, ic2eq}` per stage, channel-major:
+   * `io.n_channels * n_stages * 2` floats. Zero it for a cold start.
+   */
+  float *states;
+
+  /**
+   * @param[in] n_stages The number of sections in the cascade.
+   */
+  uint32_t n_stages;
+
+  /**
+   * @param[in] flags A combination of ::spark_sosfilt_flags.
+   */
+  uint32_t flags;
+
+} spark_svf_f32_t;
+
+/**
+ * @brief Cascade of normalized two-pole lattice sections.
+ *
+ * Same shape as ::spark_svf_f32_t with ::SPARK_LATTICE_COEFFS floats and
+ * states `{w0, w1}` per stage. The recursion is a product of rotations, so
+ * it keeps its energy exactly through rounding and any linear ramp between
+ * two stable sections is itself stable.
+ */
+typedef struct spark_lattice_f32 {
+  /**
+   * @param[in,out] header Block header structure
+   */
+  spark_block_t header;
+
+  /**
+   * @param[in] coefficients ::SPARK_LATTICE_COEFFS floats per stage; one
+   * set per channel, or one set in total with ::SPARK_SOSFILT_SHARE_SOS.
+   */
+  const float *coefficients;
+
+  /**
+   * @param[in,out] states `{w0, w1}` per stage, channel-major:
+   * `io.n_channels * n_stages * 2` floats. Zero it for a cold start.
+   */
+  float *states;
+
+  /**
+   * @param[in] n_stages The number of sections in the cascade.
+   */
+  uint32_t n_stages;
+
+  /**
+   * @param[in] flags A combination of ::spark_sosfilt_flags.
+   */
+  uint32_t flags;
+
+} spark_lattice_f32_t;
+
+/** Public API functions **/
+LIBSPARK_API void spark_svf_f32(spark_svf_f32_t *self);
+LIBSPARK_API void spark_svf_f32_ramp(spark_svf_f32_t *self, const float *target);
+
+LIBSPARK_API void spark_lattice_f32(spark_lattice_f32_t *self);
+LIBSPARK_API void spark_lattice_f32_ramp(spark_lattice_f32_t *self, const float *target);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LIBSPARK_IIR_TOPOLOGY_H_ */
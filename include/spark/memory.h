@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_MEMORY_H_
+#define LIBSPARK_MEMORY_H_
+
+#include "spark/libspark_api.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Alignment of every allocation carved by spark_arena_alloc().
+ *
+ * At least the alignment each module asks of its storage (::SPARK_FFT_ALIGN,
+ * ::SPARK_FIR_ALIGN, ::SPARK_RESAMPLE_ALIGN, ::SPARK_SOSFILT_ALIGN,
+ * ::SPARK_GRAPH_ALIGN, ::SPARK_METER_ALIGN, ::SPARK_STREAM_ALIGN), so any
+ * arena allocation can back any object.
+ */
+#define SPARK_MEMORY_ALIGN 64
+
+/**
+ * @brief Placement hints for the block behind a ::spark_arena_t.
+ *
+ * Passed to ::spark_allocator_t::alloc. The system allocator
+ * (spark_allocator_system()) treats @ref SPARK_MEMORY_LOCK as a requirement
+ * and the others as best effort.
+ */
+enum spark_memory_hints {
+  /** Ordinary pages. */
+  SPARK_MEMORY_DEFAULT = 0,
+
+  /**
+   * Back the block with huge pages where the OS offers them (explicit huge
+   * pages, else transparent huge pages), to cut TLB misses on large FFT and
+   * FIR working sets. The block is rounded up to the huge page size.
+   */
+  SPARK_MEMORY_HUGE_PAGES = 1,
+
+  /**
+   * Pin the block in RAM (`mlock`) so the audio thread never takes a page
+   * fault on it. Fails with ::SPARK_ERR_NO_MEMORY when the pages cannot be
+   * locked, e.g. past `RLIMIT_MEMLOCK`.
+   */
+  SPARK_MEMORY_LOCK = 2,
+
+  /**
+   * Touch every page from the reserving thread. Under the usual first-touch
+   * NUMA policy this places the block on that thread's node: reserve from a
+   * thread already bound to the node the audio thread runs on.
+   */
+  SPARK_MEMORY_PREFAULT = 4,
+};
+
+/**
+ * @brief Pluggable source of the memory behind arenas.
+ *
+ * libspark never allocates on its own: objects are carved from memory the
+ * caller passes to their `_init()` functions. The allocator is only called
+ * by spark_arena_reserve() and spark_arena_release(), at setup and
+ * teardown, never from a processing call.
+ */
+typedef struct spark_allocator {
+  /**
+   * @param[in] alloc Return @p size bytes aligned to @p align (a power of
+   * two, at least ::SPARK_MEMORY_ALIGN) honoring @p hints
+   * (::spark_memory_hints), or NULL.
+   */
+  void *(*alloc)(void *ctx, size_t size, size_t align, uint32_t hints);
+
+  /**
+   * @param[in] free Return a block from @ref alloc, with the same size and
+   * hints.
+   */
+  void (*free)(void *ctx, void *ptr, size_t size, uint32_t hints);
+
+  /**
+   * @param[in] ctx Passed to both callbacks.
+   */
+  void *ctx;
+
+} spark_allocator_t;
+
+/**
+ * @brief Bump allocator over one block, reserved once at startup.
+ *
+ * spark_arena_alloc() hands out ::SPARK_MEMORY_ALIGN-aligned pieces in O(1)
+ * with no locking and no system calls, so every FFT plan, FIR engine,
+ * resampler, packed filter, batch, slot and graph scratch of a session can
+ * come out of one pinned block:
+ *
+ *     spark_arena_t arena;
+ *     spark_arena_init(&arena, NULL, 0);               // measure
+ *     spark_arena_alloc(&arena, spark_fir_f32_size(&fir_desc));
+ *     ...
+ *     spark_arena_reserve(&arena, NULL, arena.used, SPARK_MEMORY_LOCK);
+ *     size_t n = spark_fir_f32_size(&fir_desc);       // carve
+ *     spark_fir_f32_init(&fir, &fir_desc, spark_arena_alloc(&arena, n), n);
+ *
+ * Not thread-safe. Treat the fields as read-only.
+ */
+typedef struct spark_arena {
+  /**
+   * @param[out] base First byte of the block, or NULL while measuring.
+   */
+  unsigned char *base;
+
+  /**
+   * @param[out] size Bytes in the block.
+   */
+  size_t size;
+
+  /**
+   * @param[out] used Bytes handed out so far, alignment padding included.
+   * A measuring arena keeps counting: its final value is the block size to
+   * reserve.
+   */
+  size_t used;
+
+  /**
+   * @param[out] allocator Source of the block, or NULL for caller memory.
+   */
+  const spark_allocator_t *allocator;
+
+  /**
+   * @param[out] hints ::spark_memory_hints the block was reserved with.
+   */
+  uint32_t hints;
+
+} spark_arena_t;
+
+/** Public API functions **/
+LIBSPARK_API const spark_allocator_t *spark_allocator_system(void);
+
+LIBSPARK_API int spark_arena_init(spark_arena_t *self, void *memory, size_t size);
+LIBSPARK_API int spark_arena_reserve(spark_arena_t *self,
+                                     const spark_allocator_t *allocator, size_t size,
+                                     uint32_t hints);
+LIBSPARK_API void spark_arena_release(spark_arena_t *self);
+LIBSPARK_API void *spark_arena_alloc(spark_arena_t *self, size_t size);
+LIBSPARK_API void spark_arena_rewind(spark_arena_t *self, size_t mark);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LIBSPARK_MEMORY_H_ */
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_METER_H_
+#define LIBSPARK_METER_H_
+
+#include "spark/block.h"
+#include "spark/iir_filter.h"
+#include "spark/libspark_api.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Measurements kept by a ::spark_meter_f32_engine_t.
+ */
+enum spark_meter_flags {
+  /** Sample peak per channel (largest magnitude). */
+  SPARK_METER_PEAK = 1,
+
+  /** Mean square per channel, read as RMS. */
+  SPARK_METER_RMS = 2,
+
+  /**
+   * K-weighted loudness after ITU-R BS.1770: momentary (400 ms), short-term
+   * (3 s) and gated integrated loudness, in LUFS.
+   */
+  SPARK_METER_LOUDNESS = 4,
+
+  /** Every measurement. */
+  SPARK_METER_ALL = 7,
+};
+
+/**
+ * @brief Loudness readings of spark_meter_f32_loudness().
+ */
+enum spark_meter_loudness {
+  /** Last 400 ms, ungated. */
+  SPARK_METER_MOMENTARY = 0,
+
+  /** Last 3 s, ungated. */
+  SPARK_METER_SHORT_TERM = 1,
+
+  /** Since the last reset, with the absolute (-70 LUFS) and relative (-10 LU) gates. */
+  SPARK_METER_INTEGRATED = 2,
+};
+
+/** Alignment of the storage carved by spark_meter_f32_init(). */
+#define SPARK_METER_ALIGN 64
+
+/**
+ * @brief Description of a level meter (SINK block).
+ *
+ * The header's input gives the shape every call will have: F32 samples in
+ * any layout and the block size in `samples`; the output is unused.
+ */
+typedef struct spark_meter_f32 {
+  /**
+   * @param[in] header Block header structure (input shape only; bases are unused)
+   */
+  spark_block_t header;
+
+  /**
+   * @param[in] flags A combination of ::spark_meter_flags values.
+   */
+  uint32_t flags;
+
+  /**
+   * @param[in] sample_rate Sample rate in Hz; sets the K-weighting filters
+   * and the 100 ms loudness steps. Needed with ::SPARK_METER_LOUDNESS only.
+   */
+  float sample_rate;
+
+  /**
+   * @param[in] channel_weights Loudness weight of each channel (BS.1770 uses
+   * 1.0 for front channels, 1.41 for surrounds and 0 for LFE), or NULL for
+   * 1.0 everywhere. Copied at init.
+   */
+  const float *channel_weights;
+
+} spark_meter_f32_t;
+
+/* Internal engine storage, carved from the caller's arena. */
+struct spark_meter_f32_state;
+
+/**
+ * @brief Library-owned meter: running measurements in a caller arena.
+ *
+ * Readings accumulate from the last spark_meter_f32_reset() of their kind,
+ * so a UI can read and reset the peak per frame while the integrated
+ * loudness keeps running. Treat the fields as read-only.
+ */
+typedef struct spark_meter_f32_engine {
+  /**
+   * @param[out] flags The ::spark_meter_flags measured.
+   */
+  uint32_t flags;
+
+  /**
+   * @param[out] n_chan Number of channels.
+   */
+  uint32_t n_chan;
+
+  /**
+   * @param[out] block Samples per channel per call.
+   */
+  uint32_t block;
+
+  /**
+   * @param[out] step Samples per 100 ms loudness step (0 without loudness).
+   */
+  uint32_t step;
+
+  /**
+   * @param[out] chan_stride Samples between channel k and k+1 (0 for planes).
+   */
+  size_t chan_stride;
+
+  /**
+   * @param[out] sample_stride Samples between frame n and n+1.
+   */
+  size_t sample_stride;
+
+  /**
+   * @param[out] planes The input is host channel arrays (@ref SPARK_LAYOUT_PLANAR_PTR).
+   */
+  bool planes;
+
+  /**
+   * @param[out] state Engine storage inside the arena.
+   */
+  struct spark_meter_f32_state *state;
+
+} spark_meter_f32_engine_t;
+
+/** Public API functions **/
+LIBSPARK_API size_t spark_meter_f32_size(const spark_meter_f32_t *desc);
+LIBSPARK_API int spark_meter_f32_init(spark_meter_f32_engine_t *self,
+                                      const spark_meter_f32_t *desc, void *arena,
+                                      size_t arena_size);
+LIBSPARK_API void spark_meter_f32_execute(spark_meter_f32_engine_t *self,
+                                          const float *input);
+LIBSPARK_API void spark_meter_f32_execute_planes(spark_meter_f32_engine_t *self,
+                                                 const float *const *input);
+LIBSPARK_API void spark_meter_f32_reset(spark_meter_f32_engine_t *self, uint32_t flags);
+LIBSPARK_API float spark_meter_f32_peak(const spark_meter_f32_engine_t *self,
+                                        uint32_t chan);
+LIBSPARK_API float spark_meter_f32_rms(const spark_meter_f32_engine_t *self,
+                                       uint32_t chan);
+LIBSPARK_API float spark_meter_f32_loudness(const spark_meter_f32_engine_t *self,
+                                            uint32_t which);
+
+LIBSPARK_API void spark_sosfilt_f32_execute_metered(const spark_sosfilt_f32_plan_t *plan,
+                                                    spark_meter_f32_engine_t *meter,
+                                                    const float *input, float *output);
+LIBSPARK_API void
+spark_sosfilt_f32_execute_planes_metered(const spark_sosfilt_f32_plan_t *plan,
+                                         spark_meter_f32_engine_t *meter,
+                                         const float *const *input, float *const *output);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LIBSPARK_METER_H_ */
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_RESAMPLE_H_
+#define LIBSPARK_RESAMPLE_H_
+
+#include "spark/block.h"
+#include "spark/libspark_api.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Quality / latency trade-off of a resampler.
+ *
+ * Taps per phase are given for upsampling; downsampling by D widens the
+ * filter, and its latency, by D. Stopband figures are approximate.
+ */
+enum spark_resample_quality {
+  /** 16 taps: about 60 dB of stopband rejection, 8 input samples of latency. */
+  SPARK_RESAMPLE_LOW = 0,
+
+  /** 32 taps: about 90 dB, 16 samples of latency. */
+  SPARK_RESAMPLE_MEDIUM = 1,
+
+  /** 64 taps: about 120 dB, 32 samples of latency. */
+  SPARK_RESAMPLE_HIGH = 2,
+};
+
+/** Alignment of the storage carved by spark_resample_f32_init(). */
+#define SPARK_RESAMPLE_ALIGN 64
+
+/**
+ * Largest reduced output rate `out_rate / gcd(in_rate, out_rate)` run as an
+ * exact rational polyphase filter; above it the phases are interpolated.
+ */
+#define SPARK_RESAMPLE_MAX_PHASES 1024
+
+/** Largest ratio between the two rates, either way. */
+#define SPARK_RESAMPLE_MAX_RATIO 16
+
+/**
+ * @brief Description of a sample-rate converter (CONVERT block).
+ *
+ * `header.input` gives the F32 format, planar or interleaved layout, channel
+ * count and the frames consumed by every call; `header.output` has the same
+ * format, layout and channels, and `samples` is the capacity per call (at
+ * least spark_resample_f32_max_output()). Planar output planes are
+ * `header.output.samples` apart.
+ */
+typedef struct spark_resample_f32 {
+  /**
+   * @param[in] header Block header structure (shape only; bases are unused)
+   */
+  spark_block_t header;
+
+  /**
+   * @param[in] in_rate Input sample rate (any unit, e.g. Hz).
+   */
+  uint32_t in_rate;
+
+  /**
+   * @param[in] out_rate Output sample rate, in the unit of @ref in_rate.
+   */
+  uint32_t out_rate;
+
+  /**
+   * @param[in] quality A value from ::spark_resample_quality.
+   */
+  uint32_t quality;
+
+} spark_resample_f32_t;
+
+/* Internal resampler storage, carved from the caller's arena. */
+struct spark_resample_f32_state;
+
+/**
+ * @brief Library-owned resampler: filter bank and per-channel history in a
+ * caller arena. Treat the fields as read-only.
+ */
+typedef struct spark_resample_f32_engine {
+  /**
+   * @param[out] n_chan Number of channels.
+   */
+  uint32_t n_chan;
+
+  /**
+   * @param[out] block Input frames consumed per call.
+   */
+  uint32_t block;
+
+  /**
+   * @param[out] max_output Most frames one call can produce.
+   */
+  uint32_t max_output;
+
+  /**
+   * @param[out] n_taps Taps per phase.
+   */
+  uint32_t n_taps;
+
+  /**
+   * @param[out] n_phases Filter phases: L of the reduced ratio L / M, or the
+   * size of the interpolated bank.
+   */
+  uint32_t n_phases;
+
+  /**
+   * @param[out] interpolated 1 if the ratio runs on interpolated phases, 0 if exact.
+   */
+  uint32_t interpolated;
+
+  /**
+   * @param[out] latency Delay of the output, in input samples (`n_taps / 2`).
+   */
+  uint32_t latency;
+
+  /**
+   * @param[out] state Resampler storage inside the arena.
+   */
+  struct spark_resample_f32_state *state;
+
+} spark_resample_f32_engine_t;
+
+/** Public API functions **/
+LIBSPARK_API uint32_t spark_resample_f32_max_output(const spark_resample_f32_t *desc);
+LIBSPARK_API size_t spark_resample_f32_size(const spark_resample_f32_t *desc);
+LIBSPARK_API int spark_resample_f32_init(spark_resample_f32_engine_t *self,
+                                         const spark_resample_f32_t *desc, void *arena,
+                                         size_t arena_size);
+LIBSPARK_API uint32_t spark_resample_f32_execute(spark_resample_f32_engine_t *self,
+                                                 const float *input, float *output);
+LIBSPARK_API void spark_resample_f32_reset(spark_resample_f32_engine_t *self);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LIBSPARK_RESAMPLE_H_ */
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_STATS_H_
+#define LIBSPARK_STATS_H_
+
+#include "spark/block.h"
+#include "spark/libspark_api.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Buckets of the per-kernel cycle histogram: bucket b counts calls of [2^b, 2^(b+1)) ticks. */
+#define SPARK_STATS_HIST_BUCKETS 32
+
+/**
+ * @brief Instrumented entry points.
+ */
+enum spark_stats_kernel {
+  SPARK_STATS_SOSFILT_F32 = 0, /**< Every f32 sosfilt execution (plain, ramp, packed). */
+  SPARK_STATS_SOSFILT_F64 = 1, /**< Every f64 / mixed sosfilt execution. */
+  SPARK_STATS_CONVERT = 2,     /**< spark_convert(). */
+  SPARK_STATS_GRAPH = 3,       /**< spark_graph_run(), inclusive of its nodes. */
+  SPARK_STATS_FIR_F32 = 4,     /**< spark_fir_f32_execute(). */
+  SPARK_STATS_RESAMPLE_F32 = 5, /**< spark_resample_f32_execute() (input samples). */
+  SPARK_STATS_SVF_F32 = 6,      /**< spark_svf_f32() and its ramp. */
+  SPARK_STATS_LATTICE_F32 = 7,  /**< spark_lattice_f32() and its ramp. */
+  SPARK_STATS_GAIN_F32 = 8,     /**< spark_gain_f32(). */
+  SPARK_STATS_METER_F32 = 9,    /**< Every meter execution, fused or not. */
+  SPARK_STATS_FFT_F32 = 10,     /**< spark_fft_f32_forward() and inverse (n per call). */
+  SPARK_STATS_KERNEL_COUNT = 11 /**< Number of entries; not a kernel itself. */
+};
+
+/**
+ * @brief Counters of one kernel.
+ *
+ * Ticks come from the CPU's cheapest monotonic counter: the TSC on x86
+ * (reference cycles), CNTVCT_EL0 on AArch64, nanoseconds elsewhere.
+ */
+typedef struct spark_stats_entry {
+  uint32_t block_type;  /**< `SPARK_BLOCK_*` type of the kernel. */
+  uint64_t calls;       /**< Number of calls. */
+  uint64_t samples;     /**< Samples processed (channels × samples per call). */
+  uint64_t ticks;       /**< Total ticks spent inside the kernel. */
+  uint64_t histogram[SPARK_STATS_HIST_BUCKETS]; /**< Calls by log2 of their ticks. */
+} spark_stats_entry_t;
+
+/**
+ * @brief Copy of all counters at one point in time.
+ */
+typedef struct spark_stats_snapshot {
+  bool enabled; /**< False if the library was built without instrumentation. */
+  spark_stats_entry_t kernels[SPARK_STATS_KERNEL_COUNT]; /**< By ::spark_stats_kernel. */
+} spark_stats_snapshot_t;
+
+
+/** Public API functions **/
+LIBSPARK_API bool spark_stats_enabled(void);
+LIBSPARK_API void spark_stats_snapshot(spark_stats_snapshot_t *snapshot);
+LIBSPARK_API void spark_stats_reset(void);
+LIBSPARK_API const char *spark_stats_kernel_name(int kernel);
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LIBSPARK_STATS_H_ */
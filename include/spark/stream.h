@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_STREAM_H_
+#define LIBSPARK_STREAM_H_
+
+#include "spark/executor.h"
+#include "spark/graph.h"
+#include "spark/libspark_api.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Alignment of the chunk buffers carved by spark_stream_init(). */
+#define SPARK_STREAM_ALIGN 64
+
+/**
+ * @brief Options for spark_stream_init().
+ */
+enum spark_stream_flags {
+  /** Read the input with buffered reads into the chunk buffers. */
+  SPARK_STREAM_DEFAULT = 0,
+
+  /**
+   * Memory-map the input when it is a regular file (POSIX), and feed whole
+   * chunks to the graph straight from the mapping, with no read copy. Pipes,
+   * terminals and platforms without `mmap` fall back to reads.
+   */
+  SPARK_STREAM_MMAP = 1,
+};
+
+/* Internal chunk buffers, carved from the caller's arena. */
+struct spark_stream_state;
+
+/**
+ * @brief Offline driver running a ::spark_graph_t over raw PCM files.
+ *
+ * The graph's `header.input` and `header.output` describe one chunk of raw
+ * interleaved frames (any `SPARK_FMT_*`; a mono chunk may use any planar
+ * layout), so a typical graph is convert → filters → convert. The driver
+ * binds the chunk buffers, runs the graph once per chunk and writes each
+ * result straight from the graph's output buffer.
+ *
+ * With an executor of two or more workers, every step runs three tasks at
+ * once: read chunk k+1, process chunk k, write chunk k-1. Each stage owns a
+ * separate buffer of a double-buffered pair, so I/O overlaps with compute.
+ *
+ * The last, partial chunk is zero-padded to the graph's chunk size and
+ * only its valid frames are written. Treat the fields as read-only.
+ */
+typedef struct spark_stream {
+  /**
+   * @param[out] graph The pipeline, initialized with its scratch.
+   */
+  spark_graph_t *graph;
+
+  /**
+   * @param[out] executor Thread pool for overlapped I/O, or NULL for serial.
+   */
+  const spark_executor_t *executor;
+
+  /**
+   * @param[out] flags The ::spark_stream_flags the stream was set up with.
+   */
+  uint32_t flags;
+
+  /**
+   * @param[out] frames Frames written by the last spark_stream_run().
+   */
+  uint64_t frames;
+
+  /**
+   * @param[out] state Chunk buffers in the arena. Opaque.
+   */
+  struct spark_stream_state *state;
+
+} spark_stream_t;
+
+/** Public API functions **/
+LIBSPARK_API size_t spark_stream_size(const spark_graph_t *graph);
+LIBSPARK_API int spark_stream_init(spark_stream_t *self, spark_graph_t *graph,
+                                   const spark_executor_t *executor, uint32_t flags,
+                                   void *arena, size_t arena_size);
+LIBSPARK_API int spark_stream_run(spark_stream_t *self, FILE *input, FILE *output);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* LIBSPARK_STREAM_H_ */
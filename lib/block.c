@@ -178,6 +178,10 @@ const char *spark_strerror(int err)
     return "invalid output buffer";
   case SPARK_ERR_INVALID_BLOCK:
     return "invalid block constraints";
+  case SPARK_ERR_NO_MEMORY:
+    return "out of memory";
+  case SPARK_ERR_IO:
+    return "I/O error";
   default:
     return "unknown error";
   }
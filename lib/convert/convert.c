@@ -0,0 +1,488 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "spark/convert.h"
+#include "dispatch/kernels.h"
+#include "convert/convert_kernels.h"
+#include "stats/stats_internal.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief Samples converted per decode → transpose → encode round.
+ *
+ * The working set is three scratch tiles of this many doubles (12 KiB), so it
+ * stays in L1 and on small RT stacks.
+ */
+#define CONVERT_TILE 512
+
+/** Seed used when spark_convert_t::dither_state is 0. */
+#define CONVERT_DITHER_SEED 0x9E3779B9u
+
+typedef union convert_scratch {
+  float f32[CONVERT_TILE];
+  double f64[CONVERT_TILE];
+} convert_scratch_t;
+
+/**
+ * @brief Per-call conversion state, resolved once from the block.
+ */
+typedef struct convert_ctx {
+  const spark_kernels_t *kernels;
+  uint32_t in_fmt;
+  uint32_t out_fmt;
+  size_t in_bps;  /**< Bytes per input sample. */
+  size_t out_bps; /**< Bytes per output sample. */
+  size_t tmp_bps; /**< Bytes per scratch sample (float or double). */
+  bool wide;      /**< F64 on either side: go through double, not float. */
+  bool dither;    /**< TPDF dither is applied on encode. */
+  uint32_t *rng;  /**< Dither generator state. */
+  convert_scratch_t a, b, noise;
+} convert_ctx_t;
+
+static inline const unsigned char *cbytes(const void *base, size_t idx, size_t bps)
+{
+  return (const unsigned char *)base + (idx * bps);
+}
+
+static inline unsigned char *bytes(void *base, size_t idx, size_t bps)
+{
+  return (unsigned char *)base + (idx * bps);
+}
+
+static inline uint32_t xorshift32(uint32_t *state)
+{
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return x;
+}
+
+/**
+ * @brief Fill @p n TPDF dither values in (-1, 1) LSB: the sum of two uniforms.
+ */
+static void dither_fill(convert_ctx_t *ctx, size_t n)
+{
+  const float k = 1.0f / 16777216.0f;
+
+  for (size_t i = 0; i < n; ++i) {
+    const float u1 = (float)(xorshift32(ctx->rng) >> 8) * k;
+    const float u2 = (float)(xorshift32(ctx->rng) >> 8) * k;
+    if (ctx->wide)
+      ctx->noise.f64[i] = (double)(u1 + u2 - 1.0f);
+    else
+      ctx->noise.f32[i] = u1 + u2 - 1.0f;
+  }
+}
+
+/** Double-precision counterpart of convert_decode_f32 (any format). */
+static void decode_f64(double *dst, const void *src, uint32_t fmt, size_t n)
+{
+  switch (fmt) {
+  case SPARK_FMT_I16:
+    for (size_t i = 0; i < n; ++i)
+      dst[i] = (double)((const int16_t *)src)[i] * (1.0 / CONVERT_I16_SCALE);
+    break;
+  case SPARK_FMT_I32:
+    for (size_t i = 0; i < n; ++i)
+      dst[i] = (double)((const int32_t *)src)[i] * (1.0 / CONVERT_I32_SCALE);
+    break;
+  case SPARK_FMT_F32:
+    for (size_t i = 0; i < n; ++i)
+      dst[i] = (double)((const float *)src)[i];
+    break;
+  case SPARK_FMT_F64:
+    memcpy(dst, src, n * sizeof(double));
+    break;
+  default:
+    break;
+  }
+}
+
+/** Double-precision counterpart of convert_encode_f32 (any format). */
+static void encode_f64(void *dst, uint32_t fmt, const double *src, const double *noise,
+                       size_t n)
+{
+  switch (fmt) {
+  case SPARK_FMT_I16:
+    for (size_t i = 0; i < n; ++i) {
+      double x = src[i] * CONVERT_I16_SCALE + (noise ? noise[i] : 0.0);
+      x = (x > -32768.0) ? x : -32768.0;
+      x = (x < 32767.0) ? x : 32767.0;
+      ((int16_t *)dst)[i] = (int16_t)lrint(x);
+    }
+    break;
+  case SPARK_FMT_I32:
+    for (size_t i = 0; i < n; ++i) {
+      double x = src[i] * CONVERT_I32_SCALE + (noise ? noise[i] : 0.0);
+      x = (x > -2147483648.0) ? x : -2147483648.0;
+      x = (x < 2147483647.0) ? x : 2147483647.0;
+      ((int32_t *)dst)[i] = (int32_t)lrint(x);
+    }
+    break;
+  case SPARK_FMT_F32:
+    for (size_t i = 0; i < n; ++i)
+      ((float *)dst)[i] = (float)src[i];
+    break;
+  case SPARK_FMT_F64:
+    memcpy(dst, src, n * sizeof(double));
+    break;
+  default:
+    break;
+  }
+}
+
+/** Decode @p n contiguous input samples into scratch @p dst. */
+static void decode(const convert_ctx_t *ctx, void *dst, const void *src, size_t n)
+{
+  if (ctx->wide)
+    decode_f64((double *)dst, src, ctx->in_fmt, n);
+  else
+    ctx->kernels->convert_decode_f32((float *)dst, src, ctx->in_fmt, n);
+}
+
+/** Encode @p n scratch samples from @p src into contiguous output @p dst. */
+static void encode(convert_ctx_t *ctx, void *dst, const void *src, size_t n)
+{
+  if (ctx->dither)
+    dither_fill(ctx, n);
+
+  if (ctx->wide)
+    encode_f64(dst, ctx->out_fmt, (const double *)src,
+               ctx->dither ? ctx->noise.f64 : NULL, n);
+  else
+    ctx->kernels->convert_encode_f32(dst, ctx->out_fmt, (const float *)src,
+                                     ctx->dither ? ctx->noise.f32 : NULL, n);
+}
+
+#define CONVERT_DEFINE_TRANSPOSE(name, type)                                             \
+  static void name(type *dst, const type *src, size_t rows, size_t cols, size_t dst_ld, \
+                   size_t src_ld)                                                        \
+  {                                                                                      \
+    for (size_t i0 = 0; i0 < rows; i0 += 16) {                                           \
+      const size_t i1 = (rows - i0 < 16) ? rows : i0 + 16;                               \
+      for (size_t j0 = 0; j0 < cols; j0 += 16) {                                         \
+        const size_t j1 = (cols - j0 < 16) ? cols : j0 + 16;                             \
+        for (size_t i = i0; i < i1; ++i) {                                               \
+          for (size_t j = j0; j < j1; ++j)                                               \
+            dst[j * dst_ld + i] = src[i * src_ld + j];                                   \
+        }                                                                                \
+      }                                                                                  \
+    }                                                                                    \
+  }
+
+CONVERT_DEFINE_TRANSPOSE(transpose_u16, uint16_t)
+CONVERT_DEFINE_TRANSPOSE(transpose_u32, uint32_t)
+CONVERT_DEFINE_TRANSPOSE(transpose_u64, uint64_t)
+
+#define CONVERT_DEFINE_COPY_STRIDED(name, type)                                          \
+  static void name(type *dst, size_t dst_step, const type *src, size_t src_step,         \
+                   size_t n)                                                             \
+  {                                                                                      \
+    for (size_t i = 0; i < n; ++i)                                                       \
+      dst[i * dst_step] = src[i * src_step];                                             \
+  }
+
+CONVERT_DEFINE_COPY_STRIDED(copy_strided_u16, uint16_t)
+CONVERT_DEFINE_COPY_STRIDED(copy_strided_u32, uint32_t)
+CONVERT_DEFINE_COPY_STRIDED(copy_strided_u64, uint64_t)
+
+/**
+ * @brief Strided copy of raw words: `dst[i * dst_step] = src[i * src_step]`.
+ */
+static void copy_strided(void *dst, size_t dst_step, const void *src, size_t src_step,
+                         size_t n, size_t bps)
+{
+  switch (bps) {
+  case 2:
+    copy_strided_u16(dst, dst_step, src, src_step, n);
+    break;
+  case 4:
+    copy_strided_u32(dst, dst_step, src, src_step, n);
+    break;
+  case 8:
+    copy_strided_u64(dst, dst_step, src, src_step, n);
+    break;
+  default:
+    break;
+  }
+}
+
+/**
+ * @brief Blocked transpose: `dst[j * dst_ld + i] = src[i * src_ld + j]`.
+ *
+ * Elements are moved as raw 2/4/8-byte words, so no value is ever rounded.
+ */
+static void transpose(void *dst, const void *src, size_t rows, size_t cols, size_t dst_ld,
+                      size_t src_ld, size_t bps)
+{
+  switch (bps) {
+  case 2:
+    transpose_u16(dst, src, rows, cols, dst_ld, src_ld);
+    break;
+  case 4:
+    transpose_u32(dst, src, rows, cols, dst_ld, src_ld);
+    break;
+  case 8:
+    transpose_u64(dst, src, rows, cols, dst_ld, src_ld);
+    break;
+  default:
+    break;
+  }
+}
+
+/** Convert @p n contiguous samples, same layout on both sides. */
+static void convert_run(convert_ctx_t *ctx, void *dst, const void *src, size_t n)
+{
+  if (ctx->in_fmt == ctx->out_fmt) {
+    if (dst != src)
+      memmove(dst, src, n * ctx->in_bps);
+    return;
+  }
+
+  for (size_t off = 0; off < n; off += CONVERT_TILE) {
+    const size_t count = (n - off < CONVERT_TILE) ? (n - off) : CONVERT_TILE;
+    decode(ctx, &ctx->a, cbytes(src, off, ctx->in_bps), count);
+    encode(ctx, bytes(dst, off, ctx->out_bps), &ctx->a, count);
+  }
+}
+
+/**
+ * @brief Convert channel by channel, for any pair of layouts.
+ *
+ * Each channel is walked through its start pointer and sample stride (see
+ * spark_buffer_channel()). Strided runs are gathered into a tile, converted
+ * and scattered back; contiguous runs are converted in place of the copies.
+ */
+static void convert_channels(convert_ctx_t *ctx, const spark_buffer_t *in,
+                             const spark_buffer_t *out)
+{
+  const size_t N = in->samples;
+  const size_t src_step = spark_buffer_sample_stride(in);
+  const size_t dst_step = spark_buffer_sample_stride(out);
+
+  for (uint32_t c = 0; c < in->channels; ++c) {
+    const void *src = spark_buffer_channel(in, c);
+    void *dst = spark_buffer_channel(out, c);
+
+    if (src_step == 1 && dst_step == 1) {
+      convert_run(ctx, dst, src, N);
+      continue;
+    }
+
+    if (ctx->in_fmt == ctx->out_fmt) {
+      copy_strided(dst, dst_step, src, src_step, N, ctx->in_bps);
+      continue;
+    }
+
+    for (size_t off = 0; off < N; off += CONVERT_TILE) {
+      const size_t count = (N - off < CONVERT_TILE) ? (N - off) : CONVERT_TILE;
+      const void *run = cbytes(src, off * src_step, ctx->in_bps);
+
+      if (src_step != 1) {
+        copy_strided(&ctx->b, 1, run, src_step, count, ctx->in_bps);
+        run = &ctx->b;
+      }
+
+      decode(ctx, &ctx->a, run, count);
+
+      if (dst_step == 1) {
+        encode(ctx, bytes(dst, off, ctx->out_bps), &ctx->a, count);
+      } else {
+        encode(ctx, &ctx->b, &ctx->a, count);
+        copy_strided(bytes(dst, off * dst_step, ctx->out_bps), dst_step, &ctx->b, 1,
+                     count, ctx->out_bps);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Convert and change layout, one tile of frames at a time.
+ *
+ * Each tile is decoded from its source runs (planes or frames), transposed
+ * in the scratch format and encoded into the destination runs, so the buffers
+ * are each touched once. The planar side may be contiguous planes or plane
+ * pointers; a layout-only change needs contiguous planes.
+ */
+static void convert_transpose(convert_ctx_t *ctx, const spark_buffer_t *in,
+                              const spark_buffer_t *out, bool to_interleaved)
+{
+  const spark_buffer_t *planar = to_interleaved ? in : out;
+  const void *src = in->base;
+  void *dst = out->base;
+  const size_t C = in->channels;
+  const size_t N = in->samples;
+
+  if (ctx->in_fmt == ctx->out_fmt) {
+    if (to_interleaved)
+      transpose(dst, src, C, N, C, N, ctx->in_bps);
+    else
+      transpose(dst, src, N, C, N, C, ctx->in_bps);
+    return;
+  }
+
+  const size_t frames = CONVERT_TILE / C;
+
+  if (frames == 0) {
+    /* More channels than a tile: convert one sample at a time. */
+    for (size_t t = 0; t < N; ++t) {
+      for (size_t c = 0; c < C; ++c) {
+        const size_t inter = t * C + c;
+        void *plane = spark_buffer_channel(planar, (uint32_t)c);
+        const void *from = to_interleaved ? cbytes(plane, t, ctx->in_bps)
+                                          : cbytes(src, inter, ctx->in_bps);
+        void *to = to_interleaved ? bytes(dst, inter, ctx->out_bps)
+                                  : bytes(plane, t, ctx->out_bps);
+        decode(ctx, &ctx->a, from, 1);
+        encode(ctx, to, &ctx->a, 1);
+      }
+    }
+    return;
+  }
+
+  for (size_t t0 = 0; t0 < N; t0 += frames) {
+    const size_t cnt = (N - t0 < frames) ? (N - t0) : frames;
+
+    if (to_interleaved) {
+      for (size_t c = 0; c < C; ++c)
+        decode(ctx, bytes(&ctx->a, c * cnt, ctx->tmp_bps),
+               cbytes(spark_buffer_channel(planar, (uint32_t)c), t0, ctx->in_bps), cnt);
+      transpose(&ctx->b, &ctx->a, C, cnt, C, cnt, ctx->tmp_bps);
+      encode(ctx, bytes(dst, t0 * C, ctx->out_bps), &ctx->b, cnt * C);
+    } else {
+      decode(ctx, &ctx->a, cbytes(src, t0 * C, ctx->in_bps), cnt * C);
+      transpose(&ctx->b, &ctx->a, cnt, C, cnt, C, ctx->tmp_bps);
+      for (size_t c = 0; c < C; ++c)
+        encode(ctx, bytes(spark_buffer_channel(planar, (uint32_t)c), t0, ctx->out_bps),
+               bytes(&ctx->b, c * cnt, ctx->tmp_bps), cnt);
+    }
+  }
+}
+
+/**
+ * @brief Convert a buffer between sample formats and/or memory layouts.
+ *
+ * Handles every `SPARK_FMT_*` × `SPARK_LAYOUT_*` pair for input and output:
+ *
+ * - **Format**: integers are scaled by `1 / 2^(bits-1)` to float. Float to
+ *   integer scales back, optionally adds TPDF dither
+ *   (@ref SPARK_CONVERT_DITHER_TPDF), saturates and rounds to nearest.
+ *   I16/I32/F32 pairs run on the SIMD kernels through float; any pair with
+ *   F64 goes through double so no precision is lost. On the float path,
+ *   positive I32 full scale saturates at 2147483520 (the largest float below
+ *   2^31).
+ * - **Layout**: interleave/deinterleave is fused with the format step. Tiles
+ *   of frames are decoded, transposed in L1 and encoded, so no full-size
+ *   intermediate buffer is needed. A layout-only change moves raw words.
+ *   Host channel arrays (@ref SPARK_LAYOUT_PLANAR_PTR) and strided buffers
+ *   (@ref SPARK_LAYOUT_STRIDED) are read and written in place through their
+ *   channel pointers and strides, so a host's `float **` can be converted
+ *   to or from any other layout without a packing copy.
+ *
+ * ### Constraints
+ * - CONVERT block: input and output must have the same channel and frame
+ *   counts.
+ * - Input and output may be the same buffer only if the layout is unchanged
+ *   and both formats have the same sample size; otherwise they must not
+ *   overlap.
+ *
+ * @param[in,out] self Pointer to instance
+ */
+void spark_convert(spark_convert_t *self)
+{
+  assert(self);
+  const spark_buffer_t *in = &self->header.input;
+  const spark_buffer_t *out = &self->header.output;
+
+  const uint32_t in_layout = spark_buffer_get_layout(in->flags);
+  const uint32_t out_layout = spark_buffer_get_layout(out->flags);
+
+  int status = spark_block_validate(self, spark_buffer_get_format(in->flags) | in_layout |
+                                              SPARK_BLOCK_CONVERT);
+
+  if (status == SPARK_NOERROR) {
+    if (!spark_buffer_bytes_per_sample(in) || in_layout > SPARK_LAYOUT_STRIDED)
+      status = SPARK_ERR_INVALID_INPUT;
+    else if (!spark_buffer_bytes_per_sample(out) || out_layout == SPARK_LAYOUT_INVALID ||
+             out_layout > SPARK_LAYOUT_STRIDED)
+      status = SPARK_ERR_INVALID_OUTPUT;
+    else if (in->channels != out->channels || in->samples != out->samples)
+      status = SPARK_ERR_INVALID_BLOCK;
+  }
+
+  assert(status == SPARK_NOERROR);
+
+  if (status != SPARK_NOERROR) {
+    return;
+  }
+
+  SPARK_STATS_BEGIN();
+
+  convert_ctx_t ctx;
+  ctx.kernels = spark_kernels();
+  ctx.in_fmt = spark_buffer_get_format(in->flags);
+  ctx.out_fmt = spark_buffer_get_format(out->flags);
+  ctx.in_bps = spark_buffer_bytes_per_sample(in);
+  ctx.out_bps = spark_buffer_bytes_per_sample(out);
+  ctx.wide = (ctx.in_fmt == SPARK_FMT_F64) || (ctx.out_fmt == SPARK_FMT_F64);
+  ctx.tmp_bps = ctx.wide ? sizeof(double) : sizeof(float);
+  ctx.dither = (self->flags & SPARK_CONVERT_DITHER_TPDF) && (ctx.in_fmt != ctx.out_fmt) &&
+               (ctx.out_fmt == SPARK_FMT_I16 || ctx.out_fmt == SPARK_FMT_I32);
+  ctx.rng = &self->dither_state;
+
+  if (ctx.dither && self->dither_state == 0)
+    self->dither_state = CONVERT_DITHER_SEED;
+
+  const size_t total = (size_t)in->channels * in->samples;
+
+  const bool in_single = (in_layout == SPARK_LAYOUT_INTERLEAVED ||
+                         in_layout == SPARK_LAYOUT_PLANAR);
+  const bool out_single = (out_layout == SPARK_LAYOUT_INTERLEAVED ||
+                           out_layout == SPARK_LAYOUT_PLANAR);
+  const bool in_ptr_to_interleaved =
+      (in_layout == SPARK_LAYOUT_PLANAR_PTR && out_layout == SPARK_LAYOUT_INTERLEAVED);
+  const bool interleaved_to_ptr =
+      (in_layout == SPARK_LAYOUT_INTERLEAVED && out_layout == SPARK_LAYOUT_PLANAR_PTR);
+
+  /* Mono has a single layout in practice. */
+  if (in_single && out_single && (in_layout == out_layout || in->channels == 1))
+    convert_run(&ctx, out->base, in->base, total);
+  else if (in_single && out_single)
+    convert_transpose(&ctx, in, out, out_layout == SPARK_LAYOUT_INTERLEAVED);
+  else if ((in_ptr_to_interleaved || interleaved_to_ptr) && in->channels > 1 &&
+           ctx.in_fmt != ctx.out_fmt)
+    convert_transpose(&ctx, in, out, in_ptr_to_interleaved);
+  else
+    convert_channels(&ctx, in, out);
+
+  SPARK_STATS_END(SPARK_STATS_CONVERT, total);
+}
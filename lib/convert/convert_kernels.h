@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Internal kernel interface for sample-format conversion. Not installed.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_CONVERT_KERNELS_H_
+#define LIBSPARK_CONVERT_KERNELS_H_
+
+#include "dispatch/isa.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Integer full-scale values: x_float = x_int / scale. */
+#define CONVERT_I16_SCALE 32768.0f
+#define CONVERT_I32_SCALE 2147483648.0f
+
+#ifdef SPARK_ISA
+/**
+ * @brief Decode @p n contiguous I16, I32 or F32 samples to float.
+ *
+ * @param[out] dst  @p n floats (must not overlap @p src).
+ * @param[in] src   @p n samples of format @p fmt.
+ * @param[in] fmt   `SPARK_FMT_I16`, `SPARK_FMT_I32` or `SPARK_FMT_F32`.
+ * @param[in] n     Number of samples.
+ */
+void SPARK_ISA_FN(convert_decode_f32)(float *dst, const void *src, uint32_t fmt, size_t n);
+
+/**
+ * @brief Encode @p n contiguous floats as I16, I32 or F32 samples.
+ *
+ * Integer targets are scaled, offset by @p noise (in LSB, may be NULL),
+ * saturated and rounded to nearest.
+ *
+ * @param[out] dst   @p n samples of format @p fmt (must not overlap @p src).
+ * @param[in] fmt    `SPARK_FMT_I16`, `SPARK_FMT_I32` or `SPARK_FMT_F32`.
+ * @param[in] src    @p n floats.
+ * @param[in] noise  @p n dither values in LSB, or NULL.
+ * @param[in] n      Number of samples.
+ */
+void SPARK_ISA_FN(convert_encode_f32)(void *dst, uint32_t fmt, const float *src,
+                                      const float *noise, size_t n);
+#endif
+
+#endif /* LIBSPARK_CONVERT_KERNELS_H_ */
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "spark/block.h"
+#include "convert/convert_kernels.h"
+#include "simd/simd_f32.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+void SPARK_ISA_FN(convert_decode_f32)(float *dst, const void *src, uint32_t fmt, size_t n)
+{
+  size_t i = 0;
+
+  switch (fmt) {
+  case SPARK_FMT_I16: {
+    const int16_t *in = (const int16_t *)src;
+    const vf32_t k = vf32_set1(1.0f / CONVERT_I16_SCALE);
+    for (; i + VF32_LANES <= n; i += VF32_LANES)
+      vf32_store(dst + i, vf32_mul(vf32_from_i16(in + i), k));
+    for (; i < n; ++i)
+      dst[i] = (float)in[i] * (1.0f / CONVERT_I16_SCALE);
+    break;
+  }
+  case SPARK_FMT_I32: {
+    const int32_t *in = (const int32_t *)src;
+    const vf32_t k = vf32_set1(1.0f / CONVERT_I32_SCALE);
+    for (; i + VF32_LANES <= n; i += VF32_LANES)
+      vf32_store(dst + i, vf32_mul(vf32_from_i32(in + i), k));
+    for (; i < n; ++i)
+      dst[i] = (float)in[i] * (1.0f / CONVERT_I32_SCALE);
+    break;
+  }
+  case SPARK_FMT_F32:
+    memcpy(dst, src, n * sizeof(float));
+    break;
+  default:
+    break;
+  }
+}
+
+void SPARK_ISA_FN(convert_encode_f32)(void *dst, uint32_t fmt, const float *src,
+                                      const float *noise, size_t n)
+{
+  size_t i = 0;
+
+  switch (fmt) {
+  case SPARK_FMT_I16: {
+    int16_t *out = (int16_t *)dst;
+    const float lo = -CONVERT_I16_SCALE;
+    const float hi = CONVERT_I16_SCALE - 1.0f;
+    const vf32_t k = vf32_set1(CONVERT_I16_SCALE);
+    const vf32_t vlo = vf32_set1(lo);
+    const vf32_t vhi = vf32_set1(hi);
+
+    for (; i + VF32_LANES <= n; i += VF32_LANES) {
+      vf32_t x = vf32_mul(vf32_load(src + i), k);
+      if (noise)
+        x = vf32_add(x, vf32_load(noise + i));
+      vf32_to_i16(out + i, vf32_min(vf32_max(x, vlo), vhi));
+    }
+    for (; i < n; ++i) {
+      float x = src[i] * CONVERT_I16_SCALE + (noise ? noise[i] : 0.0f);
+      x = (x > lo) ? x : lo; /* NaN saturates low, as in the vector path */
+      x = (x < hi) ? x : hi;
+      out[i] = (int16_t)lrintf(x);
+    }
+    break;
+  }
+  case SPARK_FMT_I32: {
+    int32_t *out = (int32_t *)dst;
+    /* 2^31 - 1 is not a float; clamp to the largest float below 2^31. */
+    const float lo = -CONVERT_I32_SCALE;
+    const float hi = 2147483520.0f;
+    const vf32_t k = vf32_set1(CONVERT_I32_SCALE);
+    const vf32_t vlo = vf32_set1(lo);
+    const vf32_t vhi = vf32_set1(hi);
+
+    for (; i + VF32_LANES <= n; i += VF32_LANES) {
+      vf32_t x = vf32_mul(vf32_load(src + i), k);
+      if (noise)
+        x = vf32_add(x, vf32_load(noise + i));
+      vf32_to_i32(out + i, vf32_min(vf32_max(x, vlo), vhi));
+    }
+    for (; i < n; ++i) {
+      float x = src[i] * CONVERT_I32_SCALE + (noise ? noise[i] : 0.0f);
+      x = (x > lo) ? x : lo; /* NaN saturates low, as in the vector path */
+      x = (x < hi) ? x : hi;
+      out[i] = (int32_t)lrintf(x);
+    }
+    break;
+  }
+  case SPARK_FMT_F32:
+    memcpy(dst, src, n * sizeof(float));
+    break;
+  default:
+    break;
+  }
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "spark/denormal.h"
+#include "denormal/denormal_internal.h"
+
+#include <stdatomic.h>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define SPARK_FPMODE_MXCSR 1
+#elif defined(__aarch64__) && !defined(_MSC_VER)
+#define SPARK_FPMODE_FPCR 1
+#elif defined(__arm__) && defined(__ARM_FP) && !defined(__SOFTFP__)
+#define SPARK_FPMODE_FPSCR 1
+#endif
+
+/** MXCSR flush-to-zero (bit 15) and denormals-are-zero (bit 6). */
+#define FPMODE_MXCSR_FTZ_DAZ 0x8040u
+
+/** FPCR / FPSCR flush-to-zero (FZ, bit 24); covers inputs and results. */
+#define FPMODE_ARM_FZ (1u << 24)
+
+/** Blocks in which at least one state was flushed. */
+static atomic_uint_fast64_t denormal_count;
+
+static inline uint64_t fpmode_read(void)
+{
+#if defined(SPARK_FPMODE_MXCSR)
+  return _mm_getcsr();
+#elif defined(SPARK_FPMODE_FPCR)
+  uint64_t v;
+  __asm__ volatile("mrs %0, fpcr" : "=r"(v));
+  return v;
+#elif defined(SPARK_FPMODE_FPSCR)
+  uint32_t v;
+  __asm__ volatile("vmrs %0, fpscr" : "=r"(v));
+  return v;
+#else
+  return 0;
+#endif
+}
+
+static inline void fpmode_write(uint64_t v)
+{
+#if defined(SPARK_FPMODE_MXCSR)
+  _mm_setcsr((unsigned int)v);
+#elif defined(SPARK_FPMODE_FPCR)
+  __asm__ volatile("msr fpcr, %0" : : "r"(v));
+#elif defined(SPARK_FPMODE_FPSCR)
+  __asm__ volatile("vmsr fpscr, %0" : : "r"((uint32_t)v));
+#else
+  (void)v;
+#endif
+}
+
+/** Bits spark_fpmode_enter() sets on this target; 0 when it has none. */
+static inline uint64_t fpmode_bits(void)
+{
+#if defined(SPARK_FPMODE_MXCSR)
+  return FPMODE_MXCSR_FTZ_DAZ;
+#elif defined(SPARK_FPMODE_FPCR) || defined(SPARK_FPMODE_FPSCR)
+  return FPMODE_ARM_FZ;
+#else
+  return 0;
+#endif
+}
+
+/**
+ * @brief Whether spark_fpmode_enter() can switch this target to flush-to-zero.
+ *
+ * True on x86 with SSE (MXCSR) and on ARM with a VFP/NEON unit (FPCR/FPSCR).
+ * Elsewhere enter and leave are no-ops; use @ref SPARK_SOSFILT_FLUSH_DENORMALS,
+ * which works everywhere.
+ */
+bool spark_fpmode_supported(void)
+{
+  return fpmode_bits() != 0;
+}
+
+/**
+ * @brief Switch the calling thread to flush-to-zero arithmetic.
+ *
+ * Sets FTZ and DAZ on x86 (subnormal results and operands read as zero) or
+ * FZ on ARM, after saving the current mode in @p mode. The register is only
+ * written when the bits are not already set, so nested scopes and threads
+ * that run with FTZ permanently pay one register read.
+ *
+ * The mode is per thread and affects all floating-point code on it until
+ * spark_fpmode_leave(), so keep the scope tight: around one callback or
+ * one block. The @ref SPARK_SOSFILT_FTZ flag does exactly this around each
+ * filter call.
+ *
+ * @param[out] mode Saved state to pass to spark_fpmode_leave().
+ */
+void spark_fpmode_enter(spark_fpmode_t *mode)
+{
+  const uint64_t bits = fpmode_bits();
+  const uint64_t saved = fpmode_read();
+
+  mode->saved = saved;
+  mode->changed = (saved & bits) != bits;
+
+  if (mode->changed)
+    fpmode_write(saved | bits);
+}
+
+/**
+ * @brief Restore the mode saved by spark_fpmode_enter() on the same thread.
+ *
+ * @param[in] mode State filled by spark_fpmode_enter().
+ */
+void spark_fpmode_leave(const spark_fpmode_t *mode)
+{
+  if (mode->changed)
+    fpmode_write(mode->saved);
+}
+
+/**
+ * @brief Number of filter calls that found and flushed near-subnormal states.
+ *
+ * Counted by filters running with @ref SPARK_SOSFILT_FLUSH_DENORMALS, once per
+ * call in which at least one nonzero state was below the threshold
+ * (::SPARK_DENORMAL_THRESHOLD_F32 or ::SPARK_DENORMAL_THRESHOLD_F64). A
+ * count that grows during silence is expected; one that grows on a busy
+ * signal points at a section whose state underflows while in use. The
+ * counter is process-wide, relaxed and always enabled.
+ *
+ * @return Calls with flushed states since start-up or the last reset.
+ */
+uint64_t spark_denormal_count(void)
+{
+  return atomic_load_explicit(&denormal_count, memory_order_relaxed);
+}
+
+/**
+ * @brief Reset the counter read by spark_denormal_count().
+ */
+void spark_denormal_reset(void)
+{
+  atomic_store_explicit(&denormal_count, 0, memory_order_relaxed);
+}
+
+void spark_denormal_record(void)
+{
+  atomic_fetch_add_explicit(&denormal_count, 1, memory_order_relaxed);
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * State flushing shared by the IIR entry points (see spark/denormal.h). Not
+ * installed.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_DENORMAL_INTERNAL_H_
+#define LIBSPARK_DENORMAL_INTERNAL_H_
+
+#include "spark/denormal.h"
+
+#include <math.h>
+#include <stddef.h>
+
+/** Count one block in which states were flushed (see spark_denormal_count()). */
+void spark_denormal_record(void);
+
+/**
+ * Zero every value of @p x whose magnitude is below
+ * ::SPARK_DENORMAL_THRESHOLD_F32 and return how many nonzero values were
+ * flushed. Branch-free, so it vectorizes.
+ */
+static inline size_t spark_flush_denormals_f32(float *x, size_t n)
+{
+  size_t hits = 0;
+
+  for (size_t i = 0; i < n; ++i) {
+    const float v = x[i];
+    const int tiny = (fabsf(v) < SPARK_DENORMAL_THRESHOLD_F32);
+    hits += (size_t)(tiny & (v != 0.0f));
+    x[i] = tiny ? 0.0f : v;
+  }
+
+  return hits;
+}
+
+/** Double counterpart of spark_flush_denormals_f32(). */
+static inline size_t spark_flush_denormals_f64(double *x, size_t n)
+{
+  size_t hits = 0;
+
+  for (size_t i = 0; i < n; ++i) {
+    const double v = x[i];
+    const int tiny = (fabs(v) < SPARK_DENORMAL_THRESHOLD_F64);
+    hits += (size_t)(tiny & (v != 0.0));
+    x[i] = tiny ? 0.0 : v;
+  }
+
+  return hits;
+}
+
+#endif /* LIBSPARK_DENORMAL_INTERNAL_H_ */
@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "spark/dispatch.h"
+#include "spark/block.h"
+#include "dispatch/kernels.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+# include <intrin.h>
+# define SPARK_CPU_X86 1
+#elif defined(__i386__) || defined(__x86_64__)
+# include <cpuid.h>
+# define SPARK_CPU_X86 1
+#endif
+
+/* Tables compiled in by the build; SPARK_HAVE_ISA_* come from meson.build. */
+extern const spark_kernels_t spark_kernels_scalar;
+#ifdef SPARK_HAVE_ISA_SSE2
+extern const spark_kernels_t spark_kernels_sse2;
+#endif
+#ifdef SPARK_HAVE_ISA_AVX2
+extern const spark_kernels_t spark_kernels_avx2;
+#endif
+#ifdef SPARK_HAVE_ISA_AVX512
+extern const spark_kernels_t spark_kernels_avx512;
+#endif
+#ifdef SPARK_HAVE_ISA_NEON
+extern const spark_kernels_t spark_kernels_neon;
+#endif
+
+static const spark_kernels_t *const isa_tables[SPARK_ISA_COUNT] = {
+    [SPARK_ISA_SCALAR] = &spark_kernels_scalar,
+#ifdef SPARK_HAVE_ISA_SSE2
+    [SPARK_ISA_SSE2] = &spark_kernels_sse2,
+#endif
+#ifdef SPARK_HAVE_ISA_AVX2
+    [SPARK_ISA_AVX2] = &spark_kernels_avx2,
+#endif
+#ifdef SPARK_HAVE_ISA_AVX512
+    [SPARK_ISA_AVX512] = &spark_kernels_avx512,
+#endif
+#ifdef SPARK_HAVE_ISA_NEON
+    [SPARK_ISA_NEON] = &spark_kernels_neon,
+#endif
+};
+
+static const char *const isa_names[SPARK_ISA_COUNT] = {
+    [SPARK_ISA_SCALAR] = "scalar", [SPARK_ISA_SSE2] = "sse2",
+    [SPARK_ISA_AVX2] = "avx2",     [SPARK_ISA_AVX512] = "avx512",
+    [SPARK_ISA_NEON] = "neon",
+};
+
+/** Automatic selection order, best first. */
+static const int isa_preference[SPARK_ISA_COUNT] = {
+    SPARK_ISA_AVX512, SPARK_ISA_AVX2, SPARK_ISA_SSE2, SPARK_ISA_NEON, SPARK_ISA_SCALAR,
+};
+
+/** Bound level, or SPARK_ISA_AUTO until the first kernel call. */
+static atomic_int bound_isa = SPARK_ISA_AUTO;
+
+/** Cached result of cpu_detect(); 0 until computed. */
+static atomic_uint supported_mask = 0;
+
+#if defined(SPARK_CPU_X86)
+static void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4])
+{
+# if defined(_MSC_VER)
+  int r[4];
+  __cpuidex(r, (int)leaf, (int)subleaf);
+  for (int i = 0; i < 4; ++i)
+    regs[i] = (uint32_t)r[i];
+# else
+  __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+# endif
+}
+
+/** Read XCR0: which register states the OS saves on context switch. */
+static uint64_t xgetbv0(void)
+{
+# if defined(_MSC_VER)
+  return _xgetbv(0);
+# else
+  uint32_t eax, edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return ((uint64_t)edx << 32) | eax;
+# endif
+}
+#endif /* SPARK_CPU_X86 */
+
+/**
+ * @brief Probe the running CPU for the levels this code knows about.
+ *
+ * @return Bitmask of `(1u << SPARK_ISA_*)`, regardless of what was compiled in.
+ */
+static uint32_t cpu_detect(void)
+{
+  uint32_t mask = 1u << SPARK_ISA_SCALAR;
+
+#if defined(SPARK_CPU_X86)
+  uint32_t r[4];
+
+  cpuid(0, 0, r);
+  const uint32_t max_leaf = r[0];
+  if (max_leaf < 1)
+    return mask;
+
+  cpuid(1, 0, r);
+  const bool sse2 = (r[3] >> 26) & 1u;
+  const bool fma = (r[2] >> 12) & 1u;
+  const bool osxsave = (r[2] >> 27) & 1u;
+  const bool avx = (r[2] >> 28) & 1u;
+
+  if (sse2)
+    mask |= 1u << SPARK_ISA_SSE2;
+
+  if (!osxsave || !avx || max_leaf < 7)
+    return mask;
+
+  const uint64_t xcr0 = xgetbv0();
+  cpuid(7, 0, r);
+
+  /* XMM|YMM state, then opmask|ZMM_Hi256|Hi16_ZMM on top. */
+  if ((xcr0 & 0x06u) == 0x06u && fma && ((r[1] >> 5) & 1u))
+    mask |= 1u << SPARK_ISA_AVX2;
+
+  const uint32_t avx512 = (1u << 16) | (1u << 17) | (1u << 30) | (1u << 31);
+  if ((xcr0 & 0xE6u) == 0xE6u && (r[1] & avx512) == avx512 &&
+      (mask & (1u << SPARK_ISA_AVX2)))
+    mask |= 1u << SPARK_ISA_AVX512;
+
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+  /* Advanced SIMD is mandatory on AArch64 and assumed when targeted on Arm. */
+  mask |= 1u << SPARK_ISA_NEON;
+#endif
+
+  return mask;
+}
+
+/**
+ * @brief Return the levels usable in this process as a bitmask.
+ *
+ * Bit `(1u << isa)` is set when the level was compiled into the library
+ * **and** the running CPU supports it. @ref SPARK_ISA_SCALAR is always set.
+ *
+ * @return Bitmask of `spark_isa` values.
+ */
+uint32_t spark_dispatch_supported(void)
+{
+  uint32_t mask = atomic_load_explicit(&supported_mask, memory_order_relaxed);
+  if (mask)
+    return mask;
+
+  mask = cpu_detect();
+  for (int isa = 0; isa < SPARK_ISA_COUNT; ++isa) {
+    if (!isa_tables[isa])
+      mask &= ~(1u << isa);
+  }
+
+  atomic_store_explicit(&supported_mask, mask, memory_order_relaxed);
+  return mask;
+}
+
+/**
+ * @brief Pick the level used when nothing was forced.
+ *
+ * Honors `SPARK_ISA=<name>` from the environment when it names a supported
+ * level, otherwise takes the best supported one.
+ */
+static int dispatch_default_isa(void)
+{
+  const uint32_t mask = spark_dispatch_supported();
+  const char *env = getenv("SPARK_ISA");
+
+  if (env) {
+    for (int isa = 0; isa < SPARK_ISA_COUNT; ++isa) {
+      if (strcmp(env, isa_names[isa]) == 0 && (mask & (1u << isa)))
+        return isa;
+    }
+  }
+
+  for (int i = 0; i < SPARK_ISA_COUNT; ++i) {
+    if (mask & (1u << isa_preference[i]))
+      return isa_preference[i];
+  }
+
+  return SPARK_ISA_SCALAR;
+}
+
+/**
+ * @brief Return the table bound to the current level, binding it on first use.
+ */
+const spark_kernels_t *spark_kernels(void)
+{
+  int isa = atomic_load_explicit(&bound_isa, memory_order_acquire);
+
+  if (isa < 0) {
+    int expected = SPARK_ISA_AUTO;
+    isa = dispatch_default_isa();
+
+    /* Lose gracefully to a concurrent first call or spark_dispatch_set_isa(). */
+    if (!atomic_compare_exchange_strong(&bound_isa, &expected, isa))
+      isa = expected;
+  }
+
+  return isa_tables[isa];
+}
+
+/**
+ * @brief Return the level the kernels are bound to.
+ *
+ * Binds the default level first if no kernel has run yet.
+ *
+ * @return A `spark_isa` value (never @ref SPARK_ISA_AUTO).
+ */
+int spark_dispatch_get_isa(void)
+{
+  int isa = atomic_load_explicit(&bound_isa, memory_order_acquire);
+  if (isa < 0) {
+    (void)spark_kernels();
+    isa = atomic_load_explicit(&bound_isa, memory_order_acquire);
+  }
+  return isa;
+}
+
+/**
+ * @brief Force the kernels onto a given level.
+ *
+ * Pass @ref SPARK_ISA_AUTO to return to the best supported level. The switch
+ * is atomic: a kernel call in flight on another thread completes on the level
+ * it started with.
+ *
+ * @param[in] isa A `spark_isa` value.
+ * @retval SPARK_NOERROR            on success
+ * @retval SPARK_ERR_INVALID_PARAM  if @p isa is unknown or not supported here
+ */
+int spark_dispatch_set_isa(int isa)
+{
+  if (isa == SPARK_ISA_AUTO) {
+    /* Re-run the default policy without the environment override. */
+    const uint32_t mask = spark_dispatch_supported();
+    for (int i = 0; i < SPARK_ISA_COUNT; ++i) {
+      if (mask & (1u << isa_preference[i])) {
+        isa = isa_preference[i];
+        break;
+      }
+    }
+  }
+
+  if (isa < 0 || isa >= SPARK_ISA_COUNT || !(spark_dispatch_supported() & (1u << isa)))
+    return SPARK_ERR_INVALID_PARAM;
+
+  atomic_store_explicit(&bound_isa, isa, memory_order_release);
+  return SPARK_NOERROR;
+}
+
+/**
+ * @brief Return a short lowercase name for a level ("scalar", "avx2", ...).
+ *
+ * The same names are accepted by the `SPARK_ISA` environment variable, which
+ * is read once when the kernels are first bound.
+ *
+ * @param[in] isa A `spark_isa` value.
+ * @return A constant string, or "unknown" for values outside the enum.
+ */
+const char *spark_dispatch_isa_name(int isa)
+{
+  if (isa < 0 || isa >= SPARK_ISA_COUNT)
+    return "unknown";
+  return isa_names[isa];
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Per-level symbol naming. Each instruction-set level compiles the vector
+ * kernels once with `-DSPARK_ISA=<name>` and its target flags; SPARK_ISA_FN()
+ * gives every copy a distinct symbol. Not installed.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_DISPATCH_ISA_H_
+#define LIBSPARK_DISPATCH_ISA_H_
+
+#define SPARK_ISA_CAT_(name, isa) name##_##isa
+#define SPARK_ISA_CAT(name, isa) SPARK_ISA_CAT_(name, isa)
+
+/** Suffix @p name with the level this translation unit is compiled for. */
+#define SPARK_ISA_FN(name) SPARK_ISA_CAT(name, SPARK_ISA)
+
+#endif /* LIBSPARK_DISPATCH_ISA_H_ */
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Internal kernel table. kernels_isa.c is compiled once per instruction-set
+ * level alongside the vector kernels (see dispatch/isa.h). Not installed.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_DISPATCH_KERNELS_H_
+#define LIBSPARK_DISPATCH_KERNELS_H_
+
+#include "convert/convert_kernels.h"
+#include "dispatch/isa.h"
+#include "fft/fft_kernels.h"
+#include "fir-filter/fir_kernels.h"
+#include "gain/gain_kernels.h"
+#include "iir-filter/sosfilt_kernels.h"
+#include "meter/meter_kernels.h"
+#include "resample/resample_kernels.h"
+
+#include <stdint.h>
+
+/**
+ * @brief Function-pointer table for one instruction-set level.
+ *
+ * New kernels add a member here and an initializer in kernels_isa.c.
+ */
+typedef struct spark_kernels {
+  uint32_t f32_lanes; /**< f32 lanes per vector (1 for scalar). */
+  uint32_t f64_lanes; /**< f64 lanes per vector (1 for scalar). */
+
+  /** Cross-channel SOS cascade, one channel per lane. */
+  void (*sosfilt_f32_lanes)(const sosfilt_f32_args_t *args);
+
+  /**
+   * Fixed-shape SOS cascades, indexed by sosfilt_f32_fixed_stages() and
+   * sosfilt_f32_fixed_channels(); same arguments as @ref sosfilt_f32_lanes.
+   */
+  void (*sosfilt_f32_fixed[SOSFILT_F32_FIXED_N][SOSFILT_F32_FIXED_N])(
+      const sosfilt_f32_args_t *args);
+
+  /** Double-precision (or f32 I/O, f64 state) SOS cascade, one channel per lane. */
+  void (*sosfilt_f64_lanes)(const sosfilt_f64_args_t *args);
+
+  /** Adds a section's zero-input response to lanes (time-split fix-up). */
+  void (*sosfilt_f32_fixup_lanes)(const sosfilt_f32_fixup_args_t *args);
+
+  /** SOS cascades of unrelated filters, one channel per lane. */
+  void (*sosfilt_f32_batch)(const sosfilt_f32_batch_args_t *args);
+
+  /** Trapezoidal SVF cascade ({g, k, m0, m1, m2} stages), one channel per lane. */
+  void (*svf_f32_lanes)(const sosfilt_f32_args_t *args);
+
+  /** Normalized-lattice cascade (7 floats per stage), one channel per lane. */
+  void (*lattice_f32_lanes)(const sosfilt_f32_args_t *args);
+
+  /** One Stockham pass of a complex FFT. */
+  void (*fft_f32_pass)(const fft_f32_pass_t *pass, const float *x_re, const float *x_im,
+                       float *y_re, float *y_im);
+
+  /** Direct-form FIR over a history-prefixed window. */
+  void (*fir_f32_direct)(float *y, const float *x, const float *h_rev, size_t n_taps,
+                         size_t n_out);
+
+  /** Planar complex multiply-accumulate (partitioned convolution). */
+  void (*fir_f32_cmac)(float *acc_re, float *acc_im, const float *x_re, const float *x_im,
+                       const float *h_re, const float *h_im, size_t n);
+
+  /** Polyphase resampler run, exact ratio. */
+  void (*resample_f32_rational)(const resample_f32_args_t *args);
+
+  /** Polyphase resampler run, interpolated phases. */
+  void (*resample_f32_interpolated)(const resample_f32_args_t *args);
+
+  /** I16/I32/F32 → float, contiguous. */
+  void (*convert_decode_f32)(float *dst, const void *src, uint32_t fmt, size_t n);
+
+  /** float → I16/I32/F32 with optional dither, contiguous. */
+  void (*convert_encode_f32)(void *dst, uint32_t fmt, const float *src, const float *noise,
+                             size_t n);
+
+  /** Gain, gain ramp or mix-add over contiguous frames. */
+  void (*gain_f32)(float *dst, const float *src, size_t n_frames, uint32_t n_chan,
+                   float g0, float dg, bool mix);
+
+  /** Peak, energy and K-weighted loudness energy, one channel per lane. */
+  void (*meter_f32_lanes)(const meter_f32_args_t *args);
+} spark_kernels_t;
+
+/**
+ * @brief Return the table bound to the current level.
+ *
+ * Detects CPU features and binds the table on first call; afterwards this is
+ * a single atomic load. Never returns NULL.
+ */
+const spark_kernels_t *spark_kernels(void);
+
+#endif /* LIBSPARK_DISPATCH_KERNELS_H_ */
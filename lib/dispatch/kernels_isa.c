@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Kernel table for one instruction-set level; compiled once per level.
+ */
+
+#include "dispatch/kernels.h"
+#include "simd/simd_f32.h"
+#include "simd/simd_f64.h"
+
+#ifndef SPARK_ISA
+# error "kernels_isa.c must be compiled with -DSPARK_ISA=<level>"
+#endif
+
+/* One row of fixed-shape SOS kernels: 1, 2 and 8 channels of @p s stages. */
+#define SOSFILT_F32_FIXED_ROW(s)                                                         \
+  {SPARK_ISA_FN(sosfilt_f32_fixed_##s##x1), SPARK_ISA_FN(sosfilt_f32_fixed_##s##x2),     \
+   SPARK_ISA_FN(sosfilt_f32_fixed_##s##x8)}
+
+const spark_kernels_t SPARK_ISA_FN(spark_kernels) = {
+    .f32_lanes = VF32_LANES,
+    .f64_lanes = VF64_LANES,
+    .sosfilt_f32_lanes = SPARK_ISA_FN(sosfilt_f32_lanes),
+    .sosfilt_f32_fixed = {SOSFILT_F32_FIXED_ROW(1), SOSFILT_F32_FIXED_ROW(2),
+                          SOSFILT_F32_FIXED_ROW(4)},
+    .sosfilt_f64_lanes = SPARK_ISA_FN(sosfilt_f64_lanes),
+    .sosfilt_f32_fixup_lanes = SPARK_ISA_FN(sosfilt_f32_fixup_lanes),
+    .sosfilt_f32_batch = SPARK_ISA_FN(sosfilt_f32_batch),
+    .svf_f32_lanes = SPARK_ISA_FN(svf_f32_lanes),
+    .lattice_f32_lanes = SPARK_ISA_FN(lattice_f32_lanes),
+    .fft_f32_pass = SPARK_ISA_FN(fft_f32_pass),
+    .fir_f32_direct = SPARK_ISA_FN(fir_f32_direct),
+    .fir_f32_cmac = SPARK_ISA_FN(fir_f32_cmac),
+    .resample_f32_rational = SPARK_ISA_FN(resample_f32_rational),
+    .resample_f32_interpolated = SPARK_ISA_FN(resample_f32_interpolated),
+    .convert_decode_f32 = SPARK_ISA_FN(convert_decode_f32),
+    .convert_encode_f32 = SPARK_ISA_FN(convert_encode_f32),
+    .gain_f32 = SPARK_ISA_FN(gain_f32),
+    .meter_f32_lanes = SPARK_ISA_FN(meter_f32_lanes),
+};
@@ -0,0 +1,421 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "spark/fft.h"
+#include "spark/block.h"
+#include "dispatch/kernels.h"
+#include "fft/fft_kernels.h"
+#include "memory/memory_internal.h"
+#include "stats/stats_internal.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/** Passes of the largest plan: 2^32 in radix-4 passes, with room to spare. */
+#define FFT_MAX_PASSES 32
+
+/** Twiddle rows are sized for the expanded layout below this stride (the widest vector). */
+#define FFT_EXPAND_STRIDE 16
+
+static const double fft_pi = 3.14159265358979323846;
+
+struct spark_fft_f32_state {
+  const spark_kernels_t *kernels;
+  uint32_t n_complex; /**< Complex transform size: n, or n / 2 for real plans. */
+  uint32_t n_passes;
+  fft_f32_pass_t passes[FFT_MAX_PASSES];
+  float *rt_re; /**< Real plans: cos(2 pi k / n), k <= n / 4. */
+  float *rt_im; /**< Real plans: -sin(2 pi k / n), k <= n / 4. */
+  float *work;  /**< 2 n floats of scratch. */
+};
+
+/**
+ * @brief Split @p n into radices; returns the pass count, or 0 if @p n has
+ * a prime factor above 5 (or is 0).
+ *
+ * Larger radices go first so the stride outgrows a vector within a pass or
+ * two; a lone factor of 2 is left for last.
+ */
+static uint32_t fft_factor(uint32_t n, uint32_t radices[FFT_MAX_PASSES])
+{
+  static const uint32_t order[] = {5, 4, 3, 2};
+  uint32_t count = 0;
+
+  if (n == 0)
+    return 0;
+
+  for (size_t r = 0; r < sizeof(order) / sizeof(order[0]); ++r)
+    while (n % order[r] == 0) {
+      radices[count++] = order[r];
+      n /= order[r];
+    }
+
+  return n == 1 ? count : 0;
+}
+
+/** Complex size of a plan, or 0 if @p type / @p n are unsupported. */
+static uint32_t fft_complex_size(uint32_t type, uint32_t n)
+{
+  if (type == SPARK_FFT_COMPLEX)
+    return n;
+  if (type == SPARK_FFT_REAL && n >= 2 && n % 2 == 0)
+    return n / 2;
+  return 0;
+}
+
+/**
+ * @brief Lay out a plan; returns its size. With @p base NULL only the size
+ * is computed.
+ *
+ * Fills the twiddle tables when @p base is set; @p lanes picks which
+ * passes use the expanded twiddle layout.
+ */
+static size_t fft_layout(uint32_t type, uint32_t n, uint32_t lanes,
+                         struct spark_fft_f32_state *state, unsigned char *base)
+{
+  const uint32_t size = fft_complex_size(type, n);
+  uint32_t radices[FFT_MAX_PASSES];
+  const uint32_t n_passes = fft_factor(size, radices);
+
+  memset(state, 0, sizeof(*state));
+  state->n_complex = size;
+  state->n_passes = n_passes;
+
+  spark_carve_t carve = {.base = base, .align = SPARK_FFT_ALIGN};
+  (void)spark_carve_offset(&carve, sizeof(struct spark_fft_f32_state));
+
+  size_t s = 1;
+  for (uint32_t i = 0; i < n_passes; ++i) {
+    fft_f32_pass_t *pass = &state->passes[i];
+    const uint32_t radix = radices[i];
+    const size_t m = size / (s * radix);
+    const size_t row = (s < FFT_EXPAND_STRIDE) ? m * s : m;
+
+    pass->radix = radix;
+    pass->m = (uint32_t)m;
+    pass->s = (uint32_t)s;
+    pass->expanded = (s < lanes);
+
+    /* Rows are sized for the expanded layout but packed at the width in use. */
+    const size_t width = pass->expanded ? m * s : m;
+    float *tw = spark_carve_floats(&carve, 2 * (radix - 1) * row);
+    pass->tw_re = tw;
+    pass->tw_im = tw ? tw + (radix - 1) * width : NULL;
+
+    if (tw) {
+      /* w^(p k) with w = e^(-2 pi i / (R m)), in double for large sizes. */
+      float *re = tw, *im = tw + (radix - 1) * width;
+
+      for (uint32_t k = 1; k < radix; ++k)
+        for (size_t j = 0; j < width; ++j) {
+          const size_t p = pass->expanded ? j / s : j;
+          const double angle = -2.0 * fft_pi * (double)(p * k) / (double)(radix * m);
+          re[(k - 1) * width + j] = (float)cos(angle);
+          im[(k - 1) * width + j] = (float)sin(angle);
+        }
+    }
+
+    s *= radix;
+  }
+
+  if (type == SPARK_FFT_REAL) {
+    const size_t rows = size / 2 + 1;
+    state->rt_re = spark_carve_floats(&carve, rows);
+    state->rt_im = spark_carve_floats(&carve, rows);
+
+    if (base)
+      for (size_t k = 0; k < rows; ++k) {
+        state->rt_re[k] = (float)cos(2.0 * fft_pi * (double)k / n);
+        state->rt_im[k] = (float)-sin(2.0 * fft_pi * (double)k / n);
+      }
+  }
+
+  state->work = spark_carve_floats(&carve, 2 * (size_t)n);
+  return carve.used;
+}
+
+/**
+ * @brief Arena bytes needed by spark_fft_f32_init().
+ *
+ * Includes slack to align an arbitrary arena pointer; independent of the
+ * dispatch level.
+ *
+ * @param[in] type A value from ::spark_fft_type.
+ * @param[in] n Transform size.
+ * @return Arena size in bytes, or 0 if @p type or @p n is unsupported.
+ */
+size_t spark_fft_f32_size(uint32_t type, uint32_t n)
+{
+  const uint32_t size = fft_complex_size(type, n);
+  uint32_t radices[FFT_MAX_PASSES];
+
+  if (size == 0 || (size > 1 && fft_factor(size, radices) == 0))
+    return 0;
+
+  struct spark_fft_f32_state state;
+  return (SPARK_FFT_ALIGN - 1) + fft_layout(type, n, 1, &state, NULL);
+}
+
+/**
+ * @brief Plan a transform: factor @p n and precompute its twiddles.
+ *
+ * The transform runs as Stockham autosort passes of radix 5, 4, 3 and 2, so
+ * results come out in natural order with no bit-reversal. Each pass is one
+ * vectorized sweep reading its inputs and twiddles contiguously; the
+ * twiddles, scratch and (for real plans) the split factors are carved,
+ * 64-byte aligned, from @p arena. Real transforms of size n run as a
+ * complex transform of n / 2 plus an O(n) split.
+ *
+ * @param[out] self Plan to initialize.
+ * @param[in] type A value from ::spark_fft_type.
+ * @param[in] n Transform size: a product of 2, 3 and 5; even for
+ *              ::SPARK_FFT_REAL.
+ * @param[in] arena Caller-owned memory of at least spark_fft_f32_size()
+ *                  bytes. Must outlive @p self.
+ * @param[in] arena_size Size of @p arena in bytes.
+ *
+ * @retval SPARK_NOERROR on success
+ * @retval SPARK_ERR_INVALID_PARAM for NULL arguments, an unknown type or an
+ *         unsupported size
+ * @retval SPARK_ERR_INVALID_SIZE if @p arena is too small
+ */
+int spark_fft_f32_init(spark_fft_f32_t *self, uint32_t type, uint32_t n, void *arena,
+                       size_t arena_size)
+{
+  if (!self || !arena)
+    return SPARK_ERR_INVALID_PARAM;
+
+  const size_t bytes = spark_fft_f32_size(type, n);
+  if (bytes == 0)
+    return SPARK_ERR_INVALID_PARAM;
+  if (arena_size < bytes)
+    return SPARK_ERR_INVALID_SIZE;
+
+  const spark_kernels_t *kernels = spark_kernels();
+  unsigned char *base = spark_align_ptr(arena, SPARK_FFT_ALIGN);
+  struct spark_fft_f32_state *state = (struct spark_fft_f32_state *)base;
+
+  fft_layout(type, n, kernels->f32_lanes, state, base);
+  state->kernels = kernels;
+
+  self->type = type;
+  self->n = n;
+  self->state = state;
+
+  return SPARK_NOERROR;
+}
+
+/**
+ * @brief Run every pass from @p src to @p dst, ping-ponging with @p work.
+ *
+ * Out of place, the buffers alternate so the last pass lands in @p dst and
+ * @p src is only read. In place (@p src == @p dst) the first pass has to
+ * leave @p src, so an odd pass count ends with a copy.
+ */
+static void fft_run(const struct spark_fft_f32_state *state, const float *src_re,
+                    const float *src_im, float *dst_re, float *dst_im, float *work_re,
+                    float *work_im)
+{
+  const uint32_t n_passes = state->n_passes;
+  const bool in_place = (src_re == dst_re);
+  const float *x_re = src_re, *x_im = src_im;
+
+  for (uint32_t i = 1; i <= n_passes; ++i) {
+    const bool to_dst = in_place ? (i % 2 == 0) : ((n_passes - i) % 2 == 0);
+    float *y_re = to_dst ? dst_re : work_re;
+    float *y_im = to_dst ? dst_im : work_im;
+
+    state->kernels->fft_f32_pass(&state->passes[i - 1], x_re, x_im, y_re, y_im);
+    x_re = y_re, x_im = y_im;
+  }
+
+  if (x_re != dst_re) {
+    memcpy(dst_re, x_re, sizeof(float) * state->n_complex);
+    memcpy(dst_im, x_im, sizeof(float) * state->n_complex);
+  }
+}
+
+/** Real forward transform of spark_fft_f32_forward(). */
+static void fft_forward_real(struct spark_fft_f32_state *state, const float *in_re,
+                             float *out_re, float *out_im)
+{
+  const size_t size = state->n_complex;
+
+  /* Pack x[2k] + i x[2k+1] into Z and transform it into the output. */
+  float *z_re = state->work, *z_im = z_re + size;
+  float *t_re = z_im + size, *t_im = t_re + size;
+
+  for (size_t k = 0; k < size; ++k) {
+    z_re[k] = in_re[2 * k];
+    z_im[k] = in_re[2 * k + 1];
+  }
+
+  fft_run(state, z_re, z_im, out_re, out_im, t_re, t_im);
+
+  out_re[size] = out_re[0];
+  out_im[size] = out_im[0];
+
+  /*
+   * X[k] = E[k] + W^k O[k] with E = (Z[k] + conj Z[h-k]) / 2 and
+   * O = (Z[k] - conj Z[h-k]) / 2i, W = e^(-2 pi i / n); the mirror bin
+   * h - k is conj(E - W^k O).
+   */
+  for (size_t k = 0; k <= size / 2; ++k) {
+    const size_t j = size - k;
+    const float zr = out_re[k], zi = out_im[k];
+    const float cr = out_re[j], ci = -out_im[j];
+
+    const float er = 0.5f * (zr + cr), ei = 0.5f * (zi + ci);
+    const float or = 0.5f * (zi - ci), oi = -0.5f * (zr - cr);
+
+    const float pr = state->rt_re[k] * or - state->rt_im[k] * oi;
+    const float pi = state->rt_re[k] * oi + state->rt_im[k] * or;
+
+    out_re[k] = er + pr, out_im[k] = ei + pi;
+    out_re[j] = er - pr, out_im[j] = pi - ei;
+  }
+}
+
+/** Real inverse transform of spark_fft_f32_inverse(). */
+static void fft_inverse_real(struct spark_fft_f32_state *state, const float *in_re,
+                             const float *in_im, float *out_re)
+{
+  const size_t size = state->n_complex;
+
+  float *z_re = state->work, *z_im = z_re + size;
+  float *t_re = z_im + size, *t_im = t_re + size;
+
+  /*
+   * Z = E + i O with E = X[k] + conj X[h-k] and O = (X[k] - conj X[h-k])
+   * W^-k (twice the forward split, so the result is n x); as E and O are
+   * spectra of real sequences, Z[h-k] = conj E + i conj O.
+   */
+  {
+    const float er = in_re[0] + in_re[size], or = in_re[0] - in_re[size];
+    z_re[0] = er;
+    z_im[0] = or;
+  }
+
+  for (size_t k = 1; k <= size / 2; ++k) {
+    const size_t j = size - k;
+    const float xr = in_re[k], xi = in_im[k];
+    const float cr = in_re[j], ci = -in_im[j];
+
+    const float er = xr + cr, ei = xi + ci;
+    const float dr = xr - cr, di = xi - ci;
+    const float or = dr * state->rt_re[k] + di * state->rt_im[k];
+    const float oi = di * state->rt_re[k] - dr * state->rt_im[k];
+
+    z_re[k] = er - oi, z_im[k] = ei + or;
+    z_re[j] = er + oi, z_im[j] = or - ei;
+  }
+
+  /* The input is consumed: the output doubles as the pass scratch. */
+  fft_run(state, z_im, z_re, t_im, t_re, out_re + size, out_re);
+
+  for (size_t k = 0; k < size; ++k) {
+    out_re[2 * k] = t_re[k];
+    out_re[2 * k + 1] = t_im[k];
+  }
+}
+
+/**
+ * @brief Forward transform.
+ *
+ * - ::SPARK_FFT_COMPLEX: @p in_re / @p in_im (n each) to @p out_re /
+ *   @p out_im (n each).
+ * - ::SPARK_FFT_REAL: @p in_re (n reals; @p in_im unused, may be NULL) to
+ *   bins 0 … n/2 in @p out_re / @p out_im (n/2 + 1 each).
+ *
+ * Buffers are planar F32, as in one channel of a ::SPARK_LAYOUT_PLANAR
+ * block, and need no particular alignment. The transform may run in place
+ * (@p out_re == @p in_re and, for complex plans, @p out_im == @p in_im);
+ * otherwise the inputs are left untouched.
+ *
+ * @param[in,out] self Plan (its scratch is used).
+ * @param[in] in_re Real parts (or real samples).
+ * @param[in] in_im Imaginary parts; unused for real plans.
+ * @param[out] out_re Real parts of the bins.
+ * @param[out] out_im Imaginary parts of the bins.
+ */
+void spark_fft_f32_forward(spark_fft_f32_t *self, const float *in_re, const float *in_im,
+                           float *out_re, float *out_im)
+{
+  assert(self && self->state && in_re && out_re && out_im);
+  SPARK_STATS_BEGIN();
+
+  struct spark_fft_f32_state *state = self->state;
+
+  if (self->type == SPARK_FFT_COMPLEX) {
+    assert(in_im);
+    fft_run(state, in_re, in_im, out_re, out_im, state->work,
+            state->work + state->n_complex);
+  } else {
+    fft_forward_real(state, in_re, out_re, out_im);
+  }
+
+  SPARK_STATS_END(SPARK_STATS_FFT_F32, self->n);
+}
+
+/**
+ * @brief Inverse transform, unnormalized: forward then inverse scales by n.
+ *
+ * - ::SPARK_FFT_COMPLEX: n bins to n planar samples.
+ * - ::SPARK_FFT_REAL: bins 0 … n/2 in @p in_re / @p in_im to n reals in
+ *   @p out_re (@p out_im unused, may be NULL). In place, @p in_re must
+ *   then hold n floats.
+ *
+ * The imaginary parts of bins 0 and n/2 of a real plan are ignored, as a
+ * real signal has none. Inputs are left untouched unless in place.
+ *
+ * @param[in,out] self Plan (its scratch is used).
+ * @param[in] in_re Real parts of the bins.
+ * @param[in] in_im Imaginary parts of the bins.
+ * @param[out] out_re Real parts (or real samples).
+ * @param[out] out_im Imaginary parts; unused for real plans.
+ */
+void spark_fft_f32_inverse(spark_fft_f32_t *self, const float *in_re, const float *in_im,
+                           float *out_re, float *out_im)
+{
+  assert(self && self->state && in_re && in_im && out_re);
+  SPARK_STATS_BEGIN();
+
+  struct spark_fft_f32_state *state = self->state;
+
+  /* conj(DFT(conj x)): swap re and im on the way in and out. */
+  if (self->type == SPARK_FFT_COMPLEX) {
+    assert(out_im);
+    fft_run(state, in_im, in_re, out_im, out_re, state->work + state->n_complex,
+            state->work);
+  } else {
+    fft_inverse_real(state, in_re, in_im, out_re);
+  }
+
+  SPARK_STATS_END(SPARK_STATS_FFT_F32, self->n);
+}
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "fft/fft_kernels.h"
+#include "simd/simd_f32.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* cos and sin of 2 pi / 3, 2 pi / 5 and 4 pi / 5. */
+#define FFT_SIN_3 0.866025403784438647f
+#define FFT_COS1_5 0.309016994374947424f
+#define FFT_COS2_5 -0.809016994374947424f
+#define FFT_SIN1_5 0.951056516295153572f
+#define FFT_SIN2_5 0.587785252292473129f
+
+/** `(re, im) *= (wr, wi)`. */
+static inline void cmul(vf32_t *re, vf32_t *im, vf32_t wr, vf32_t wi)
+{
+  const vf32_t r = vf32_sub(vf32_mul(*re, wr), vf32_mul(*im, wi));
+  *im = vf32_fmadd(*re, wi, vf32_mul(*im, wr));
+  *re = r;
+}
+
+/**
+ * @brief Forward DFT of size @p radix across the vectors, in place.
+ *
+ * `-i (a + ib) = b - ia` is folded into the adds, so radix 2 and 4 need
+ * no multiplies.
+ */
+static inline void butterfly(uint32_t radix, vf32_t *re, vf32_t *im)
+{
+  switch (radix) {
+  case 2: {
+    const vf32_t r = vf32_sub(re[0], re[1]), i = vf32_sub(im[0], im[1]);
+    re[0] = vf32_add(re[0], re[1]), im[0] = vf32_add(im[0], im[1]);
+    re[1] = r, im[1] = i;
+    break;
+  }
+  case 3: {
+    const vf32_t half = vf32_set1(-0.5f), sin3 = vf32_set1(FFT_SIN_3);
+    const vf32_t tr = vf32_add(re[1], re[2]), ti = vf32_add(im[1], im[2]);
+    const vf32_t mr = vf32_fmadd(tr, half, re[0]), mi = vf32_fmadd(ti, half, im[0]);
+    const vf32_t dr = vf32_mul(vf32_sub(im[1], im[2]), sin3);
+    const vf32_t di = vf32_mul(vf32_sub(re[2], re[1]), sin3);
+
+    re[0] = vf32_add(re[0], tr), im[0] = vf32_add(im[0], ti);
+    re[1] = vf32_add(mr, dr), im[1] = vf32_add(mi, di);
+    re[2] = vf32_sub(mr, dr), im[2] = vf32_sub(mi, di);
+    break;
+  }
+  case 4: {
+    const vf32_t t0r = vf32_add(re[0], re[2]), t0i = vf32_add(im[0], im[2]);
+    const vf32_t t1r = vf32_sub(re[0], re[2]), t1i = vf32_sub(im[0], im[2]);
+    const vf32_t t2r = vf32_add(re[1], re[3]), t2i = vf32_add(im[1], im[3]);
+    const vf32_t t3r = vf32_sub(re[1], re[3]), t3i = vf32_sub(im[1], im[3]);
+
+    re[0] = vf32_add(t0r, t2r), im[0] = vf32_add(t0i, t2i);
+    re[2] = vf32_sub(t0r, t2r), im[2] = vf32_sub(t0i, t2i);
+    re[1] = vf32_add(t1r, t3i), im[1] = vf32_sub(t1i, t3r);
+    re[3] = vf32_sub(t1r, t3i), im[3] = vf32_add(t1i, t3r);
+    break;
+  }
+  case 5: {
+    const vf32_t c1 = vf32_set1(FFT_COS1_5), c2 = vf32_set1(FFT_COS2_5);
+    const vf32_t s1 = vf32_set1(FFT_SIN1_5), s2 = vf32_set1(FFT_SIN2_5);
+    const vf32_t t1r = vf32_add(re[1], re[4]), t1i = vf32_add(im[1], im[4]);
+    const vf32_t t2r = vf32_add(re[2], re[3]), t2i = vf32_add(im[2], im[3]);
+    const vf32_t t3r = vf32_sub(re[1], re[4]), t3i = vf32_sub(im[1], im[4]);
+    const vf32_t t4r = vf32_sub(re[2], re[3]), t4i = vf32_sub(im[2], im[3]);
+
+    const vf32_t m1r = vf32_fmadd(c2, t2r, vf32_fmadd(c1, t1r, re[0]));
+    const vf32_t m1i = vf32_fmadd(c2, t2i, vf32_fmadd(c1, t1i, im[0]));
+    const vf32_t m2r = vf32_fmadd(c1, t2r, vf32_fmadd(c2, t1r, re[0]));
+    const vf32_t m2i = vf32_fmadd(c1, t2i, vf32_fmadd(c2, t1i, im[0]));
+    const vf32_t u1r = vf32_fmadd(s2, t4r, vf32_mul(s1, t3r));
+    const vf32_t u1i = vf32_fmadd(s2, t4i, vf32_mul(s1, t3i));
+    const vf32_t u2r = vf32_sub(vf32_mul(s2, t3r), vf32_mul(s1, t4r));
+    const vf32_t u2i = vf32_sub(vf32_mul(s2, t3i), vf32_mul(s1, t4i));
+
+    re[0] = vf32_add(re[0], vf32_add(t1r, t2r));
+    im[0] = vf32_add(im[0], vf32_add(t1i, t2i));
+    re[1] = vf32_add(m1r, u1i), im[1] = vf32_sub(m1i, u1r);
+    re[4] = vf32_sub(m1r, u1i), im[4] = vf32_add(m1i, u1r);
+    re[2] = vf32_add(m2r, u2i), im[2] = vf32_sub(m2i, u2r);
+    re[3] = vf32_sub(m2r, u2i), im[3] = vf32_add(m2i, u2r);
+    break;
+  }
+  }
+}
+
+/**
+ * @brief One vector column: R loads @p in_step apart, butterfly, twiddle, R
+ * stores @p out_step apart. @p wr / @p wi hold twiddles 1..R-1, or are NULL
+ * for a column whose twiddles are all 1.
+ */
+static inline void column(uint32_t radix, const float *x_re, const float *x_im,
+                          size_t in_step, float *y_re, float *y_im, size_t out_step,
+                          const vf32_t *wr, const vf32_t *wi)
+{
+  vf32_t re[5], im[5];
+
+  for (uint32_t j = 0; j < radix; ++j) {
+    re[j] = vf32_load(x_re + j * in_step);
+    im[j] = vf32_load(x_im + j * in_step);
+  }
+
+  butterfly(radix, re, im);
+
+  if (wr)
+    for (uint32_t k = 1; k < radix; ++k)
+      cmul(&re[k], &im[k], wr[k - 1], wi[k - 1]);
+
+  for (uint32_t k = 0; k < radix; ++k) {
+    vf32_store(y_re + k * out_step, re[k]);
+    vf32_store(y_im + k * out_step, im[k]);
+  }
+}
+
+/**
+ * @brief column() over the last @p count (< lanes) values of a run, through
+ * zero-padded stack buffers.
+ */
+static void column_tail(uint32_t radix, const float *x_re, const float *x_im,
+                        size_t in_step, float *y_re, float *y_im, size_t out_step,
+                        const vf32_t *wr, const vf32_t *wi, size_t count)
+{
+  float br[5][VF32_LANES] = {{0}}, bi[5][VF32_LANES] = {{0}};
+
+  for (uint32_t j = 0; j < radix; ++j)
+    for (size_t l = 0; l < count; ++l) {
+      br[j][l] = x_re[j * in_step + l];
+      bi[j][l] = x_im[j * in_step + l];
+    }
+
+  column(radix, br[0], bi[0], VF32_LANES, br[0], bi[0], VF32_LANES, wr, wi);
+
+  for (uint32_t k = 0; k < radix; ++k)
+    for (size_t l = 0; l < count; ++l) {
+      y_re[k * out_step + l] = br[k][l];
+      y_im[k * out_step + l] = bi[k][l];
+    }
+}
+
+/**
+ * Stride at least one vector: vectors run along q, with one broadcast
+ * twiddle set per p.
+ */
+static inline void pass_strided(const fft_f32_pass_t *pass, uint32_t radix,
+                                const float *x_re, const float *x_im, float *y_re,
+                                float *y_im)
+{
+  const size_t m = pass->m, s = pass->s;
+  const size_t in_step = m * s;
+
+  for (size_t p = 0; p < m; ++p) {
+    vf32_t wr[4], wi[4];
+    const vf32_t *twr = NULL, *twi = NULL;
+
+    if (p != 0) {
+      for (uint32_t k = 1; k < radix; ++k) {
+        wr[k - 1] = vf32_set1(pass->tw_re[(k - 1) * m + p]);
+        wi[k - 1] = vf32_set1(pass->tw_im[(k - 1) * m + p]);
+      }
+      twr = wr, twi = wi;
+    }
+
+    const float *xr = x_re + s * p, *xi = x_im + s * p;
+    float *yr = y_re + s * radix * p, *yi = y_im + s * radix * p;
+    size_t q = 0;
+
+    for (; q + VF32_LANES <= s; q += VF32_LANES)
+      column(radix, xr + q, xi + q, in_step, yr + q, yi + q, s, twr, twi);
+
+    if (q < s)
+      column_tail(radix, xr + q, xi + q, in_step, yr + q, yi + q, s, twr, twi, s - q);
+  }
+}
+
+/**
+ * Stride narrower than a vector: vectors run along the flattened index
+ * `j = q + s p`, which is contiguous on input, with per-j twiddles; the
+ * outputs (runs of s, R s apart) are scattered from a stack buffer.
+ */
+static inline void pass_expanded(const fft_f32_pass_t *pass, uint32_t radix,
+                                 const float *x_re, const float *x_im, float *y_re,
+                                 float *y_im)
+{
+  const size_t s = pass->s;
+  const size_t in_step = pass->m * s;
+  float br[5][VF32_LANES], bi[5][VF32_LANES];
+  size_t q = 0, base = 0;
+
+  for (size_t j = 0; j < in_step; j += VF32_LANES) {
+    const size_t count = in_step - j < VF32_LANES ? in_step - j : VF32_LANES;
+    vf32_t wr[4], wi[4];
+
+    if (count == VF32_LANES) {
+      for (uint32_t k = 1; k < radix; ++k) {
+        wr[k - 1] = vf32_load(pass->tw_re + (k - 1) * in_step + j);
+        wi[k - 1] = vf32_load(pass->tw_im + (k - 1) * in_step + j);
+      }
+      column(radix, x_re + j, x_im + j, in_step, br[0], bi[0], VF32_LANES, wr, wi);
+    } else {
+      float tr[4][VF32_LANES] = {{0}}, ti[4][VF32_LANES] = {{0}};
+
+      for (uint32_t k = 1; k < radix; ++k)
+        for (size_t l = 0; l < count; ++l) {
+          tr[k - 1][l] = pass->tw_re[(k - 1) * in_step + j + l];
+          ti[k - 1][l] = pass->tw_im[(k - 1) * in_step + j + l];
+        }
+      for (uint32_t k = 1; k < radix; ++k)
+        wr[k - 1] = vf32_load(tr[k - 1]), wi[k - 1] = vf32_load(ti[k - 1]);
+
+      column_tail(radix, x_re + j, x_im + j, in_step, br[0], bi[0], VF32_LANES, wr, wi,
+                  count);
+    }
+
+    for (size_t l = 0; l < count; ++l) {
+      for (uint32_t k = 0; k < radix; ++k) {
+        y_re[base + q + k * s] = br[k][l];
+        y_im[base + q + k * s] = bi[k][l];
+      }
+      if (++q == s)
+        q = 0, base += s * radix;
+    }
+  }
+}
+
+void SPARK_ISA_FN(fft_f32_pass)(const fft_f32_pass_t *pass, const float *x_re,
+                                const float *x_im, float *y_re, float *y_im)
+{
+  /* Constant radices so each case inlines its own butterfly. */
+  switch (pass->radix) {
+  case 2:
+    if (pass->expanded)
+      pass_expanded(pass, 2, x_re, x_im, y_re, y_im);
+    else
+      pass_strided(pass, 2, x_re, x_im, y_re, y_im);
+    break;
+  case 3:
+    if (pass->expanded)
+      pass_expanded(pass, 3, x_re, x_im, y_re, y_im);
+    else
+      pass_strided(pass, 3, x_re, x_im, y_re, y_im);
+    break;
+  case 4:
+    if (pass->expanded)
+      pass_expanded(pass, 4, x_re, x_im, y_re, y_im);
+    else
+      pass_strided(pass, 4, x_re, x_im, y_re, y_im);
+    break;
+  case 5:
+    if (pass->expanded)
+      pass_expanded(pass, 5, x_re, x_im, y_re, y_im);
+    else
+      pass_strided(pass, 5, x_re, x_im, y_re, y_im);
+    break;
+  }
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Internal kernel interface for the FFT plans. Not installed.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_FFT_KERNELS_H_
+#define LIBSPARK_FFT_KERNELS_H_
+
+#include "dispatch/isa.h"
+
+#include <stdint.h>
+
+/**
+ * @brief One Stockham pass of radix R over a complex planar sequence.
+ *
+ * With `m` the remaining sub-transform size over R and `s` the stride
+ * (the product of the radices before this pass), the pass computes, for
+ * p < m and q < s,
+ *
+ *   y[q + s (R p + k)] = w^(p k) sum_j x[q + s (p + j m)] e^(-2 pi i j k / R)
+ *
+ * with `w = e^(-2 pi i / (R m))`; the last pass leaves the transform in
+ * natural order. When `expanded` is set the twiddles are stored per
+ * flattened index `q + s p` instead of per `p`, so passes with a stride
+ * narrower than a vector can run across p as well.
+ */
+typedef struct fft_f32_pass {
+  uint32_t radix;  /**< 2, 3, 4 or 5. */
+  uint32_t m;      /**< Sub-transform size after this pass, over R. */
+  uint32_t s;      /**< Stride: product of the earlier radices. */
+  uint32_t expanded; /**< Twiddles indexed by `q + s p` rather than `p`. */
+  const float *tw_re; /**< radix - 1 rows of m (or m * s) twiddles, row k - 1 first. */
+  const float *tw_im; /**< Imaginary parts, same layout. */
+} fft_f32_pass_t;
+
+#ifdef SPARK_ISA
+/**
+ * @brief Run one pass from @p x to @p y (distinct buffers of `R m s` values).
+ */
+void SPARK_ISA_FN(fft_f32_pass)(const fft_f32_pass_t *pass, const float *x_re,
+                                const float *x_im, float *y_re, float *y_im);
+#endif
+
+#endif /* LIBSPARK_FFT_KERNELS_H_ */
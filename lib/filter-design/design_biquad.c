@@ -0,0 +1,360 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "spark/block.h"
+#include "spark/filter_design.h"
+
+#include "filter-design/design_math.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/** log2(10) / 40: `10^(gain_db / 40) = 2^(gain_db * DESIGN_DB_EXP2)`. */
+#define DESIGN_DB_EXP2 0.08304820237218405
+
+static bool biquad_band_is_valid(const spark_biquad_band_t *band)
+{
+  return band->type <= SPARK_BIQUAD_HIGHSHELF && band->freq > 0.0f &&
+         band->freq < 0.5f && band->q > 0.0f && isfinite(band->q) &&
+         isfinite(band->gain_db);
+}
+
+/**
+ * RBJ cookbook section from `t = tan(w0 / 2)` and the shelf/peak amplitude
+ * `A = 10^(gain_db / 40)`. The cookbook's sin and cos of w0 are rebuilt from
+ * t, and `1 - cos` / `1 + cos` are formed directly so low corners keep their
+ * precision.
+ */
+static void biquad_section(uint32_t type, double t, double A, double q, double c[5])
+{
+  const double d = 1.0 / (1.0 + t * t);
+  const double sn = 2.0 * t * d;
+  const double cs = (1.0 - t * t) * d;
+  const double omc = 2.0 * t * t * d; /* 1 - cos(w0) */
+  const double opc = 2.0 * d;         /* 1 + cos(w0) */
+  const double alpha = sn / (2.0 * q);
+
+  double b0, b1, b2, a0, a1, a2;
+  switch (type) {
+  case SPARK_BIQUAD_LOWPASS:
+    b0 = b2 = 0.5 * omc;
+    b1 = omc;
+    a0 = 1.0 + alpha, a1 = -2.0 * cs, a2 = 1.0 - alpha;
+    break;
+  case SPARK_BIQUAD_HIGHPASS:
+    b0 = b2 = 0.5 * opc;
+    b1 = -opc;
+    a0 = 1.0 + alpha, a1 = -2.0 * cs, a2 = 1.0 - alpha;
+    break;
+  case SPARK_BIQUAD_BANDPASS:
+    b0 = alpha, b1 = 0.0, b2 = -alpha;
+    a0 = 1.0 + alpha, a1 = -2.0 * cs, a2 = 1.0 - alpha;
+    break;
+  case SPARK_BIQUAD_NOTCH:
+    b0 = 1.0, b1 = -2.0 * cs, b2 = 1.0;
+    a0 = 1.0 + alpha, a1 = -2.0 * cs, a2 = 1.0 - alpha;
+    break;
+  case SPARK_BIQUAD_ALLPASS:
+    b0 = 1.0 - alpha, b1 = -2.0 * cs, b2 = 1.0 + alpha;
+    a0 = 1.0 + alpha, a1 = -2.0 * cs, a2 = 1.0 - alpha;
+    break;
+  case SPARK_BIQUAD_PEAKING:
+    b0 = 1.0 + alpha * A, b1 = -2.0 * cs, b2 = 1.0 - alpha * A;
+    a0 = 1.0 + alpha / A, a1 = -2.0 * cs, a2 = 1.0 - alpha / A;
+    break;
+  case SPARK_BIQUAD_LOWSHELF: {
+    const double s = 2.0 * sqrt(A) * alpha;
+    b0 = A * ((A + 1.0) - (A - 1.0) * cs + s);
+    b1 = 2.0 * A * ((A - 1.0) - (A + 1.0) * cs);
+    b2 = A * ((A + 1.0) - (A - 1.0) * cs - s);
+    a0 = (A + 1.0) + (A - 1.0) * cs + s;
+    a1 = -2.0 * ((A - 1.0) + (A + 1.0) * cs);
+    a2 = (A + 1.0) + (A - 1.0) * cs - s;
+    break;
+  }
+  default: { /* SPARK_BIQUAD_HIGHSHELF */
+    const double s = 2.0 * sqrt(A) * alpha;
+    b0 = A * ((A + 1.0) + (A - 1.0) * cs + s);
+    b1 = -2.0 * A * ((A - 1.0) + (A + 1.0) * cs);
+    b2 = A * ((A + 1.0) + (A - 1.0) * cs - s);
+    a0 = (A + 1.0) - (A - 1.0) * cs + s;
+    a1 = 2.0 * ((A - 1.0) - (A + 1.0) * cs);
+    a2 = (A + 1.0) - (A - 1.0) * cs - s;
+    break;
+  }
+  }
+
+  const double inv = 1.0 / a0;
+  c[0] = b0 * inv;
+  c[1] = b1 * inv;
+  c[2] = b2 * inv;
+  c[3] = -a1 * inv;
+  c[4] = -a2 * inv;
+}
+
+/**
+ * Lattice form of one section `{b0, b1, b2, -a1, -a2}`, or false unless both
+ * poles are strictly inside the unit circle. With
+ * `A(z) = 1 + a1 z^-1 + a2 z^-2` the reflections are `k2 = a2` and
+ * `k1 = a1 / (1 + a2)`; the numerator is expanded on the backward
+ * polynomials (ladder v) and rescaled by the gains of the outer rotations.
+ */
+static bool lattice_section(const double sos[5], float *lattice)
+{
+  const double a1 = -sos[3];
+  const double a2 = -sos[4];
+  const double k2 = a2;
+  const double k1 = a1 / (1.0 + k2);
+
+  if (!(fabs(k2) < 1.0) || !(fabs(k1) < 1.0) || !isfinite(sos[0]) ||
+      !isfinite(sos[1]) || !isfinite(sos[2]))
+    return false;
+
+  if (!lattice)
+    return true;
+
+  const double c1 = sqrt(1.0 - k1 * k1);
+  const double c2 = sqrt(1.0 - k2 * k2);
+  const double v2 = sos[2];
+  const double v1 = sos[1] - sos[2] * a1;
+  const double v0 = sos[0] - v2 * a2 - v1 * k1;
+
+  lattice[0] = (float)k1;
+  lattice[1] = (float)c1;
+  lattice[2] = (float)k2;
+  lattice[3] = (float)c2;
+  lattice[4] = (float)(v0 / (c1 * c2));
+  lattice[5] = (float)(v1 / c2);
+  lattice[6] = (float)v2;
+  return true;
+}
+
+/** Section parameters of @p band, exact or per @ref SPARK_DESIGN_FAST. */
+static void biquad_band_params(const spark_biquad_band_t *band, uint32_t flags,
+                               double *t, double *A)
+{
+  if (flags & SPARK_DESIGN_FAST) {
+    *t = design_tan_pi_fast(band->freq);
+    *A = design_exp2_fast(band->gain_db * (float)DESIGN_DB_EXP2);
+  } else {
+    *t = tan(design_pi * band->freq);
+    *A = pow(10.0, band->gain_db / 40.0);
+  }
+}
+
+/**
+ * @brief Design a batch of RBJ cookbook sections in kernel layout.
+ *
+ * Writes `{b0, b1, b2, -a1, -a2}` (a0 normalized to 1) of band `i` at
+ * `coefficients + 5 * i`, which is the layout spark_sosfilt_f32_t reads: the
+ * bands of one call can be the stages of a shared cascade (an EQ), or with
+ * @ref SPARK_SOSFILT_INDEPENDENT_SOS the `n_stages` bands of each channel in
+ * turn. Point @p coefficients at the filter's storage and the new sections
+ * take effect on the next call (or ramp to them with spark_sosfilt_f32_ramp()).
+ *
+ * @ref SPARK_DESIGN_FAST swaps `tan` and `pow` for their approximations
+ * (see ::spark_design_flags); each band then costs one division-based tan,
+ * one exp2 polynomial and a handful of operations, with no libm calls but
+ * `sqrt`. All bands are validated before anything is written.
+ *
+ * @param bands Section parameters.
+ * @param n_bands Number of sections to design.
+ * @param coefficients Destination, `5 * n_bands` floats.
+ * @param flags A combination of ::spark_design_flags.
+ * @return SPARK_NOERROR, or SPARK_ERR_INVALID_PARAM for NULL arguments, an
+ * unknown type or flag, a frequency outside (0, 0.5), or a non-positive q.
+ */
+int spark_design_biquad_f32(const spark_biquad_band_t *bands, uint32_t n_bands,
+                            float *coefficients, uint32_t flags)
+{
+  if ((n_bands > 0 && (!bands || !coefficients)) || (flags & ~SPARK_DESIGN_FAST))
+    return SPARK_ERR_INVALID_PARAM;
+
+  for (uint32_t i = 0; i < n_bands; ++i) {
+    if (!biquad_band_is_valid(&bands[i]))
+      return SPARK_ERR_INVALID_PARAM;
+  }
+
+  for (uint32_t i = 0; i < n_bands; ++i) {
+    double t, A, c[5];
+    biquad_band_params(&bands[i], flags, &t, &A);
+    biquad_section(bands[i].type, t, A, bands[i].q, c);
+    for (int k = 0; k < 5; ++k)
+      coefficients[5 * (size_t)i + k] = (float)c[k];
+  }
+
+  return SPARK_NOERROR;
+}
+
+/**
+ * Cytomic trapezoidal SVF section `{g, k, m0, m1, m2}` for the same band as
+ * biquad_section(): `g = t`, `k = 1 / q`, and the mix taps pick the response
+ * from the input, band-pass and low-pass outputs. Shelves move the corner by
+ * `sqrt(A)` and the bell scales `k` by `1 / A` so the gain sits in the taps.
+ */
+static void svf_section(uint32_t type, double t, double A, double q, float *c)
+{
+  double g = t, k = 1.0 / q;
+  double m0, m1, m2;
+
+  switch (type) {
+  case SPARK_BIQUAD_LOWPASS:
+    m0 = 0.0, m1 = 0.0, m2 = 1.0;
+    break;
+  case SPARK_BIQUAD_HIGHPASS:
+    m0 = 1.0, m1 = -k, m2 = -1.0;
+    break;
+  case SPARK_BIQUAD_BANDPASS:
+    m0 = 0.0, m1 = k, m2 = 0.0;
+    break;
+  case SPARK_BIQUAD_NOTCH:
+    m0 = 1.0, m1 = -k, m2 = 0.0;
+    break;
+  case SPARK_BIQUAD_ALLPASS:
+    m0 = 1.0, m1 = -2.0 * k, m2 = 0.0;
+    break;
+  case SPARK_BIQUAD_PEAKING:
+    k = 1.0 / (q * A);
+    m0 = 1.0, m1 = k * (A * A - 1.0), m2 = 0.0;
+    break;
+  case SPARK_BIQUAD_LOWSHELF:
+    g = t / sqrt(A);
+    m0 = 1.0, m1 = k * (A - 1.0), m2 = A * A - 1.0;
+    break;
+  default: /* SPARK_BIQUAD_HIGHSHELF */
+    g = t * sqrt(A);
+    m0 = A * A, m1 = k * (1.0 - A) * A, m2 = 1.0 - A * A;
+    break;
+  }
+
+  c[0] = (float)g;
+  c[1] = (float)k;
+  c[2] = (float)m0;
+  c[3] = (float)m1;
+  c[4] = (float)m2;
+}
+
+/**
+ * @brief Design a batch of sections for spark_svf_f32().
+ *
+ * The counterpart of spark_design_biquad_f32() for the trapezoidal SVF:
+ * same bands, same responses, written as `{g, k, m0, m1, m2}` at
+ * `coefficients + 5 * i`. Since the SVF stays stable while g and k move,
+ * these sets can be ramped between freely with spark_svf_f32_ramp().
+ *
+ * @param bands Section parameters.
+ * @param n_bands Number of sections to design.
+ * @param coefficients Destination, `5 * n_bands` floats.
+ * @param flags A combination of ::spark_design_flags.
+ * @return SPARK_NOERROR, or SPARK_ERR_INVALID_PARAM for the same cases as
+ * spark_design_biquad_f32().
+ */
+int spark_design_svf_f32(const spark_biquad_band_t *bands, uint32_t n_bands,
+                         float *coefficients, uint32_t flags)
+{
+  if ((n_bands > 0 && (!bands || !coefficients)) || (flags & ~SPARK_DESIGN_FAST))
+    return SPARK_ERR_INVALID_PARAM;
+
+  for (uint32_t i = 0; i < n_bands; ++i) {
+    if (!biquad_band_is_valid(&bands[i]))
+      return SPARK_ERR_INVALID_PARAM;
+  }
+
+  for (uint32_t i = 0; i < n_bands; ++i) {
+    double t, A;
+    biquad_band_params(&bands[i], flags, &t, &A);
+    svf_section(bands[i].type, t, A, bands[i].q, coefficients + 5 * (size_t)i);
+  }
+
+  return SPARK_NOERROR;
+}
+
+/**
+ * @brief Design a batch of sections for spark_lattice_f32().
+ *
+ * The sections of spark_design_biquad_f32(), converted to
+ * `{k1, c1, k2, c2, t0, t1, t2}` at `coefficients + 7 * i` before rounding
+ * to float. Going through double is what lets a low, high-Q corner keep its
+ * pole radius; converting already-rounded sections with
+ * spark_lattice_f32_from_sos() inherits their error.
+ *
+ * @param bands Section parameters.
+ * @param n_bands Number of sections to design.
+ * @param coefficients Destination, `7 * n_bands` floats.
+ * @param flags A combination of ::spark_design_flags.
+ * @return SPARK_NOERROR, or SPARK_ERR_INVALID_PARAM for the same cases as
+ * spark_design_biquad_f32().
+ */
+int spark_design_lattice_f32(const spark_biquad_band_t *bands, uint32_t n_bands,
+                             float *coefficients, uint32_t flags)
+{
+  if ((n_bands > 0 && (!bands || !coefficients)) || (flags & ~SPARK_DESIGN_FAST))
+    return SPARK_ERR_INVALID_PARAM;
+
+  for (uint32_t i = 0; i < n_bands; ++i) {
+    if (!biquad_band_is_valid(&bands[i]))
+      return SPARK_ERR_INVALID_PARAM;
+  }
+
+  for (uint32_t i = 0; i < n_bands; ++i) {
+    double t, A, c[5];
+    biquad_band_params(&bands[i], flags, &t, &A);
+    biquad_section(bands[i].type, t, A, bands[i].q, c);
+    lattice_section(c, coefficients + 7 * (size_t)i);
+  }
+
+  return SPARK_NOERROR;
+}
+
+/**
+ * @brief Convert SOS sections to spark_lattice_f32() coefficients.
+ *
+ * Nothing is written unless every section has both poles strictly inside
+ * the unit circle.
+ *
+ * @param sos @p n_sections runs of `{b0, b1, b2, -a1, -a2}`.
+ * @param n_sections Number of sections.
+ * @param lattice Destination, `7 * n_sections` floats; may not overlap @p sos.
+ * @return SPARK_NOERROR, or SPARK_ERR_INVALID_PARAM for NULL pointers, zero
+ * sections, or a section that is unstable, marginal or not finite.
+ */
+int spark_lattice_f32_from_sos(const float *sos, uint32_t n_sections, float *lattice)
+{
+  if (!sos || !lattice || n_sections == 0)
+    return SPARK_ERR_INVALID_PARAM;
+
+  for (int pass = 0; pass < 2; ++pass) {
+    for (uint32_t s = 0; s < n_sections; ++s) {
+      double c[5];
+      for (int k = 0; k < 5; ++k)
+        c[k] = sos[5 * (size_t)s + k];
+      if (!lattice_section(c, pass ? lattice + 7 * (size_t)s : NULL))
+        return SPARK_ERR_INVALID_PARAM;
+    }
+  }
+
+  return SPARK_NOERROR;
+}
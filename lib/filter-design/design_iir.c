@@ -0,0 +1,343 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "spark/block.h"
+#include "spark/filter_design.h"
+
+#include "filter-design/design_math.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/** Most descending Landen steps; a modulus reaches 1e-20 well within it. */
+#define DESIGN_LANDEN_MAX 16
+
+typedef struct design_complex {
+  double re, im;
+} design_complex_t;
+
+static inline design_complex_t cmul(design_complex_t a, design_complex_t b)
+{
+  return (design_complex_t){a.re * b.re - a.im * b.im, a.re * b.im + a.im * b.re};
+}
+
+static inline design_complex_t cdiv(design_complex_t a, design_complex_t b)
+{
+  const double d = b.re * b.re + b.im * b.im;
+  return (design_complex_t){(a.re * b.re + a.im * b.im) / d,
+                            (a.im * b.re - a.re * b.im) / d};
+}
+
+/**
+ * Descending Landen moduli `k_{n+1} = (k_n / (1 + k_n'))^2` of @p k, whose
+ * complement @p kp is passed in so moduli near 1 keep their precision.
+ * Returns the number of moduli written to @p v.
+ */
+static uint32_t design_landen(double k, double kp, double *v)
+{
+  uint32_t m = 0;
+  while (m < DESIGN_LANDEN_MAX && k > 1e-20) {
+    k = k / (1.0 + kp);
+    k *= k;
+    v[m++] = k;
+    kp = sqrt((1.0 - k) * (1.0 + k));
+  }
+  return m;
+}
+
+/**
+ * Ascending Landen recursion from `w = cd(u K, 0)` or `sn(u K, 0)` back to
+ * the modulus whose Landen sequence is @p v (Orfanidis).
+ */
+static design_complex_t design_landen_up(design_complex_t w, const double *v, uint32_t m)
+{
+  for (uint32_t n = m; n-- > 0;) {
+    const design_complex_t w2 = cmul(w, w);
+    const design_complex_t den = {1.0 + v[n] * w2.re, v[n] * w2.im};
+    w = cdiv((design_complex_t){(1.0 + v[n]) * w.re, (1.0 + v[n]) * w.im}, den);
+  }
+  return w;
+}
+
+/** Jacobi `cd(u K, k)` for complex @p u (`u = a + j b`). */
+static design_complex_t design_cd(double a, double b, const double *v, uint32_t m)
+{
+  const double x = 0.5 * design_pi * a, y = 0.5 * design_pi * b;
+  const design_complex_t w = {cos(x) * cosh(y), -sin(x) * sinh(y)};
+  return design_landen_up(w, v, m);
+}
+
+/** Jacobi `sn(u K, k)` for real @p u. */
+static double design_sn(double u, const double *v, uint32_t m)
+{
+  const design_complex_t w = {sin(0.5 * design_pi * u), 0.0};
+  return design_landen_up(w, v, m).re;
+}
+
+/**
+ * Real v with `sn(j v K, k) = j y`: the descending recursion of the inverse
+ * keeps the argument imaginary, and `asn(j y, 0) = j (2 / pi) asinh(y)`.
+ */
+static double design_asn_imag(double y, double k, const double *v, uint32_t m)
+{
+  for (uint32_t n = 0; n < m; ++n) {
+    const double v1 = n ? v[n - 1] : k;
+    y = y / (1.0 + sqrt(1.0 + y * y * v1 * v1)) * 2.0 / (1.0 + v[n]);
+  }
+  return 2.0 / design_pi * asinh(y);
+}
+
+static void design_butterworth(spark_design_prototype_t *proto)
+{
+  const uint32_t N = proto->order;
+  for (uint32_t i = 0; i < N / 2; ++i) {
+    const double theta = design_pi * (2.0 * i + 1.0) / (2.0 * N);
+    proto->pole_re[i] = -sin(theta);
+    proto->pole_im[i] = cos(theta);
+  }
+  if (N & 1)
+    proto->pole_re[N / 2] = -1.0;
+}
+
+static void design_chebyshev1(spark_design_prototype_t *proto, double eps)
+{
+  const uint32_t N = proto->order;
+  const double mu = asinh(1.0 / eps) / N;
+  for (uint32_t i = 0; i < N / 2; ++i) {
+    const double theta = design_pi * (2.0 * i + 1.0) / (2.0 * N);
+    proto->pole_re[i] = -sinh(mu) * sin(theta);
+    proto->pole_im[i] = cosh(mu) * cos(theta);
+  }
+  if (N & 1)
+    proto->pole_re[N / 2] = -sinh(mu);
+}
+
+/**
+ * Elliptic prototype of a given order (Orfanidis, "Lecture Notes on Elliptic
+ * Filter Design"): solve the degree equation for the selectivity k, then
+ * place the zeros at `j / (k cd(u_i K))` and the poles at
+ * `j cd((u_i - j v0) K)`, `u_i = (2i - 1) / N`.
+ */
+static void design_elliptic(spark_design_prototype_t *proto, double eps, double eps_s)
+{
+  const uint32_t N = proto->order;
+  const uint32_t L = N / 2;
+  double v[DESIGN_LANDEN_MAX];
+
+  /* Degree equation: k' = k1'^N * prod(sn(u_i K1', k1'))^4. */
+  const double k1 = eps / eps_s;
+  const double k1p = sqrt((1.0 - k1) * (1.0 + k1));
+  uint32_t m = design_landen(k1p, k1, v);
+  double kp = pow(k1p, N);
+  for (uint32_t i = 1; i <= L; ++i) {
+    const double s = design_sn((2.0 * i - 1.0) / N, v, m);
+    kp *= (s * s) * (s * s);
+  }
+  const double k = sqrt((1.0 - kp) * (1.0 + kp));
+
+  m = design_landen(k1, k1p, v);
+  const double v0 = design_asn_imag(1.0 / eps, k1, v, m) / N;
+
+  m = design_landen(k, kp, v);
+  for (uint32_t i = 1; i <= L; ++i) {
+    const double u = (2.0 * i - 1.0) / N;
+    const design_complex_t z = design_cd(u, 0.0, v, m);
+    const design_complex_t p = design_cd(u, -v0, v, m);
+    proto->zero_im[i - 1] = 1.0 / (k * z.re);
+    proto->pole_re[i - 1] = -p.im; /* j * cd */
+    proto->pole_im[i - 1] = p.re;
+  }
+  if (N & 1) {
+    /* sn(j v0 K) = j y stays imaginary through the recursion. */
+    double y = sinh(0.5 * design_pi * v0);
+    for (uint32_t n = m; n-- > 0;)
+      y = (1.0 + v[n]) * y / (1.0 - v[n] * y * y);
+    proto->pole_re[L] = -y;
+  }
+}
+
+/**
+ * @brief Compute a normalized analog prototype for spark_design_iir_f32().
+ *
+ * Poles and zeros are found once, in double precision, for a passband edge
+ * (Butterworth: -3 dB point) of 1 rad/s. Sections are ordered by increasing
+ * pole Q, with the real pole of an odd order last; each elliptic zero pair
+ * sits with the pole pair it is closest to.
+ *
+ * @param proto Prototype to fill.
+ * @param family A value from ::spark_design_family.
+ * @param order Filter order, 1 to ::SPARK_DESIGN_MAX_ORDER.
+ * @param ripple_db Passband ripple in dB (> 0; Chebyshev and elliptic).
+ * @param atten_db Stopband attenuation in dB (> ripple_db; elliptic).
+ * @return SPARK_NOERROR, or SPARK_ERR_INVALID_PARAM for a NULL prototype, an
+ * unknown family, an order out of range, or ripple / attenuation outside
+ * their ranges.
+ */
+int spark_design_prototype_init(spark_design_prototype_t *proto, uint32_t family,
+                                uint32_t order, double ripple_db, double atten_db)
+{
+  if (!proto || family > SPARK_DESIGN_ELLIPTIC || order == 0 ||
+      order > SPARK_DESIGN_MAX_ORDER)
+    return SPARK_ERR_INVALID_PARAM;
+  if (family != SPARK_DESIGN_BUTTERWORTH && !(ripple_db > 0.0 && isfinite(ripple_db)))
+    return SPARK_ERR_INVALID_PARAM;
+  if (family == SPARK_DESIGN_ELLIPTIC && !(atten_db > ripple_db && isfinite(atten_db)))
+    return SPARK_ERR_INVALID_PARAM;
+
+  spark_design_prototype_t p = {
+      .family = family,
+      .order = order,
+      .n_stages = (order + 1) / 2,
+      .gain = 1.0,
+  };
+
+  const double eps = sqrt(expm1(ripple_db * (log(10.0) / 10.0)));
+  switch (family) {
+  case SPARK_DESIGN_BUTTERWORTH:
+    design_butterworth(&p);
+    break;
+  case SPARK_DESIGN_CHEBYSHEV1:
+    design_chebyshev1(&p, eps);
+    break;
+  default: /* SPARK_DESIGN_ELLIPTIC */
+    design_elliptic(&p, eps, sqrt(expm1(atten_db * (log(10.0) / 10.0))));
+    break;
+  }
+  if (family != SPARK_DESIGN_BUTTERWORTH && !(order & 1))
+    p.gain = 1.0 / sqrt(1.0 + eps * eps);
+
+  /* The pole at index 0 has the highest Q; run the pairs in reverse. */
+  const uint32_t L = order / 2;
+  for (uint32_t i = 0; i < L / 2; ++i) {
+    const uint32_t j = L - 1 - i;
+    double t;
+    t = p.pole_re[i], p.pole_re[i] = p.pole_re[j], p.pole_re[j] = t;
+    t = p.pole_im[i], p.pole_im[i] = p.pole_im[j], p.pole_im[j] = t;
+    t = p.zero_im[i], p.zero_im[i] = p.zero_im[j], p.zero_im[j] = t;
+  }
+
+  *proto = p;
+  return SPARK_NOERROR;
+}
+
+/**
+ * Map the prototype onto one digital filter by the bilinear transform
+ * `s = (1 - z^-1) / (1 + z^-1)` with the prewarped cutoff @p wa, lowpass
+ * `s -> s / wa` or highpass `s -> wa / s`, and normalize every section to
+ * unity at DC (lowpass) or Nyquist (highpass).
+ */
+static void design_iir_map(const spark_design_prototype_t *proto, bool highpass,
+                           double wa, float *c)
+{
+  const double z0 = highpass ? -1.0 : 1.0; /* point of unity gain */
+  for (uint32_t s = 0; s < proto->n_stages; ++s, c += 5) {
+    double re = proto->pole_re[s], im = proto->pole_im[s];
+    const double zi = proto->zero_im[s];
+    if (highpass) {
+      const double m = wa / (re * re + im * im);
+      re *= m, im *= -m;
+    } else {
+      re *= wa, im *= wa;
+    }
+
+    double b[3], a1, a2;
+    if ((proto->order & 1) && s == proto->n_stages - 1) {
+      /* First-order section: pole (1 + re) / (1 - re), zero at -z0. */
+      a1 = (1.0 + re) / (1.0 - re);
+      a2 = 0.0;
+      b[0] = 1.0, b[1] = z0, b[2] = 0.0;
+    } else {
+      const double d = (1.0 - re) * (1.0 - re) + im * im;
+      a1 = 2.0 * (1.0 - re * re - im * im) / d;
+      a2 = -((1.0 + re) * (1.0 + re) + im * im) / d;
+      if (zi != 0.0) {
+        const double w = highpass ? wa / zi : wa * zi;
+        b[0] = 1.0, b[1] = -2.0 * (1.0 - w * w) / (1.0 + w * w), b[2] = 1.0;
+      } else {
+        b[0] = 1.0, b[1] = 2.0 * z0, b[2] = 1.0;
+      }
+    }
+
+    double g = (1.0 - a1 * z0 - a2) / (b[0] + b[1] * z0 + b[2]);
+    if (s == 0)
+      g *= proto->gain;
+    c[0] = (float)(b[0] * g);
+    c[1] = (float)(b[1] * g);
+    c[2] = (float)(b[2] * g);
+    c[3] = (float)a1;
+    c[4] = (float)a2;
+  }
+}
+
+/**
+ * @brief Design digital lowpass or highpass filters from a prototype.
+ *
+ * Writes the `proto->n_stages` sections of filter `i`, cutoff @p freq[i],
+ * at `coefficients + 5 * n_stages * i` in `{b0, b1, b2, -a1, -a2}` form: the
+ * layout of spark_sosfilt_f32_t, so @p n_filters cutoffs fill the storage of
+ * an @ref SPARK_SOSFILT_INDEPENDENT_SOS filter with one channel each (or a
+ * shared one for @p n_filters 1). Set the filter's `n_stages` to
+ * `proto->n_stages`.
+ *
+ * The cost per filter is one `tan` (the approximation under
+ * @ref SPARK_DESIGN_FAST) plus two divisions per section; the prototype's
+ * trigonometry is not repeated, so it is cheap enough to sweep a cutoff on
+ * every block. All frequencies are validated before anything is written.
+ *
+ * @param proto Prototype from spark_design_prototype_init().
+ * @param response A value from ::spark_design_response.
+ * @param freq Cutoff per filter in cycles/sample (`f / fs`), in (0, 0.5).
+ * @param n_filters Number of filters to design.
+ * @param coefficients Destination, `5 * n_stages * n_filters` floats.
+ * @param flags A combination of ::spark_design_flags.
+ * @return SPARK_NOERROR, or SPARK_ERR_INVALID_PARAM for NULL arguments, an
+ * unknown response or flag, or a frequency outside (0, 0.5).
+ */
+int spark_design_iir_f32(const spark_design_prototype_t *proto, uint32_t response,
+                         const float *freq, uint32_t n_filters, float *coefficients,
+                         uint32_t flags)
+{
+  if (!proto || response > SPARK_DESIGN_HIGHPASS || (flags & ~SPARK_DESIGN_FAST) ||
+      proto->n_stages == 0 || proto->n_stages > SPARK_DESIGN_MAX_STAGES)
+    return SPARK_ERR_INVALID_PARAM;
+  if (n_filters > 0 && (!freq || !coefficients))
+    return SPARK_ERR_INVALID_PARAM;
+
+  for (uint32_t i = 0; i < n_filters; ++i) {
+    if (!(freq[i] > 0.0f && freq[i] < 0.5f))
+      return SPARK_ERR_INVALID_PARAM;
+  }
+
+  const bool highpass = response == SPARK_DESIGN_HIGHPASS;
+  const size_t stride = 5 * (size_t)proto->n_stages;
+  for (uint32_t i = 0; i < n_filters; ++i) {
+    const double wa = (flags & SPARK_DESIGN_FAST) ? design_tan_pi_fast(freq[i])
+                                                  : tan(design_pi * freq[i]);
+    design_iir_map(proto, highpass, wa, coefficients + stride * i);
+  }
+
+  return SPARK_NOERROR;
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Internal math shared by the design sources. Not installed.
+ *
+ * The fast approximations are branch-free (selects compile to blends or
+ * conditional moves), so batch loops over many bands stay straight-line.
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+static const double design_pi = 3.14159265358979323846;
+
+/**
+ * @brief `tan(pi * f)` for f in (0, 0.5), single precision.
+ *
+ * [5/4] Padé approximant of tan on [0, pi/4] after folding f onto the nearer
+ * end, `tan(pi * f) = 1 / tan(pi * (0.5 - f))` above 0.25: at most ~2.5e-7
+ * relative error, i.e. float rounding.
+ */
+static inline float design_tan_pi_fast(float f)
+{
+  const bool high = f > 0.25f;
+  const float x = (float)design_pi * (high ? 0.5f - f : f);
+  const float x2 = x * x;
+  const float num = x * (945.0f + x2 * (-105.0f + x2));
+  const float den = 945.0f + x2 * (-420.0f + 15.0f * x2);
+  return high ? den / num : num / den;
+}
+
+/**
+ * @brief `2^x` for |x| < 126, single precision.
+ *
+ * Rounds x to the nearest integer n, evaluates the degree-6 Taylor series of
+ * `e^(r ln 2)` on the remainder |r| <= 0.5 (~1.2e-7 relative error) and
+ * scales by 2^n through the exponent bits.
+ */
+static inline float design_exp2_fast(float x)
+{
+  x = fminf(fmaxf(x, -126.0f), 126.0f);
+  const float n = floorf(x + 0.5f);
+  const float y = (x - n) * 0.69314718f;
+  float p = 1.0f / 720.0f;
+  p = p * y + 1.0f / 120.0f;
+  p = p * y + 1.0f / 24.0f;
+  p = p * y + 1.0f / 6.0f;
+  p = p * y + 0.5f;
+  p = p * y + 1.0f;
+  p = p * y + 1.0f;
+
+  const uint32_t bits = (uint32_t)((int32_t)n + 127) << 23;
+  float scale;
+  memcpy(&scale, &bits, sizeof(scale));
+  return p * scale;
+}
@@ -0,0 +1,594 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "spark/fir_filter.h"
+#include "spark/fft.h"
+#include "dispatch/kernels.h"
+#include "memory/memory_internal.h"
+#include "stats/stats_internal.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief spark_fir_f32_init() accepts planar and interleaved F32 buffers
+ */
+#define FIR_F32_FLAGS (SPARK_FMT_F32 | SPARK_LAYOUT_PLANAR | SPARK_BLOCK_PROCESS)
+#define FIR_F32_INTERLEAVED_FLAGS                                                        \
+  (SPARK_FMT_F32 | SPARK_LAYOUT_INTERLEAVED | SPARK_BLOCK_PROCESS)
+
+/** Smallest FFT partition; below it the transforms cost more than they save. */
+#define FIR_MIN_PARTITION 16
+
+/** Levels of a non-uniform engine: one head level plus doublings up to the cap. */
+#define FIR_MAX_LEVELS 16
+
+/**
+ * @brief One partition size of an FFT engine.
+ *
+ * Partition p of the level holds taps `[(p + delay) * size, ...)` and meets
+ * the spectrum of the input window ending `p` periods earlier; the spectra
+ * of the last `n_parts` windows form a frequency-domain delay line (FDL).
+ * The head level (`delay` 0) includes the current sub-block and has
+ * `size == partition`; the others (`delay` 1) compute `size` outputs at
+ * once, ahead of time, into `pending`.
+ */
+typedef struct fir_level {
+  uint32_t size;    /**< Partition length M; the FFT is 2M. */
+  uint32_t n_parts; /**< Partitions in this level. */
+  uint32_t delay;   /**< Partition offset in periods: 0 for the head level, else 1. */
+  size_t bins;      /**< Floats per re/im array: M + 1 rounded up to the alignment. */
+  spark_fft_f32_t fft; /**< Real 2M-point plan. */
+  float *taps;    /**< Per tap set: n_parts spectra of 2 * bins (re, then im). */
+  float *fdl;     /**< Per channel: n_parts input spectra of 2 * bins. */
+  float *pending; /**< Per channel: M precomputed outputs (delay 1 only). */
+} fir_level_t;
+
+struct spark_fir_f32_state {
+  const spark_kernels_t *kernels;
+  uint32_t n_sets;      /**< Tap sets: 1 if shared, else n_chan. */
+  size_t chan_stride;   /**< Samples between channel k and k+1. */
+  size_t sample_stride; /**< Samples between frame n and n+1. */
+  uint64_t position;    /**< Samples per channel consumed so far. */
+
+  /* Direct method. */
+  float *taps_rev; /**< Per tap set: n_taps reversed taps. */
+  float *window;   /**< Per channel: n_taps - 1 history + block. */
+  float *out;      /**< One channel's block of output. */
+
+  /* FFT methods. */
+  uint32_t n_levels;
+  fir_level_t levels[FIR_MAX_LEVELS];
+  uint32_t ring_len; /**< Input ring length (power of two), stored twice. */
+  float *ring;       /**< Per channel: 2 * ring_len samples. */
+  float *time;       /**< 2 * largest M: one transform in the time domain. */
+  float *acc;        /**< 2 * largest bins: the FDL sum. */
+};
+
+static inline uint32_t log2_u32(uint32_t n)
+{
+  uint32_t r = 0;
+  while ((1u << r) < n)
+    ++r;
+  return r;
+}
+
+/**
+ * @brief Rough cost in flops per output sample of one FFT level.
+ *
+ * A forward and an inverse real transform of 2M per M outputs, plus one
+ * complex multiply-add per bin and partition, vectorized `lanes` wide. The
+ * transform term is weighted for the vectorized spark_fft_f32 passes.
+ */
+static double level_cost(uint32_t size, uint32_t n_parts, uint32_t lanes)
+{
+  const double fft = 2.0 * 3.0 * log2_u32(2 * size);
+  return fft + 8.0 * n_parts * (size + 1.0) / size / lanes;
+}
+
+/**
+ * @brief Split the response into levels for @p method; returns the count.
+ */
+static uint32_t plan_levels(fir_level_t levels[FIR_MAX_LEVELS], uint32_t method,
+                            uint32_t n_taps, uint32_t partition)
+{
+  const uint32_t head_parts = (n_taps + partition - 1) / partition;
+
+  if (method == SPARK_FIR_UNIFORM || 2 * partition > SPARK_FIR_MAX_PARTITION ||
+      head_parts <= 2) {
+    levels[0] = (fir_level_t){.size = partition, .n_parts = head_parts, .delay = 0};
+    return 1;
+  }
+
+  /*
+   * [0, 2L) in two partitions of L, then one partition of M over [M, 2M)
+   * for M = 2L, 4L, ... up to the cap, whose last level takes the rest.
+   * Level M starts M taps in, so its outputs for [T, T + M) depend only on
+   * input before T: they are computed in one go when T is reached and the
+   * engine keeps zero latency.
+   */
+  uint32_t n = 0;
+  levels[n++] = (fir_level_t){.size = partition, .n_parts = 2, .delay = 0};
+
+  size_t covered = 2 * (size_t)partition;
+
+  for (uint32_t size = 2 * partition; covered < n_taps && n < FIR_MAX_LEVELS; size *= 2) {
+    const bool last = (2 * size > SPARK_FIR_MAX_PARTITION) || (n + 1 == FIR_MAX_LEVELS);
+    const uint32_t parts = last ? (uint32_t)((n_taps - covered + size - 1) / size) : 1;
+
+    levels[n++] = (fir_level_t){.size = size, .n_parts = parts, .delay = 1};
+    covered += (size_t)parts * size;
+  }
+
+  return n;
+}
+
+/**
+ * @brief Resolve the method and lay out the arena; returns its size.
+ *
+ * With @p base NULL only the size is computed and @p state receives the
+ * layout with NULL storage pointers; otherwise @p state is carved from the
+ * aligned @p base.
+ */
+static size_t fir_layout(const spark_fir_f32_t *desc, uint32_t method, uint32_t partition,
+                         struct spark_fir_f32_state *state, unsigned char *base)
+{
+  const uint32_t n_chan = desc->header.input.channels;
+  const uint32_t block = desc->header.input.samples;
+  const uint32_t n_taps = desc->n_taps;
+  const uint32_t n_sets = (desc->flags & SPARK_FIR_SHARE_TAPS) ? 1 : n_chan;
+
+  memset(state, 0, sizeof(*state));
+  state->n_sets = n_sets;
+
+  spark_carve_t carve = {.base = base, .align = SPARK_FIR_ALIGN};
+  (void)spark_carve_offset(&carve, sizeof(struct spark_fir_f32_state));
+
+  if (method == SPARK_FIR_DIRECT) {
+    const size_t window = (size_t)n_taps - 1 + block;
+    state->taps_rev = spark_carve_floats(&carve, (size_t)n_sets * n_taps);
+    state->window = spark_carve_floats(&carve, (size_t)n_chan * window);
+    state->out = spark_carve_floats(&carve, block);
+    return carve.used;
+  }
+
+  state->n_levels = plan_levels(state->levels, method, n_taps, partition);
+
+  uint32_t largest = 0;
+
+  for (uint32_t j = 0; j < state->n_levels; ++j) {
+    fir_level_t *level = &state->levels[j];
+    const size_t bins =
+        spark_align_up(sizeof(float) * (level->size + 1), carve.align) / sizeof(float);
+    const size_t spectra = (size_t)level->n_parts * 2 * bins;
+
+    level->bins = bins;
+    if (level->size > largest)
+      largest = level->size;
+
+    const size_t fft_bytes = spark_fft_f32_size(SPARK_FFT_REAL, 2 * level->size);
+    const size_t fft_at = spark_carve_offset(&carve, fft_bytes);
+    if (base)
+      (void)spark_fft_f32_init(&level->fft, SPARK_FFT_REAL, 2 * level->size,
+                               base + fft_at, fft_bytes);
+
+    level->taps = spark_carve_floats(&carve, (size_t)n_sets * spectra);
+    level->fdl = spark_carve_floats(&carve, (size_t)n_chan * spectra);
+    if (level->delay)
+      level->pending =
+          spark_carve_floats(&carve, (size_t)n_chan * level->size);
+  }
+
+  const size_t bins =
+      spark_align_up(sizeof(float) * (largest + 1), carve.align) / sizeof(float);
+
+  state->ring_len = 1u << log2_u32(2 * largest + partition);
+  state->ring = spark_carve_floats(&carve, (size_t)n_chan * 2 * state->ring_len);
+  state->time = spark_carve_floats(&carve, 2 * largest);
+  state->acc = spark_carve_floats(&carve, 2 * bins);
+
+  return carve.used;
+}
+
+/**
+ * @brief Check the description and resolve the method and partition size.
+ */
+static int fir_resolve(const spark_fir_f32_t *desc, uint32_t *method, uint32_t *partition)
+{
+  if (!desc)
+    return SPARK_ERR_INVALID_PARAM;
+
+  const bool interleaved =
+      (spark_buffer_get_layout(desc->header.input.flags) == SPARK_LAYOUT_INTERLEAVED);
+
+  /* Bases are bound at execute time: validate the shape only. */
+  spark_block_t shape = desc->header;
+  shape.input.base = &shape;
+  shape.output.base = &shape;
+
+  int status =
+      spark_block_validate(&shape, interleaved ? FIR_F32_INTERLEAVED_FLAGS : FIR_F32_FLAGS);
+  if (status != SPARK_NOERROR)
+    return status;
+
+  if (!desc->taps || desc->n_taps == 0 || desc->method > SPARK_FIR_NONUNIFORM)
+    return SPARK_ERR_INVALID_PARAM;
+
+  /* Partitions are powers of two that divide the block. */
+  const uint32_t block = desc->header.input.samples;
+  uint32_t l = block & (~block + 1);
+  if (l > SPARK_FIR_MAX_PARTITION)
+    l = SPARK_FIR_MAX_PARTITION;
+
+  *partition = l;
+  *method = desc->method;
+
+  if (*method == SPARK_FIR_DIRECT)
+    return SPARK_NOERROR;
+
+  if (l < FIR_MIN_PARTITION) {
+    if (*method != SPARK_FIR_AUTO)
+      return SPARK_ERR_INVALID_PARAM;
+    *method = SPARK_FIR_DIRECT;
+    return SPARK_NOERROR;
+  }
+
+  if (*method == SPARK_FIR_AUTO) {
+    const uint32_t lanes = spark_kernels()->f32_lanes;
+    fir_level_t levels[FIR_MAX_LEVELS];
+    double cost[2] = {0.0, 0.0};
+
+    for (int k = 0; k < 2; ++k) {
+      const uint32_t m = k ? SPARK_FIR_NONUNIFORM : SPARK_FIR_UNIFORM;
+      const uint32_t n = plan_levels(levels, m, desc->n_taps, l);
+      for (uint32_t j = 0; j < n; ++j)
+        cost[k] += level_cost(levels[j].size, levels[j].n_parts, lanes);
+    }
+
+    /* One multiply-add per tap, vectorized across outputs. */
+    const double direct = (double)desc->n_taps / lanes;
+
+    *method = SPARK_FIR_UNIFORM;
+    if (cost[1] < cost[0])
+      *method = SPARK_FIR_NONUNIFORM;
+    if (direct <= cost[*method == SPARK_FIR_NONUNIFORM])
+      *method = SPARK_FIR_DIRECT;
+  }
+
+  return SPARK_NOERROR;
+}
+
+/**
+ * @brief Arena bytes needed by spark_fir_f32_init() for @p desc.
+ *
+ * Depends on the shape, the tap count, the resolved method and (for
+ * ::SPARK_FIR_AUTO) the active dispatch level. Includes slack to align an
+ * arbitrary arena pointer.
+ *
+ * @param[in] desc Filter description.
+ * @return Arena size in bytes, or 0 if @p desc is invalid.
+ */
+size_t spark_fir_f32_size(const spark_fir_f32_t *desc)
+{
+  uint32_t method, partition;
+
+  if (fir_resolve(desc, &method, &partition) != SPARK_NOERROR)
+    return 0;
+
+  struct spark_fir_f32_state state;
+  return (SPARK_FIR_ALIGN - 1) + fir_layout(desc, method, partition, &state, NULL);
+}
+
+/**
+ * @brief Build a FIR engine for a fixed block shape.
+ *
+ * Picks the convolution method and copies (direct) or transforms (FFT
+ * methods) the taps into @p arena; @p desc is not referenced afterwards.
+ * The history starts at zero.
+ *
+ * ### Methods
+ * - ::SPARK_FIR_DIRECT: each output vector of VF32_LANES consecutive
+ *   samples is a run of multiply-adds over the taps, with the last
+ *   `n_taps - 1` inputs kept per channel. Best for short filters.
+ * - ::SPARK_FIR_UNIFORM: overlap-save with the response cut into
+ *   partitions of L samples, L the largest power of two dividing the block
+ *   (at most ::SPARK_FIR_MAX_PARTITION, at least 16); one 2L-point real FFT
+ *   in and one out per L samples, and one complex multiply-add per bin and
+ *   partition. Cost grows with `n_taps / L`.
+ * - ::SPARK_FIR_NONUNIFORM: two partitions of L, then single partitions of
+ *   2L, 4L, … for the tail and as many ::SPARK_FIR_MAX_PARTITION ones as
+ *   needed. Long tails cost a few large transforms instead of many spectral
+ *   products. Each level computes its outputs all at once when its period
+ *   comes round, so the work of a call is uneven: budget for the call in
+ *   which every level fires.
+ *
+ * ::SPARK_FIR_AUTO compares a flop estimate of the three for this tap count,
+ * block and vector width. Every method has zero latency and the same
+ * result up to rounding.
+ *
+ * @param[out] self Engine to initialize.
+ * @param[in] desc Shape, taps, ::spark_fir_flags and ::spark_fir_method.
+ * @param[in] arena Caller-owned memory of at least spark_fir_f32_size()
+ *                  bytes. Must outlive @p self.
+ * @param[in] arena_size Size of @p arena in bytes.
+ *
+ * @retval SPARK_NOERROR on success
+ * @retval SPARK_ERR_INVALID_PARAM for NULL arguments or taps, zero taps, an
+ *         unknown method, or an FFT method on a block with no power-of-two
+ *         divisor of at least 16
+ * @retval SPARK_ERR_INVALID_SIZE if @p arena is too small
+ * @return Otherwise the error from spark_block_validate().
+ */
+int spark_fir_f32_init(spark_fir_f32_engine_t *self, const spark_fir_f32_t *desc,
+                       void *arena, size_t arena_size)
+{
+  if (!self || !arena)
+    return SPARK_ERR_INVALID_PARAM;
+
+  uint32_t method, partition;
+  int status = fir_resolve(desc, &method, &partition);
+  if (status != SPARK_NOERROR)
+    return status;
+
+  struct spark_fir_f32_state layout;
+  if (arena_size < (SPARK_FIR_ALIGN - 1) + fir_layout(desc, method, partition, &layout, NULL))
+    return SPARK_ERR_INVALID_SIZE;
+
+  unsigned char *base = spark_align_ptr(arena, SPARK_FIR_ALIGN);
+  struct spark_fir_f32_state *state = (struct spark_fir_f32_state *)base;
+
+  fir_layout(desc, method, partition, state, base);
+
+  const bool interleaved =
+      (spark_buffer_get_layout(desc->header.input.flags) == SPARK_LAYOUT_INTERLEAVED);
+  const uint32_t n_chan = desc->header.input.channels;
+  const uint32_t block = desc->header.input.samples;
+  const uint32_t n_taps = desc->n_taps;
+
+  state->kernels = spark_kernels();
+  state->chan_stride = interleaved ? 1 : block;
+  state->sample_stride = interleaved ? n_chan : 1;
+
+  self->method = method;
+  self->n_chan = n_chan;
+  self->n_taps = n_taps;
+  self->block = block;
+  self->partition = (method == SPARK_FIR_DIRECT) ? 0 : partition;
+  self->state = state;
+
+  if (method == SPARK_FIR_DIRECT) {
+    for (uint32_t set = 0; set < state->n_sets; ++set) {
+      const float *h = desc->taps + (size_t)set * n_taps;
+      float *r = state->taps_rev + (size_t)set * n_taps;
+      for (uint32_t k = 0; k < n_taps; ++k)
+        r[k] = h[n_taps - 1 - k];
+    }
+  } else {
+    /* Partition spectra, scaled to undo the inverse transform's gain of 2M. */
+    for (uint32_t j = 0; j < state->n_levels; ++j) {
+      fir_level_t *level = &state->levels[j];
+      const uint32_t m = level->size;
+      const float scale = 0.5f / (float)m;
+
+      for (uint32_t set = 0; set < state->n_sets; ++set) {
+        const float *h = desc->taps + (size_t)set * n_taps;
+
+        for (uint32_t p = 0; p < level->n_parts; ++p) {
+          const size_t first = (size_t)(p + level->delay) * m;
+          float *spectrum =
+              level->taps + ((size_t)set * level->n_parts + p) * 2 * level->bins;
+
+          for (uint32_t k = 0; k < 2 * m; ++k) {
+            const size_t tap = first + k;
+            state->time[k] = (k < m && tap < n_taps) ? h[tap] * scale : 0.0f;
+          }
+
+          spark_fft_f32_forward(&level->fft, state->time, NULL, spectrum,
+                                spectrum + level->bins);
+        }
+      }
+    }
+  }
+
+  spark_fir_f32_reset(self);
+
+  return SPARK_NOERROR;
+}
+
+/**
+ * @brief Clear the history of an engine (silence before the next block).
+ *
+ * @param[in,out] self Engine.
+ */
+void spark_fir_f32_reset(spark_fir_f32_engine_t *self)
+{
+  assert(self && self->state);
+
+  struct spark_fir_f32_state *state = self->state;
+  const uint32_t n_chan = self->n_chan;
+
+  state->position = 0;
+
+  if (self->method == SPARK_FIR_DIRECT) {
+    memset(state->window, 0, sizeof(float) * n_chan * ((size_t)self->n_taps - 1 + self->block));
+    return;
+  }
+
+  memset(state->ring, 0, sizeof(float) * n_chan * 2 * state->ring_len);
+
+  for (uint32_t j = 0; j < state->n_levels; ++j) {
+    fir_level_t *level = &state->levels[j];
+    memset(level->fdl, 0, sizeof(float) * n_chan * level->n_parts * 2 * level->bins);
+    if (level->pending)
+      memset(level->pending, 0, sizeof(float) * n_chan * level->size);
+  }
+}
+
+static void fir_direct(spark_fir_f32_engine_t *self, const float *input, float *output)
+{
+  struct spark_fir_f32_state *state = self->state;
+  const size_t history = (size_t)self->n_taps - 1;
+  const size_t block = self->block;
+  const size_t step = state->sample_stride;
+
+  for (uint32_t chan = 0; chan < self->n_chan; ++chan) {
+    const float *x = input + chan * state->chan_stride;
+    float *y = output + chan * state->chan_stride;
+    float *window = state->window + chan * (history + block);
+    const float *h = state->taps_rev + (state->n_sets > 1 ? (size_t)chan * self->n_taps : 0);
+
+    for (size_t t = 0; t < block; ++t)
+      window[history + t] = x[t * step];
+
+    state->kernels->fir_f32_direct(state->out, window, h, self->n_taps, block);
+
+    for (size_t t = 0; t < block; ++t)
+      y[t * step] = state->out[t];
+
+    memmove(window, window + block, sizeof(float) * history);
+  }
+}
+
+/**
+ * @brief One level of one channel: transform its newest window if its period
+ * starts at @p t, then sum the FDL against the partitions into `state->time`.
+ *
+ * @return true if `state->time` holds new outputs in its upper half.
+ */
+static bool fir_level_run(struct spark_fir_f32_state *state, fir_level_t *level,
+                          uint32_t chan, uint64_t t, uint32_t partition)
+{
+  const uint32_t m = level->size;
+
+  /* The head level fires every sub-block and sees it; the others fire every M. */
+  if (level->delay && (t % m) != 0)
+    return false;
+
+  const uint64_t end = level->delay ? t : t + partition;
+  const uint64_t period = end / m;
+  const size_t spectrum = 2 * level->bins;
+  const uint32_t mask = state->ring_len - 1;
+  const float *ring = state->ring + (size_t)chan * 2 * state->ring_len;
+  float *fdl = level->fdl + (size_t)chan * level->n_parts * spectrum;
+  const float *taps =
+      level->taps + (state->n_sets > 1 ? (size_t)chan * level->n_parts * spectrum : 0);
+
+  /* The ring is stored twice, so any window up to ring_len is contiguous. */
+  const float *window = ring + ((end - 2 * (uint64_t)m) & mask);
+  float *newest = fdl + (size_t)(period % level->n_parts) * spectrum;
+
+  spark_fft_f32_forward(&level->fft, window, NULL, newest, newest + level->bins);
+
+  memset(state->acc, 0, sizeof(float) * spectrum);
+
+  for (uint32_t p = 0; p < level->n_parts; ++p) {
+    const uint64_t slot = (period + level->n_parts - p) % level->n_parts;
+    const float *x = fdl + (size_t)slot * spectrum;
+    const float *h = taps + (size_t)p * spectrum;
+
+    state->kernels->fir_f32_cmac(state->acc, state->acc + level->bins, x, x + level->bins,
+                                 h, h + level->bins, m + 1);
+  }
+
+  spark_fft_f32_inverse(&level->fft, state->acc, state->acc + level->bins, state->time,
+                        NULL);
+  return true;
+}
+
+static void fir_partitioned(spark_fir_f32_engine_t *self, const float *input,
+                            float *output)
+{
+  struct spark_fir_f32_state *state = self->state;
+  const uint32_t partition = self->partition;
+  const size_t step = state->sample_stride;
+  const uint32_t mask = state->ring_len - 1;
+
+  for (uint32_t offset = 0; offset < self->block; offset += partition) {
+    const uint64_t t = state->position;
+
+    for (uint32_t chan = 0; chan < self->n_chan; ++chan) {
+      const float *x = input + chan * state->chan_stride + offset * step;
+      float *y = output + chan * state->chan_stride + offset * step;
+      float *ring = state->ring + (size_t)chan * 2 * state->ring_len;
+
+      for (uint32_t k = 0; k < partition; ++k) {
+        const uint32_t at = (uint32_t)((t + k) & mask);
+        ring[at] = ring[at + state->ring_len] = x[k * step];
+      }
+
+      /* Tail levels first: their outputs for this sub-block may be new. */
+      for (uint32_t j = 1; j < state->n_levels; ++j) {
+        fir_level_t *level = &state->levels[j];
+        if (fir_level_run(state, level, chan, t, partition))
+          memcpy(level->pending + (size_t)chan * level->size, state->time + level->size,
+                 sizeof(float) * level->size);
+      }
+
+      fir_level_run(state, &state->levels[0], chan, t, partition);
+
+      /* The sub-block lies inside one period of every tail level. */
+      float *head = state->time + partition;
+
+      for (uint32_t j = 1; j < state->n_levels; ++j) {
+        const fir_level_t *level = &state->levels[j];
+        const float *p = level->pending + (size_t)chan * level->size + t % level->size;
+        for (uint32_t k = 0; k < partition; ++k)
+          head[k] += p[k];
+      }
+
+      for (uint32_t k = 0; k < partition; ++k)
+        y[k * step] = head[k];
+    }
+
+    state->position += partition;
+  }
+}
+
+/**
+ * @brief Filter one block.
+ *
+ * @p input and @p output must have the shape given at init and may be the
+ * same buffer. Safe for real-time use: no allocation and no locks.
+ *
+ * @param[in,out] self Engine from spark_fir_f32_init().
+ * @param[in] input Input samples in the initialized layout.
+ * @param[out] output Output samples in the initialized layout.
+ */
+void spark_fir_f32_execute(spark_fir_f32_engine_t *self, const float *input, float *output)
+{
+  assert(self && self->state && input && output);
+  SPARK_STATS_BEGIN();
+
+  if (self->method == SPARK_FIR_DIRECT)
+    fir_direct(self, input, output);
+  else
+    fir_partitioned(self, input, output);
+
+  SPARK_STATS_END(SPARK_STATS_FIR_F32, (uint64_t)self->n_chan * self->block);
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "fir-filter/fir_kernels.h"
+#include "simd/simd_f32.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Four output vectors are in flight at once so the FMA chains of the tap
+ * loop overlap; each tap is one broadcast and four unaligned loads.
+ */
+void SPARK_ISA_FN(fir_f32_direct)(float *y, const float *x, const float *h_rev,
+                                  size_t n_taps, size_t n_out)
+{
+  size_t t = 0;
+
+  for (; t + 4 * VF32_LANES <= n_out; t += 4 * VF32_LANES) {
+    vf32_t acc0 = vf32_zero(), acc1 = vf32_zero();
+    vf32_t acc2 = vf32_zero(), acc3 = vf32_zero();
+    const float *p = x + t;
+
+    for (size_t j = 0; j < n_taps; ++j, ++p) {
+      const vf32_t h = vf32_set1(h_rev[j]);
+      acc0 = vf32_fmadd(h, vf32_load(p), acc0);
+      acc1 = vf32_fmadd(h, vf32_load(p + VF32_LANES), acc1);
+      acc2 = vf32_fmadd(h, vf32_load(p + 2 * VF32_LANES), acc2);
+      acc3 = vf32_fmadd(h, vf32_load(p + 3 * VF32_LANES), acc3);
+    }
+
+    vf32_store(y + t, acc0);
+    vf32_store(y + t + VF32_LANES, acc1);
+    vf32_store(y + t + 2 * VF32_LANES, acc2);
+    vf32_store(y + t + 3 * VF32_LANES, acc3);
+  }
+
+  for (; t + VF32_LANES <= n_out; t += VF32_LANES) {
+    vf32_t acc = vf32_zero();
+
+    for (size_t j = 0; j < n_taps; ++j)
+      acc = vf32_fmadd(vf32_set1(h_rev[j]), vf32_load(x + t + j), acc);
+
+    vf32_store(y + t, acc);
+  }
+
+  for (; t < n_out; ++t) {
+    float acc = 0.0f;
+
+    for (size_t j = 0; j < n_taps; ++j)
+      acc += h_rev[j] * x[t + j];
+
+    y[t] = acc;
+  }
+}
+
+void SPARK_ISA_FN(fir_f32_cmac)(float *acc_re, float *acc_im, const float *x_re,
+                                const float *x_im, const float *h_re, const float *h_im,
+                                size_t n)
+{
+  size_t k = 0;
+
+  for (; k + VF32_LANES <= n; k += VF32_LANES) {
+    const vf32_t xr = vf32_load(x_re + k), xi = vf32_load(x_im + k);
+    const vf32_t hr = vf32_load(h_re + k), hi = vf32_load(h_im + k);
+    vf32_t ar = vf32_load(acc_re + k), ai = vf32_load(acc_im + k);
+
+    ar = vf32_fmadd(xr, hr, ar);
+    ar = vf32_sub(ar, vf32_mul(xi, hi));
+    ai = vf32_fmadd(xr, hi, ai);
+    ai = vf32_fmadd(xi, hr, ai);
+
+    vf32_store(acc_re + k, ar);
+    vf32_store(acc_im + k, ai);
+  }
+
+  for (; k < n; ++k) {
+    acc_re[k] += x_re[k] * h_re[k] - x_im[k] * h_im[k];
+    acc_im[k] += x_re[k] * h_im[k] + x_im[k] * h_re[k];
+  }
+}
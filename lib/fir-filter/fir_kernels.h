@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Internal kernel interface for the FIR engine. Not installed.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_FIR_KERNELS_H_
+#define LIBSPARK_FIR_KERNELS_H_
+
+#include "dispatch/isa.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef SPARK_ISA
+/**
+ * @brief Direct-form FIR over a contiguous window.
+ *
+ * `y[t] = sum_j h_rev[j] * x[t + j]` for t < @p n_out: @p x holds the
+ * `n_taps - 1` samples of history followed by the block, and @p h_rev the
+ * taps in reverse order, so every output vector is a run of unaligned loads.
+ *
+ * @param[out] y      @p n_out outputs.
+ * @param[in] x       `n_out + n_taps - 1` samples.
+ * @param[in] h_rev   @p n_taps reversed taps.
+ * @param[in] n_taps  Number of taps.
+ * @param[in] n_out   Number of outputs.
+ */
+void SPARK_ISA_FN(fir_f32_direct)(float *y, const float *x, const float *h_rev,
+                                  size_t n_taps, size_t n_out);
+
+/**
+ * @brief Planar complex multiply-accumulate: `acc += x * h` over @p n bins.
+ */
+void SPARK_ISA_FN(fir_f32_cmac)(float *acc_re, float *acc_im, const float *x_re,
+                                const float *x_im, const float *h_re, const float *h_im,
+                                size_t n);
+#endif
+
+#endif /* LIBSPARK_FIR_KERNELS_H_ */
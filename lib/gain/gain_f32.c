@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "spark/gain.h"
+#include "dispatch/kernels.h"
+#include "stats/stats_internal.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief spark_gain_f32() accepts F32 buffers in any layout.
+ */
+#define GAIN_F32_FLAGS (SPARK_FMT_F32 | SPARK_BLOCK_PROCESS)
+
+/**
+ * @brief Strided channels that are neither contiguous nor adjacent: scalar loop.
+ */
+static void gain_f32_strided(const spark_block_t *header, float g0, float dg, bool mix)
+{
+  const spark_buffer_t *in = &header->input;
+  const size_t sample_stride = in->sample_stride;
+
+  for (uint32_t chan = 0; chan < in->channels; ++chan) {
+    const size_t at = (size_t)chan * in->channel_stride;
+    const float *src = (const float *)header->input.base + at;
+    float *dst = (float *)header->output.base + at;
+
+    for (size_t t = 0; t < in->samples; ++t) {
+      const float g = g0 + dg * (float)(t + 1);
+      const float y = g * src[t * sample_stride];
+      dst[t * sample_stride] = mix ? dst[t * sample_stride] + y : y;
+    }
+  }
+}
+
+/**
+ * @brief Apply a gain or gain ramp to a block, or mix it into the output.
+ *
+ * Multiplies every sample by the block's gain (see ::spark_gain_f32_t for
+ * the ramp) and stores the result, or adds it to the output with
+ * @ref SPARK_GAIN_MIX, which turns a chain of calls over one output buffer
+ * into a mixer.
+ *
+ * ### Layouts
+ * Interleaved and planar buffers run on the SIMD kernel as contiguous
+ * arrays; a flat gain treats the whole block as one array whatever its
+ * layout. Host channel arrays (@ref SPARK_LAYOUT_PLANAR_PTR) are processed
+ * plane by plane, and strided buffers with contiguous or adjacent channels
+ * like planar or interleaved ones. Only other strides take a scalar loop.
+ *
+ * Input and output may be the same buffer; with @ref SPARK_GAIN_MIX that
+ * adds the scaled block to itself.
+ *
+ * @param[in,out] self Pointer to instance
+ */
+void spark_gain_f32(spark_gain_f32_t *self)
+{
+  assert(self);
+
+  const spark_buffer_t *in = &self->header.input;
+  const uint32_t layout = spark_buffer_get_layout(in->flags);
+  const bool known =
+      (layout == SPARK_LAYOUT_INTERLEAVED || layout == SPARK_LAYOUT_PLANAR ||
+       layout == SPARK_LAYOUT_PLANAR_PTR || layout == SPARK_LAYOUT_STRIDED);
+
+  int status = spark_block_validate(
+      &self->header, GAIN_F32_FLAGS | (known ? layout : SPARK_LAYOUT_PLANAR));
+
+  assert(status == SPARK_NOERROR);
+
+  if (status != SPARK_NOERROR) {
+    return;
+  }
+
+  const spark_kernels_t *kernels = spark_kernels();
+  const uint32_t n_chan = in->channels;
+  const size_t n_samples = in->samples;
+  const float g0 = self->gain;
+  const float dg = (self->target - g0) / (float)n_samples;
+  const bool mix = (self->flags & SPARK_GAIN_MIX);
+  const float *input = self->header.input.base;
+  float *output = self->header.output.base;
+
+  SPARK_STATS_BEGIN();
+
+  /* Strided buffers whose channels are planes or frames run like those layouts. */
+  uint32_t run = layout;
+  if (layout == SPARK_LAYOUT_STRIDED) {
+    if (in->sample_stride == 1)
+      run = SPARK_LAYOUT_PLANAR;
+    else if (in->channel_stride == 1 && in->sample_stride == n_chan)
+      run = SPARK_LAYOUT_INTERLEAVED;
+  }
+  const size_t chan_stride =
+      (layout == SPARK_LAYOUT_STRIDED) ? in->channel_stride : n_samples;
+
+  if (run == SPARK_LAYOUT_INTERLEAVED ||
+      (run == SPARK_LAYOUT_PLANAR && dg == 0.0f && chan_stride == n_samples)) {
+    kernels->gain_f32(output, input, n_samples, n_chan, g0, dg, mix);
+  } else if (run == SPARK_LAYOUT_PLANAR) {
+    for (uint32_t chan = 0; chan < n_chan; ++chan)
+      kernels->gain_f32(output + chan * chan_stride, input + chan * chan_stride,
+                        n_samples, 1, g0, dg, mix);
+  } else if (run == SPARK_LAYOUT_PLANAR_PTR) {
+    const float *const *src = self->header.input.base;
+    float *const *dst = self->header.output.base;
+    for (uint32_t chan = 0; chan < n_chan; ++chan)
+      kernels->gain_f32(dst[chan], src[chan], n_samples, 1, g0, dg, mix);
+  } else {
+    gain_f32_strided(&self->header, g0, dg, mix);
+  }
+
+  SPARK_STATS_END(SPARK_STATS_GAIN_F32, (uint64_t)n_chan * n_samples);
+
+  self->gain = self->target;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "gain/gain_kernels.h"
+#include "simd/simd_f32.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** One output vector: `g * x`, or `dst + g * x` when mixing. */
+static SPARK_FORCE_INLINE void gain_vec(float *dst, const float *src, vf32_t g,
+                                        const bool mix)
+{
+  const vf32_t x = vf32_load(src);
+  vf32_store(dst, mix ? vf32_fmadd(g, x, vf32_load(dst)) : vf32_mul(g, x));
+}
+
+/** Scalar frame of @p n_chan samples at gain @p g. */
+static SPARK_FORCE_INLINE void gain_frame(float *dst, const float *src, uint32_t n_chan,
+                                          float g, const bool mix)
+{
+  for (uint32_t c = 0; c < n_chan; ++c)
+    dst[c] = mix ? dst[c] + g * src[c] : g * src[c];
+}
+
+/**
+ * Body of gain_f32(), specialized on @p mix by the two calls below.
+ *
+ * A flat gain runs over the frames as one contiguous array. A ramp needs
+ * the gain of each sample's frame: wide frames broadcast it once per frame,
+ * and frames narrower than a vector fill every lane instead, `VF32_LANES`
+ * frames forming `n_chan` vectors whose per-lane frame offsets are fixed
+ * and precomputed.
+ */
+static SPARK_FORCE_INLINE void gain_run(float *dst, const float *src, size_t n_frames,
+                                        uint32_t n_chan, float g0, float dg,
+                                        const bool mix)
+{
+  size_t t = 0;
+
+  if (dg == 0.0f) {
+    const size_t n = n_frames * n_chan;
+    const vf32_t g = vf32_set1(g0);
+    size_t i = 0;
+
+    for (; i + VF32_LANES <= n; i += VF32_LANES)
+      gain_vec(dst + i, src + i, g, mix);
+    gain_frame(dst + i, src + i, (uint32_t)(n - i), g0, mix);
+    return;
+  }
+
+  if (n_chan < VF32_LANES) {
+    vf32_t ramp[VF32_LANES];
+
+    for (uint32_t k = 0; k < n_chan; ++k) {
+      SPARK_ALIGNED(SPARK_SIMD_ALIGN) float lanes[VF32_LANES];
+      for (uint32_t l = 0; l < VF32_LANES; ++l)
+        lanes[l] = dg * (float)((k * VF32_LANES + l) / n_chan);
+      ramp[k] = vf32_load(lanes);
+    }
+
+    for (; t + VF32_LANES <= n_frames; t += VF32_LANES) {
+      const vf32_t base = vf32_set1(g0 + dg * (float)(t + 1));
+      const size_t at = t * n_chan;
+
+      for (uint32_t k = 0; k < n_chan; ++k)
+        gain_vec(dst + at + k * VF32_LANES, src + at + k * VF32_LANES,
+                 vf32_add(base, ramp[k]), mix);
+    }
+  }
+
+  for (; t < n_frames; ++t) {
+    const float g = g0 + dg * (float)(t + 1);
+    float *d = dst + t * n_chan;
+    const float *s = src + t * n_chan;
+    uint32_t c = 0;
+
+    for (; c + VF32_LANES <= n_chan; c += VF32_LANES)
+      gain_vec(d + c, s + c, vf32_set1(g), mix);
+    gain_frame(d + c, s + c, n_chan - c, g, mix);
+  }
+}
+
+void SPARK_ISA_FN(gain_f32)(float *dst, const float *src, size_t n_frames,
+                            uint32_t n_chan, float g0, float dg, bool mix)
+{
+  if (mix)
+    gain_run(dst, src, n_frames, n_chan, g0, dg, true);
+  else
+    gain_run(dst, src, n_frames, n_chan, g0, dg, false);
+}
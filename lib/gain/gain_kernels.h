@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Internal kernel interface for gain, ramps and mix-add. Not installed.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_GAIN_KERNELS_H_
+#define LIBSPARK_GAIN_KERNELS_H_
+
+#include "dispatch/isa.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef SPARK_ISA
+/**
+ * @brief Scale @p n_frames contiguous frames of @p n_chan samples.
+ *
+ * Frame t is multiplied by `g0 + dg * (t + 1)`: a flat gain when @p dg is
+ * 0, a linear ramp otherwise. A planar channel is one run with @p n_chan 1.
+ *
+ * @param[in,out] dst  `n_frames * n_chan` output samples; may equal @p src.
+ *                     Read as well when @p mix is set.
+ * @param[in] src      `n_frames * n_chan` input samples.
+ * @param[in] n_frames Number of frames.
+ * @param[in] n_chan   Samples per frame.
+ * @param[in] g0       Gain before the first frame.
+ * @param[in] dg       Gain increment per frame.
+ * @param[in] mix      Add the scaled samples to @p dst instead of storing them.
+ */
+void SPARK_ISA_FN(gain_f32)(float *dst, const float *src, size_t n_frames,
+                            uint32_t n_chan, float g0, float dg, bool mix);
+#endif
+
+#endif /* LIBSPARK_GAIN_KERNELS_H_ */
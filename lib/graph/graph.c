@@ -0,0 +1,375 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "spark/graph.h"
+#include "memory/memory_internal.h"
+#include "stats/stats_internal.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Buffers a node can be bound to. */
+enum graph_slot {
+  GRAPH_SLOT_INPUT = 0,  /**< header.input of the graph (never written). */
+  GRAPH_SLOT_OUTPUT = 1, /**< header.output of the graph. */
+  GRAPH_SLOT_SCRATCH_A = 2,
+  GRAPH_SLOT_SCRATCH_B = 3,
+};
+
+static inline size_t buffer_bytes(const spark_buffer_t *buf)
+{
+  return (size_t)buf->channels * buf->samples * spark_buffer_bytes_per_sample(buf);
+}
+
+static inline bool buffer_is_shaped(const spark_buffer_t *buf)
+{
+  return buf->channels > 0 && buf->samples > 0 && spark_buffer_bytes_per_sample(buf) > 0;
+}
+
+/**
+ * @brief True for the layouts whose base is one flat sample buffer of
+ * buffer_bytes(): the only ones graph scratch (or the graph output, reused
+ * as scratch) can hold.
+ */
+static inline bool buffer_is_flat(const spark_buffer_t *buf)
+{
+  const uint32_t layout = spark_buffer_get_layout(buf->flags);
+  return layout == SPARK_LAYOUT_INTERLEAVED || layout == SPARK_LAYOUT_PLANAR;
+}
+
+static inline spark_block_t *node_header(const spark_graph_node_t *node)
+{
+  return (spark_block_t *)node->block;
+}
+
+static int check_header(const spark_block_t *header)
+{
+  if (header->struct_size < sizeof(spark_block_t))
+    return SPARK_ERR_INVALID_SIZE;
+
+  if (header->abi_version != SPARK_ABI_VERSION)
+    return SPARK_ERR_INVALID_ABI;
+
+  return SPARK_NOERROR;
+}
+
+/**
+ * @brief Check every node and that consecutive nodes agree on their buffers.
+ */
+static int graph_validate(const spark_graph_t *self)
+{
+  int status = check_header(&self->header);
+  if (status != SPARK_NOERROR)
+    return status;
+
+  if (!self->nodes || self->n_nodes == 0)
+    return SPARK_ERR_INVALID_PARAM;
+
+  for (uint32_t k = 0; k < self->n_nodes; ++k) {
+    const spark_graph_node_t *node = &self->nodes[k];
+    if (!node->block || !node->run)
+      return SPARK_ERR_INVALID_PARAM;
+
+    const spark_block_t *h = node_header(node);
+    status = check_header(h);
+    if (status != SPARK_NOERROR)
+      return status;
+
+    if (!buffer_is_shaped(&h->input))
+      return SPARK_ERR_INVALID_INPUT;
+
+    if (!buffer_is_shaped(&h->output))
+      return SPARK_ERR_INVALID_OUTPUT;
+
+    if (k > 0 && !spark_buffer_is_similar(&node_header(node - 1)->output, &h->input))
+      return SPARK_ERR_INVALID_BLOCK;
+
+    /* Internal edges live in scratch: plane pointers and strides have no place there. */
+    if (k > 0 && !buffer_is_flat(&h->input))
+      return SPARK_ERR_INVALID_BLOCK;
+  }
+
+  if (!spark_buffer_is_similar(&self->header.input, &node_header(&self->nodes[0])->input))
+    return SPARK_ERR_INVALID_INPUT;
+
+  const spark_graph_node_t *last = &self->nodes[self->n_nodes - 1];
+  if (!spark_buffer_is_similar(&self->header.output, &node_header(last)->output))
+    return SPARK_ERR_INVALID_OUTPUT;
+
+  return SPARK_NOERROR;
+}
+
+/**
+ * @brief Assign a buffer slot to every edge, walking back from the output.
+ *
+ * The edge into node `k` reuses node `k`'s output slot when the node runs in
+ * place. Otherwise it goes to the graph output if that is free and large
+ * enough, or else to whichever scratch buffer node `k` is not writing. At most
+ * two scratch buffers are ever live, sized for the largest edge each carries.
+ *
+ * Only an interleaved or planar graph output is reused this way: a
+ * @ref SPARK_LAYOUT_PLANAR_PTR base is the caller's pointer array, and a
+ * @ref SPARK_LAYOUT_STRIDED one need not span `channels * samples` samples.
+ */
+static void graph_plan(spark_graph_t *self, size_t *need_a, size_t *need_b)
+{
+  const size_t out_cap =
+      buffer_is_flat(&self->header.output) ? buffer_bytes(&self->header.output) : 0;
+  uint32_t next = GRAPH_SLOT_OUTPUT;
+
+  *need_a = 0;
+  *need_b = 0;
+
+  for (uint32_t k = self->n_nodes; k-- > 0;) {
+    spark_graph_node_t *node = &self->nodes[k];
+    const size_t bytes = buffer_bytes(&node_header(node)->input);
+    uint32_t slot;
+
+    node->out_slot = next;
+
+    if (k == 0)
+      slot = GRAPH_SLOT_INPUT;
+    else if ((node->flags & SPARK_GRAPH_NODE_INPLACE) &&
+             (next != GRAPH_SLOT_OUTPUT || bytes <= out_cap))
+      slot = next;
+    else if (next != GRAPH_SLOT_OUTPUT && bytes <= out_cap)
+      slot = GRAPH_SLOT_OUTPUT;
+    else
+      slot = (next == GRAPH_SLOT_SCRATCH_A) ? GRAPH_SLOT_SCRATCH_B : GRAPH_SLOT_SCRATCH_A;
+
+    if (slot == GRAPH_SLOT_SCRATCH_A && bytes > *need_a)
+      *need_a = bytes;
+    else if (slot == GRAPH_SLOT_SCRATCH_B && bytes > *need_b)
+      *need_b = bytes;
+
+    node->in_slot = slot;
+    next = slot;
+  }
+}
+
+static inline void *slot_base(const spark_graph_t *self, uint32_t slot)
+{
+  unsigned char *scratch = (unsigned char *)self->scratch;
+
+  switch (slot) {
+  case GRAPH_SLOT_INPUT:
+    return self->header.input.base;
+  case GRAPH_SLOT_OUTPUT:
+    return self->header.output.base;
+  case GRAPH_SLOT_SCRATCH_A:
+    return scratch;
+  default:
+    return scratch + self->scratch_offset_b;
+  }
+}
+
+/**
+ * @brief Validate a chain of blocks and plan its buffers.
+ *
+ * All validation happens here, once: node headers, chaining (each node's
+ * output must be similar to the next node's input), and the graph's own
+ * input/output. Then each edge is given a buffer (see the plan rules above)
+ * and scratch bases are written into the node headers.
+ *
+ * Call with `scratch == NULL` and `scratch_size == 0` to only plan: on
+ * success @ref spark_graph_t::scratch_size holds the bytes required. Then
+ * call again with at least that much memory, aligned to
+ * ::SPARK_GRAPH_ALIGN. A plan that needs no scratch is ready after the first
+ * call.
+ *
+ * @param[in,out] self Pointer to instance
+ * @param[in] scratch Caller-owned scratch memory, or NULL to query.
+ * @param[in] scratch_size Size of @p scratch in bytes.
+ *
+ * @retval SPARK_NOERROR on success
+ * @retval SPARK_ERR_INVALID_PARAM for NULL pointers, an empty chain, or
+ *         misaligned scratch
+ * @retval SPARK_ERR_INVALID_SIZE if @p scratch is smaller than required, or
+ *         a header's `struct_size` is too small
+ * @retval SPARK_ERR_INVALID_ABI on an `abi_version` mismatch
+ * @retval SPARK_ERR_INVALID_INPUT / SPARK_ERR_INVALID_OUTPUT for unshaped
+ *         buffers or a graph input/output that does not match the chain ends
+ * @retval SPARK_ERR_INVALID_BLOCK if two consecutive nodes do not chain, or
+ *         chain through a buffer that is not interleaved or planar
+ */
+int spark_graph_init(spark_graph_t *self, void *scratch, size_t scratch_size)
+{
+  if (!self)
+    return SPARK_ERR_INVALID_PARAM;
+
+  self->scratch = NULL;
+  self->scratch_size = 0;
+  self->scratch_offset_b = 0;
+
+  int status = graph_validate(self);
+  if (status != SPARK_NOERROR)
+    return status;
+
+  size_t need_a, need_b;
+  graph_plan(self, &need_a, &need_b);
+
+  self->scratch_offset_b = spark_align_up(need_a, SPARK_GRAPH_ALIGN);
+  self->scratch_size = (need_b > 0) ? self->scratch_offset_b + need_b : need_a;
+
+  if (!scratch && scratch_size == 0)
+    return SPARK_NOERROR;
+
+  if (!scratch || ((uintptr_t)scratch & (SPARK_GRAPH_ALIGN - 1)) != 0)
+    return SPARK_ERR_INVALID_PARAM;
+
+  if (scratch_size < self->scratch_size)
+    return SPARK_ERR_INVALID_SIZE;
+
+  self->scratch = scratch;
+
+  for (uint32_t k = 0; k < self->n_nodes; ++k) {
+    spark_block_t *h = node_header(&self->nodes[k]);
+    h->input.base = slot_base(self, self->nodes[k].in_slot);
+    h->output.base = slot_base(self, self->nodes[k].out_slot);
+  }
+
+  return SPARK_NOERROR;
+}
+
+/**
+ * @brief Run every node of a planned graph, in order.
+ *
+ * Only the current `header.input.base` / `header.output.base` are bound into
+ * the first and last nodes (and any node planned onto the graph output);
+ * nothing is validated or allocated. The graph input is never written.
+ *
+ * ### Constraints
+ * - ::spark_graph_init must have succeeded with enough scratch.
+ * - Graph input and output must not overlap.
+ *
+ * @param[in,out] self Pointer to instance
+ */
+void spark_graph_run(spark_graph_t *self)
+{
+  assert(self);
+  assert(self->scratch || self->scratch_size == 0);
+  assert(self->header.input.base && self->header.output.base);
+  SPARK_STATS_BEGIN();
+
+  for (uint32_t k = 0; k < self->n_nodes; ++k) {
+    spark_graph_node_t *node = &self->nodes[k];
+    spark_block_t *h = node_header(node);
+    h->input.base = slot_base(self, node->in_slot);
+    h->output.base = slot_base(self, node->out_slot);
+    node->run(node->block);
+  }
+
+  SPARK_STATS_END(SPARK_STATS_GRAPH,
+                  (size_t)self->header.input.channels * self->header.input.samples);
+}
+
+static void graph_run_sosfilt_f32(void *block)
+{
+  spark_sosfilt_f32((spark_sosfilt_f32_t *)block);
+}
+
+static void graph_run_sosfilt_f64(void *block)
+{
+  spark_sosfilt_f64((spark_sosfilt_f64_t *)block);
+}
+
+static void graph_run_convert(void *block)
+{
+  spark_convert((spark_convert_t *)block);
+}
+
+static void graph_run_gain_f32(void *block)
+{
+  spark_gain_f32((spark_gain_f32_t *)block);
+}
+
+/**
+ * @brief Describe a ::spark_sosfilt_f32_t as an in-place graph node.
+ *
+ * @param[in] block Filter to run; its header gives the node's shape.
+ * @return The node, ready to be placed in ::spark_graph_t::nodes.
+ */
+spark_graph_node_t spark_graph_node_sosfilt_f32(spark_sosfilt_f32_t *block)
+{
+  spark_graph_node_t node = {block, graph_run_sosfilt_f32, SPARK_GRAPH_NODE_INPLACE, 0, 0};
+  return node;
+}
+
+/**
+ * @brief Describe a ::spark_sosfilt_f64_t as an in-place graph node.
+ *
+ * @param[in] block Filter to run; its header gives the node's shape.
+ * @return The node, ready to be placed in ::spark_graph_t::nodes.
+ */
+spark_graph_node_t spark_graph_node_sosfilt_f64(spark_sosfilt_f64_t *block)
+{
+  spark_graph_node_t node = {block, graph_run_sosfilt_f64, SPARK_GRAPH_NODE_INPLACE, 0, 0};
+  return node;
+}
+
+/**
+ * @brief Describe a ::spark_convert_t as a graph node.
+ *
+ * The node runs in place when ::spark_convert allows it: same layout (or a
+ * single channel) and the same sample size on both sides.
+ *
+ * @param[in] block Conversion to run; its header gives the node's shape.
+ * @return The node, ready to be placed in ::spark_graph_t::nodes.
+ */
+spark_graph_node_t spark_graph_node_convert(spark_convert_t *block)
+{
+  const spark_buffer_t *in = &block->header.input;
+  const spark_buffer_t *out = &block->header.output;
+  const bool same_layout = spark_buffer_get_layout(in->flags) ==
+                               spark_buffer_get_layout(out->flags) ||
+                           in->channels == 1;
+  const bool same_size = spark_buffer_bytes_per_sample(in) ==
+                         spark_buffer_bytes_per_sample(out);
+
+  spark_graph_node_t node = {block, graph_run_convert,
+                             (same_layout && same_size) ? SPARK_GRAPH_NODE_INPLACE
+                                                        : SPARK_GRAPH_NODE_DEFAULT,
+                             0, 0};
+  return node;
+}
+
+/**
+ * @brief Describe a ::spark_gain_f32_t as an in-place graph node.
+ *
+ * A ::SPARK_GAIN_MIX gain adds into its output, which a graph may plan as
+ * scratch holding stale data; use mixing gains outside graphs.
+ *
+ * @param[in] block Gain to run; its header gives the node's shape.
+ * @return The node, ready to be placed in ::spark_graph_t::nodes.
+ */
+spark_graph_node_t spark_graph_node_gain_f32(spark_gain_f32_t *block)
+{
+  assert(!(block->flags & SPARK_GAIN_MIX));
+
+  spark_graph_node_t node = {block, graph_run_gain_f32, SPARK_GRAPH_NODE_INPLACE, 0, 0};
+  return node;
+}
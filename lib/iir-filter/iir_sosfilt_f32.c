@@ -24,18 +24,51 @@
  */
 
 #include "spark/iir_filter.h"
+#include "denormal/denormal_internal.h"
+#include "dispatch/kernels.h"
+#include "stats/stats_internal.h"
 
 #include <assert.h>
 #include <stdbool.h>
 #include <stddef.h>
 
 static void biquad_process_f32(const float coeff[5], float state[2], float *output,
-                               const float *input, size_t samples);
+                               const float *input, size_t samples, size_t stride);
+static void biquad_ramp_f32(const float coeff[5], const float target[5], float state[2],
+                            float *output, const float *input, size_t samples,
+                            size_t stride, size_t left, float inv_n);
+/**
+ * @brief Buffers and sample range of one execute call.
+ */
+typedef struct sosfilt_f32_io {
+  const float *input;               /**< Single-buffer input, or NULL for planes. */
+  float *output;                    /**< Single-buffer output, or NULL for planes. */
+  const float *const *input_planes; /**< PLANAR_PTR input channels, or NULL. */
+  float *const *output_planes;      /**< PLANAR_PTR output channels, or NULL. */
+  uint32_t first;                   /**< First sample of the run in each channel. */
+  uint32_t count;                   /**< Samples per channel in the run. */
+} sosfilt_f32_io_t;
+
+static void sosfilt_f32_run(const spark_sosfilt_f32_plan_t *plan, const float *target,
+                            const sosfilt_f32_io_t *io);
+static void sosfilt_f32_cascade(const spark_sosfilt_f32_plan_t *plan, const float *target,
+                                const sosfilt_f32_io_t *io);
+static sosfilt_f32_io_t sosfilt_f32_block_io(const spark_sosfilt_f32_plan_t *plan,
+                                             const spark_block_t *header);
+static void sosfilt_f32_flush(const spark_sosfilt_f32_plan_t *plan);
+
+/**
+ * @brief spark_sosfilt_f32() accepts F32 buffers in any layout.
+ */
+#define SOSFILT_F32_FLAGS (SPARK_FMT_F32 | SPARK_BLOCK_PROCESS)
 
 /**
- * @brief spark_sosfilt_f32() only supports planar memory layout
+ * @brief Samples per channel carried through every stage before moving on.
+ *
+ * 256 floats (1 KiB) of input and output stay in L1 across the whole cascade,
+ * so long blocks are not streamed through the cache once per stage.
  */
-#define SOSFILT_F32_FLAGS (SPARK_FMT_F32 | SPARK_LAYOUT_PLANAR | SPARK_BLOCK_PROCESS)
+#define SOSFILT_F32_TILE 256
 
 /**
  * @brief Cascade of biquad (SOS) filters, single-precision, mono.
@@ -85,9 +118,53 @@ static void biquad_process_f32(const float coeff[5], float state[2], float *outp
  * - Stage 0 reads @p input and writes @p output.
  * - For k>0, stage k reads from @p output of the previous stage
  *   (in-place cascade).
+ * - Stages are fused over cache-sized tiles: each tile of a channel runs
+ *   through the whole cascade while it is in L1, so the buffer is read and
+ *   written once per call whatever the number of stages.
+ *
+ * ### Layouts
+ * Buffers are filtered in their native layout, whichever it is; input and
+ * output must use the same one (and, for @ref SPARK_LAYOUT_STRIDED, the same
+ * strides). Interleaved frames, and any strided buffer whose channels are
+ * adjacent, are loaded straight into a vector (one channel per lane) in
+ * either coefficient mode, so no deinterleave round trip is needed. Host
+ * channel arrays (@ref SPARK_LAYOUT_PLANAR_PTR) are read and written through
+ * their plane pointers, so no packing copy is needed either.
+ *
+ * ### Shared coefficients
+ * With @ref SPARK_SOSFILT_SHARE_SOS, channels are filtered in groups of one
+ * SIMD vector (4/8/16 channels on SSE/AVX/AVX-512 and NEON), one channel per
+ * lane, so each step of the recursion serves the whole group. The level is
+ * picked at runtime (see spark/dispatch.h). Results match the per-channel
+ * path up to floating-point contraction.
+ *
+ * ### Fixed shapes
+ * Cascades of 1, 2 or 4 stages over 1, 2 or 8 channels run on kernels
+ * specialized for that shape, which hold every coefficient and state in
+ * registers and advance all stages per sample, in any layout and coefficient
+ * mode. Other shapes, and coefficient ramps, use the generic kernels.
+ *
+ * ### Denormals
+ * Fed silence, a section's state decays geometrically towards zero and ends
+ * up subnormal, where x86 arithmetic runs 10-100x slower. Two flags guard
+ * against it, alone or together: @ref SPARK_SOSFILT_FTZ runs the call in
+ * flush-to-zero mode, and @ref SPARK_SOSFILT_FLUSH_DENORMALS zeroes tiny
+ * states at the end of each block (counted by spark_denormal_count()).
+ *
+ * ### Prepared execution
+ * This function validates and resolves the dispatch target on every call.
+ * When the block shape is fixed, call spark_sosfilt_f32_prepare() once and
+ * spark_sosfilt_f32_execute() (or spark_sosfilt_f32_execute_planes() for
+ * plane pointers) per block instead. To act on events inside a block, run
+ * it in segments with spark_sosfilt_f32_execute_range(), reusing the plan.
+ * For many small filters (one per voice, say) spark_sosfilt_f32_batch_init()
+ * validates them all once and runs them together, lanes packed across
+ * filters.
  *
  * @note Thread safety: @p state belongs to this filter instance; do not share
- * it across threads or filter chains without external synchronization.
+ * it across threads or filter chains without external synchronization. To
+ * update coefficients from another thread, feed them through a
+ * ::spark_sosfilt_f32_slot_t instead of swapping the pointer under a lock.
  *
  * @note Feedback coefficients (a1, a2) are assumed to be negative.
  *
@@ -96,7 +173,8 @@ static void biquad_process_f32(const float coeff[5], float state[2], float *outp
 void spark_sosfilt_f32(spark_sosfilt_f32_t *self)
 {
   assert(self);
-  int status = spark_block_validate(self, SOSFILT_F32_FLAGS);
+  spark_sosfilt_f32_plan_t plan;
+  int status = spark_sosfilt_f32_prepare(self, &plan);
 
   assert(status == SPARK_NOERROR);
 
@@ -104,48 +182,466 @@ void spark_sosfilt_f32(spark_sosfilt_f32_t *self)
     return;
   }
 
-  assert(self->coefficients && self->states && (self->n_stages > 0));
+  assert(self->header.input.base && self->header.output.base);
+
+  const sosfilt_f32_io_t io = sosfilt_f32_block_io(&plan, &self->header);
+  sosfilt_f32_run(&plan, NULL, &io);
+}
+
+/**
+ * @brief Validate a filter once and resolve everything a call needs.
+ *
+ * Runs the checks spark_sosfilt_f32() makes on every call (ABI, size,
+ * format, layout, shape) and records the result in @p plan: strides for the
+ * layout, coefficient stride, the number of channels, samples and stages, and
+ * the dispatched kernel. The buffer bases in `self->header` are not needed
+ * and not captured; they are passed to spark_sosfilt_f32_execute().
+ *
+ * The plan refers to `self->coefficients` and `self->states` and stays valid
+ * while those arrays and the block shape are unchanged. Prepare again after
+ * changing the shape, flags or stage count, or after forcing another ISA
+ * with spark_dispatch_set_isa().
+ *
+ * @param[in] self Filter to prepare; only the header shape is checked.
+ * @param[out] plan Resolved plan.
+ *
+ * @retval SPARK_NOERROR on success
+ * @retval SPARK_ERR_INVALID_PARAM for NULL arguments, coefficients or states,
+ *         or zero stages
+ * @return Otherwise the error from spark_block_validate().
+ */
+int spark_sosfilt_f32_prepare(const spark_sosfilt_f32_t *self,
+                              spark_sosfilt_f32_plan_t *plan)
+{
+  if (!self || !plan)
+    return SPARK_ERR_INVALID_PARAM;
+
+  const spark_buffer_t *in = &self->header.input;
+  const uint32_t layout = spark_buffer_get_layout(in->flags);
+  const bool known =
+      (layout == SPARK_LAYOUT_INTERLEAVED || layout == SPARK_LAYOUT_PLANAR ||
+       layout == SPARK_LAYOUT_PLANAR_PTR || layout == SPARK_LAYOUT_STRIDED);
+
+  /* Bases are bound at execute time: validate the shape only. */
+  spark_block_t shape = self->header;
+  shape.input.base = &shape;
+  shape.output.base = &shape;
+
+  int status = spark_block_validate(
+      &shape, SOSFILT_F32_FLAGS | (known ? layout : SPARK_LAYOUT_PLANAR));
+  if (status != SPARK_NOERROR)
+    return status;
 
-  const uint32_t n_chan = self->header.input.channels;
-  const uint32_t n_samples = self->header.input.samples;
-  const uint32_t n_stages = self->n_stages;
+  if (!self->coefficients || !self->states || self->n_stages == 0)
+    return SPARK_ERR_INVALID_PARAM;
+
+  const uint32_t n_chan = in->channels;
+  const uint32_t n_samples = in->samples;
   const bool share_sos = (self->flags & SPARK_SOSFILT_SHARE_SOS);
+  const spark_kernels_t *kernels = spark_kernels();
 
-  const float *coeff = self->coefficients;
-  const float *input = self->header.input.base;
-  float *output = self->header.output.base;
-  float *states = self->states;
+  plan->coefficients = self->coefficients;
+  plan->coeff_stride = share_sos ? 0 : (size_t)self->n_stages * 5;
+  plan->states = self->states;
 
-  assert(input && output);
+  /*
+   * Interleaved: channels are adjacent and frames are n_chan samples apart.
+   * Plane pointers have no channel stride; each channel is found by pointer.
+   */
+  switch (layout) {
+  case SPARK_LAYOUT_INTERLEAVED:
+    plan->chan_stride = 1;
+    break;
+  case SPARK_LAYOUT_PLANAR_PTR:
+    plan->chan_stride = 0;
+    break;
+  case SPARK_LAYOUT_STRIDED:
+    plan->chan_stride = in->channel_stride;
+    break;
+  default:
+    plan->chan_stride = n_samples;
+    break;
+  }
+  plan->sample_stride = spark_buffer_sample_stride(in);
+  plan->planes = (layout == SPARK_LAYOUT_PLANAR_PTR);
+  plan->n_chan = n_chan;
+  plan->n_samples = n_samples;
+  plan->n_stages = self->n_stages;
+  plan->packed = false;
+  plan->denormals = self->flags & (SPARK_SOSFILT_FTZ | SPARK_SOSFILT_FLUSH_DENORMALS);
 
-  for (uint32_t chan = 0; chan < n_chan; ++chan) {
-    const float *in = input + (chan * n_samples);
-    float *out = output + (chan * n_samples);
+  /*
+   * The lane kernel pays off when coefficients are shared, or when the
+   * channels of a frame are adjacent so lanes load without a transpose.
+   */
+  const bool adjacent = (plan->chan_stride == 1);
+  plan->lanes = ((share_sos || adjacent) && (n_chan > 1) && (kernels->f32_lanes > 1))
+                    ? kernels->sosfilt_f32_lanes
+                    : NULL;
+  plan->group = plan->lanes ? kernels->f32_lanes : 1;
 
-    /* Start over the count if SOS is shared for all channels */
-    if (share_sos) {
-      coeff = self->coefficients;
-    }
+  /*
+   * Common small shapes have kernels that keep the whole cascade in
+   * registers, in any layout: coefficients are loaded once per call.
+   */
+  const int fixed_stages = sosfilt_f32_fixed_stages(self->n_stages);
+  const int fixed_chan = sosfilt_f32_fixed_channels(n_chan);
+  if (fixed_stages >= 0 && fixed_chan >= 0) {
+    plan->lanes = kernels->sosfilt_f32_fixed[fixed_stages][fixed_chan];
+    plan->group = (n_chan > 1) ? kernels->f32_lanes : 1;
+  }
+
+  return SPARK_NOERROR;
+}
+
+/**
+ * @brief Run a prepared filter on one block.
+ *
+ * The real-time half of spark_sosfilt_f32(): no validation and no dispatch
+ * lookup, only the buffers change from call to call. They must match the
+ * shape the plan was prepared for and may be the same buffer.
+ *
+ * @param[in] plan Plan from spark_sosfilt_f32_prepare().
+ * @param[in] input Input samples in the prepared layout.
+ * @param[out] output Output samples in the prepared layout.
+ */
+void spark_sosfilt_f32_execute(const spark_sosfilt_f32_plan_t *plan, const float *input,
+                               float *output)
+{
+  assert(plan && input && output);
+  assert(!plan->planes);
 
-    for (uint32_t stage = 0; stage < n_stages; ++stage) {
-      biquad_process_f32(coeff, states, out, in, n_samples);
-      coeff += 5;
-      states += 2;
+  const sosfilt_f32_io_t io = {
+      .input = input, .output = output, .count = plan->n_samples};
+  sosfilt_f32_run(plan, NULL, &io);
+}
 
-      /*
-       * For all subsequent stages, the input is the result of the previous
-       * stage, which is now in the output buffer.
-       */
-      in = out;
+/**
+ * @brief Run a prepared filter on host channel arrays.
+ *
+ * spark_sosfilt_f32_execute() for a plan prepared with
+ * @ref SPARK_LAYOUT_PLANAR_PTR buffers: channel k is read from `input[k]`
+ * and written to `output[k]`, in place when they are the same plane. Only
+ * the pointer arrays change from call to call, so a plugin can pass the
+ * host's `float **` straight through.
+ *
+ * @param[in] plan Plan from spark_sosfilt_f32_prepare() over plane pointers.
+ * @param[in] input `n_chan` input planes of `n_samples` samples.
+ * @param[out] output `n_chan` output planes of `n_samples` samples.
+ */
+void spark_sosfilt_f32_execute_planes(const spark_sosfilt_f32_plan_t *plan,
+                                      const float *const *input, float *const *output)
+{
+  assert(plan && input && output);
+  assert(plan->planes);
+
+  const sosfilt_f32_io_t io = {
+      .input_planes = input, .output_planes = output, .count = plan->n_samples};
+  sosfilt_f32_run(plan, NULL, &io);
+}
+
+/**
+ * @brief Run a prepared filter on samples `[first, first + count)` of each channel.
+ *
+ * Sample-accurate sub-block execution: split a block at event boundaries
+ * (automation points, MIDI notes) and filter each segment with whatever
+ * coefficients apply to it, without building new descriptors or preparing
+ * again. The buffers are the full block the plan was prepared for; the
+ * plan's channel strides still apply, and only the segment is read and
+ * written. States carry over from segment to segment, so covering the
+ * block with consecutive ranges gives the same output as one execute.
+ *
+ * Coefficients may be changed between segments, as long as the plan's
+ * coefficient pointer (and layout) stays the same, or by preparing a second
+ * plan over the new coefficients and the same states.
+ *
+ * @param[in] plan Plan from spark_sosfilt_f32_prepare() or a packed filter.
+ * @param[in] input Input block in the prepared layout (plane pointer plans
+ *                  use spark_sosfilt_f32_execute_planes_range()).
+ * @param[out] output Output block in the prepared layout.
+ * @param[in] first First sample of the segment.
+ * @param[in] count Samples in the segment; `first + count <= n_samples`. A
+ *                  zero count does nothing.
+ */
+void spark_sosfilt_f32_execute_range(const spark_sosfilt_f32_plan_t *plan,
+                                     const float *input, float *output, uint32_t first,
+                                     uint32_t count)
+{
+  assert(plan && input && output);
+  assert(!plan->planes);
+  assert(first <= plan->n_samples && count <= plan->n_samples - first);
+
+  if (count == 0)
+    return;
+
+  const sosfilt_f32_io_t io = {
+      .input = input, .output = output, .first = first, .count = count};
+  sosfilt_f32_run(plan, NULL, &io);
+}
+
+/**
+ * @brief spark_sosfilt_f32_execute_range() on host channel arrays.
+ *
+ * @param[in] plan Plan from spark_sosfilt_f32_prepare() over plane pointers.
+ * @param[in] input `n_chan` input planes of the full block.
+ * @param[out] output `n_chan` output planes of the full block.
+ * @param[in] first First sample of the segment.
+ * @param[in] count Samples in the segment; `first + count <= n_samples`.
+ */
+void spark_sosfilt_f32_execute_planes_range(const spark_sosfilt_f32_plan_t *plan,
+                                            const float *const *input,
+                                            float *const *output, uint32_t first,
+                                            uint32_t count)
+{
+  assert(plan && input && output);
+  assert(plan->planes);
+  assert(first <= plan->n_samples && count <= plan->n_samples - first);
+
+  if (count == 0)
+    return;
+
+  const sosfilt_f32_io_t io = {
+      .input_planes = input, .output_planes = output, .first = first, .count = count};
+  sosfilt_f32_run(plan, NULL, &io);
+}
+
+/**
+ * @brief Filter one block while moving to new coefficients (parameter automation).
+ *
+ * Sample t of the block (t = 0 … N-1) is filtered with coefficients
+ * `c + (t + 1) / N * (target - c)`, where `c` are the plan's coefficients:
+ * they glide linearly and reach @p target exactly on the last sample. Every
+ * sample's set is interpolated from the two ends, not stepped from the
+ * previous one, so float rounding does not build up over long blocks. Point
+ * the filter at @p target for the following blocks (and prepare again if
+ * the plan holds the old pointer), or keep ramping block by block.
+ *
+ * Each {-a1, -a2} pair stays on the segment between its end values, to
+ * within the rounding of one interpolation, and so inside the stability
+ * triangle, which is convex: a ramp between two stable sections never passes
+ * through an unstable one unless an end already sits within rounding of the
+ * triangle's edge. The state is carried across as is; there is no
+ * transient from swapping between blocks, so large blocks can be kept while
+ * a parameter is automated.
+ *
+ * @param[in] plan Plan from spark_sosfilt_f32_prepare() (not a packed filter).
+ * @param[in] target End coefficients, same layout and sharing as the plan's.
+ * @param[in] input Input samples in the prepared layout.
+ * @param[out] output Output samples in the prepared layout.
+ */
+void spark_sosfilt_f32_execute_ramp(const spark_sosfilt_f32_plan_t *plan,
+                                    const float *target, const float *input, float *output)
+{
+  assert(plan && target && input && output);
+  assert(!plan->packed && !plan->planes);
+
+  const sosfilt_f32_io_t io = {
+      .input = input, .output = output, .count = plan->n_samples};
+  sosfilt_f32_run(plan, target, &io);
+}
+
+/**
+ * @brief Ramp to @p target over samples `[first, first + count)` only.
+ *
+ * spark_sosfilt_f32_execute_ramp() on one segment of the block, as
+ * spark_sosfilt_f32_execute_range() does for fixed coefficients: the glide
+ * starts at the plan's coefficients and lands on @p target on the last
+ * sample of the segment, so an automation ramp can start and stop at any
+ * sample.
+ *
+ * @param[in] plan Plan from spark_sosfilt_f32_prepare() (not packed, not planes).
+ * @param[in] target End coefficients, same layout and sharing as the plan's.
+ * @param[in] input Input block in the prepared layout.
+ * @param[out] output Output block in the prepared layout.
+ * @param[in] first First sample of the segment.
+ * @param[in] count Samples in the segment; `first + count <= n_samples`.
+ */
+void spark_sosfilt_f32_execute_ramp_range(const spark_sosfilt_f32_plan_t *plan,
+                                          const float *target, const float *input,
+                                          float *output, uint32_t first, uint32_t count)
+{
+  assert(plan && target && input && output);
+  assert(!plan->packed && !plan->planes);
+  assert(first <= plan->n_samples && count <= plan->n_samples - first);
+
+  if (count == 0)
+    return;
+
+  const sosfilt_f32_io_t io = {
+      .input = input, .output = output, .first = first, .count = count};
+  sosfilt_f32_run(plan, target, &io);
+}
+
+/**
+ * @brief spark_sosfilt_f32() with a coefficient ramp to @p target over the block.
+ *
+ * Validating form of spark_sosfilt_f32_execute_ramp(). Set
+ * `self->coefficients = target` afterwards to hold the new response.
+ *
+ * @param[in,out] self Pointer to instance
+ * @param[in] target End coefficients, same layout as `self->coefficients`.
+ */
+void spark_sosfilt_f32_ramp(spark_sosfilt_f32_t *self, const float *target)
+{
+  assert(self && target);
+  spark_sosfilt_f32_plan_t plan;
+  int status = spark_sosfilt_f32_prepare(self, &plan);
+
+  assert(status == SPARK_NOERROR);
+
+  if (status != SPARK_NOERROR) {
+    return;
+  }
+
+  assert(self->header.input.base && self->header.output.base);
+
+  const sosfilt_f32_io_t io = sosfilt_f32_block_io(&plan, &self->header);
+  sosfilt_f32_run(&plan, target, &io);
+}
+
+/**
+ * @brief Whole-block I/O of a validating call, from the header's bases.
+ */
+static sosfilt_f32_io_t sosfilt_f32_block_io(const spark_sosfilt_f32_plan_t *plan,
+                                             const spark_block_t *header)
+{
+  sosfilt_f32_io_t io = {.count = plan->n_samples};
+
+  if (plan->planes) {
+    io.input_planes = header->input.base;
+    io.output_planes = header->output.base;
+  } else {
+    io.input = header->input.base;
+    io.output = header->output.base;
+  }
+
+  return io;
+}
+
+/**
+ * @brief Shared body of the execute entry points.
+ *
+ * @param[in] target Ramp end coefficients, or NULL for fixed coefficients.
+ * @param[in] io Buffers and the sample range to run.
+ */
+static void sosfilt_f32_run(const spark_sosfilt_f32_plan_t *plan, const float *target,
+                            const sosfilt_f32_io_t *io)
+{
+  assert(plan->lanes || !plan->packed);
+  spark_fpmode_t mode;
+
+  if (plan->denormals & SPARK_SOSFILT_FTZ)
+    spark_fpmode_enter(&mode);
+
+  SPARK_STATS_BEGIN();
+
+  if (plan->lanes) {
+    const sosfilt_f32_args_t args = {
+        .coefficients = plan->coefficients,
+        .coeff_stride = plan->coeff_stride,
+        .states = plan->states,
+        .input = io->input,
+        .output = io->output,
+        .input_planes = io->input_planes,
+        .output_planes = io->output_planes,
+        .chan_stride = plan->chan_stride,
+        .sample_stride = plan->sample_stride,
+        .first = io->first,
+        .n_chan = plan->n_chan,
+        .n_samples = io->count,
+        .n_stages = plan->n_stages,
+        .packed = plan->packed,
+        .target = target,
+    };
+    plan->lanes(&args);
+  } else {
+    sosfilt_f32_cascade(plan, target, io);
+  }
+
+  if (plan->denormals & SPARK_SOSFILT_FLUSH_DENORMALS)
+    sosfilt_f32_flush(plan);
+
+  SPARK_STATS_END(SPARK_STATS_SOSFILT_F32, (size_t)plan->n_chan * io->count);
+
+  if (plan->denormals & SPARK_SOSFILT_FTZ)
+    spark_fpmode_leave(&mode);
+}
+
+/**
+ * @brief Per-channel path of sosfilt_f32_run(): scalar cascade over L1 tiles.
+ */
+static void sosfilt_f32_cascade(const spark_sosfilt_f32_plan_t *plan, const float *target,
+                                const sosfilt_f32_io_t *io)
+{
+  const uint32_t n_samples = io->count;
+  const uint32_t n_stages = plan->n_stages;
+  const size_t chan_stride = plan->chan_stride;
+  const size_t sample_stride = plan->sample_stride;
+  const size_t first = (size_t)io->first * sample_stride;
+  const float inv_n = 1.0f / (float)n_samples;
+
+  for (uint32_t chan = 0; chan < plan->n_chan; ++chan) {
+    const float *in =
+        io->input_planes ? io->input_planes[chan] : io->input + (chan * chan_stride);
+    float *out =
+        io->output_planes ? io->output_planes[chan] : io->output + (chan * chan_stride);
+
+    in += first;
+    out += first;
+    float *chan_states = plan->states + ((size_t)chan * n_stages * 2);
+
+    /* coeff_stride is 0 when SOS is shared for all channels */
+    const float *chan_coeff = plan->coefficients + (chan * plan->coeff_stride);
+    const float *chan_target = target ? target + (chan * plan->coeff_stride) : NULL;
+
+    for (size_t offset = 0; offset < n_samples; offset += SOSFILT_F32_TILE) {
+      const size_t count = (n_samples - offset < SOSFILT_F32_TILE) ? (n_samples - offset)
+                                                                  : SOSFILT_F32_TILE;
+      const float *src = in + (offset * sample_stride);
+      float *dst = out + (offset * sample_stride);
+
+      for (uint32_t stage = 0; stage < n_stages; ++stage) {
+        if (target) {
+          biquad_ramp_f32(chan_coeff + (stage * 5), chan_target + (stage * 5),
+                          chan_states + (stage * 2), dst, src, count, sample_stride,
+                          n_samples - 1 - offset, inv_n);
+        } else {
+          biquad_process_f32(chan_coeff + (stage * 5), chan_states + (stage * 2), dst, src,
+                             count, sample_stride);
+        }
+
+        /*
+         * For all subsequent stages, the input is the result of the previous
+         * stage, which is now in the output tile.
+         */
+        src = dst;
+      }
     }
   }
 }
 
+/**
+ * @brief Zero the plan's near-subnormal states (@ref SPARK_SOSFILT_FLUSH_DENORMALS).
+ *
+ * Packed storage is flushed in whole groups; padding lanes hold zeros and
+ * are left as they are.
+ */
+static void sosfilt_f32_flush(const spark_sosfilt_f32_plan_t *plan)
+{
+  const uint32_t group = plan->packed ? plan->group : 1;
+  const size_t n_chan = ((size_t)plan->n_chan + group - 1) / group * group;
+
+  if (spark_flush_denormals_f32(plan->states, n_chan * plan->n_stages * 2))
+    spark_denormal_record();
+}
+
 /**
  * @brief Single-precision biquad (SOS) IIR, transposed Direct Form II (TDF-II).
  *
  * Processes @p samples mono samples through one biquad section. The function
- * reads @p input, writes @p output, and updates @p state in place.
+ * reads @p input, writes @p output, and updates @p state in place. Consecutive
+ * samples are @p stride floats apart in both buffers (1 for a planar channel,
+ * the channel count for an interleaved one).
  *
  * ### Coefficient layout (5 floats)
  * Coefficients are normalized with a0 = 1 and packed as:
@@ -158,7 +654,8 @@ void spark_sosfilt_f32(spark_sosfilt_f32_t *self)
  * @code
  * state = { w1, w2 }
  * @endcode
- * These must be preserved across calls (initialize to 0.0f for a cold start).
+ * These must be preserved across calls (initialize to 0.0f for a cold start,
+ * or to the steady state with spark_sosfilt_f32_zi() for a DC-heavy stream).
  *
  * ### Difference equations (TDF-II)
  * @code
@@ -168,15 +665,15 @@ void spark_sosfilt_f32(spark_sosfilt_f32_t *self)
  * @endcode
  *
  * ### Buffer flow
- * - Input : input[0..samples-1]   (read)
- * - Output: output[0..samples-1]  (write)
+ * - Input : input[0], input[stride], ...   (read)
+ * - Output: output[0], output[stride], ... (write)
  * - In-place is allowed if `output == input` (reads happen before writes per
  * sample).
  *
  * ### Notes / contracts
  * - @p coeff points to exactly 5 floats: {b0,b1,b2,a1,a2} with a0≡1.
  * - @p state points to exactly 2 floats: {w1,w2}, updated and preserved.
- * - All buffers must be contiguous `float` (32-bit) arrays.
+ * - All buffers must be `float` (32-bit) arrays with @p stride >= 1.
  * - Stable behavior requires a realizable, stable section (|poles| < 1 in
  * z-plane).
  * - If you use this inside a cascade, pass the same @p output as the next
@@ -189,9 +686,10 @@ void spark_sosfilt_f32(spark_sosfilt_f32_t *self)
  * @param[out] output Pointer to @p samples float32 output samples.
  * @param[in] input  Pointer to @p samples float32 input samples.
  * @param[in] samples Number of mono samples to process.
+ * @param[in] stride Distance, in floats, between consecutive samples.
  */
 static void biquad_process_f32(const float coeff[5], float state[2], float *output,
-                               const float *input, size_t samples)
+                               const float *input, size_t samples, size_t stride)
 {
   // Load coefficients
   const float b0 = coeff[0];
@@ -205,14 +703,57 @@ static void biquad_process_f32(const float coeff[5], float state[2], float *outp
   float s2 = state[1];
 
   for (size_t i = 0; i < samples; ++i) {
-    float x = input[i];
+    float x = input[i * stride];
     float y = (b0 * x) + s1;
     s1 = (b1 * x) + (a1 * y) + s2;
     s2 = (b2 * x) + (a2 * y);
-    output[i] = y;
+    output[i * stride] = y;
   }
 
   // Update the state values for the next iteration.
   state[0] = s1;
   state[1] = s2;
 }
+
+/**
+ * @brief biquad_process_f32() with coefficients ramping towards @p target.
+ *
+ * Sample i of this run is followed by `left - i` more samples of the block
+ * and uses `target + (left - i) * inv_n * (coeff - target)`. Each sample is
+ * interpolated afresh, so rounding does not accumulate over the block and
+ * its last sample uses @p target exactly.
+ *
+ * @param[in] coeff   Coefficients at the start of the block.
+ * @param[in] target  Coefficients at the end of the block.
+ * @param[in] left    Samples of the block after the first one of this run.
+ * @param[in] inv_n   Reciprocal of the block length.
+ */
+static void biquad_ramp_f32(const float coeff[5], const float target[5], float state[2],
+                            float *output, const float *input, size_t samples,
+                            size_t stride, size_t left, float inv_n)
+{
+  float span[5];
+
+  for (int k = 0; k < 5; ++k)
+    span[k] = coeff[k] - target[k];
+
+  float s1 = state[0];
+  float s2 = state[1];
+
+  for (size_t i = 0; i < samples; ++i) {
+    const float w = (float)(left - i) * inv_n;
+    float c[5];
+
+    for (int k = 0; k < 5; ++k)
+      c[k] = target[k] + w * span[k];
+
+    float x = input[i * stride];
+    float y = (c[0] * x) + s1;
+    s1 = (c[1] * x) + (c[3] * y) + s2;
+    s2 = (c[2] * x) + (c[4] * y);
+    output[i * stride] = y;
+  }
+
+  state[0] = s1;
+  state[1] = s2;
+}
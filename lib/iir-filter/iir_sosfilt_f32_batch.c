@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "spark/iir_filter.h"
+#include "denormal/denormal_internal.h"
+#include "dispatch/kernels.h"
+#include "memory/memory_internal.h"
+#include "stats/stats_internal.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Shape of one filter, frozen at init. */
+typedef struct batch_filter {
+  size_t coeff_stride;  /**< Floats between channel sets; 0 if shared. */
+  size_t sample_stride; /**< Samples between frame n and n+1. */
+  uint32_t n_chan;      /**< Channels (lanes) of the filter. */
+  uint32_t n_stages;    /**< Sections in the cascade. */
+  bool flush;           /**< SPARK_SOSFILT_FLUSH_DENORMALS is set. */
+} batch_filter_t;
+
+/** Consecutive lanes of one block length: one kernel call. */
+typedef struct batch_run {
+  uint32_t first;     /**< First lane. */
+  uint32_t n_lanes;   /**< Lanes in the run. */
+  uint32_t n_samples; /**< Samples per lane. */
+} batch_run_t;
+
+struct spark_sosfilt_f32_batch_state {
+  void (*kernel)(const sosfilt_f32_batch_args_t *args);
+  batch_filter_t *info;      /**< One per filter. */
+  sosfilt_f32_lane_t *lanes; /**< One per channel, refreshed on every call. */
+  batch_run_t *runs;         /**< Runs of equal block length. */
+  size_t n_samples;          /**< Samples across all channels, for the stats. */
+  bool ftz;                  /**< Some filter asked for SPARK_SOSFILT_FTZ. */
+  bool flush;                /**< Some filter asked for FLUSH_DENORMALS. */
+};
+
+/** Arena bytes after alignment, for @p n_filters filters and @p n_lanes channels. */
+static size_t batch_bytes(uint32_t n_filters, size_t n_lanes)
+{
+  const size_t align = SPARK_SOSFILT_ALIGN;
+
+  return spark_align_up(sizeof(struct spark_sosfilt_f32_batch_state), align) +
+         spark_align_up(n_filters * sizeof(batch_filter_t), align) +
+         spark_align_up(n_lanes * sizeof(sosfilt_f32_lane_t), align) +
+         spark_align_up(n_filters * sizeof(batch_run_t), align);
+}
+
+/**
+ * @brief Arena bytes needed by spark_sosfilt_f32_batch_init().
+ *
+ * Only the channel counts are read. Includes slack to align an arbitrary
+ * arena pointer.
+ *
+ * @param[in] filters Filter descriptions.
+ * @param[in] n_filters Number of filters.
+ * @return Arena size in bytes, or 0 if @p filters is NULL or empty.
+ */
+size_t spark_sosfilt_f32_batch_size(const spark_sosfilt_f32_t *filters,
+                                    uint32_t n_filters)
+{
+  if (!filters || n_filters == 0)
+    return 0;
+
+  size_t n_lanes = 0;
+  for (uint32_t i = 0; i < n_filters; ++i)
+    n_lanes += filters[i].header.input.channels;
+
+  return (SPARK_SOSFILT_ALIGN - 1) + batch_bytes(n_filters, n_lanes);
+}
+
+/**
+ * @brief Group many small filters into one call.
+ *
+ * Validates every filter once, as spark_sosfilt_f32_prepare() would, and
+ * lays their channels out as one sequence of SIMD lanes: filter 0's
+ * channels, then filter 1's, and so on. spark_sosfilt_f32_batch_execute()
+ * then runs them VF32_LANES at a time regardless of which filter a lane
+ * belongs to, so 2000 mono voices fill 16-wide vectors instead of running
+ * 2000 one-lane cascades, and nothing is validated per call.
+ *
+ * Lanes in one vector must share a block length; put filters with the same
+ * `samples` next to each other (each change of length starts a new group).
+ * Cascades of different lengths mix freely, the shorter ones padded with
+ * pass-through sections.
+ *
+ * @p filters is referenced, not copied: every call reads the current buffer
+ * bases, `coefficients` and `states` of each filter, which may change
+ * between calls. Their shape (channels, samples, layouts, `n_stages`,
+ * `flags`) must not. The kernel is the one selected now, as for
+ * spark_sosfilt_f32_packed_init().
+ *
+ * @param[out] self Batch to initialize.
+ * @param[in] filters Filter descriptions. Must outlive @p self.
+ * @param[in] n_filters Number of filters.
+ * @param[in] arena Caller-owned memory of at least spark_sosfilt_f32_batch_size()
+ *                  bytes. Must outlive @p self.
+ * @param[in] arena_size Size of @p arena in bytes.
+ *
+ * @retval SPARK_NOERROR on success
+ * @retval SPARK_ERR_INVALID_PARAM for NULL arguments or no filters
+ * @retval SPARK_ERR_INVALID_SIZE if @p arena is too small
+ * @return Otherwise the first error from spark_sosfilt_f32_prepare().
+ */
+int spark_sosfilt_f32_batch_init(spark_sosfilt_f32_batch_t *self,
+                                 const spark_sosfilt_f32_t *filters, uint32_t n_filters,
+                                 void *arena, size_t arena_size)
+{
+  if (!self || !filters || n_filters == 0 || !arena)
+    return SPARK_ERR_INVALID_PARAM;
+
+  size_t n_lanes = 0;
+  for (uint32_t i = 0; i < n_filters; ++i) {
+    spark_sosfilt_f32_plan_t plan;
+    const int status = spark_sosfilt_f32_prepare(&filters[i], &plan);
+    if (status != SPARK_NOERROR)
+      return status;
+    n_lanes += plan.n_chan;
+  }
+
+  if (n_lanes > UINT32_MAX)
+    return SPARK_ERR_INVALID_PARAM;
+  if (arena_size < spark_sosfilt_f32_batch_size(filters, n_filters))
+    return SPARK_ERR_INVALID_SIZE;
+
+  unsigned char *base = spark_align_ptr(arena, SPARK_SOSFILT_ALIGN);
+  struct spark_sosfilt_f32_batch_state *state =
+      (struct spark_sosfilt_f32_batch_state *)base;
+  base += spark_align_up(sizeof(*state), SPARK_SOSFILT_ALIGN);
+  state->info = (batch_filter_t *)base;
+  base += spark_align_up(n_filters * sizeof(batch_filter_t), SPARK_SOSFILT_ALIGN);
+  state->lanes = (sosfilt_f32_lane_t *)base;
+  base += spark_align_up(n_lanes * sizeof(sosfilt_f32_lane_t), SPARK_SOSFILT_ALIGN);
+  state->runs = (batch_run_t *)base;
+
+  state->kernel = spark_kernels()->sosfilt_f32_batch;
+  state->n_samples = 0;
+  state->ftz = false;
+  state->flush = false;
+
+  uint32_t n_runs = 0;
+  uint32_t lane = 0;
+
+  for (uint32_t i = 0; i < n_filters; ++i) {
+    const spark_sosfilt_f32_t *f = &filters[i];
+    const uint32_t n_chan = f->header.input.channels;
+    const uint32_t n_samples = f->header.input.samples;
+
+    state->info[i] = (batch_filter_t){
+        .coeff_stride =
+            (f->flags & SPARK_SOSFILT_SHARE_SOS) ? 0 : (size_t)f->n_stages * 5,
+        .sample_stride = spark_buffer_sample_stride(&f->header.input),
+        .n_chan = n_chan,
+        .n_stages = f->n_stages,
+        .flush = (f->flags & SPARK_SOSFILT_FLUSH_DENORMALS) != 0,
+    };
+    state->ftz |= (f->flags & SPARK_SOSFILT_FTZ) != 0;
+    state->flush |= state->info[i].flush;
+    state->n_samples += (size_t)n_chan * n_samples;
+
+    if (n_runs == 0 || state->runs[n_runs - 1].n_samples != n_samples)
+      state->runs[n_runs++] = (batch_run_t){.first = lane, .n_samples = n_samples};
+    state->runs[n_runs - 1].n_lanes += n_chan;
+    lane += n_chan;
+  }
+
+  self->filters = filters;
+  self->n_filters = n_filters;
+  self->n_lanes = lane;
+  self->n_runs = n_runs;
+  self->state = state;
+
+  return SPARK_NOERROR;
+}
+
+/**
+ * @brief Run every filter of the batch over its current buffers.
+ *
+ * Equivalent to spark_sosfilt_f32() on each filter in turn, without the
+ * per-filter validation and dispatch. Per call the cost is one pass over
+ * the filters to pick up their pointers, then one kernel call per run of
+ * equal block length. Filters with @ref SPARK_SOSFILT_FTZ put the whole
+ * batch in flush-to-zero mode; @ref SPARK_SOSFILT_FLUSH_DENORMALS is
+ * applied, and counted, per filter.
+ *
+ * @note Buffers of different filters must not overlap (in-place filtering,
+ * output equal to input, is fine).
+ *
+ * @param[in,out] self Batch from spark_sosfilt_f32_batch_init().
+ */
+void spark_sosfilt_f32_batch_execute(spark_sosfilt_f32_batch_t *self)
+{
+  assert(self && self->state);
+  struct spark_sosfilt_f32_batch_state *state = self->state;
+  spark_fpmode_t mode;
+
+  if (state->ftz)
+    spark_fpmode_enter(&mode);
+
+  SPARK_STATS_BEGIN();
+
+  sosfilt_f32_lane_t *lane = state->lanes;
+  for (uint32_t i = 0; i < self->n_filters; ++i) {
+    const spark_sosfilt_f32_t *f = &self->filters[i];
+    const batch_filter_t *info = &state->info[i];
+    assert(f->coefficients && f->states);
+    assert(f->header.input.base && f->header.output.base);
+
+    for (uint32_t k = 0; k < info->n_chan; ++k, ++lane) {
+      *lane = (sosfilt_f32_lane_t){
+          .input = spark_buffer_channel(&f->header.input, k),
+          .output = spark_buffer_channel(&f->header.output, k),
+          .coefficients = f->coefficients + k * info->coeff_stride,
+          .states = f->states + (size_t)k * info->n_stages * 2,
+          .stride = info->sample_stride,
+          .n_stages = info->n_stages,
+      };
+    }
+  }
+
+  for (uint32_t r = 0; r < self->n_runs; ++r) {
+    const batch_run_t *run = &state->runs[r];
+    const sosfilt_f32_batch_args_t args = {
+        .lanes = state->lanes + run->first,
+        .n_lanes = run->n_lanes,
+        .n_samples = run->n_samples,
+    };
+    state->kernel(&args);
+  }
+
+  for (uint32_t i = 0; state->flush && i < self->n_filters; ++i) {
+    const batch_filter_t *info = &state->info[i];
+    const size_t n_states = (size_t)info->n_chan * info->n_stages * 2;
+    if (info->flush && spark_flush_denormals_f32(self->filters[i].states, n_states))
+      spark_denormal_record();
+  }
+
+  SPARK_STATS_END(SPARK_STATS_SOSFILT_F32, state->n_samples);
+
+  if (state->ftz)
+    spark_fpmode_leave(&mode);
+}
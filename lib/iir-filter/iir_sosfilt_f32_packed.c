@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "spark/iir_filter.h"
+#include "dispatch/kernels.h"
+#include "memory/memory_internal.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/** Floats of packed coefficients, rounded up to ::SPARK_SOSFILT_ALIGN bytes. */
+static inline size_t packed_coeff_bytes(uint32_t n_groups, uint32_t n_stages,
+                                        uint32_t lanes)
+{
+  return spark_align_up((size_t)n_groups * n_stages * 5 * lanes * sizeof(float),
+                        SPARK_SOSFILT_ALIGN);
+}
+
+static inline size_t packed_state_bytes(uint32_t n_groups, uint32_t n_stages,
+                                        uint32_t lanes)
+{
+  return spark_align_up((size_t)n_groups * n_stages * 2 * lanes * sizeof(float),
+                        SPARK_SOSFILT_ALIGN);
+}
+
+/**
+ * @brief Arena bytes needed by spark_sosfilt_f32_packed_init().
+ *
+ * The size depends on the channel and stage counts and on the vector width
+ * of the active dispatch level (channels are padded to a whole group). It
+ * includes slack to align an arbitrary arena pointer, so any buffer of this
+ * size will do.
+ *
+ * @param[in] n_chan Number of channels.
+ * @param[in] n_stages Sections in the cascade.
+ * @return Arena size in bytes, or 0 if either count is 0.
+ */
+size_t spark_sosfilt_f32_packed_size(uint32_t n_chan, uint32_t n_stages)
+{
+  if (n_chan == 0 || n_stages == 0)
+    return 0;
+
+  const uint32_t lanes = spark_kernels()->f32_lanes;
+  const uint32_t n_groups = (n_chan + lanes - 1) / lanes;
+
+  return (SPARK_SOSFILT_ALIGN - 1) + packed_coeff_bytes(n_groups, n_stages, lanes) +
+         packed_state_bytes(n_groups, n_stages, lanes);
+}
+
+/**
+ * @brief Build a packed filter from a regular filter description.
+ *
+ * Validates @p desc like spark_sosfilt_f32_prepare() (its buffer bases are
+ * not used), carves aligned coefficient and state storage out of @p arena,
+ * repacks `desc->coefficients` into it and copies `desc->states` (or zeroes
+ * the state when it is NULL). @p desc is not referenced afterwards.
+ *
+ * The packing matches the kernel chosen now; the filter keeps using that
+ * kernel even if spark_dispatch_set_isa() changes the level later.
+ *
+ * @param[out] self Packed filter to initialize.
+ * @param[in] desc Shape, coefficients, optional initial states, stages and
+ *                 ::spark_sosfilt_flags.
+ * @param[in] arena Caller-owned memory, at least
+ *                  spark_sosfilt_f32_packed_size() bytes. Must outlive @p self.
+ * @param[in] arena_size Size of @p arena in bytes.
+ *
+ * @retval SPARK_NOERROR on success
+ * @retval SPARK_ERR_INVALID_PARAM for NULL arguments
+ * @retval SPARK_ERR_INVALID_SIZE if @p arena is too small
+ * @return Otherwise the error from spark_sosfilt_f32_prepare().
+ */
+int spark_sosfilt_f32_packed_init(spark_sosfilt_f32_packed_t *self,
+                                  const spark_sosfilt_f32_t *desc, void *arena,
+                                  size_t arena_size)
+{
+  if (!self || !desc || !arena)
+    return SPARK_ERR_INVALID_PARAM;
+
+  /* States are optional here; prepare only needs a non-NULL placeholder. */
+  spark_sosfilt_f32_t shape = *desc;
+  if (!shape.states)
+    shape.states = (float *)arena;
+
+  spark_sosfilt_f32_plan_t plan;
+  int status = spark_sosfilt_f32_prepare(&shape, &plan);
+  if (status != SPARK_NOERROR)
+    return status;
+
+  if (arena_size < spark_sosfilt_f32_packed_size(plan.n_chan, plan.n_stages))
+    return SPARK_ERR_INVALID_SIZE;
+
+  const spark_kernels_t *kernels = spark_kernels();
+  const uint32_t lanes = kernels->f32_lanes;
+  const uint32_t n_groups = (plan.n_chan + lanes - 1) / lanes;
+
+  unsigned char *base = spark_align_ptr(arena, SPARK_SOSFILT_ALIGN);
+  float *coeff = (float *)base;
+  float *states = (float *)(base + packed_coeff_bytes(n_groups, plan.n_stages, lanes));
+
+  plan.coefficients = coeff;
+  plan.coeff_stride = 0;
+  plan.states = states;
+  plan.packed = true;
+  plan.lanes = kernels->sosfilt_f32_lanes;
+  plan.group = lanes;
+
+  self->plan = plan;
+  self->lanes = lanes;
+  self->flags = desc->flags;
+
+  spark_sosfilt_f32_packed_set_coefficients(self, desc->coefficients);
+
+  const uint32_t n_stages = plan.n_stages;
+  memset(states, 0, packed_state_bytes(n_groups, n_stages, lanes));
+
+  if (desc->states) {
+    for (uint32_t chan = 0; chan < plan.n_chan; ++chan) {
+      const uint32_t g = chan / lanes;
+      const uint32_t l = chan % lanes;
+      for (uint32_t stage = 0; stage < n_stages; ++stage) {
+        const float *src = desc->states + ((size_t)chan * n_stages + stage) * 2;
+        float *dst = states + ((size_t)g * n_stages + stage) * 2 * lanes;
+        dst[l] = src[0];
+        dst[lanes + l] = src[1];
+      }
+    }
+  }
+
+  return SPARK_NOERROR;
+}
+
+/**
+ * @brief Repack new coefficients into an initialized packed filter.
+ *
+ * @p coefficients uses the public layout (5 floats per stage, one set per
+ * channel or a single shared set, per the flags given at init). Padding lanes
+ * keep zero coefficients. Not synchronized with a concurrent execute.
+ *
+ * @param[in,out] self Packed filter.
+ * @param[in] coefficients Coefficients in the public layout.
+ */
+void spark_sosfilt_f32_packed_set_coefficients(spark_sosfilt_f32_packed_t *self,
+                                               const float *coefficients)
+{
+  assert(self && coefficients);
+
+  const uint32_t lanes = self->lanes;
+  const uint32_t n_chan = self->plan.n_chan;
+  const uint32_t n_stages = self->plan.n_stages;
+  const uint32_t n_groups = (n_chan + lanes - 1) / lanes;
+  const bool share_sos = (self->flags & SPARK_SOSFILT_SHARE_SOS);
+
+  /* The plan only reads the coefficients; the packed filter owns them. */
+  float *dst = (float *)self->plan.coefficients;
+
+  for (uint32_t g = 0; g < n_groups; ++g) {
+    for (uint32_t stage = 0; stage < n_stages; ++stage) {
+      for (uint32_t l = 0; l < lanes; ++l) {
+        const uint32_t chan = g * lanes + l;
+        if (chan >= n_chan) {
+          for (int k = 0; k < 5; ++k)
+            dst[k * lanes + l] = 0.0f;
+          continue;
+        }
+
+        const float *src =
+            coefficients + (share_sos ? 0 : (size_t)chan * n_stages * 5) + stage * 5;
+        for (int k = 0; k < 5; ++k)
+          dst[k * lanes + l] = src[k];
+      }
+      dst += 5 * lanes;
+    }
+  }
+}
+
+/**
+ * @brief Clear the state of a packed filter (cold start).
+ *
+ * @param[in,out] self Packed filter.
+ */
+void spark_sosfilt_f32_packed_reset(spark_sosfilt_f32_packed_t *self)
+{
+  assert(self);
+
+  const uint32_t n_groups = (self->plan.n_chan + self->lanes - 1) / self->lanes;
+  memset(self->plan.states, 0, packed_state_bytes(n_groups, self->plan.n_stages, self->lanes));
+}
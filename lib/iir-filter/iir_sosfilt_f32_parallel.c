@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "spark/iir_filter.h"
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Shared, read-only description of one parallel call.
+ */
+typedef struct sosfilt_f32_split {
+  const spark_sosfilt_f32_plan_t *plan;
+  const float *target;
+  const float *input;
+  float *output;
+  uint32_t chunk; /**< Channels per task, a multiple of the plan's group. */
+} sosfilt_f32_split_t;
+
+/**
+ * @brief Run channels `[index * chunk, ...)` as a plan of their own.
+ *
+ * Channel k of the sub-plan is channel `first + k` of the block: bases are
+ * offset by whole channels, strides are unchanged, so this works for both
+ * layouts, and for packed storage since chunks start on a group boundary.
+ */
+static void sosfilt_f32_task(void *arg, uint32_t index)
+{
+  const sosfilt_f32_split_t *split = (const sosfilt_f32_split_t *)arg;
+  const spark_sosfilt_f32_plan_t *plan = split->plan;
+  const uint32_t first = index * split->chunk;
+
+  if (first >= plan->n_chan)
+    return;
+
+  spark_sosfilt_f32_plan_t sub = *plan;
+  sub.n_chan = (plan->n_chan - first < split->chunk) ? plan->n_chan - first : split->chunk;
+
+  const size_t coeff_at = plan->packed ? (size_t)first * plan->n_stages * 5
+                                       : (size_t)first * plan->coeff_stride;
+  sub.coefficients = plan->coefficients + coeff_at;
+  sub.states = plan->states + (size_t)first * plan->n_stages * 2;
+
+  const size_t io_at = (size_t)first * plan->chan_stride;
+
+  if (split->target)
+    spark_sosfilt_f32_execute_ramp(&sub, split->target + coeff_at, split->input + io_at,
+                                   split->output + io_at);
+  else
+    spark_sosfilt_f32_execute(&sub, split->input + io_at, split->output + io_at);
+}
+
+/**
+ * @brief Run a prepared filter with its channels split across a thread pool.
+ *
+ * Channels are independent in both coefficient modes, so the block is cut
+ * into at most `executor->n_workers` runs of whole kernel groups (one SIMD
+ * vector of channels, see @ref spark_sosfilt_f32_plan_t::group), each
+ * filtered as a sub-plan on whichever worker picks it up. The split is a
+ * pure function of the plan and `n_workers`, and every channel sees exactly
+ * the arithmetic of a serial call, so the output is bit-identical to
+ * spark_sosfilt_f32_execute() whatever the pool does. Nothing is allocated;
+ * the task description lives on the caller's stack for the duration of
+ * `parallel_for`.
+ *
+ * Worth it for many channels and long blocks (offline rendering); for a few
+ * channels the pool's wake-up cost exceeds the filtering.
+ *
+ * @param[in] plan Plan from spark_sosfilt_f32_prepare() or a packed filter, over a
+ *                 single buffer (not @ref SPARK_LAYOUT_PLANAR_PTR).
+ * @param[in] executor Thread pool; NULL or fewer than 2 workers runs serially.
+ * @param[in] target Ramp end coefficients as for
+ *                   spark_sosfilt_f32_execute_ramp(), or NULL.
+ * @param[in] input Input samples in the prepared layout.
+ * @param[out] output Output samples in the prepared layout.
+ */
+void spark_sosfilt_f32_execute_parallel(const spark_sosfilt_f32_plan_t *plan,
+                                        const spark_executor_t *executor,
+                                        const float *target, const float *input,
+                                        float *output)
+{
+  assert(plan && input && output);
+  assert(!target || !plan->packed);
+  assert(!plan->planes);
+
+  const uint32_t group = plan->group ? plan->group : 1;
+  const uint32_t n_groups = (plan->n_chan + group - 1) / group;
+  uint32_t n_tasks = executor ? executor->n_workers : 1;
+
+  if (n_tasks > n_groups)
+    n_tasks = n_groups;
+
+  if (n_tasks < 2 || !executor->parallel_for) {
+    if (target)
+      spark_sosfilt_f32_execute_ramp(plan, target, input, output);
+    else
+      spark_sosfilt_f32_execute(plan, input, output);
+    return;
+  }
+
+  const uint32_t groups_per_task = (n_groups + n_tasks - 1) / n_tasks;
+  const sosfilt_f32_split_t split = {
+      .plan = plan,
+      .target = target,
+      .input = input,
+      .output = output,
+      .chunk = groups_per_task * group,
+  };
+
+  /* Rounding up can leave trailing tasks empty; do not schedule them. */
+  n_tasks = (n_groups + groups_per_task - 1) / groups_per_task;
+
+  executor->parallel_for(executor->pool, sosfilt_f32_task, (void *)&split, n_tasks);
+}
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "spark/iir_filter.h"
+#include "memory/memory_internal.h"
+
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/** Set in `middle` when it holds a set the audio thread has not picked up. */
+#define SLOT_FRESH 4u
+
+/** Index bits of `middle`. */
+#define SLOT_INDEX 3u
+
+/**
+ * Slot storage at the start of the arena. The exchanged index and each
+ * thread's private indices sit on their own cache lines, so the two sides
+ * only ever share the one atomic.
+ */
+struct spark_sosfilt_f32_slot_state {
+  /** Coefficient sets, read-only after init. */
+  float *sets[4];
+
+  /** Handed over between the threads: an index plus ::SLOT_FRESH. */
+  _Alignas(64) atomic_uint_fast32_t middle;
+
+  /** Control thread: the set being written. */
+  _Alignas(64) uint32_t back;
+
+  /** Audio thread: the set in use, and the one in use before it. */
+  _Alignas(64) uint32_t current;
+  uint32_t previous;
+};
+
+/** Floats in one coefficient set of @p desc; 0 if it has no stages or channels. */
+static size_t slot_floats(const spark_sosfilt_f32_t *desc)
+{
+  if (!desc || desc->n_stages == 0)
+    return 0;
+  if (desc->flags & SPARK_SOSFILT_SHARE_SOS)
+    return (size_t)desc->n_stages * 5;
+  return (size_t)desc->n_stages * 5 * desc->header.input.channels;
+}
+
+/**
+ * @brief Arena bytes needed by spark_sosfilt_f32_slot_init() for @p desc.
+ *
+ * Four coefficient sets of the filter's shape (one shared set, or one per
+ * channel) plus the slot state, with slack to align an arbitrary arena
+ * pointer.
+ *
+ * @param[in] desc Filter the slot will feed (stages, channels and flags).
+ * @return Arena size in bytes, or 0 if @p desc has no stages or channels.
+ */
+size_t spark_sosfilt_f32_slot_size(const spark_sosfilt_f32_t *desc)
+{
+  const size_t n = slot_floats(desc);
+  if (n == 0)
+    return 0;
+
+  const size_t align = SPARK_SOSFILT_ALIGN;
+
+  return (align - 1) +
+         spark_align_up(sizeof(struct spark_sosfilt_f32_slot_state), align) +
+         4 * spark_align_up(n * sizeof(float), align);
+}
+
+/**
+ * @brief Attach a lock-free coefficient slot to a filter.
+ *
+ * Copies `filter->coefficients` into every set of the slot and points
+ * `filter->coefficients` at the audio thread's current one. From then on
+ * the control thread fills spark_sosfilt_f32_slot_begin() and calls
+ * spark_sosfilt_f32_slot_publish(); the audio thread calls
+ * spark_sosfilt_f32_slot_acquire() at block boundaries. Both sides are
+ * wait-free: one atomic exchange each, no lock, no allocation, and neither
+ * ever touches a set the other is using. Call this before either thread
+ * starts using the slot.
+ *
+ * @param[out] slot Slot to initialize.
+ * @param[in,out] filter Filter to feed; its coefficients seed the slot.
+ * @param[in] arena Caller-owned memory of at least spark_sosfilt_f32_slot_size()
+ *                  bytes. Must outlive @p slot.
+ * @param[in] arena_size Size of @p arena in bytes.
+ *
+ * @retval SPARK_NOERROR on success
+ * @retval SPARK_ERR_INVALID_PARAM for NULL arguments or coefficients, or a
+ *         filter without stages or channels
+ * @retval SPARK_ERR_INVALID_SIZE if @p arena is too small
+ */
+int spark_sosfilt_f32_slot_init(spark_sosfilt_f32_slot_t *slot,
+                                spark_sosfilt_f32_t *filter, void *arena,
+                                size_t arena_size)
+{
+  if (!slot || !filter || !filter->coefficients || !arena)
+    return SPARK_ERR_INVALID_PARAM;
+
+  const size_t n = slot_floats(filter);
+  if (n == 0)
+    return SPARK_ERR_INVALID_PARAM;
+  if (arena_size < spark_sosfilt_f32_slot_size(filter))
+    return SPARK_ERR_INVALID_SIZE;
+
+  unsigned char *base = spark_align_ptr(arena, SPARK_SOSFILT_ALIGN);
+  struct spark_sosfilt_f32_slot_state *state =
+      (struct spark_sosfilt_f32_slot_state *)base;
+  base += spark_align_up(sizeof(*state), SPARK_SOSFILT_ALIGN);
+
+  for (uint32_t i = 0; i < 4; ++i) {
+    state->sets[i] = (float *)base;
+    memcpy(state->sets[i], filter->coefficients, n * sizeof(float));
+    base += spark_align_up(n * sizeof(float), SPARK_SOSFILT_ALIGN);
+  }
+  state->current = 0;
+  state->previous = 1;
+  state->back = 2;
+  atomic_init(&state->middle, 3);
+
+  slot->n_coeffs = n;
+  slot->state = state;
+  filter->coefficients = state->sets[state->current];
+
+  return SPARK_NOERROR;
+}
+
+/**
+ * @brief Control thread: the set to fill with the next coefficients.
+ *
+ * Holds `slot->n_coeffs` floats in the filter's coefficient layout, private
+ * to the control thread until spark_sosfilt_f32_slot_publish(). It contains
+ * an older set, not the last one published, so write it in full (the design
+ * functions, e.g. spark_design_biquad_f32(), can write straight into it).
+ *
+ * @param[in] slot Slot from spark_sosfilt_f32_slot_init().
+ * @return The back set.
+ */
+float *spark_sosfilt_f32_slot_begin(spark_sosfilt_f32_slot_t *slot)
+{
+  assert(slot && slot->state);
+  return slot->state->sets[slot->state->back];
+}
+
+/**
+ * @brief Control thread: hand the set from spark_sosfilt_f32_slot_begin() to
+ * the audio thread.
+ *
+ * Swaps it with the middle set in one atomic exchange (release, so the
+ * audio thread sees every coefficient written before). Publishing again
+ * before the audio thread has acquired replaces the pending set: only the
+ * newest design is ever picked up.
+ *
+ * @param[in,out] slot Slot from spark_sosfilt_f32_slot_init().
+ */
+void spark_sosfilt_f32_slot_publish(spark_sosfilt_f32_slot_t *slot)
+{
+  assert(slot && slot->state);
+  struct spark_sosfilt_f32_slot_state *state = slot->state;
+
+  const uint_fast32_t prev = atomic_exchange_explicit(
+      &state->middle, state->back | SLOT_FRESH, memory_order_acq_rel);
+  state->back = (uint32_t)(prev & SLOT_INDEX);
+}
+
+/**
+ * @brief Control thread: copy @p coefficients into the slot and publish them.
+ *
+ * @param[in,out] slot Slot from spark_sosfilt_f32_slot_init().
+ * @param[in] coefficients `slot->n_coeffs` floats in the filter's layout.
+ */
+void spark_sosfilt_f32_slot_store(spark_sosfilt_f32_slot_t *slot,
+                                  const float *coefficients)
+{
+  assert(slot && coefficients);
+  memcpy(spark_sosfilt_f32_slot_begin(slot), coefficients,
+         slot->n_coeffs * sizeof(float));
+  spark_sosfilt_f32_slot_publish(slot);
+}
+
+/**
+ * @brief Audio thread: pick up the newest published set, if any.
+ *
+ * Stores the current set in `*coefficients` (typically
+ * `&filter.coefficients`, or `&plan.coefficients` of a prepared plan, whose
+ * layout is unchanged) and returns whether it changed. Costs one relaxed
+ * load when nothing was published, one atomic exchange otherwise.
+ *
+ * The set in use before a change stays untouched until the next acquire,
+ * so it can be the start of a ramp:
+ *
+ * @code
+ * const float *next;
+ * if (spark_sosfilt_f32_slot_acquire(&slot, &next)) {
+ *   spark_sosfilt_f32_ramp(&filter, next);  // from filter.coefficients
+ *   filter.coefficients = next;
+ * } else {
+ *   spark_sosfilt_f32(&filter);
+ * }
+ * @endcode
+ *
+ * @param[in,out] slot Slot from spark_sosfilt_f32_slot_init().
+ * @param[out] coefficients Receives the current set.
+ * @return true if a newly published set was picked up.
+ */
+bool spark_sosfilt_f32_slot_acquire(spark_sosfilt_f32_slot_t *slot,
+                                    const float **coefficients)
+{
+  assert(slot && slot->state && coefficients);
+  struct spark_sosfilt_f32_slot_state *state = slot->state;
+
+  bool changed = false;
+  if (atomic_load_explicit(&state->middle, memory_order_relaxed) & SLOT_FRESH) {
+    /* Give back the oldest set; the one in use becomes the ramp origin. */
+    const uint_fast32_t next =
+        atomic_exchange_explicit(&state->middle, state->previous, memory_order_acq_rel);
+    state->previous = state->current;
+    state->current = (uint32_t)(next & SLOT_INDEX);
+    changed = true;
+  }
+
+  *coefficients = state->sets[state->current];
+  return changed;
+}
@@ -0,0 +1,402 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "spark/iir_filter.h"
+
+#include "denormal/denormal_internal.h"
+#include "dispatch/kernels.h"
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/** Upper bound on time chunks per call (bounds the on-stack state tables). */
+#define SOSFILT_TIME_MAX_CHUNKS 128
+
+/** Sections folded into one state-space system; longer cascades take several. */
+#define SOSFILT_TIME_MAX_STAGES 8
+
+/** Order of one folded system. */
+#define SOSFILT_TIME_MAX_ORDER (SOSFILT_TIME_MAX_STAGES * 2)
+
+/** Shortest chunk worth splitting off; below this the fix-up dominates. */
+#define SOSFILT_TIME_MIN_CHUNK 1024
+
+/** Chunk lengths are a multiple of this plus one cache line of floats. */
+#define SOSFILT_TIME_SKEW 1024
+
+/**
+ * @brief Shared description of one pass over one channel and stage block.
+ *
+ * Chunk j of the channel starts at sample `j * len` and, viewed through the
+ * kernels, is simply lane j of a planar block whose channel stride is
+ * `len * sample_stride`. Each task owns a run of `per_task` chunks.
+ */
+typedef struct sosfilt_f32_time {
+  const spark_kernels_t *kernels;
+  const float *coefficients; /**< 5 floats per stage of the block. */
+  const float *input;        /**< Channel base read by the zero-state pass. */
+  float *output;             /**< Channel base written by both passes. */
+  float *zero_states;        /**< Per chunk: end state from zero state. */
+  float *start_states;       /**< Per chunk: true start state (consumed). */
+  size_t sample_stride;
+  size_t len;      /**< Samples per chunk but the last. */
+  size_t last_len; /**< Samples in the last chunk. */
+  uint32_t n_stages;
+  uint32_t n_chunks;
+  uint32_t per_task;
+} sosfilt_f32_time_t;
+
+/**
+ * @brief Filter chunks `[first, first + count)` from zero state into @p time->output.
+ */
+static void time_filter(const sosfilt_f32_time_t *time, uint32_t first, uint32_t count,
+                        size_t n_samples)
+{
+  const size_t at = (size_t)first * time->len * time->sample_stride;
+  const sosfilt_f32_args_t args = {
+      .coefficients = time->coefficients,
+      .coeff_stride = 0,
+      .states = time->zero_states + (size_t)first * time->n_stages * 2,
+      .input = time->input + at,
+      .output = time->output + at,
+      .chan_stride = time->len * time->sample_stride,
+      .sample_stride = time->sample_stride,
+      .n_chan = count,
+      .n_samples = (uint32_t)n_samples,
+      .n_stages = time->n_stages,
+  };
+
+  time->kernels->sosfilt_f32_lanes(&args);
+}
+
+/**
+ * @brief Add the zero-input response of chunks `[first, first + count)`.
+ */
+static void time_fixup(const sosfilt_f32_time_t *time, uint32_t first, uint32_t count,
+                       size_t n_samples)
+{
+  const sosfilt_f32_fixup_args_t args = {
+      .coefficients = time->coefficients,
+      .states = time->start_states + (size_t)first * time->n_stages * 2,
+      .data = time->output + (size_t)first * time->len * time->sample_stride,
+      .chan_stride = time->len * time->sample_stride,
+      .sample_stride = time->sample_stride,
+      .n_chan = count,
+      .n_samples = (uint32_t)n_samples,
+      .n_stages = time->n_stages,
+  };
+
+  time->kernels->sosfilt_f32_fixup_lanes(&args);
+}
+
+/**
+ * @brief Run one pass over the chunks owned by task @p index.
+ *
+ * Full-length chunks go to the kernel as one lane block; a shorter final
+ * chunk is a second call of its own.
+ */
+static void time_pass(const sosfilt_f32_time_t *time, uint32_t index,
+                      void (*pass)(const sosfilt_f32_time_t *, uint32_t, uint32_t, size_t))
+{
+  const uint32_t first = index * time->per_task;
+
+  if (first >= time->n_chunks)
+    return;
+
+  uint32_t count = time->n_chunks - first;
+
+  if (count > time->per_task)
+    count = time->per_task;
+
+  const bool has_last = (first + count == time->n_chunks) && (time->last_len != time->len);
+  const uint32_t full = has_last ? count - 1 : count;
+
+  if (full)
+    pass(time, first, full, time->len);
+
+  if (has_last)
+    pass(time, time->n_chunks - 1, 1, time->last_len);
+}
+
+static void time_filter_task(void *arg, uint32_t index)
+{
+  time_pass((const sosfilt_f32_time_t *)arg, index, time_filter);
+}
+
+static void time_fixup_task(void *arg, uint32_t index)
+{
+  time_pass((const sosfilt_f32_time_t *)arg, index, time_fixup);
+}
+
+static void time_run(const spark_executor_t *executor, sosfilt_f32_time_t *time,
+                     spark_task_fn fn, uint32_t n_tasks)
+{
+  if (n_tasks > 1)
+    executor->parallel_for(executor->pool, fn, (void *)time, n_tasks);
+  else
+    fn((void *)time, 0);
+}
+
+/**
+ * @brief Advance the state of @p n_stages sections by one sample of silence.
+ *
+ * @p s holds `{s1, s2}` per stage, the layout the kernels use, so a unit
+ * vector in, a column of the cascade's transition matrix out.
+ */
+static void time_step(const float *c, uint32_t n_stages, const double *s, double *next)
+{
+  double u = 0.0;
+
+  for (uint32_t k = 0; k < n_stages; ++k, c += 5) {
+    const double y = c[0] * u + s[k * 2];
+    next[k * 2] = c[1] * u + c[3] * y + s[k * 2 + 1];
+    next[k * 2 + 1] = c[2] * u + c[4] * y;
+    u = y;
+  }
+}
+
+/**
+ * @brief `r = a * b` for square matrices of order @p n, row-major.
+ */
+static void time_multiply(double *r, const double *a, const double *b, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; ++i) {
+    for (uint32_t j = 0; j < n; ++j) {
+      double acc = 0.0;
+      for (uint32_t k = 0; k < n; ++k)
+        acc += a[i * n + k] * b[k * n + j];
+      r[i * n + j] = acc;
+    }
+  }
+}
+
+/**
+ * @brief `r = m^e` for a square matrix of order @p n, by squaring.
+ */
+static void time_power(double *r, const double *m, uint32_t n, size_t e)
+{
+  double base[SOSFILT_TIME_MAX_ORDER * SOSFILT_TIME_MAX_ORDER];
+  double t[SOSFILT_TIME_MAX_ORDER * SOSFILT_TIME_MAX_ORDER];
+  const size_t size = sizeof(double) * n * n;
+
+  memcpy(base, m, size);
+
+  for (uint32_t i = 0; i < n; ++i)
+    for (uint32_t j = 0; j < n; ++j)
+      r[i * n + j] = (i == j) ? 1.0 : 0.0;
+
+  while (e) {
+    if (e & 1) {
+      time_multiply(t, r, base, n);
+      memcpy(r, t, size);
+    }
+
+    e >>= 1;
+
+    if (e) {
+      time_multiply(t, base, base, n);
+      memcpy(base, t, size);
+    }
+  }
+}
+
+/**
+ * @brief Run a prepared filter with each channel's time axis split into chunks.
+ *
+ * For long blocks of few channels (a mono file), where
+ * spark_sosfilt_f32_execute_parallel() has nothing to split. Up to
+ * SOSFILT_TIME_MAX_STAGES sections at a time are treated as one linear
+ * system `S' = M S + N x` over their stacked states, so a chunk's output is
+ * its output from zero state plus the zero-input response of its true start
+ * state. Each block of stages therefore runs in three steps:
+ *
+ * 1. every chunk is filtered from zero state, all chunks at once: they are
+ *    handed to the cross-lane kernel as the lanes of a virtual planar block,
+ *    so one SIMD vector advances VF32_LANES points in time per step, and
+ *    runs of chunks are spread over the pool's workers;
+ * 2. a short serial scan, in double, carries the true state across chunk
+ *    boundaries: `S[j + 1] = Z[j] + M^len S[j]`, with `S[0]` the plan's
+ *    state and `Z[j]` chunk j's end state from zero;
+ * 3. every chunk gets the response of the cascade to silence from `S[j]`
+ *    added, again one chunk per lane. The response decays, so only the head
+ *    of each chunk is touched.
+ *
+ * The scan is O(chunks), at most a few hundred small matrix products, so it
+ * is not itself parallelized. The plan's states are read as the start state
+ * and updated to the end state as by spark_sosfilt_f32_execute(). Results
+ * match the serial path to rounding, not bit-exactly; filters with poles
+ * very close to the unit circle lose accuracy in the fix-up first. Blocks
+ * too short to yield two chunks of SOSFILT_TIME_MIN_CHUNK samples and
+ * packed plans fall back to the serial call. Nothing is allocated.
+ *
+ * @param[in] plan Plan from spark_sosfilt_f32_prepare(), not packed, over a single
+ *                 buffer (not @ref SPARK_LAYOUT_PLANAR_PTR).
+ * @param[in] executor Thread pool, or NULL to split across SIMD lanes only.
+ * @param[in] input Input samples in the prepared layout.
+ * @param[out] output Output samples in the prepared layout (may equal @p input).
+ */
+void spark_sosfilt_f32_execute_time_parallel(const spark_sosfilt_f32_plan_t *plan,
+                                             const spark_executor_t *executor,
+                                             const float *input, float *output)
+{
+  assert(plan && input && output);
+  assert(!plan->planes);
+
+  const spark_kernels_t *kernels = spark_kernels();
+  const size_t n_samples = plan->n_samples;
+  uint32_t n_tasks = (executor && executor->parallel_for) ? executor->n_workers : 1;
+
+  if (n_tasks < 1)
+    n_tasks = 1;
+
+  size_t n_chunks = (size_t)n_tasks * kernels->f32_lanes;
+  const size_t max_chunks = n_samples / SOSFILT_TIME_MIN_CHUNK;
+
+  if (n_chunks > max_chunks)
+    n_chunks = max_chunks;
+  if (n_chunks > SOSFILT_TIME_MAX_CHUNKS)
+    n_chunks = SOSFILT_TIME_MAX_CHUNKS;
+
+  if (n_chunks < 2 || plan->packed) {
+    spark_sosfilt_f32_execute(plan, input, output);
+    return;
+  }
+
+  float zero_states[SOSFILT_TIME_MAX_CHUNKS * SOSFILT_TIME_MAX_ORDER];
+  float start_states[SOSFILT_TIME_MAX_CHUNKS * SOSFILT_TIME_MAX_ORDER];
+  double m[SOSFILT_TIME_MAX_ORDER * SOSFILT_TIME_MAX_ORDER];
+  double step[SOSFILT_TIME_MAX_ORDER * SOSFILT_TIME_MAX_ORDER];
+  double last[SOSFILT_TIME_MAX_ORDER * SOSFILT_TIME_MAX_ORDER];
+
+  sosfilt_f32_time_t time = {
+      .kernels = kernels,
+      .zero_states = zero_states,
+      .start_states = start_states,
+      .sample_stride = plan->sample_stride,
+      .len = (n_samples + n_chunks - 1) / n_chunks,
+  };
+
+  /*
+   * The lanes of one vector walk streams `len` samples apart; a power-of-two
+   * distance puts them all in the same cache sets. Skew it by one line.
+   */
+  time.len = ((time.len + SOSFILT_TIME_SKEW - 1) & ~(size_t)(SOSFILT_TIME_SKEW - 1)) + 16;
+
+  /* Rounding the length up can leave trailing chunks empty; drop them. */
+  time.n_chunks = (uint32_t)((n_samples + time.len - 1) / time.len);
+  time.last_len = n_samples - (size_t)(time.n_chunks - 1) * time.len;
+
+  if (time.n_chunks < 2) {
+    spark_sosfilt_f32_execute(plan, input, output);
+    return;
+  }
+
+  /* Workers filter in their own FP mode; only the fix-up here runs in FTZ. */
+  spark_fpmode_t mode;
+
+  if (plan->denormals & SPARK_SOSFILT_FTZ)
+    spark_fpmode_enter(&mode);
+
+  const uint32_t lanes = kernels->f32_lanes;
+  const uint32_t groups = (time.n_chunks + lanes - 1) / lanes;
+  const uint32_t groups_per_task = (groups + n_tasks - 1) / n_tasks;
+
+  time.per_task = groups_per_task * lanes;
+  n_tasks = (time.n_chunks + time.per_task - 1) / time.per_task;
+
+  for (uint32_t chan = 0; chan < plan->n_chan; ++chan) {
+    const size_t io_at = (size_t)chan * plan->chan_stride;
+
+    for (uint32_t stage = 0; stage < plan->n_stages; stage += SOSFILT_TIME_MAX_STAGES) {
+      const uint32_t n_stages = (plan->n_stages - stage < SOSFILT_TIME_MAX_STAGES)
+                                    ? plan->n_stages - stage
+                                    : SOSFILT_TIME_MAX_STAGES;
+      const uint32_t order = n_stages * 2;
+      const float *c =
+          plan->coefficients + (size_t)chan * plan->coeff_stride + (size_t)stage * 5;
+      float *state = plan->states + ((size_t)chan * plan->n_stages + stage) * 2;
+
+      time.coefficients = c;
+      time.n_stages = n_stages;
+      time.input = (stage == 0) ? input + io_at : output + io_at;
+      time.output = output + io_at;
+
+      memset(zero_states, 0, sizeof(float) * order * time.n_chunks);
+      time_run(executor, &time, time_filter_task, n_tasks);
+
+      /* Column i of M is one step of silence from unit state i. */
+      for (uint32_t i = 0; i < order; ++i) {
+        double unit[SOSFILT_TIME_MAX_ORDER] = {0};
+        double column[SOSFILT_TIME_MAX_ORDER];
+
+        unit[i] = 1.0;
+        time_step(c, n_stages, unit, column);
+
+        for (uint32_t r = 0; r < order; ++r)
+          m[r * order + i] = column[r];
+      }
+
+      time_power(step, m, order, time.len);
+      time_power(last, m, order, time.last_len);
+
+      double s[SOSFILT_TIME_MAX_ORDER];
+
+      for (uint32_t k = 0; k < order; ++k)
+        s[k] = state[k];
+
+      for (uint32_t j = 0; j < time.n_chunks; ++j) {
+        const double *p = (j + 1 == time.n_chunks) ? last : step;
+        const float *z = zero_states + (size_t)j * order;
+        double next[SOSFILT_TIME_MAX_ORDER];
+
+        for (uint32_t r = 0; r < order; ++r) {
+          double acc = z[r];
+          for (uint32_t k = 0; k < order; ++k)
+            acc += p[r * order + k] * s[k];
+          next[r] = acc;
+        }
+
+        for (uint32_t k = 0; k < order; ++k) {
+          start_states[(size_t)j * order + k] = (float)s[k];
+          s[k] = next[k];
+        }
+      }
+
+      for (uint32_t k = 0; k < order; ++k)
+        state[k] = (float)s[k];
+
+      time_run(executor, &time, time_fixup_task, n_tasks);
+    }
+  }
+
+  if ((plan->denormals & SPARK_SOSFILT_FLUSH_DENORMALS) &&
+      spark_flush_denormals_f32(plan->states, (size_t)plan->n_chan * plan->n_stages * 2))
+    spark_denormal_record();
+
+  if (plan->denormals & SPARK_SOSFILT_FTZ)
+    spark_fpmode_leave(&mode);
+}
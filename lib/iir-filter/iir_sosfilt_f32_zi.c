@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "spark/iir_filter.h"
+#include "iir-filter/sosfilt_zi.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** `1 + a1 + a2` below this is treated as a pole at DC. */
+#define SOSFILT_ZI_EPSILON 1e-12
+
+bool sosfilt_f32_has_steady(const float *coeff, uint32_t n_stages)
+{
+  for (uint32_t k = 0; k < n_stages; ++k, coeff += 5) {
+    if (fabs(1.0 - coeff[3] - coeff[4]) < SOSFILT_ZI_EPSILON)
+      return false;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Load the step-response steady state of a cascade, scaled by @p x0.
+ *
+ * Section k sees a constant input `g` once settled, `g` being @p x0 times
+ * the DC gain of the sections before it, and its TDF-II state is then
+ * `s1 = y - b0 g`, `s2 = b2 g - a2 y` with `y` its own DC output. Computed
+ * in double so long cascades do not accumulate gain error.
+ */
+bool sosfilt_f32_steady(const float *coeff, uint32_t n_stages, float x0, float *states)
+{
+  double g = x0;
+
+  for (uint32_t k = 0; k < n_stages; ++k, coeff += 5, states += 2) {
+    const double den = 1.0 - coeff[3] - coeff[4];
+
+    if (fabs(den) < SOSFILT_ZI_EPSILON)
+      return false;
+
+    const double y = g * (coeff[0] + coeff[1] + coeff[2]) / den;
+
+    states[0] = (float)(y - coeff[0] * g);
+    states[1] = (float)(coeff[2] * g + coeff[4] * y);
+    g = y;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Load the steady-state response to a step as the filter's state.
+ *
+ * The equivalent of scipy's `sosfilt_zi`: after this call, a constant
+ * input of 1 (or of the block's first sample, with
+ * ::SPARK_SOSFILT_ZI_FIRST_SAMPLE) passes through the cascade at its DC
+ * gain from the very first sample, instead of ringing in from a zero
+ * state. Use it at the start of a stream with a DC offset in place of
+ * discarding warm-up blocks.
+ *
+ * With ::SPARK_SOSFILT_ZI_FIRST_SAMPLE each channel's state is scaled by
+ * sample 0 of that channel in `self->header.input.base`, which must then be
+ * set; the buffer is only read. States are written for every channel, in
+ * the layout spark_sosfilt_f32() uses, and nothing is written on error.
+ *
+ * @param[in,out] self Filter whose `states` are set.
+ * @param[in] zi_flags A combination of ::spark_sosfilt_zi_flags.
+ *
+ * @retval SPARK_NOERROR on success
+ * @retval SPARK_ERR_INVALID_PARAM for NULL arguments, coefficients or states,
+ *         zero stages, a missing input base with
+ *         ::SPARK_SOSFILT_ZI_FIRST_SAMPLE, or a section with a pole at DC
+ *         (`1 + a1 + a2 == 0`, no steady state)
+ * @return Otherwise the error from spark_block_validate().
+ */
+int spark_sosfilt_f32_zi(spark_sosfilt_f32_t *self, uint32_t zi_flags)
+{
+  spark_sosfilt_f32_plan_t plan;
+  int status = spark_sosfilt_f32_prepare(self, &plan);
+
+  if (status != SPARK_NOERROR)
+    return status;
+
+  const bool first_sample = (zi_flags & SPARK_SOSFILT_ZI_FIRST_SAMPLE);
+  const spark_buffer_t *input = &self->header.input;
+
+  if (first_sample && !input->base)
+    return SPARK_ERR_INVALID_PARAM;
+
+  const uint32_t n_sets = plan.coeff_stride ? plan.n_chan : 1;
+
+  for (uint32_t set = 0; set < n_sets; ++set) {
+    if (!sosfilt_f32_has_steady(plan.coefficients + (size_t)set * plan.coeff_stride,
+                                plan.n_stages))
+      return SPARK_ERR_INVALID_PARAM;
+  }
+
+  for (uint32_t chan = 0; chan < plan.n_chan; ++chan) {
+    const float x0 =
+        first_sample ? *(const float *)spark_buffer_channel(input, chan) : 1.0f;
+
+    sosfilt_f32_steady(plan.coefficients + (size_t)chan * plan.coeff_stride,
+                       plan.n_stages, x0,
+                       plan.states + (size_t)chan * plan.n_stages * 2);
+  }
+
+  return SPARK_NOERROR;
+}
@@ -0,0 +1,429 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "spark/iir_filter.h"
+#include "denormal/denormal_internal.h"
+#include "dispatch/kernels.h"
+#include "stats/stats_internal.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Buffers and sample range of one execute call.
+ */
+typedef struct sosfilt_f64_io {
+  const void *input;               /**< Single-buffer input, or NULL for planes. */
+  void *output;                    /**< Single-buffer output, or NULL for planes. */
+  const void *const *input_planes; /**< PLANAR_PTR input channels, or NULL. */
+  void *const *output_planes;      /**< PLANAR_PTR output channels, or NULL. */
+  uint32_t first;                  /**< First sample of the run in each channel. */
+  uint32_t count;                  /**< Samples per channel in the run. */
+} sosfilt_f64_io_t;
+
+static void biquad_process_f64(const double coeff[5], double state[2], double *output,
+                               const double *input, size_t samples, size_t stride);
+static void sosfilt_f64_run(const spark_sosfilt_f64_plan_t *plan,
+                            const sosfilt_f64_io_t *io);
+static void sosfilt_f64_cascade(const spark_sosfilt_f64_plan_t *plan,
+                                const sosfilt_f64_io_t *io);
+
+/**
+ * @brief Samples per channel carried through every stage before moving on.
+ *
+ * Also the size of the widening buffer used for f32 I/O (2 KiB of doubles).
+ */
+#define SOSFILT_F64_TILE 256
+
+/**
+ * @brief Cascade of biquad (SOS) filters, double-precision state.
+ *
+ * Identical to spark_sosfilt_f32() (coefficient and state layout, TDF-II
+ * recurrence, tiles, layouts and ::spark_sosfilt_flags) except that
+ * coefficients, state and arithmetic are double. Interleaved, planar,
+ * plane-pointer and strided buffers are all filtered in place.
+ *
+ * ### Buffer formats
+ * - `SPARK_FMT_F64`: double in, double out.
+ * - `SPARK_FMT_F32`: mixed precision. Samples are widened on load and rounded
+ *   to float on store; the state never leaves double precision.
+ *
+ * Input and output must share format and layout (PROCESS block). With shared
+ * coefficients or interleaved buffers, channels run 2/4/8 per vector on
+ * SSE2/NEON, AVX2 and AVX-512 respectively.
+ *
+ * For fixed block shapes, spark_sosfilt_f64_prepare() and
+ * spark_sosfilt_f64_execute() split validation from processing.
+ *
+ * @note Thread safety: @p state belongs to this filter instance; do not share
+ * it across threads or filter chains without external synchronization.
+ *
+ * @param[in,out] self Pointer to instance
+ */
+void spark_sosfilt_f64(spark_sosfilt_f64_t *self)
+{
+  assert(self);
+  spark_sosfilt_f64_plan_t plan;
+  int status = spark_sosfilt_f64_prepare(self, &plan);
+
+  assert(status == SPARK_NOERROR);
+
+  if (status != SPARK_NOERROR) {
+    return;
+  }
+
+  assert(self->header.input.base && self->header.output.base);
+
+  sosfilt_f64_io_t io = {.count = plan.n_samples};
+
+  if (plan.planes) {
+    io.input_planes = self->header.input.base;
+    io.output_planes = self->header.output.base;
+  } else {
+    io.input = self->header.input.base;
+    io.output = self->header.output.base;
+  }
+
+  sosfilt_f64_run(&plan, &io);
+}
+
+/**
+ * @brief Validate a double-precision filter once and resolve its plan.
+ *
+ * Same contract as spark_sosfilt_f32_prepare(); the plan also records
+ * whether the buffers are F32 (mixed precision) or F64.
+ *
+ * @param[in] self Filter to prepare; only the header shape is checked.
+ * @param[out] plan Resolved plan.
+ *
+ * @retval SPARK_NOERROR on success
+ * @retval SPARK_ERR_INVALID_PARAM for NULL arguments, coefficients or states,
+ *         or zero stages
+ * @return Otherwise the error from spark_block_validate().
+ */
+int spark_sosfilt_f64_prepare(const spark_sosfilt_f64_t *self,
+                              spark_sosfilt_f64_plan_t *plan)
+{
+  if (!self || !plan)
+    return SPARK_ERR_INVALID_PARAM;
+
+  const spark_buffer_t *in = &self->header.input;
+  const uint32_t fmt = spark_buffer_get_format(in->flags);
+  const uint32_t layout = spark_buffer_get_layout(in->flags);
+  const bool io_f32 = (fmt == SPARK_FMT_F32);
+  const bool known =
+      (layout == SPARK_LAYOUT_INTERLEAVED || layout == SPARK_LAYOUT_PLANAR ||
+       layout == SPARK_LAYOUT_PLANAR_PTR || layout == SPARK_LAYOUT_STRIDED);
+
+  /* Bases are bound at execute time: validate the shape only. */
+  spark_block_t shape = self->header;
+  shape.input.base = &shape;
+  shape.output.base = &shape;
+
+  int status = spark_block_validate(&shape, (io_f32 ? SPARK_FMT_F32 : SPARK_FMT_F64) |
+                                                (known ? layout : SPARK_LAYOUT_PLANAR) |
+                                                SPARK_BLOCK_PROCESS);
+  if (status != SPARK_NOERROR)
+    return status;
+
+  if (!self->coefficients || !self->states || self->n_stages == 0)
+    return SPARK_ERR_INVALID_PARAM;
+
+  const uint32_t n_chan = in->channels;
+  const uint32_t n_samples = in->samples;
+  const bool share_sos = (self->flags & SPARK_SOSFILT_SHARE_SOS);
+  const spark_kernels_t *kernels = spark_kernels();
+
+  plan->coefficients = self->coefficients;
+  plan->coeff_stride = share_sos ? 0 : (size_t)self->n_stages * 5;
+  plan->states = self->states;
+
+  /* Channel strides as in spark_sosfilt_f32_prepare(). */
+  switch (layout) {
+  case SPARK_LAYOUT_INTERLEAVED:
+    plan->chan_stride = 1;
+    break;
+  case SPARK_LAYOUT_PLANAR_PTR:
+    plan->chan_stride = 0;
+    break;
+  case SPARK_LAYOUT_STRIDED:
+    plan->chan_stride = in->channel_stride;
+    break;
+  default:
+    plan->chan_stride = n_samples;
+    break;
+  }
+  plan->sample_stride = spark_buffer_sample_stride(in);
+  plan->planes = (layout == SPARK_LAYOUT_PLANAR_PTR);
+  plan->n_chan = n_chan;
+  plan->n_samples = n_samples;
+  plan->n_stages = self->n_stages;
+  plan->io_f32 = io_f32;
+  plan->denormals = self->flags & (SPARK_SOSFILT_FTZ | SPARK_SOSFILT_FLUSH_DENORMALS);
+  plan->lanes = ((share_sos || plan->chan_stride == 1) && (n_chan > 1) &&
+                 (kernels->f64_lanes > 1))
+                    ? kernels->sosfilt_f64_lanes
+                    : NULL;
+
+  return SPARK_NOERROR;
+}
+
+/**
+ * @brief Run a prepared double-precision filter on one block.
+ *
+ * @param[in] plan Plan from spark_sosfilt_f64_prepare().
+ * @param[in] input Input samples (float or double, as prepared).
+ * @param[out] output Output samples; may be the same buffer as @p input.
+ */
+void spark_sosfilt_f64_execute(const spark_sosfilt_f64_plan_t *plan, const void *input,
+                               void *output)
+{
+  assert(plan && input && output);
+  assert(!plan->planes);
+
+  const sosfilt_f64_io_t io = {
+      .input = input, .output = output, .count = plan->n_samples};
+  sosfilt_f64_run(plan, &io);
+}
+
+/**
+ * @brief Run a prepared double-precision filter on host channel arrays.
+ *
+ * Double counterpart of spark_sosfilt_f32_execute_planes(): channel k is
+ * read from `input[k]` and written to `output[k]`.
+ *
+ * @param[in] plan Plan from spark_sosfilt_f64_prepare() over plane pointers.
+ * @param[in] input `n_chan` input planes (float or double, as prepared).
+ * @param[out] output `n_chan` output planes; may be the input planes.
+ */
+void spark_sosfilt_f64_execute_planes(const spark_sosfilt_f64_plan_t *plan,
+                                      const void *const *input, void *const *output)
+{
+  assert(plan && input && output);
+  assert(plan->planes);
+
+  const sosfilt_f64_io_t io = {
+      .input_planes = input, .output_planes = output, .count = plan->n_samples};
+  sosfilt_f64_run(plan, &io);
+}
+
+/**
+ * @brief Run a prepared double-precision filter on samples `[first, first + count)`.
+ *
+ * Double counterpart of spark_sosfilt_f32_execute_range(): the buffers are
+ * the full prepared block and only the segment is filtered, with no
+ * revalidation.
+ *
+ * @param[in] plan Plan from spark_sosfilt_f64_prepare().
+ * @param[in] input Input block (float or double, as prepared; plane pointer
+ *                  plans use spark_sosfilt_f64_execute_planes_range()).
+ * @param[out] output Output block; may be the same buffer as @p input.
+ * @param[in] first First sample of the segment.
+ * @param[in] count Samples in the segment; `first + count <= n_samples`.
+ */
+void spark_sosfilt_f64_execute_range(const spark_sosfilt_f64_plan_t *plan,
+                                     const void *input, void *output, uint32_t first,
+                                     uint32_t count)
+{
+  assert(plan && input && output);
+  assert(!plan->planes);
+  assert(first <= plan->n_samples && count <= plan->n_samples - first);
+
+  if (count == 0)
+    return;
+
+  const sosfilt_f64_io_t io = {
+      .input = input, .output = output, .first = first, .count = count};
+  sosfilt_f64_run(plan, &io);
+}
+
+/**
+ * @brief spark_sosfilt_f64_execute_range() on host channel arrays.
+ *
+ * @param[in] plan Plan from spark_sosfilt_f64_prepare() over plane pointers.
+ * @param[in] input `n_chan` input planes of the full block.
+ * @param[out] output `n_chan` output planes of the full block.
+ * @param[in] first First sample of the segment.
+ * @param[in] count Samples in the segment; `first + count <= n_samples`.
+ */
+void spark_sosfilt_f64_execute_planes_range(const spark_sosfilt_f64_plan_t *plan,
+                                            const void *const *input,
+                                            void *const *output, uint32_t first,
+                                            uint32_t count)
+{
+  assert(plan && input && output);
+  assert(plan->planes);
+  assert(first <= plan->n_samples && count <= plan->n_samples - first);
+
+  if (count == 0)
+    return;
+
+  const sosfilt_f64_io_t io = {
+      .input_planes = input, .output_planes = output, .first = first, .count = count};
+  sosfilt_f64_run(plan, &io);
+}
+
+/**
+ * @brief Shared body of the execute entry points.
+ *
+ * @param[in] io Buffers and the sample range to run.
+ */
+static void sosfilt_f64_run(const spark_sosfilt_f64_plan_t *plan,
+                            const sosfilt_f64_io_t *io)
+{
+  spark_fpmode_t mode;
+
+  if (plan->denormals & SPARK_SOSFILT_FTZ)
+    spark_fpmode_enter(&mode);
+
+  SPARK_STATS_BEGIN();
+
+  if (plan->lanes) {
+    const sosfilt_f64_args_t args = {
+        .coefficients = plan->coefficients,
+        .coeff_stride = plan->coeff_stride,
+        .states = plan->states,
+        .input = io->input,
+        .output = io->output,
+        .input_planes = io->input_planes,
+        .output_planes = io->output_planes,
+        .chan_stride = plan->chan_stride,
+        .sample_stride = plan->sample_stride,
+        .first = io->first,
+        .n_chan = plan->n_chan,
+        .n_samples = io->count,
+        .n_stages = plan->n_stages,
+        .io_f32 = plan->io_f32,
+    };
+    plan->lanes(&args);
+  } else {
+    sosfilt_f64_cascade(plan, io);
+  }
+
+  if ((plan->denormals & SPARK_SOSFILT_FLUSH_DENORMALS) &&
+      spark_flush_denormals_f64(plan->states, (size_t)plan->n_chan * plan->n_stages * 2))
+    spark_denormal_record();
+
+  SPARK_STATS_END(SPARK_STATS_SOSFILT_F64, (size_t)plan->n_chan * io->count);
+
+  if (plan->denormals & SPARK_SOSFILT_FTZ)
+    spark_fpmode_leave(&mode);
+}
+
+/**
+ * @brief Per-channel path of sosfilt_f64_run().
+ */
+static void sosfilt_f64_cascade(const spark_sosfilt_f64_plan_t *plan,
+                                const sosfilt_f64_io_t *io)
+{
+  const uint32_t n_samples = io->count;
+  const uint32_t n_stages = plan->n_stages;
+  const size_t chan_stride = plan->chan_stride;
+  const size_t sample_stride = plan->sample_stride;
+  const size_t first = (size_t)io->first * sample_stride;
+  const bool io_f32 = plan->io_f32;
+
+  double wide[SOSFILT_F64_TILE];
+
+  for (uint32_t chan = 0; chan < plan->n_chan; ++chan) {
+    /* Element offsets below apply to float or double buffers alike. */
+    const void *input = io->input_planes ? io->input_planes[chan] : io->input;
+    void *output = io->output_planes ? io->output_planes[chan] : io->output;
+    const size_t origin = (io->input_planes ? 0 : chan * chan_stride) + first;
+    double *chan_states = plan->states + ((size_t)chan * n_stages * 2);
+    const double *chan_coeff = plan->coefficients + (chan * plan->coeff_stride);
+
+    for (size_t offset = 0; offset < n_samples; offset += SOSFILT_F64_TILE) {
+      const size_t count = (n_samples - offset < SOSFILT_F64_TILE) ? (n_samples - offset)
+                                                                  : SOSFILT_F64_TILE;
+      const size_t at = origin + (offset * sample_stride);
+      const double *src;
+      double *dst;
+      size_t stride;
+
+      if (io_f32) {
+        const float *in = (const float *)input + at;
+        for (size_t i = 0; i < count; ++i)
+          wide[i] = in[i * sample_stride];
+        src = dst = wide;
+        stride = 1;
+      } else {
+        src = (const double *)input + at;
+        dst = (double *)output + at;
+        stride = sample_stride;
+      }
+
+      for (uint32_t stage = 0; stage < n_stages; ++stage) {
+        biquad_process_f64(chan_coeff + (stage * 5), chan_states + (stage * 2), dst, src,
+                           count, stride);
+        src = dst;
+      }
+
+      if (io_f32) {
+        float *out = (float *)output + at;
+        for (size_t i = 0; i < count; ++i)
+          out[i * sample_stride] = (float)wide[i];
+      }
+    }
+  }
+}
+
+/**
+ * @brief Double-precision biquad (SOS) IIR, transposed Direct Form II (TDF-II).
+ *
+ * Double counterpart of biquad_process_f32(): same coefficient layout
+ * {b0, b1, b2, -a1, -a2}, state {w1, w2} and difference equations.
+ *
+ * @param[in] coeff  Pointer to 5 float64 coefficients {b0,b1,b2,a1,a2}.
+ * @param[in,out] state  Pointer to 2 float64 state values {w1,w2} (persist across calls).
+ * @param[out] output Pointer to @p samples float64 output samples.
+ * @param[in] input  Pointer to @p samples float64 input samples.
+ * @param[in] samples Number of mono samples to process.
+ * @param[in] stride Distance, in doubles, between consecutive samples.
+ */
+static void biquad_process_f64(const double coeff[5], double state[2], double *output,
+                               const double *input, size_t samples, size_t stride)
+{
+  const double b0 = coeff[0];
+  const double b1 = coeff[1];
+  const double b2 = coeff[2];
+  const double a1 = coeff[3];
+  const double a2 = coeff[4];
+
+  double s1 = state[0];
+  double s2 = state[1];
+
+  for (size_t i = 0; i < samples; ++i) {
+    double x = input[i * stride];
+    double y = (b0 * x) + s1;
+    s1 = (b1 * x) + (a1 * y) + s2;
+    s2 = (b2 * x) + (a2 * y);
+    output[i * stride] = y;
+  }
+
+  state[0] = s1;
+  state[1] = s2;
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "spark/iir_filter.h"
+#include "iir-filter/sosfilt_zi.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Samples per channel reversed at a time by the backward pass. */
+#define SOSFILTFILT_TILE 256
+
+/**
+ * @brief Sample k of the extension past an edge, `k` = 1 … pad_len.
+ *
+ * @p edge is the edge sample and @p mirror the sample `k` steps inside it.
+ */
+static float sosfiltfilt_pad(uint32_t pad_type, float edge, float mirror)
+{
+  switch (pad_type) {
+  case SPARK_SOSFILTFILT_PAD_ODD:
+    return 2.0f * edge - mirror;
+  case SPARK_SOSFILTFILT_PAD_EVEN:
+    return mirror;
+  default:
+    return edge;
+  }
+}
+
+/**
+ * @brief Zero-phase SOS filtering of a whole signal, as scipy's `sosfiltfilt`.
+ *
+ * Each channel is extended by `pad_len` samples at both edges, filtered
+ * forward, then backward, and the extension is dropped: the magnitude
+ * response is squared and the phase cancels. Both passes start from the
+ * cascade's step-response steady state scaled by the first sample they see,
+ * so a signal sitting at a DC offset causes no start-up transient.
+ *
+ * Neither the padded signal nor a reversed copy is materialized. The
+ * extensions are generated into a buffer of at most
+ * ::SPARK_SOSFILTFILT_MAX_PAD samples on the stack, the forward pass runs
+ * straight from input to output, and the backward pass filters the output
+ * in place through SOSFILTFILT_TILE-sample tiles read and written in
+ * reverse order. The block must be a ::SPARK_BLOCK_PROCESS block of
+ * SPARK_FMT_F32 samples in any layout, and may be filtered in place.
+ *
+ * @param[in,out] self Filter parameters and buffers.
+ *
+ * @retval SPARK_NOERROR on success
+ * @retval SPARK_ERR_INVALID_PARAM for NULL arguments, coefficients or states,
+ *         zero stages, an unknown pad type, a `pad_len` that does not fit,
+ *         or a section with a pole at DC (no steady state)
+ * @return Otherwise the error from spark_block_validate().
+ */
+int spark_sosfiltfilt_f32(spark_sosfiltfilt_f32_t *self)
+{
+  if (!self)
+    return SPARK_ERR_INVALID_PARAM;
+
+  const spark_sosfilt_f32_t filter = {
+      .header = self->header,
+      .coefficients = self->coefficients,
+      .states = self->states,
+      .n_stages = self->n_stages,
+      .flags = self->flags,
+  };
+  spark_sosfilt_f32_plan_t plan;
+  int status = spark_sosfilt_f32_prepare(&filter, &plan);
+
+  if (status != SPARK_NOERROR)
+    return status;
+
+  if (!self->header.input.base || !self->header.output.base ||
+      self->pad_type > SPARK_SOSFILTFILT_PAD_NONE)
+    return SPARK_ERR_INVALID_PARAM;
+
+  const size_t n = plan.n_samples;
+  size_t pad = self->pad_len;
+
+  if (self->pad_type == SPARK_SOSFILTFILT_PAD_NONE) {
+    pad = 0;
+  } else if (pad == 0) {
+    pad = 3 * ((size_t)2 * plan.n_stages + 1);
+    if (pad > n - 1)
+      pad = n - 1;
+  }
+
+  if (pad >= n || pad > SPARK_SOSFILTFILT_MAX_PAD)
+    return SPARK_ERR_INVALID_PARAM;
+
+  const size_t step = plan.sample_stride;
+
+  float ext[SPARK_SOSFILTFILT_MAX_PAD];
+  float tile[SOSFILTFILT_TILE];
+
+  for (uint32_t chan = 0; chan < plan.n_chan; ++chan) {
+    const float *x = spark_buffer_channel(&self->header.input, chan);
+    float *y = spark_buffer_channel(&self->header.output, chan);
+
+    /* One channel of the block, filtered by the per-channel path. */
+    spark_sosfilt_f32_plan_t sub = plan;
+    sub.coefficients = plan.coefficients + (size_t)chan * plan.coeff_stride;
+    sub.states = plan.states + (size_t)chan * plan.n_stages * 2;
+    sub.n_chan = 1;
+    sub.sample_stride = 1;
+    sub.planes = false;
+    sub.lanes = NULL;
+    sub.group = 1;
+
+    const float first = x[0];
+    const float last = x[(n - 1) * step];
+
+    /* Forward: left extension (output discarded), from its first sample. */
+    for (size_t k = 0; k < pad; ++k)
+      ext[k] = sosfiltfilt_pad(self->pad_type, first, x[(pad - k) * step]);
+
+    if (!sosfilt_f32_steady(sub.coefficients, sub.n_stages, pad ? ext[0] : first,
+                            sub.states))
+      return SPARK_ERR_INVALID_PARAM;
+
+    if (pad) {
+      sub.n_samples = (uint32_t)pad;
+      spark_sosfilt_f32_execute(&sub, ext, ext);
+    }
+
+    /* The right extension reads the input, which an in-place pass overwrites. */
+    for (size_t k = 0; k < pad; ++k)
+      ext[k] = sosfiltfilt_pad(self->pad_type, last, x[(n - 2 - k) * step]);
+
+    sub.n_samples = (uint32_t)n;
+    sub.sample_stride = step;
+    spark_sosfilt_f32_execute(&sub, x, y);
+
+    if (pad) {
+      sub.n_samples = (uint32_t)pad;
+      sub.sample_stride = 1;
+      spark_sosfilt_f32_execute(&sub, ext, ext);
+    }
+
+    /* Backward: from the far end of the right extension, reversed in place. */
+    if (!sosfilt_f32_steady(sub.coefficients, sub.n_stages,
+                            pad ? ext[pad - 1] : y[(n - 1) * step], sub.states))
+      return SPARK_ERR_INVALID_PARAM;
+
+    for (size_t k = 0; k < pad / 2; ++k) {
+      const float t = ext[k];
+      ext[k] = ext[pad - 1 - k];
+      ext[pad - 1 - k] = t;
+    }
+
+    if (pad) {
+      sub.n_samples = (uint32_t)pad;
+      sub.sample_stride = 1;
+      spark_sosfilt_f32_execute(&sub, ext, ext);
+    }
+
+    for (size_t end = n; end > 0;) {
+      const size_t count = (end < SOSFILTFILT_TILE) ? end : SOSFILTFILT_TILE;
+
+      for (size_t k = 0; k < count; ++k)
+        tile[k] = y[(end - 1 - k) * step];
+
+      sub.n_samples = (uint32_t)count;
+      sub.sample_stride = 1;
+      spark_sosfilt_f32_execute(&sub, tile, tile);
+
+      for (size_t k = 0; k < count; ++k)
+        y[(end - 1 - k) * step] = tile[k];
+
+      end -= count;
+    }
+  }
+
+  return SPARK_NOERROR;
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "spark/iir_topology.h"
+#include "denormal/denormal_internal.h"
+#include "dispatch/kernels.h"
+#include "stats/stats_internal.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Kernel entry shared by both topologies. */
+typedef void (*topology_kernel_fn)(const sosfilt_f32_args_t *args);
+
+/**
+ * @brief Validate a cascade the way spark_sosfilt_f32_prepare() does.
+ *
+ * SVF and lattice filters share the SOS header, state and flag rules; only
+ * the coefficients per stage differ, so the plan's stride is rescaled to
+ * @p n_coeffs.
+ */
+static int topology_prepare(const spark_block_t *header, const float *coefficients,
+                            float *states, uint32_t n_stages, uint32_t flags,
+                            size_t n_coeffs, spark_sosfilt_f32_plan_t *plan)
+{
+  const spark_sosfilt_f32_t shape = {
+      .header = *header,
+      .coefficients = coefficients,
+      .states = states,
+      .n_stages = n_stages,
+      .flags = flags,
+  };
+
+  int status = spark_sosfilt_f32_prepare(&shape, plan);
+  if (status != SPARK_NOERROR)
+    return status;
+
+  const bool share = (flags & SPARK_SOSFILT_SHARE_SOS);
+  plan->coeff_stride = share ? 0 : (size_t)n_stages * n_coeffs;
+  return SPARK_NOERROR;
+}
+
+/**
+ * @brief Validate, then run @p kernel over the whole block.
+ *
+ * @param[in] target Ramp end coefficients, or NULL for fixed coefficients.
+ * @param[in] stats_id Counter charged with the call (::spark_stats_kernel).
+ */
+static void topology_run(const spark_block_t *header, const float *coefficients,
+                         float *states, uint32_t n_stages, uint32_t flags,
+                         size_t n_coeffs, const float *target, topology_kernel_fn kernel,
+                         int stats_id)
+{
+  spark_sosfilt_f32_plan_t plan;
+  int status =
+      topology_prepare(header, coefficients, states, n_stages, flags, n_coeffs, &plan);
+
+  assert(status == SPARK_NOERROR);
+
+  if (status != SPARK_NOERROR) {
+    return;
+  }
+
+  assert(header->input.base && header->output.base);
+
+  spark_fpmode_t mode;
+
+  if (plan.denormals & SPARK_SOSFILT_FTZ)
+    spark_fpmode_enter(&mode);
+
+  SPARK_STATS_BEGIN();
+
+  const sosfilt_f32_args_t args = {
+      .coefficients = plan.coefficients,
+      .coeff_stride = plan.coeff_stride,
+      .states = plan.states,
+      .input = plan.planes ? NULL : header->input.base,
+      .output = plan.planes ? NULL : header->output.base,
+      .input_planes = plan.planes ? header->input.base : NULL,
+      .output_planes = plan.planes ? header->output.base : NULL,
+      .chan_stride = plan.chan_stride,
+      .sample_stride = plan.sample_stride,
+      .n_chan = plan.n_chan,
+      .n_samples = plan.n_samples,
+      .n_stages = plan.n_stages,
+      .target = target,
+  };
+  kernel(&args);
+
+  if ((plan.denormals & SPARK_SOSFILT_FLUSH_DENORMALS) &&
+      spark_flush_denormals_f32(plan.states, (size_t)plan.n_chan * plan.n_stages * 2))
+    spark_denormal_record();
+
+  SPARK_STATS_END(stats_id, (size_t)plan.n_chan * plan.n_samples);
+  (void)stats_id; /* Unused without SPARK_INSTRUMENT. */
+
+  if (plan.denormals & SPARK_SOSFILT_FTZ)
+    spark_fpmode_leave(&mode);
+}
+
+/**
+ * @brief Filter one block through a cascade of trapezoidal SVF sections.
+ *
+ * Same contract as spark_sosfilt_f32(): every layout, in-place or not, one
+ * channel per SIMD lane. Each section costs one more multiply-add than a
+ * biquad but keeps its poles well-conditioned in f32 at any cutoff.
+ *
+ * @param[in,out] self Pointer to instance
+ */
+void spark_svf_f32(spark_svf_f32_t *self)
+{
+  assert(self);
+  topology_run(&self->header, self->coefficients, self->states, self->n_stages,
+               self->flags, SPARK_SVF_COEFFS, NULL, spark_kernels()->svf_f32_lanes,
+               SPARK_STATS_SVF_F32);
+}
+
+/**
+ * @brief spark_svf_f32() with the coefficients ramped to @p target.
+ *
+ * Sample t is filtered with `c + (t + 1) / n_samples * (target - c)`, as in
+ * spark_sosfilt_f32_ramp(). The integrator gains are re-derived from the
+ * interpolated g and k on every sample (one division per section), so the
+ * cascade stays stable under arbitrary per-sample modulation. Set
+ * `self->coefficients = target` afterwards to hold the new response.
+ *
+ * @param[in,out] self Pointer to instance
+ * @param[in] target End coefficients, same layout as `self->coefficients`.
+ */
+void spark_svf_f32_ramp(spark_svf_f32_t *self, const float *target)
+{
+  assert(self && target);
+  topology_run(&self->header, self->coefficients, self->states, self->n_stages,
+               self->flags, SPARK_SVF_COEFFS, target, spark_kernels()->svf_f32_lanes,
+               SPARK_STATS_SVF_F32);
+}
+
+/**
+ * @brief Filter one block through a cascade of normalized lattice sections.
+ *
+ * Same contract as spark_sosfilt_f32(). Suited to narrow, high-Q
+ * resonances near DC, where direct-form coefficients lose the pole radius
+ * to f32 rounding.
+ *
+ * @param[in,out] self Pointer to instance
+ */
+void spark_lattice_f32(spark_lattice_f32_t *self)
+{
+  assert(self);
+  topology_run(&self->header, self->coefficients, self->states, self->n_stages,
+               self->flags, SPARK_LATTICE_COEFFS, NULL,
+               spark_kernels()->lattice_f32_lanes, SPARK_STATS_LATTICE_F32);
+}
+
+/**
+ * @brief spark_lattice_f32() with the coefficients ramped to @p target.
+ *
+ * All seven values per stage move linearly, as in spark_sosfilt_f32_ramp().
+ * Between two sections from spark_lattice_f32_from_sos() every intermediate
+ * rotation has `k^2 + c^2 <= 1`, so the ramp never leaves the stable region.
+ *
+ * @param[in,out] self Pointer to instance
+ * @param[in] target End coefficients, same layout as `self->coefficients`.
+ */
+void spark_lattice_f32_ramp(spark_lattice_f32_t *self, const float *target)
+{
+  assert(self && target);
+  topology_run(&self->header, self->coefficients, self->states, self->n_stages,
+               self->flags, SPARK_LATTICE_COEFFS, target,
+               spark_kernels()->lattice_f32_lanes, SPARK_STATS_LATTICE_F32);
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "iir-filter/sosfilt_kernels.h"
+#include "iir-filter/sosfilt_tile.h"
+#include "simd/simd_f32.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief One sample of a normalized two-stage lattice with a tap ladder.
+ *
+ * Each rotation `[c -k; k c]` is orthogonal when `c^2 + k^2 = 1`, so the
+ * recursion neither gains energy nor loses it to rounding, whatever the
+ * pole radius. @p w0 and @p w1 are the delay outputs of the inner and outer
+ * stage.
+ */
+static inline vf32_t lattice_step(const vf32_t c[7], vf32_t x, vf32_t *w0, vf32_t *w1)
+{
+  const vf32_t f1 = vf32_sub(vf32_mul(c[3], x), vf32_mul(c[2], *w1));
+  const vf32_t g2 = vf32_fmadd(c[2], x, vf32_mul(c[3], *w1));
+  const vf32_t f0 = vf32_sub(vf32_mul(c[1], f1), vf32_mul(c[0], *w0));
+  const vf32_t g1 = vf32_fmadd(c[0], f1, vf32_mul(c[1], *w0));
+
+  *w0 = f0;
+  *w1 = g1;
+  return vf32_fmadd(c[4], f0, vf32_fmadd(c[5], g1, vf32_mul(c[6], g2)));
+}
+
+/**
+ * @brief Run one normalized-lattice section over a lane tile, in place.
+ *
+ * @param[in,out] tile   Lane tile of @p count samples.
+ * @param[in] count      Samples in the tile.
+ * @param[in] c          Lane coefficients {k1, c1, k2, c2, t0, t1, t2}.
+ * @param[in] ramp       Coefficient ramp replacing @p c, or NULL for fixed
+ *                       coefficients. Every interpolated k lies between its
+ *                       two end values, so a ramp between two valid sets stays
+ *                       inside the unit disc and the section stays stable.
+ * @param[in] left       Samples of the run after this tile's first (ramps only).
+ * @param[in,out] s1     Per-lane inner delay w0.
+ * @param[in,out] s2     Per-lane outer delay w1.
+ */
+static void tile_lattice(float *tile, size_t count, const vf32_t c[7],
+                         const lane_ramp_t *ramp, size_t left, vf32_t *s1, vf32_t *s2)
+{
+  vf32_t w0 = *s1;
+  vf32_t w1 = *s2;
+
+  if (ramp) {
+    const vf32_t one = vf32_set1(1.0f);
+    vf32_t togo = vf32_set1((float)left);
+
+    for (size_t t = 0; t < count; ++t) {
+      vf32_t r[7];
+      lane_ramp_at(r, ramp, togo, 7);
+      togo = vf32_sub(togo, one);
+
+      const vf32_t x = vf32_load(tile + t * VF32_LANES);
+      vf32_store(tile + t * VF32_LANES, lattice_step(r, x, &w0, &w1));
+    }
+  } else {
+    for (size_t t = 0; t < count; ++t) {
+      const vf32_t x = vf32_load(tile + t * VF32_LANES);
+      vf32_store(tile + t * VF32_LANES, lattice_step(c, x, &w0, &w1));
+    }
+  }
+
+  *s1 = w0;
+  *s2 = w1;
+}
+
+void SPARK_ISA_FN(lattice_f32_lanes)(const sosfilt_f32_args_t *args)
+{
+  SPARK_ALIGNED(SPARK_SIMD_ALIGN) float tile[SOSFILT_TILE * VF32_LANES];
+
+  const uint32_t n_chan = args->n_chan;
+  const uint32_t n_stages = args->n_stages;
+  const size_t n_samples = args->n_samples;
+  const size_t step = args->sample_stride;
+  const size_t coeff_stride = args->coeff_stride;
+  const bool adjacent = (args->chan_stride == 1) && !args->input_planes;
+
+  for (uint32_t chan = 0; chan < n_chan; chan += VF32_LANES) {
+    const uint32_t n_lanes =
+        (n_chan - chan < VF32_LANES) ? (n_chan - chan) : VF32_LANES;
+
+    const float *src[VF32_LANES];
+    float *dst[VF32_LANES];
+    float *state[VF32_LANES];
+
+    for (size_t offset = 0; offset < n_samples; offset += SOSFILT_TILE) {
+      const size_t count =
+          (n_samples - offset < SOSFILT_TILE) ? (n_samples - offset) : SOSFILT_TILE;
+      const size_t left = n_samples - 1 - offset;
+
+      lane_io(args, chan, n_lanes, offset, src, dst);
+      tile_gather(tile, src, n_lanes, step, adjacent, count);
+
+      for (uint32_t stage = 0; stage < n_stages; ++stage) {
+        const size_t at = chan * coeff_stride + stage * 7;
+        vf32_t c[7];
+        lane_ramp_t ramp;
+        vf32_t s1, s2;
+
+        lane_coeffs(c, args->coefficients + at, coeff_stride, n_lanes, 7);
+        if (args->target)
+          lane_ramp_init(&ramp, c, args->target + at, coeff_stride, n_lanes, 7,
+                         n_samples);
+
+        for (uint32_t l = 0; l < n_lanes; ++l)
+          state[l] = args->states + ((size_t)(chan + l) * n_stages + stage) * 2;
+
+        lane_states_load(&s1, &s2, state, n_lanes);
+        tile_lattice(tile, count, c, args->target ? &ramp : NULL, left, &s1, &s2);
+        lane_states_store(state, s1, s2, n_lanes);
+      }
+
+      tile_scatter(dst, tile, n_lanes, step, adjacent, count);
+    }
+  }
+}
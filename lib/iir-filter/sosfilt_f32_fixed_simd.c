@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "iir-filter/sosfilt_kernels.h"
+#include "iir-filter/sosfilt_tile.h"
+#include "simd/simd.h"
+#include "simd/simd_f32.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Largest stage count with a fixed-shape kernel. */
+#define FIXED_MAX_STAGES 4
+
+/*
+ * Run the statement for `s = 0 .. n - 1`, written out stage by stage so
+ * every per-stage array is indexed by constants and promoted to registers
+ * (a loop, even of constant count, may be left rolled and keep them in
+ * memory). @p n is a constant <= FIXED_MAX_STAGES at every use.
+ */
+#define FIXED_UNROLL(n, s, ...)                                                          \
+  do {                                                                                   \
+    {                                                                                    \
+      const uint32_t s = 0;                                                              \
+      __VA_ARGS__;                                                                       \
+    }                                                                                    \
+    if ((n) > 1) {                                                                       \
+      const uint32_t s = 1;                                                              \
+      __VA_ARGS__;                                                                       \
+    }                                                                                    \
+    if ((n) > 2) {                                                                       \
+      const uint32_t s = 2;                                                              \
+      __VA_ARGS__;                                                                       \
+    }                                                                                    \
+    if ((n) > 3) {                                                                       \
+      const uint32_t s = 3;                                                              \
+      __VA_ARGS__;                                                                       \
+    }                                                                                    \
+  } while (0)
+
+/**
+ * @brief One sample through every stage, TDF-II as in tile_biquad().
+ *
+ * Stage s of sample t and stage s-1 of sample t+1 are independent, so the
+ * recursions of a cascade overlap instead of running back to back over a
+ * tile.
+ *
+ * @param[in] x          Input vector.
+ * @param[in] c          Per-stage lane coefficients {b0, b1, b2, -a1, -a2}.
+ * @param[in,out] s1     Per-stage first delay elements.
+ * @param[in,out] s2     Per-stage second delay elements.
+ * @param[in] n_stages   Sections in the cascade (a constant at every call).
+ * @return The cascade output.
+ */
+static SPARK_FORCE_INLINE vf32_t fixed_step(vf32_t x, vf32_t c[][5], vf32_t *s1,
+                                            vf32_t *s2, uint32_t n_stages)
+{
+  FIXED_UNROLL(n_stages, s, {
+    const vf32_t y = vf32_fmadd(c[s][0], x, s1[s]);
+    s1[s] = vf32_fmadd(c[s][3], y, vf32_fmadd(c[s][1], x, s2[s]));
+    s2[s] = vf32_fmadd(c[s][4], y, vf32_mul(c[s][2], x));
+    x = y;
+  });
+
+  return x;
+}
+
+/**
+ * @brief Channels `chan .. chan + n_lanes - 1` of the call, one per lane.
+ *
+ * A full group of adjacent interleaved channels is one vector per frame and
+ * is filtered straight from the buffer; any other group goes through a lane
+ * tile.
+ */
+static SPARK_FORCE_INLINE void fixed_group(const sosfilt_f32_args_t *args, uint32_t chan,
+                                           uint32_t n_lanes, uint32_t n_stages)
+{
+  vf32_t c[FIXED_MAX_STAGES][5];
+  vf32_t s1[FIXED_MAX_STAGES];
+  vf32_t s2[FIXED_MAX_STAGES];
+  float *state[FIXED_MAX_STAGES][VF32_LANES];
+
+  FIXED_UNROLL(n_stages, s, {
+    lane_coeffs(c[s], args->coefficients + chan * args->coeff_stride + s * 5,
+                args->coeff_stride, n_lanes, 5);
+
+    for (uint32_t l = 0; l < n_lanes; ++l)
+      state[s][l] = args->states + ((size_t)(chan + l) * n_stages + s) * 2;
+
+    lane_states_load(&s1[s], &s2[s], state[s], n_lanes);
+  });
+
+  const size_t n_samples = args->n_samples;
+  const size_t step = args->sample_stride;
+  const bool adjacent = (args->chan_stride == 1) && !args->input_planes;
+
+  if (n_lanes == VF32_LANES && adjacent) {
+    const float *src = args->input + chan + args->first * step;
+    float *dst = args->output + chan + args->first * step;
+
+    for (size_t t = 0; t < n_samples; ++t) {
+      const vf32_t x = vf32_load(src + t * step);
+      vf32_store(dst + t * step, fixed_step(x, c, s1, s2, n_stages));
+    }
+  } else {
+    SPARK_ALIGNED(SPARK_SIMD_ALIGN) float tile[SOSFILT_TILE * VF32_LANES];
+    const float *src[VF32_LANES];
+    float *dst[VF32_LANES];
+
+    for (size_t offset = 0; offset < n_samples; offset += SOSFILT_TILE) {
+      const size_t count =
+          (n_samples - offset < SOSFILT_TILE) ? (n_samples - offset) : SOSFILT_TILE;
+
+      lane_io(args, chan, n_lanes, offset, src, dst);
+      tile_gather(tile, src, n_lanes, step, adjacent, count);
+
+      for (size_t t = 0; t < count; ++t) {
+        float *p = tile + t * VF32_LANES;
+        vf32_store(p, fixed_step(vf32_load(p), c, s1, s2, n_stages));
+      }
+
+      tile_scatter(dst, tile, n_lanes, step, adjacent, count);
+    }
+  }
+
+  FIXED_UNROLL(n_stages, s, lane_states_store(state[s], s1[s], s2[s], n_lanes));
+}
+
+/** Most channels run by fixed_scalar(). */
+#define FIXED_MAX_SCALAR 2
+
+/**
+ * @brief One or two channels, in scalar registers.
+ *
+ * Used when a vector would leave most lanes idle and still pay a transpose
+ * per frame: each channel runs its own chain, and the chains of a frame
+ * overlap. Grouped like fixed_step() rather than the per-channel path:
+ * `b1 * x + s2` does not depend on this sample's output, which leaves one
+ * multiply-add per stage on the recursion.
+ */
+static SPARK_FORCE_INLINE void fixed_scalar(const sosfilt_f32_args_t *args,
+                                            uint32_t n_stages, uint32_t n_chan)
+{
+  float c[FIXED_MAX_SCALAR][FIXED_MAX_STAGES][5];
+  float s1[FIXED_MAX_SCALAR][FIXED_MAX_STAGES];
+  float s2[FIXED_MAX_SCALAR][FIXED_MAX_STAGES];
+  const float *src[FIXED_MAX_SCALAR];
+  float *dst[FIXED_MAX_SCALAR];
+
+  const size_t step = args->sample_stride;
+
+  for (uint32_t ch = 0; ch < n_chan; ++ch) {
+    const float *coeff = args->coefficients + ch * args->coeff_stride;
+    const float *state = args->states + (size_t)ch * n_stages * 2;
+
+    FIXED_UNROLL(n_stages, s, {
+      for (int k = 0; k < 5; ++k)
+        c[ch][s][k] = coeff[s * 5 + k];
+      s1[ch][s] = state[s * 2];
+      s2[ch][s] = state[s * 2 + 1];
+    });
+
+    src[ch] = (args->input_planes ? args->input_planes[ch]
+                                  : args->input + ch * args->chan_stride) +
+              args->first * step;
+    dst[ch] = (args->output_planes ? args->output_planes[ch]
+                                   : args->output + ch * args->chan_stride) +
+              args->first * step;
+  }
+
+  for (size_t t = 0; t < args->n_samples; ++t) {
+    for (uint32_t ch = 0; ch < n_chan; ++ch) {
+      float x = src[ch][t * step];
+
+      FIXED_UNROLL(n_stages, s, {
+        const float y = (c[ch][s][0] * x) + s1[ch][s];
+        s1[ch][s] = (c[ch][s][3] * y) + ((c[ch][s][1] * x) + s2[ch][s]);
+        s2[ch][s] = (c[ch][s][4] * y) + (c[ch][s][2] * x);
+        x = y;
+      });
+
+      dst[ch][t * step] = x;
+    }
+  }
+
+  for (uint32_t ch = 0; ch < n_chan; ++ch) {
+    float *state = args->states + (size_t)ch * n_stages * 2;
+
+    FIXED_UNROLL(n_stages, s, {
+      state[s * 2] = s1[ch][s];
+      state[s * 2 + 1] = s2[ch][s];
+    });
+  }
+}
+
+/**
+ * @brief Body of every fixed-shape kernel; @p n_stages and @p n_chan are
+ * constants at each expansion, so the loops over them fold away.
+ */
+static SPARK_FORCE_INLINE void fixed_cascade(const sosfilt_f32_args_t *args,
+                                             uint32_t n_stages, uint32_t n_chan)
+{
+  /* Ramps, packed storage and channel-split calls take the generic kernel. */
+  if (args->packed || args->target || args->n_stages != n_stages ||
+      args->n_chan != n_chan) {
+    SPARK_ISA_FN(sosfilt_f32_lanes)(args);
+    return;
+  }
+
+  /* Two channels keep to vectors only while they fill a quarter of one. */
+  if (n_chan == 1 || (n_chan <= FIXED_MAX_SCALAR && n_chan * 4 <= VF32_LANES)) {
+    fixed_scalar(args, n_stages, n_chan);
+    return;
+  }
+
+  for (uint32_t chan = 0; chan < n_chan; chan += VF32_LANES)
+    fixed_group(args, chan, (n_chan - chan < VF32_LANES) ? (n_chan - chan) : VF32_LANES,
+                n_stages);
+}
+
+#define SOSFILT_F32_FIXED_DEFINE(s, c)                                                   \
+  void SPARK_ISA_FN(sosfilt_f32_fixed_##s##x##c)(const sosfilt_f32_args_t *args)         \
+  {                                                                                      \
+    fixed_cascade(args, s, c);                                                           \
+  }
+
+SOSFILT_F32_FIXED_DEFINE(1, 1)
+SOSFILT_F32_FIXED_DEFINE(1, 2)
+SOSFILT_F32_FIXED_DEFINE(1, 8)
+SOSFILT_F32_FIXED_DEFINE(2, 1)
+SOSFILT_F32_FIXED_DEFINE(2, 2)
+SOSFILT_F32_FIXED_DEFINE(2, 8)
+SOSFILT_F32_FIXED_DEFINE(4, 1)
+SOSFILT_F32_FIXED_DEFINE(4, 2)
+SOSFILT_F32_FIXED_DEFINE(4, 8)
@@ -0,0 +1,375 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "iir-filter/sosfilt_kernels.h"
+#include "iir-filter/sosfilt_tile.h"
+#include "simd/simd_f32.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Run one TDF-II section over a lane tile, in place.
+ *
+ * Same recurrence as biquad_process_f32(), with every lane carrying its own
+ * channel. The state is carried in registers and updated on return.
+ *
+ * @param[in,out] tile   Lane tile of @p count samples.
+ * @param[in] count      Samples in the tile.
+ * @param[in] c          Lane coefficients {b0, b1, b2, -a1, -a2}.
+ * @param[in,out] s1     Per-lane first delay element.
+ * @param[in,out] s2     Per-lane second delay element.
+ */
+static void tile_biquad(float *tile, size_t count, const vf32_t c[5], vf32_t *s1,
+                        vf32_t *s2)
+{
+  const vf32_t b0 = c[0];
+  const vf32_t b1 = c[1];
+  const vf32_t b2 = c[2];
+  const vf32_t a1 = c[3];
+  const vf32_t a2 = c[4];
+
+  vf32_t w1 = *s1;
+  vf32_t w2 = *s2;
+
+  for (size_t t = 0; t < count; ++t) {
+    float *p = tile + t * VF32_LANES;
+    vf32_t x = vf32_load(p);
+    vf32_t y = vf32_fmadd(b0, x, w1);
+    w1 = vf32_fmadd(a1, y, vf32_fmadd(b1, x, w2));
+    w2 = vf32_fmadd(a2, y, vf32_mul(b2, x));
+    vf32_store(p, y);
+  }
+
+  *s1 = w1;
+  *s2 = w2;
+}
+
+/**
+ * @brief tile_biquad() with every sample's coefficients taken from @p ramp.
+ *
+ * @param[in] left  Samples of the run after the first one of this tile.
+ */
+static void tile_biquad_ramp(float *tile, size_t count, const lane_ramp_t *ramp,
+                             size_t left, vf32_t *s1, vf32_t *s2)
+{
+  const vf32_t one = vf32_set1(1.0f);
+  vf32_t togo = vf32_set1((float)left);
+
+  vf32_t w1 = *s1;
+  vf32_t w2 = *s2;
+
+  for (size_t t = 0; t < count; ++t) {
+    vf32_t c[5];
+    lane_ramp_at(c, ramp, togo, 5);
+    togo = vf32_sub(togo, one);
+
+    float *p = tile + t * VF32_LANES;
+    vf32_t x = vf32_load(p);
+    vf32_t y = vf32_fmadd(c[0], x, w1);
+    w1 = vf32_fmadd(c[3], y, vf32_fmadd(c[1], x, w2));
+    w2 = vf32_fmadd(c[4], y, vf32_mul(c[2], x));
+    vf32_store(p, y);
+  }
+
+  *s1 = w1;
+  *s2 = w2;
+}
+
+/**
+ * @brief tile_biquad() on a stage whose state lives in channel-major memory.
+ *
+ * @param[in] ramp       Coefficient ramp, or NULL for the fixed @p c.
+ * @param[in] left       Samples of the run after this tile's first (ramps only).
+ * @param[in,out] state  Per-lane pointers to this stage's {s1, s2}.
+ * @param[in] n_lanes    Number of valid lanes.
+ */
+static void tile_biquad_gather(float *tile, size_t count, const vf32_t c[5],
+                               const lane_ramp_t *ramp, size_t left,
+                               float *const *state, uint32_t n_lanes)
+{
+  vf32_t s1, s2;
+  lane_states_load(&s1, &s2, state, n_lanes);
+
+  if (ramp)
+    tile_biquad_ramp(tile, count, ramp, left, &s1, &s2);
+  else
+    tile_biquad(tile, count, c, &s1, &s2);
+
+  lane_states_store(state, s1, s2, n_lanes);
+}
+
+/**
+ * @brief tile_biquad() on a lane-packed stage: every operand is one vector load.
+ *
+ * @param[in] coeff   5 vectors {b0, b1, b2, -a1, -a2} of this group and stage.
+ * @param[in,out] st  2 vectors {s1, s2} of this group and stage.
+ */
+static void tile_biquad_packed(float *tile, size_t count, const float *coeff, float *st)
+{
+  vf32_t c[5];
+  for (int k = 0; k < 5; ++k)
+    c[k] = vf32_load(coeff + k * VF32_LANES);
+
+  vf32_t s1 = vf32_load(st);
+  vf32_t s2 = vf32_load(st + VF32_LANES);
+
+  tile_biquad(tile, count, c, &s1, &s2);
+
+  vf32_store(st, s1);
+  vf32_store(st + VF32_LANES, s2);
+}
+
+void SPARK_ISA_FN(sosfilt_f32_lanes)(const sosfilt_f32_args_t *args)
+{
+  SPARK_ALIGNED(SPARK_SIMD_ALIGN) float tile[SOSFILT_TILE * VF32_LANES];
+
+  const uint32_t n_chan = args->n_chan;
+  const uint32_t n_stages = args->n_stages;
+  const size_t n_samples = args->n_samples;
+  const size_t step = args->sample_stride;
+  const size_t coeff_stride = args->coeff_stride;
+  const bool adjacent = (args->chan_stride == 1) && !args->input_planes;
+
+  for (uint32_t chan = 0; chan < n_chan; chan += VF32_LANES) {
+    const uint32_t n_lanes =
+        (n_chan - chan < VF32_LANES) ? (n_chan - chan) : VF32_LANES;
+
+    const float *src[VF32_LANES];
+    float *dst[VF32_LANES];
+    float *state[VF32_LANES];
+
+    for (size_t offset = 0; offset < n_samples; offset += SOSFILT_TILE) {
+      const size_t count =
+          (n_samples - offset < SOSFILT_TILE) ? (n_samples - offset) : SOSFILT_TILE;
+      const size_t left = n_samples - 1 - offset;
+
+      lane_io(args, chan, n_lanes, offset, src, dst);
+      tile_gather(tile, src, n_lanes, step, adjacent, count);
+
+      /* Every stage runs on the tile before it goes back to memory. */
+      for (uint32_t stage = 0; stage < n_stages; ++stage) {
+        if (args->packed) {
+          const size_t at = (size_t)(chan / VF32_LANES) * n_stages + stage;
+          tile_biquad_packed(tile, count, args->coefficients + at * 5 * VF32_LANES,
+                             args->states + at * 2 * VF32_LANES);
+          continue;
+        }
+
+        const size_t at = chan * coeff_stride + stage * 5;
+        vf32_t c[5];
+        lane_ramp_t ramp;
+
+        lane_coeffs(c, args->coefficients + at, coeff_stride, n_lanes, 5);
+        if (args->target)
+          lane_ramp_init(&ramp, c, args->target + at, coeff_stride, n_lanes, 5,
+                         n_samples);
+
+        for (uint32_t l = 0; l < n_lanes; ++l)
+          state[l] = args->states + ((size_t)(chan + l) * n_stages + stage) * 2;
+
+        tile_biquad_gather(tile, count, c, args->target ? &ramp : NULL, left, state,
+                           n_lanes);
+      }
+
+      tile_scatter(dst, tile, n_lanes, step, adjacent, count);
+    }
+  }
+}
+
+void SPARK_ISA_FN(sosfilt_f32_fixup_lanes)(const sosfilt_f32_fixup_args_t *args)
+{
+  SPARK_ALIGNED(SPARK_SIMD_ALIGN) float tile[SOSFILT_TILE * VF32_LANES];
+  SPARK_ALIGNED(SPARK_SIMD_ALIGN) float data[SOSFILT_TILE * VF32_LANES];
+
+  const uint32_t n_stages = args->n_stages;
+  const size_t n_samples = args->n_samples;
+  const size_t step = args->sample_stride;
+  const bool adjacent = (args->chan_stride == 1);
+
+  for (uint32_t chan = 0; chan < args->n_chan; chan += VF32_LANES) {
+    const uint32_t n_lanes =
+        (args->n_chan - chan < VF32_LANES) ? (args->n_chan - chan) : VF32_LANES;
+    float *const states = args->states + (size_t)chan * n_stages * 2;
+    const size_t n_states = (size_t)n_lanes * n_stages * 2;
+
+    /*
+     * The response decays geometrically; once it is 2^-40 below where it
+     * started it no longer moves a float sample, and carrying on would only
+     * grind through subnormals for the rest of a long chunk.
+     */
+    float limit = 0.0f;
+
+    for (size_t k = 0; k < n_states; ++k)
+      limit = fmaxf(limit, fabsf(states[k]));
+
+    limit = fmaxf(limit * 0x1p-40f, FLT_MIN);
+
+    float *lane[VF32_LANES];
+    float *state[VF32_LANES];
+
+    for (size_t offset = 0; offset < n_samples; offset += SOSFILT_TILE) {
+      const size_t count =
+          (n_samples - offset < SOSFILT_TILE) ? (n_samples - offset) : SOSFILT_TILE;
+
+      for (size_t k = 0; k < count * VF32_LANES; ++k)
+        tile[k] = 0.0f;
+
+      for (uint32_t stage = 0; stage < n_stages; ++stage) {
+        vf32_t c[5];
+        lane_coeffs(c, args->coefficients + stage * 5, 0, n_lanes, 5);
+
+        for (uint32_t l = 0; l < n_lanes; ++l)
+          state[l] = states + ((size_t)l * n_stages + stage) * 2;
+
+        tile_biquad_gather(tile, count, c, NULL, 0, state, n_lanes);
+      }
+
+      for (uint32_t l = 0; l < n_lanes; ++l)
+        lane[l] = args->data + (chan + l) * args->chan_stride + offset * step;
+
+      tile_gather(data, (const float *const *)lane, n_lanes, step, adjacent, count);
+
+      for (size_t t = 0; t < count * VF32_LANES; t += VF32_LANES)
+        vf32_store(data + t, vf32_add(vf32_load(data + t), vf32_load(tile + t)));
+
+      tile_scatter(lane, data, n_lanes, step, adjacent, count);
+
+      bool live = false;
+
+      for (size_t k = 0; k < n_states; ++k)
+        live |= (fabsf(states[k]) >= limit);
+
+      if (!live)
+        break;
+    }
+  }
+}
+
+/**
+ * @brief tile_gather() with a stride per lane, for lanes of unrelated buffers.
+ *
+ * Defers to tile_gather() when every lane has the same stride, which keeps
+ * the transposing path for full groups of planar channels.
+ */
+static void tile_gather_batch(float *tile, const float *const *chan, const size_t *stride,
+                              uint32_t n_lanes, bool uniform, size_t count)
+{
+  if (uniform) {
+    tile_gather(tile, chan, n_lanes, stride[0], false, count);
+    return;
+  }
+
+  for (size_t t = 0; t < count; ++t) {
+    for (uint32_t l = 0; l < VF32_LANES; ++l)
+      tile[t * VF32_LANES + l] = (l < n_lanes) ? chan[l][t * stride[l]] : 0.0f;
+  }
+}
+
+/**
+ * @brief Inverse of tile_gather_batch().
+ */
+static void tile_scatter_batch(float *const *chan, const float *tile,
+                               const size_t *stride, uint32_t n_lanes, bool uniform,
+                               size_t count)
+{
+  if (uniform) {
+    tile_scatter(chan, tile, n_lanes, stride[0], false, count);
+    return;
+  }
+
+  for (size_t t = 0; t < count; ++t) {
+    for (uint32_t l = 0; l < n_lanes; ++l)
+      chan[l][t * stride[l]] = tile[t * VF32_LANES + l];
+  }
+}
+
+void SPARK_ISA_FN(sosfilt_f32_batch)(const sosfilt_f32_batch_args_t *args)
+{
+  SPARK_ALIGNED(SPARK_SIMD_ALIGN) float tile[SOSFILT_TILE * VF32_LANES];
+
+  /* Pass-through section and scratch state for lanes past their last stage. */
+  static const float identity[5] = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+  float spare[VF32_LANES][2];
+
+  const size_t n_samples = args->n_samples;
+
+  for (uint32_t first = 0; first < args->n_lanes; first += VF32_LANES) {
+    const uint32_t n_lanes =
+        (args->n_lanes - first < VF32_LANES) ? (args->n_lanes - first) : VF32_LANES;
+    const sosfilt_f32_lane_t *lane = args->lanes + first;
+
+    size_t stride[VF32_LANES];
+    uint32_t n_stages = 0;
+    bool uniform = true;
+
+    for (uint32_t l = 0; l < n_lanes; ++l) {
+      stride[l] = lane[l].stride;
+      uniform &= (stride[l] == stride[0]);
+      n_stages = (lane[l].n_stages > n_stages) ? lane[l].n_stages : n_stages;
+    }
+
+    const float *src[VF32_LANES];
+    float *dst[VF32_LANES];
+    float *state[VF32_LANES];
+
+    for (size_t offset = 0; offset < n_samples; offset += SOSFILT_TILE) {
+      const size_t count =
+          (n_samples - offset < SOSFILT_TILE) ? (n_samples - offset) : SOSFILT_TILE;
+
+      for (uint32_t l = 0; l < n_lanes; ++l) {
+        src[l] = lane[l].input + offset * stride[l];
+        dst[l] = lane[l].output + offset * stride[l];
+      }
+
+      tile_gather_batch(tile, src, stride, n_lanes, uniform, count);
+
+      for (uint32_t s = 0; s < n_stages; ++s) {
+        SPARK_ALIGNED(SPARK_SIMD_ALIGN) float lanes[5][VF32_LANES] = {{0}};
+
+        for (uint32_t l = 0; l < n_lanes; ++l) {
+          const bool live = s < lane[l].n_stages;
+          const float *c = live ? lane[l].coefficients + s * 5 : identity;
+          for (int k = 0; k < 5; ++k)
+            lanes[k][l] = c[k];
+
+          spare[l][0] = spare[l][1] = 0.0f;
+          state[l] = live ? lane[l].states + s * 2 : spare[l];
+        }
+
+        vf32_t c[5];
+        for (int k = 0; k < 5; ++k)
+          c[k] = vf32_load(lanes[k]);
+
+        tile_biquad_gather(tile, count, c, NULL, 0, state, n_lanes);
+      }
+
+      tile_scatter_batch(dst, tile, stride, n_lanes, uniform, count);
+    }
+  }
+}
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "iir-filter/sosfilt_kernels.h"
+#include "simd/simd_f64.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Samples per channel held in one lane tile (4 KiB at 8 lanes).
+ */
+#define SOSFILT_TILE 64
+
+/** Read VF64_LANES consecutive samples at element @p idx of a buffer. */
+static inline vf64_t io_load(const void *base, size_t idx, bool io_f32)
+{
+  return io_f32 ? vf64_load_f32((const float *)base + idx)
+                : vf64_load((const double *)base + idx);
+}
+
+/** Write VF64_LANES consecutive samples at element @p idx of a buffer. */
+static inline void io_store(void *base, size_t idx, vf64_t v, bool io_f32)
+{
+  if (io_f32)
+    vf64_store_f32((float *)base + idx, v);
+  else
+    vf64_store((double *)base + idx, v);
+}
+
+/** Read one sample at element @p idx of a buffer, widened to double. */
+static inline double io_get(const void *base, size_t idx, bool io_f32)
+{
+  return io_f32 ? (double)((const float *)base)[idx] : ((const double *)base)[idx];
+}
+
+/** Write one sample at element @p idx of a buffer. */
+static inline void io_put(void *base, size_t idx, double v, bool io_f32)
+{
+  if (io_f32)
+    ((float *)base)[idx] = (float)v;
+  else
+    ((double *)base)[idx] = v;
+}
+
+/** Address of element @p idx of a float or double buffer. */
+static inline const void *io_at(const void *base, size_t idx, bool io_f32)
+{
+  return (const unsigned char *)base + idx * (io_f32 ? sizeof(float) : sizeof(double));
+}
+
+/**
+ * @brief Per-lane source and destination of one tile (see the f32 lane_io()).
+ *
+ * Lanes are typeless pointers so float and double buffers share the code.
+ */
+static void lane_io(const sosfilt_f64_args_t *args, uint32_t chan, uint32_t n_lanes,
+                    size_t offset, const void **src, void **dst)
+{
+  const size_t at = (args->first + offset) * args->sample_stride;
+  const bool io_f32 = args->io_f32;
+
+  for (uint32_t l = 0; l < n_lanes; ++l) {
+    if (args->input_planes) {
+      src[l] = io_at(args->input_planes[chan + l], at, io_f32);
+      dst[l] = (void *)io_at(args->output_planes[chan + l], at, io_f32);
+    } else {
+      const size_t base = (chan + l) * args->chan_stride + at;
+      src[l] = io_at(args->input, base, io_f32);
+      dst[l] = (void *)io_at(args->output, base, io_f32);
+    }
+  }
+}
+
+/**
+ * @brief Transpose @p count samples of up to VF64_LANES channels into a tile.
+ *
+ * Same contract as the f32 tile_gather(); @p lane holds each channel's
+ * first sample, float or double as @p io_f32 says.
+ */
+static void tile_gather(double *tile, const void *const *lane, uint32_t n_lanes,
+                        size_t stride, bool adjacent, bool io_f32, size_t count)
+{
+  size_t t = 0;
+
+  if (n_lanes == VF64_LANES && adjacent) {
+    for (; t < count; ++t)
+      vf64_store(tile + t * VF64_LANES, io_load(lane[0], t * stride, io_f32));
+  } else if (n_lanes == VF64_LANES && stride == 1) {
+    for (; t + VF64_LANES <= count; t += VF64_LANES) {
+      vf64_t r[VF64_LANES];
+      for (uint32_t l = 0; l < VF64_LANES; ++l)
+        r[l] = io_load(lane[l], t, io_f32);
+      vf64_transpose(r);
+      for (uint32_t l = 0; l < VF64_LANES; ++l)
+        vf64_store(tile + (t + l) * VF64_LANES, r[l]);
+    }
+  }
+
+  for (; t < count; ++t) {
+    for (uint32_t l = 0; l < VF64_LANES; ++l)
+      tile[t * VF64_LANES + l] =
+          (l < n_lanes) ? io_get(lane[l], t * stride, io_f32) : 0.0;
+  }
+}
+
+/**
+ * @brief Inverse of tile_gather(): write the valid lanes back to the channels.
+ */
+static void tile_scatter(void *const *lane, const double *tile, uint32_t n_lanes,
+                         size_t stride, bool adjacent, bool io_f32, size_t count)
+{
+  size_t t = 0;
+
+  if (n_lanes == VF64_LANES && adjacent) {
+    for (; t < count; ++t)
+      io_store(lane[0], t * stride, vf64_load(tile + t * VF64_LANES), io_f32);
+  } else if (n_lanes == VF64_LANES && stride == 1) {
+    for (; t + VF64_LANES <= count; t += VF64_LANES) {
+      vf64_t r[VF64_LANES];
+      for (uint32_t l = 0; l < VF64_LANES; ++l)
+        r[l] = vf64_load(tile + (t + l) * VF64_LANES);
+      vf64_transpose(r);
+      for (uint32_t l = 0; l < VF64_LANES; ++l)
+        io_store(lane[l], t, r[l], io_f32);
+    }
+  }
+
+  for (; t < count; ++t) {
+    for (uint32_t l = 0; l < n_lanes; ++l)
+      io_put(lane[l], t * stride, tile[t * VF64_LANES + l], io_f32);
+  }
+}
+
+/**
+ * @brief Load one stage's coefficients for a lane group (see the f32 kernel).
+ */
+static void lane_coeffs(vf64_t c[5], const double *coeff, size_t coeff_stride,
+                        uint32_t n_lanes)
+{
+  if (coeff_stride == 0) {
+    for (int k = 0; k < 5; ++k)
+      c[k] = vf64_set1(coeff[k]);
+    return;
+  }
+
+  SPARK_ALIGNED(SPARK_SIMD_ALIGN) double lanes[5][VF64_LANES] = {{0}};
+  for (uint32_t l = 0; l < n_lanes; ++l) {
+    for (int k = 0; k < 5; ++k)
+      lanes[k][l] = coeff[l * coeff_stride + k];
+  }
+  for (int k = 0; k < 5; ++k)
+    c[k] = vf64_load(lanes[k]);
+}
+
+/**
+ * @brief Run one TDF-II section over a lane tile, in place.
+ */
+static void tile_biquad(double *tile, size_t count, const vf64_t c[5],
+                        double *const *state, uint32_t n_lanes)
+{
+  SPARK_ALIGNED(SPARK_SIMD_ALIGN) double s1_lanes[VF64_LANES] = {0};
+  SPARK_ALIGNED(SPARK_SIMD_ALIGN) double s2_lanes[VF64_LANES] = {0};
+
+  for (uint32_t l = 0; l < n_lanes; ++l) {
+    s1_lanes[l] = state[l][0];
+    s2_lanes[l] = state[l][1];
+  }
+
+  const vf64_t b0 = c[0];
+  const vf64_t b1 = c[1];
+  const vf64_t b2 = c[2];
+  const vf64_t a1 = c[3];
+  const vf64_t a2 = c[4];
+
+  vf64_t s1 = vf64_load(s1_lanes);
+  vf64_t s2 = vf64_load(s2_lanes);
+
+  for (size_t t = 0; t < count; ++t) {
+    double *p = tile + t * VF64_LANES;
+    vf64_t x = vf64_load(p);
+    vf64_t y = vf64_fmadd(b0, x, s1);
+    s1 = vf64_fmadd(a1, y, vf64_fmadd(b1, x, s2));
+    s2 = vf64_fmadd(a2, y, vf64_mul(b2, x));
+    vf64_store(p, y);
+  }
+
+  vf64_store(s1_lanes, s1);
+  vf64_store(s2_lanes, s2);
+
+  for (uint32_t l = 0; l < n_lanes; ++l) {
+    state[l][0] = s1_lanes[l];
+    state[l][1] = s2_lanes[l];
+  }
+}
+
+void SPARK_ISA_FN(sosfilt_f64_lanes)(const sosfilt_f64_args_t *args)
+{
+  SPARK_ALIGNED(SPARK_SIMD_ALIGN) double tile[SOSFILT_TILE * VF64_LANES];
+
+  const uint32_t n_chan = args->n_chan;
+  const uint32_t n_stages = args->n_stages;
+  const size_t n_samples = args->n_samples;
+  const size_t step = args->sample_stride;
+  const size_t coeff_stride = args->coeff_stride;
+  const bool adjacent = (args->chan_stride == 1) && !args->input_planes;
+  const bool io_f32 = args->io_f32;
+
+  for (uint32_t chan = 0; chan < n_chan; chan += VF64_LANES) {
+    const uint32_t n_lanes =
+        (n_chan - chan < VF64_LANES) ? (n_chan - chan) : VF64_LANES;
+
+    const void *src[VF64_LANES];
+    void *dst[VF64_LANES];
+    double *state[VF64_LANES];
+
+    for (size_t offset = 0; offset < n_samples; offset += SOSFILT_TILE) {
+      const size_t count =
+          (n_samples - offset < SOSFILT_TILE) ? (n_samples - offset) : SOSFILT_TILE;
+
+      lane_io(args, chan, n_lanes, offset, src, dst);
+      tile_gather(tile, src, n_lanes, step, adjacent, io_f32, count);
+
+      /* Every stage runs on the tile before it goes back to memory. */
+      for (uint32_t stage = 0; stage < n_stages; ++stage) {
+        vf64_t c[5];
+        lane_coeffs(c, args->coefficients + chan * coeff_stride + stage * 5,
+                    coeff_stride, n_lanes);
+
+        for (uint32_t l = 0; l < n_lanes; ++l)
+          state[l] = args->states + ((size_t)(chan + l) * n_stages + stage) * 2;
+
+        tile_biquad(tile, count, c, state, n_lanes);
+      }
+
+      tile_scatter(dst, tile, n_lanes, step, adjacent, io_f32, count);
+    }
+  }
+}
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Internal kernel interface for the SOS filter family. Not installed.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_SOSFILT_KERNELS_H_
+#define LIBSPARK_SOSFILT_KERNELS_H_
+
+#include "dispatch/isa.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Resolved arguments for one SOS cascade call.
+ *
+ * Built by the public entry point after validation so kernels never touch
+ * the block header. All strides are in samples, not bytes.
+ *
+ * With @ref packed set, @ref coefficients and @ref states are not in the
+ * public channel-major layout but lane-transposed for the kernel's own
+ * VF32_LANES: for lane group g and stage s,
+ * `coefficients[((g * n_stages + s) * 5 + k) * VF32_LANES + l]` is
+ * coefficient k of channel `g * VF32_LANES + l`, and likewise with 2 state
+ * values per stage. @ref coeff_stride is then unused.
+ *
+ * With @ref target set (never together with @ref packed), sample t of the
+ * block is filtered with `c + (t + 1) / n_samples * (target - c)`, so the
+ * coefficients reach @ref target exactly on the last sample.
+ */
+typedef struct sosfilt_f32_args {
+  const float *coefficients; /**< 5 floats per stage: {b0, b1, b2, -a1, -a2}. */
+  size_t coeff_stride;       /**< Floats between channel k and k+1 sets; 0 if shared. */
+  float *states;             /**< 2 floats per stage per channel, channel-major. */
+  const float *input;        /**< Base of the input buffer. */
+  float *output;             /**< Base of the output buffer (may equal @ref input). */
+
+  /** Channel pointers replacing @ref input and @ref output, or NULL. */
+  const float *const *input_planes;
+  float *const *output_planes;
+
+  size_t chan_stride;        /**< Distance between channel k and k+1. */
+  size_t sample_stride;      /**< Distance between sample n and n+1 of a channel. */
+  size_t first;              /**< First sample of the run in every channel. */
+  uint32_t n_chan;           /**< Number of channels. */
+  uint32_t n_samples;        /**< Samples per channel in the run. */
+  uint32_t n_stages;         /**< Sections in the cascade. */
+  bool packed;               /**< Lane-packed coefficients and states, see below. */
+  const float *target;       /**< Ramp end coefficients (same layout), or NULL. */
+} sosfilt_f32_args_t;
+
+/**
+ * @brief Resolved arguments for one double-precision SOS cascade call.
+ *
+ * Coefficients and state are always double; the buffers hold doubles, or
+ * floats when @ref io_f32 is set (mixed precision).
+ */
+typedef struct sosfilt_f64_args {
+  const double *coefficients; /**< 5 doubles per stage: {b0, b1, b2, -a1, -a2}. */
+  size_t coeff_stride;        /**< Doubles between channel k and k+1 sets; 0 if shared. */
+  double *states;             /**< 2 doubles per stage per channel, channel-major. */
+  const void *input;          /**< Base of the input buffer. */
+  void *output;               /**< Base of the output buffer (may equal @ref input). */
+
+  /** Channel pointers replacing @ref input and @ref output, or NULL. */
+  const void *const *input_planes;
+  void *const *output_planes;
+
+  size_t chan_stride;         /**< Distance between channel k and k+1. */
+  size_t sample_stride;       /**< Distance between sample n and n+1 of a channel. */
+  size_t first;               /**< First sample of the run in every channel. */
+  uint32_t n_chan;            /**< Number of channels. */
+  uint32_t n_samples;         /**< Samples per channel in the run. */
+  uint32_t n_stages;          /**< Sections in the cascade. */
+  bool io_f32;                /**< Buffers hold float rather than double. */
+} sosfilt_f64_args_t;
+
+/**
+ * @brief Arguments for adding a cascade's zero-input response to lanes.
+ *
+ * Lane l covers `data + l * chan_stride`, `n_samples` samples apart by
+ * `sample_stride`. The kernel runs the cascade on silence from the lane's
+ * state in @ref states (same layout as sosfilt_f32_args_t) and adds the
+ * result to the samples, stopping early once the response has decayed
+ * below float resolution. @ref states is scratch: it is advanced in place.
+ */
+typedef struct sosfilt_f32_fixup_args {
+  const float *coefficients; /**< 5 floats per stage, shared by every lane. */
+  float *states;             /**< 2 floats per stage per lane, consumed. */
+  float *data;               /**< Base of lane 0. */
+  size_t chan_stride;        /**< Distance between lane l and l+1. */
+  size_t sample_stride;      /**< Distance between sample n and n+1 of a lane. */
+  uint32_t n_chan;           /**< Number of lanes. */
+  uint32_t n_samples;        /**< Samples per lane. */
+  uint32_t n_stages;         /**< Sections in the cascade. */
+} sosfilt_f32_fixup_args_t;
+
+/**
+ * @brief One channel of a batch: a lane of the batch kernel.
+ *
+ * Coefficients and states are the public per-channel runs (5 and 2 floats
+ * per stage); the buffers are addressed like a strided channel.
+ */
+typedef struct sosfilt_f32_lane {
+  const float *input;        /**< First sample of the channel. */
+  float *output;             /**< First output sample (may equal @ref input). */
+  const float *coefficients; /**< `n_stages * 5` floats. */
+  float *states;             /**< `n_stages * 2` floats. */
+  size_t stride;             /**< Distance between sample n and n+1. */
+  uint32_t n_stages;         /**< Sections in this channel's cascade. */
+} sosfilt_f32_lane_t;
+
+/**
+ * @brief A run of batch lanes sharing one block length.
+ *
+ * Lanes are taken VF32_LANES at a time regardless of which filter they
+ * belong to. A lane with fewer stages than the longest in its group passes
+ * the extra stages through unchanged.
+ */
+typedef struct sosfilt_f32_batch_args {
+  const sosfilt_f32_lane_t *lanes; /**< Lane table. */
+  uint32_t n_lanes;                /**< Entries in @ref lanes. */
+  uint32_t n_samples;              /**< Samples per lane. */
+} sosfilt_f32_batch_args_t;
+
+/** Stage counts, and channel counts, with a fixed-shape SOS kernel each. */
+#define SOSFILT_F32_FIXED_N 3
+
+/**
+ * @brief Row of the fixed-shape SOS kernels for @p n_stages (1, 2 or 4), or -1.
+ */
+static inline int sosfilt_f32_fixed_stages(uint32_t n_stages)
+{
+  switch (n_stages) {
+  case 1:
+    return 0;
+  case 2:
+    return 1;
+  case 4:
+    return 2;
+  default:
+    return -1;
+  }
+}
+
+/**
+ * @brief Column of the fixed-shape SOS kernels for @p n_chan (1, 2 or 8), or -1.
+ */
+static inline int sosfilt_f32_fixed_channels(uint32_t n_chan)
+{
+  switch (n_chan) {
+  case 1:
+    return 0;
+  case 2:
+    return 1;
+  case 8:
+    return 2;
+  default:
+    return -1;
+  }
+}
+
+#ifdef SPARK_ISA
+/**
+ * @brief Cross-channel SOS cascade, any layout the strides can express.
+ *
+ * Channels are processed in groups of VF32_LANES, one channel per vector
+ * lane, so one step of the recursion advances the whole group.
+ */
+void SPARK_ISA_FN(sosfilt_f32_lanes)(const sosfilt_f32_args_t *args);
+
+/**
+ * @brief Cross-channel double-precision SOS cascade (VF64_LANES per group).
+ */
+void SPARK_ISA_FN(sosfilt_f64_lanes)(const sosfilt_f64_args_t *args);
+
+/**
+ * @brief Zero-input response fix-up, VF32_LANES lanes per vector.
+ */
+void SPARK_ISA_FN(sosfilt_f32_fixup_lanes)(const sosfilt_f32_fixup_args_t *args);
+
+/**
+ * @brief Batch of unrelated channels, VF32_LANES lanes per vector.
+ */
+void SPARK_ISA_FN(sosfilt_f32_batch)(const sosfilt_f32_batch_args_t *args);
+
+/**
+ * @brief SOS cascades of one fixed shape, `<stages>x<channels>`.
+ *
+ * Same arguments as sosfilt_f32_lanes(). Every stage advances once per
+ * sample with all coefficients and states held in registers for the whole
+ * call. Calls of another shape, ramps and packed storage go to
+ * sosfilt_f32_lanes().
+ */
+#define SOSFILT_F32_FIXED_DECLARE(s, c)                                                  \
+  void SPARK_ISA_FN(sosfilt_f32_fixed_##s##x##c)(const sosfilt_f32_args_t *args);
+SOSFILT_F32_FIXED_DECLARE(1, 1)
+SOSFILT_F32_FIXED_DECLARE(1, 2)
+SOSFILT_F32_FIXED_DECLARE(1, 8)
+SOSFILT_F32_FIXED_DECLARE(2, 1)
+SOSFILT_F32_FIXED_DECLARE(2, 2)
+SOSFILT_F32_FIXED_DECLARE(2, 8)
+SOSFILT_F32_FIXED_DECLARE(4, 1)
+SOSFILT_F32_FIXED_DECLARE(4, 2)
+SOSFILT_F32_FIXED_DECLARE(4, 8)
+#undef SOSFILT_F32_FIXED_DECLARE
+
+/**
+ * @brief Cross-channel trapezoidal SVF cascade.
+ *
+ * Same arguments as sosfilt_f32_lanes() (never @ref sosfilt_f32_args::packed),
+ * with 5 floats {g, k, m0, m1, m2} per stage and states {ic1eq, ic2eq}.
+ */
+void SPARK_ISA_FN(svf_f32_lanes)(const sosfilt_f32_args_t *args);
+
+/**
+ * @brief Cross-channel normalized-lattice cascade.
+ *
+ * Same arguments as sosfilt_f32_lanes() (never packed), with 7 floats
+ * {k1, c1, k2, c2, t0, t1, t2} per stage and states {w0, w1}.
+ */
+void SPARK_ISA_FN(lattice_f32_lanes)(const sosfilt_f32_args_t *args);
+#endif
+
+#endif /* LIBSPARK_SOSFILT_KERNELS_H_ */
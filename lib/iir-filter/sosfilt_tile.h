@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Lane-tile helpers shared by the per-ISA cascade kernels (SOS, SVF,
+ * lattice). Include only from sources compiled with SPARK_ISA. Not installed.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_SOSFILT_TILE_H_
+#define LIBSPARK_SOSFILT_TILE_H_
+
+#include "iir-filter/sosfilt_kernels.h"
+#include "simd/simd_f32.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Samples per channel held in one lane tile.
+ *
+ * A tile is `SOSFILT_TILE * VF32_LANES` floats (4 KiB at 16 lanes), small
+ * enough that every stage of the cascade runs on it while it stays in L1.
+ * Must be a multiple of the widest lane count.
+ */
+#define SOSFILT_TILE 64
+
+/**
+ * @brief Transpose @p count samples of up to VF32_LANES channels into a tile.
+ *
+ * On return `tile[t * VF32_LANES + l]` holds sample t of channel l. Lanes at
+ * or above @p n_lanes are zero-filled so they stay finite through the
+ * recursion.
+ *
+ * Two shapes take a vector path when the group is full: contiguous planes
+ * (@p stride == 1) are loaded as a square and transposed in registers, and
+ * adjacent interleaved channels (@p adjacent) already form one vector per
+ * frame.
+ *
+ * @param[out] tile     Lane tile, `count * VF32_LANES` floats.
+ * @param[in] chan      Per-lane pointers to the first sample of the tile.
+ * @param[in] n_lanes   Number of valid lanes (1..VF32_LANES).
+ * @param[in] stride    Distance between consecutive samples of one channel.
+ * @param[in] adjacent  True if `chan[l] == chan[0] + l` for every lane.
+ * @param[in] count     Samples to gather (<= SOSFILT_TILE).
+ */
+static inline void tile_gather(float *tile, const float *const *chan, uint32_t n_lanes,
+                               size_t stride, bool adjacent, size_t count)
+{
+  size_t t = 0;
+
+  if (n_lanes == VF32_LANES && adjacent) {
+    for (; t < count; ++t)
+      vf32_store(tile + t * VF32_LANES, vf32_load(chan[0] + t * stride));
+  } else if (n_lanes == VF32_LANES && stride == 1) {
+    /* Full group of contiguous planes: load a square and transpose it. */
+    for (; t + VF32_LANES <= count; t += VF32_LANES) {
+      vf32_t r[VF32_LANES];
+      for (uint32_t l = 0; l < VF32_LANES; ++l)
+        r[l] = vf32_load(chan[l] + t);
+      vf32_transpose(r);
+      for (uint32_t l = 0; l < VF32_LANES; ++l)
+        vf32_store(tile + (t + l) * VF32_LANES, r[l]);
+    }
+  }
+
+  for (; t < count; ++t) {
+    for (uint32_t l = 0; l < VF32_LANES; ++l)
+      tile[t * VF32_LANES + l] = (l < n_lanes) ? chan[l][t * stride] : 0.0f;
+  }
+}
+
+/**
+ * @brief Inverse of tile_gather(): write the valid lanes back to the channels.
+ */
+static inline void tile_scatter(float *const *chan, const float *tile,
+                                uint32_t n_lanes, size_t stride, bool adjacent,
+                                size_t count)
+{
+  size_t t = 0;
+
+  if (n_lanes == VF32_LANES && adjacent) {
+    for (; t < count; ++t)
+      vf32_store(chan[0] + t * stride, vf32_load(tile + t * VF32_LANES));
+  } else if (n_lanes == VF32_LANES && stride == 1) {
+    for (; t + VF32_LANES <= count; t += VF32_LANES) {
+      vf32_t r[VF32_LANES];
+      for (uint32_t l = 0; l < VF32_LANES; ++l)
+        r[l] = vf32_load(tile + (t + l) * VF32_LANES);
+      vf32_transpose(r);
+      for (uint32_t l = 0; l < VF32_LANES; ++l)
+        vf32_store(chan[l] + t, r[l]);
+    }
+  }
+
+  for (; t < count; ++t) {
+    for (uint32_t l = 0; l < n_lanes; ++l)
+      chan[l][t * stride] = tile[t * VF32_LANES + l];
+  }
+}
+
+/**
+ * @brief Load one stage's coefficients for a lane group.
+ *
+ * With @p coeff_stride == 0 every lane shares @p coeff and the values are
+ * broadcast; otherwise lane l reads `coeff + l * coeff_stride`. Unused lanes
+ * get zero coefficients.
+ *
+ * @param[out] c            The @p n coefficients as vectors ({b0, b1, b2, -a1,
+ *                          -a2} for a biquad).
+ * @param[in] coeff         Coefficients of lane 0 for this stage.
+ * @param[in] coeff_stride  Distance between the coefficient sets of two lanes.
+ * @param[in] n_lanes       Number of valid lanes.
+ * @param[in] n             Coefficients per stage (at most 8).
+ */
+static inline void lane_coeffs(vf32_t *c, const float *coeff, size_t coeff_stride,
+                               uint32_t n_lanes, int n)
+{
+  if (coeff_stride == 0) {
+    for (int k = 0; k < n; ++k)
+      c[k] = vf32_set1(coeff[k]);
+    return;
+  }
+
+  SPARK_ALIGNED(SPARK_SIMD_ALIGN) float lanes[8][VF32_LANES] = {{0}};
+  for (uint32_t l = 0; l < n_lanes; ++l) {
+    for (int k = 0; k < n; ++k)
+      lanes[k][l] = coeff[l * coeff_stride + k];
+  }
+  for (int k = 0; k < n; ++k)
+    c[k] = vf32_load(lanes[k]);
+}
+
+/**
+ * @brief Coefficient ramp of one stage over a lane group.
+ *
+ * Sample t of an N-sample run is filtered with `end + (N - 1 - t) / N * span`,
+ * where `span = start - end`. Each sample is interpolated afresh rather than
+ * stepped from the previous one, so rounding does not build up over a long
+ * block and the last sample uses @ref end exactly.
+ */
+typedef struct lane_ramp {
+  vf32_t end[8];  /**< Coefficients of the last sample (the ramp target). */
+  vf32_t span[8]; /**< Start minus end coefficients. */
+  vf32_t inv_n;   /**< 1 / N, broadcast. */
+} lane_ramp_t;
+
+/**
+ * @brief Set up the ramp of one stage from @p c to @p target.
+ *
+ * @param[in] c         Start coefficients, from lane_coeffs().
+ * @param[in] target    End coefficients, read as by lane_coeffs().
+ * @param[in] n_samples Length of the run the ramp spans.
+ */
+static inline void lane_ramp_init(lane_ramp_t *ramp, const vf32_t *c, const float *target,
+                                  size_t coeff_stride, uint32_t n_lanes, int n,
+                                  size_t n_samples)
+{
+  lane_coeffs(ramp->end, target, coeff_stride, n_lanes, n);
+
+  for (int k = 0; k < n; ++k)
+    ramp->span[k] = vf32_sub(c[k], ramp->end[k]);
+  ramp->inv_n = vf32_set1(1.0f / (float)n_samples);
+}
+
+/**
+ * @brief Coefficients of the sample @p left samples before the end of the run.
+ *
+ * @param[in] left Broadcast whole number of samples still to come; 0 gives
+ *                 the ramp target exactly.
+ */
+static inline void lane_ramp_at(vf32_t *c, const lane_ramp_t *ramp, vf32_t left, int n)
+{
+  const vf32_t w = vf32_mul(left, ramp->inv_n);
+
+  for (int k = 0; k < n; ++k)
+    c[k] = vf32_fmadd(w, ramp->span[k], ramp->end[k]);
+}
+
+/**
+ * @brief Per-lane pointers to sample @p offset of the run, for channels
+ * `chan .. chan + n_lanes - 1` of @p args (plane pointers or strides).
+ */
+static inline void lane_io(const sosfilt_f32_args_t *args, uint32_t chan,
+                           uint32_t n_lanes, size_t offset, const float **src,
+                           float **dst)
+{
+  const size_t at = (args->first + offset) * args->sample_stride;
+
+  for (uint32_t l = 0; l < n_lanes; ++l) {
+    if (args->input_planes) {
+      src[l] = args->input_planes[chan + l] + at;
+      dst[l] = args->output_planes[chan + l] + at;
+    } else {
+      const size_t base = (chan + l) * args->chan_stride + at;
+      src[l] = args->input + base;
+      dst[l] = args->output + base;
+    }
+  }
+}
+
+/**
+ * @brief Load the two state values of one stage for a lane group.
+ *
+ * @param[in] state  Per-lane pointers to the stage's 2 floats.
+ */
+static inline void lane_states_load(vf32_t *s1, vf32_t *s2, float *const *state,
+                                    uint32_t n_lanes)
+{
+  SPARK_ALIGNED(SPARK_SIMD_ALIGN) float s1_lanes[VF32_LANES] = {0};
+  SPARK_ALIGNED(SPARK_SIMD_ALIGN) float s2_lanes[VF32_LANES] = {0};
+
+  for (uint32_t l = 0; l < n_lanes; ++l) {
+    s1_lanes[l] = state[l][0];
+    s2_lanes[l] = state[l][1];
+  }
+
+  *s1 = vf32_load(s1_lanes);
+  *s2 = vf32_load(s2_lanes);
+}
+
+/**
+ * @brief Inverse of lane_states_load() for the valid lanes.
+ */
+static inline void lane_states_store(float *const *state, vf32_t s1, vf32_t s2,
+                                     uint32_t n_lanes)
+{
+  SPARK_ALIGNED(SPARK_SIMD_ALIGN) float s1_lanes[VF32_LANES];
+  SPARK_ALIGNED(SPARK_SIMD_ALIGN) float s2_lanes[VF32_LANES];
+
+  vf32_store(s1_lanes, s1);
+  vf32_store(s2_lanes, s2);
+
+  for (uint32_t l = 0; l < n_lanes; ++l) {
+    state[l][0] = s1_lanes[l];
+    state[l][1] = s2_lanes[l];
+  }
+}
+
+#endif /* LIBSPARK_SOSFILT_TILE_H_ */
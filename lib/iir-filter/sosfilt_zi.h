@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Steady-state initial conditions shared by the SOS filter entry points.
+ * Not installed.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_SOSFILT_ZI_H_
+#define LIBSPARK_SOSFILT_ZI_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Check that every section of a cascade has a step-response steady state.
+ */
+bool sosfilt_f32_has_steady(const float *coeff, uint32_t n_stages);
+
+/**
+ * @brief Load the step-response steady state of a cascade, scaled by @p x0.
+ *
+ * @return false (with @p states partly written) if a section has a pole at DC.
+ */
+bool sosfilt_f32_steady(const float *coeff, uint32_t n_stages, float x0, float *states);
+
+#endif /* LIBSPARK_SOSFILT_ZI_H_ */
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "iir-filter/sosfilt_kernels.h"
+#include "iir-filter/sosfilt_tile.h"
+#include "simd/simd_f32.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Run one trapezoidal (zero-delay feedback) SVF section over a lane
+ * tile, in place.
+ *
+ * With `a1 = 1 / (1 + g (g + k))`, `a2 = g a1` and `a3 = g a2`, each sample
+ * solves the implicit loop directly:
+ *
+ *     v3 = x - ic2
+ *     v1 = a1 ic1 + a2 v3            (band-pass)
+ *     v2 = ic2 + a2 ic1 + a3 v3      (low-pass)
+ *     ic1 = 2 v1 - ic1,  ic2 = 2 v2 - ic2
+ *     y  = m0 x + m1 v1 + m2 v2
+ *
+ * The states are the integrator outputs, so they stay bounded by the signal
+ * whatever g and k do between samples.
+ *
+ * @param[in,out] tile   Lane tile of @p count samples.
+ * @param[in] count      Samples in the tile.
+ * @param[in] c          Lane coefficients {g, k, m0, m1, m2}.
+ * @param[in,out] s1     Per-lane ic1eq.
+ * @param[in,out] s2     Per-lane ic2eq.
+ */
+static void tile_svf(float *tile, size_t count, const vf32_t c[5], vf32_t *s1,
+                     vf32_t *s2)
+{
+  const vf32_t one = vf32_set1(1.0f);
+  const vf32_t a1 = vf32_div(one, vf32_fmadd(c[0], vf32_add(c[0], c[1]), one));
+  const vf32_t a2 = vf32_mul(c[0], a1);
+  const vf32_t a3 = vf32_mul(c[0], a2);
+  vf32_t ic1 = *s1;
+  vf32_t ic2 = *s2;
+
+  for (size_t t = 0; t < count; ++t) {
+    const vf32_t x = vf32_load(tile + t * VF32_LANES);
+    const vf32_t v3 = vf32_sub(x, ic2);
+    const vf32_t v1 = vf32_fmadd(a1, ic1, vf32_mul(a2, v3));
+    const vf32_t v2 = vf32_add(ic2, vf32_fmadd(a2, ic1, vf32_mul(a3, v3)));
+    ic1 = vf32_sub(vf32_add(v1, v1), ic1);
+    ic2 = vf32_sub(vf32_add(v2, v2), ic2);
+    vf32_store(tile + t * VF32_LANES,
+               vf32_fmadd(c[2], x, vf32_fmadd(c[3], v1, vf32_mul(c[4], v2))));
+  }
+
+  *s1 = ic1;
+  *s2 = ic2;
+}
+
+/**
+ * @brief tile_svf() with every sample's coefficients taken from @p ramp.
+ *
+ * The a1..a3 terms are re-derived from the interpolated g and k each
+ * sample, which is what keeps the section stable under any modulation.
+ *
+ * @param[in] left  Samples of the run after the first one of this tile.
+ */
+static void tile_svf_ramp(float *tile, size_t count, const lane_ramp_t *ramp,
+                          size_t left, vf32_t *s1, vf32_t *s2)
+{
+  const vf32_t one = vf32_set1(1.0f);
+  vf32_t togo = vf32_set1((float)left);
+  vf32_t ic1 = *s1;
+  vf32_t ic2 = *s2;
+
+  for (size_t t = 0; t < count; ++t) {
+    vf32_t c[5];
+    lane_ramp_at(c, ramp, togo, 5);
+    togo = vf32_sub(togo, one);
+
+    const vf32_t a1 = vf32_div(one, vf32_fmadd(c[0], vf32_add(c[0], c[1]), one));
+    const vf32_t a2 = vf32_mul(c[0], a1);
+    const vf32_t a3 = vf32_mul(c[0], a2);
+
+    const vf32_t x = vf32_load(tile + t * VF32_LANES);
+    const vf32_t v3 = vf32_sub(x, ic2);
+    const vf32_t v1 = vf32_fmadd(a1, ic1, vf32_mul(a2, v3));
+    const vf32_t v2 = vf32_add(ic2, vf32_fmadd(a2, ic1, vf32_mul(a3, v3)));
+    ic1 = vf32_sub(vf32_add(v1, v1), ic1);
+    ic2 = vf32_sub(vf32_add(v2, v2), ic2);
+    vf32_store(tile + t * VF32_LANES,
+               vf32_fmadd(c[2], x, vf32_fmadd(c[3], v1, vf32_mul(c[4], v2))));
+  }
+
+  *s1 = ic1;
+  *s2 = ic2;
+}
+
+void SPARK_ISA_FN(svf_f32_lanes)(const sosfilt_f32_args_t *args)
+{
+  SPARK_ALIGNED(SPARK_SIMD_ALIGN) float tile[SOSFILT_TILE * VF32_LANES];
+
+  const uint32_t n_chan = args->n_chan;
+  const uint32_t n_stages = args->n_stages;
+  const size_t n_samples = args->n_samples;
+  const size_t step = args->sample_stride;
+  const size_t coeff_stride = args->coeff_stride;
+  const bool adjacent = (args->chan_stride == 1) && !args->input_planes;
+
+  for (uint32_t chan = 0; chan < n_chan; chan += VF32_LANES) {
+    const uint32_t n_lanes =
+        (n_chan - chan < VF32_LANES) ? (n_chan - chan) : VF32_LANES;
+
+    const float *src[VF32_LANES];
+    float *dst[VF32_LANES];
+    float *state[VF32_LANES];
+
+    for (size_t offset = 0; offset < n_samples; offset += SOSFILT_TILE) {
+      const size_t count =
+          (n_samples - offset < SOSFILT_TILE) ? (n_samples - offset) : SOSFILT_TILE;
+      const size_t left = n_samples - 1 - offset;
+
+      lane_io(args, chan, n_lanes, offset, src, dst);
+      tile_gather(tile, src, n_lanes, step, adjacent, count);
+
+      for (uint32_t stage = 0; stage < n_stages; ++stage) {
+        const size_t at = chan * coeff_stride + stage * 5;
+        vf32_t c[5];
+        vf32_t s1, s2;
+        lane_coeffs(c, args->coefficients + at, coeff_stride, n_lanes, 5);
+
+        for (uint32_t l = 0; l < n_lanes; ++l)
+          state[l] = args->states + ((size_t)(chan + l) * n_stages + stage) * 2;
+        lane_states_load(&s1, &s2, state, n_lanes);
+
+        if (args->target) {
+          lane_ramp_t ramp;
+          lane_ramp_init(&ramp, c, args->target + at, coeff_stride, n_lanes, 5,
+                         n_samples);
+          tile_svf_ramp(tile, count, &ramp, left, &s1, &s2);
+        } else {
+          tile_svf(tile, count, c, &s1, &s2);
+        }
+
+        lane_states_store(state, s1, s2, n_lanes);
+      }
+
+      tile_scatter(dst, tile, n_lanes, step, adjacent, count);
+    }
+  }
+}
@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/* MAP_ANONYMOUS, MAP_HUGETLB and madvise() sit outside strict POSIX.1-2008. */
+#define _DEFAULT_SOURCE
+#define _DARWIN_C_SOURCE
+
+#include "spark/memory.h"
+#include "spark/block.h"
+#include "spark/fft.h"
+#include "spark/fir_filter.h"
+#include "spark/graph.h"
+#include "spark/iir_filter.h"
+#include "spark/meter.h"
+#include "spark/resample.h"
+#include "spark/stream.h"
+#include "memory/memory_internal.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#define SPARK_MEMORY_WIN32
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define SPARK_MEMORY_MMAN
+#endif
+
+_Static_assert(SPARK_FFT_ALIGN <= SPARK_MEMORY_ALIGN &&
+                   SPARK_FIR_ALIGN <= SPARK_MEMORY_ALIGN &&
+                   SPARK_RESAMPLE_ALIGN <= SPARK_MEMORY_ALIGN &&
+                   SPARK_SOSFILT_ALIGN <= SPARK_MEMORY_ALIGN &&
+                   SPARK_GRAPH_ALIGN <= SPARK_MEMORY_ALIGN &&
+                   SPARK_METER_ALIGN <= SPARK_MEMORY_ALIGN &&
+                   SPARK_STREAM_ALIGN <= SPARK_MEMORY_ALIGN,
+               "arena alignment must cover every module");
+
+/** Huge page size assumed for rounding (2 MiB on x86-64 and arm64 Linux). */
+#define MEMORY_HUGE_PAGE ((size_t)2 << 20)
+
+#if defined(SPARK_MEMORY_MMAN)
+
+static size_t memory_page_size(void)
+{
+  const long page = sysconf(_SC_PAGESIZE);
+  return (page > 0) ? (size_t)page : 4096;
+}
+
+/** Bytes actually mapped for a block of @p size: whole (huge) pages. */
+static size_t memory_mapped_size(size_t size, uint32_t hints)
+{
+  return spark_align_up(size, (hints & SPARK_MEMORY_HUGE_PAGES) ? MEMORY_HUGE_PAGE
+                                                                : memory_page_size());
+}
+
+static void *system_alloc(void *ctx, size_t size, size_t align, uint32_t hints)
+{
+  (void)ctx;
+  const size_t length = memory_mapped_size(size, hints);
+  const int prot = PROT_READ | PROT_WRITE;
+  const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+  void *p = MAP_FAILED;
+
+#if defined(MAP_HUGETLB)
+  if (hints & SPARK_MEMORY_HUGE_PAGES)
+    p = mmap(NULL, length, prot, flags | MAP_HUGETLB, -1, 0);
+#endif
+
+  if (p == MAP_FAILED) {
+    p = mmap(NULL, length, prot, flags, -1, 0);
+    if (p == MAP_FAILED)
+      return NULL;
+
+    /* Transparent huge pages only line up on huge page boundaries. */
+#if defined(MADV_HUGEPAGE)
+    if (hints & SPARK_MEMORY_HUGE_PAGES)
+      madvise(p, length, MADV_HUGEPAGE);
+#endif
+  }
+
+  if (((uintptr_t)p & (align - 1)) != 0 ||
+      ((hints & SPARK_MEMORY_LOCK) && mlock(p, length) != 0)) {
+    munmap(p, length);
+    return NULL;
+  }
+
+  if (hints & SPARK_MEMORY_PREFAULT) {
+    const size_t page = memory_page_size();
+    for (size_t at = 0; at < length; at += page)
+      ((volatile unsigned char *)p)[at] = 0;
+  }
+
+  return p;
+}
+
+static void system_free(void *ctx, void *ptr, size_t size, uint32_t hints)
+{
+  (void)ctx;
+  /* munmap() drops any lock with the mapping. */
+  munmap(ptr, memory_mapped_size(size, hints));
+}
+
+#else
+
+static void *system_alloc(void *ctx, size_t size, size_t align, uint32_t hints)
+{
+  (void)ctx;
+
+  /* No portable page locking here: refuse rather than hand out unpinned memory. */
+  if (hints & SPARK_MEMORY_LOCK)
+    return NULL;
+
+#if defined(SPARK_MEMORY_WIN32)
+  void *p = _aligned_malloc(size, align);
+#else
+  void *p = aligned_alloc(align, spark_align_up(size, align));
+#endif
+
+  if (p && (hints & SPARK_MEMORY_PREFAULT))
+    memset(p, 0, size);
+
+  return p;
+}
+
+static void system_free(void *ctx, void *ptr, size_t size, uint32_t hints)
+{
+  (void)ctx;
+  (void)size;
+  (void)hints;
+#if defined(SPARK_MEMORY_WIN32)
+  _aligned_free(ptr);
+#else
+  free(ptr);
+#endif
+}
+
+#endif /* SPARK_MEMORY_MMAN */
+
+static const spark_allocator_t system_allocator = {
+    .alloc = system_alloc,
+    .free = system_free,
+    .ctx = NULL,
+};
+
+/**
+ * @brief The allocator spark_arena_reserve() uses when given NULL.
+ *
+ * On POSIX systems each block is its own anonymous mapping, so hints apply
+ * to whole pages: @ref SPARK_MEMORY_HUGE_PAGES tries `MAP_HUGETLB` and
+ * falls back to `madvise(MADV_HUGEPAGE)`, @ref SPARK_MEMORY_LOCK is
+ * `mlock()`, and @ref SPARK_MEMORY_PREFAULT writes one byte per page.
+ * Elsewhere blocks come from the C runtime's aligned allocation and
+ * @ref SPARK_MEMORY_LOCK cannot be honored.
+ *
+ * @return A static allocator; never NULL.
+ */
+const spark_allocator_t *spark_allocator_system(void)
+{
+  return &system_allocator;
+}
+
+/**
+ * @brief Start an arena over caller memory, or a measuring arena.
+ *
+ * @p memory is aligned up to ::SPARK_MEMORY_ALIGN first, so it may cost up
+ * to `SPARK_MEMORY_ALIGN - 1` bytes of @p size. With `memory == NULL` and
+ * `size == 0` the arena only measures: spark_arena_alloc() returns NULL and
+ * advances @ref spark_arena_t::used as if it had succeeded.
+ *
+ * @param[out] self Arena to initialize.
+ * @param[in] memory Caller-owned block, or NULL to measure.
+ * @param[in] size Bytes at @p memory.
+ *
+ * @retval SPARK_NOERROR on success
+ * @retval SPARK_ERR_INVALID_PARAM for a NULL @p self, or NULL @p memory with
+ *         a non-zero @p size
+ */
+int spark_arena_init(spark_arena_t *self, void *memory, size_t size)
+{
+  if (!self || (!memory && size != 0))
+    return SPARK_ERR_INVALID_PARAM;
+
+  memset(self, 0, sizeof(*self));
+
+  if (memory) {
+    const uintptr_t at = (uintptr_t)memory;
+    const size_t pad = spark_align_up(at, SPARK_MEMORY_ALIGN) - at;
+    self->base = (unsigned char *)memory + ((pad < size) ? pad : size);
+    self->size = (pad < size) ? size - pad : 0;
+  }
+
+  return SPARK_NOERROR;
+}
+
+/**
+ * @brief Reserve an arena's block from an allocator.
+ *
+ * The single call that obtains memory: make it at startup, off the audio
+ * thread, with the total a measuring pass arrived at. Any previous state of
+ * @p self is discarded (release reserved arenas first).
+ *
+ * @param[out] self Arena to initialize.
+ * @param[in] allocator Allocator to draw from, or NULL for
+ *            spark_allocator_system().
+ * @param[in] size Bytes to reserve; must be non-zero.
+ * @param[in] hints A combination of ::spark_memory_hints.
+ *
+ * @retval SPARK_NOERROR on success
+ * @retval SPARK_ERR_INVALID_PARAM for a NULL @p self, a zero @p size, an
+ *         unknown hint, or an allocator without callbacks
+ * @retval SPARK_ERR_NO_MEMORY if the allocator returned NULL or a block
+ *         that is not ::SPARK_MEMORY_ALIGN-aligned
+ */
+int spark_arena_reserve(spark_arena_t *self, const spark_allocator_t *allocator,
+                        size_t size, uint32_t hints)
+{
+  const uint32_t known =
+      SPARK_MEMORY_HUGE_PAGES | SPARK_MEMORY_LOCK | SPARK_MEMORY_PREFAULT;
+
+  if (!allocator)
+    allocator = &system_allocator;
+
+  if (!self || size == 0 || (hints & ~known) || !allocator->alloc || !allocator->free)
+    return SPARK_ERR_INVALID_PARAM;
+
+  memset(self, 0, sizeof(*self));
+
+  void *p = allocator->alloc(allocator->ctx, size, SPARK_MEMORY_ALIGN, hints);
+  if (!p)
+    return SPARK_ERR_NO_MEMORY;
+
+  if (((uintptr_t)p & (SPARK_MEMORY_ALIGN - 1)) != 0) {
+    allocator->free(allocator->ctx, p, size, hints);
+    return SPARK_ERR_NO_MEMORY;
+  }
+
+  self->base = p;
+  self->size = size;
+  self->allocator = allocator;
+  self->hints = hints;
+  return SPARK_NOERROR;
+}
+
+/**
+ * @brief Return a reserved block to its allocator and empty the arena.
+ *
+ * Objects carved from the arena are invalid afterwards. Arenas over caller
+ * memory are only emptied.
+ *
+ * @param[in,out] self Arena to release.
+ */
+void spark_arena_release(spark_arena_t *self)
+{
+  assert(self);
+
+  if (self->allocator && self->base)
+    self->allocator->free(self->allocator->ctx, self->base, self->size, self->hints);
+
+  memset(self, 0, sizeof(*self));
+}
+
+/**
+ * @brief Carve @p size bytes aligned to ::SPARK_MEMORY_ALIGN.
+ *
+ * The memory is not cleared; every libspark `_init()` initializes what it
+ * uses. A failed call leaves the arena unchanged, so the pattern
+ * `init(..., spark_arena_alloc(a, n), n)` reports the shortfall through the
+ * object's own ::SPARK_ERR_INVALID_PARAM.
+ *
+ * @param[in,out] self Arena to carve from.
+ * @param[in] size Bytes requested.
+ *
+ * @return The allocation, or NULL if it does not fit (always NULL while
+ * measuring).
+ */
+void *spark_arena_alloc(spark_arena_t *self, size_t size)
+{
+  assert(self);
+
+  const size_t at = spark_align_up(self->used, SPARK_MEMORY_ALIGN);
+  if (at < self->used || size > SIZE_MAX - at)
+    return NULL;
+
+  if (!self->base) {
+    self->used = at + size;
+    return NULL;
+  }
+
+  if (at + size > self->size)
+    return NULL;
+
+  self->used = at + size;
+  return self->base + at;
+}
+
+/**
+ * @brief Free everything carved since @p mark, a previous value of
+ * @ref spark_arena_t::used.
+ *
+ * Gives scoped scratch (a graph rebuilt on a preset change, say) back to the
+ * arena without touching the objects carved before it. Rewinding to 0
+ * empties the arena.
+ *
+ * @param[in,out] self Arena to rewind.
+ * @param[in] mark Earlier `used` value; must not exceed the current one.
+ */
+void spark_arena_rewind(spark_arena_t *self, size_t mark)
+{
+  assert(self && mark <= self->used);
+  self->used = mark;
+}
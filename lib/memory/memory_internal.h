@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Arena carving shared by the modules' _size() / _init() pairs. Not
+ * installed.
+ *
+ * A module lays its storage out twice with the same cursor walk: once with
+ * a NULL base to size it, and once over the caller's aligned arena to carve
+ * it, so both passes agree on every offset.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_MEMORY_INTERNAL_H_
+#define LIBSPARK_MEMORY_INTERNAL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Round @p n up to a multiple of @p align (a power of two).
+ */
+static inline size_t spark_align_up(size_t n, size_t align)
+{
+  return (n + (align - 1)) & ~(align - 1);
+}
+
+/**
+ * @brief Round the address @p p up to a multiple of @p align (a power of two).
+ */
+static inline unsigned char *spark_align_ptr(void *p, size_t align)
+{
+  return (unsigned char *)(((uintptr_t)p + (align - 1)) & ~(uintptr_t)(align - 1));
+}
+
+/**
+ * @brief Cursor over an arena being laid out.
+ */
+typedef struct spark_carve {
+  unsigned char *base; /**< Aligned arena, or NULL when only sizing. */
+  size_t used;         /**< Bytes laid out so far: the size once done. */
+  size_t align;        /**< Alignment of every piece (a power of two). */
+} spark_carve_t;
+
+/**
+ * @brief Reserve @p bytes at the next aligned offset; returns that offset.
+ */
+static inline size_t spark_carve_offset(spark_carve_t *carve, size_t bytes)
+{
+  const size_t at = spark_align_up(carve->used, carve->align);
+  carve->used = at + bytes;
+  return at;
+}
+
+/**
+ * @brief spark_carve_offset() as a pointer into the arena (NULL when sizing).
+ */
+static inline void *spark_carve(spark_carve_t *carve, size_t bytes)
+{
+  const size_t at = spark_carve_offset(carve, bytes);
+  return carve->base ? carve->base + at : NULL;
+}
+
+/**
+ * @brief spark_carve() of @p n floats.
+ */
+static inline float *spark_carve_floats(spark_carve_t *carve, size_t n)
+{
+  return spark_carve(carve, sizeof(float) * n);
+}
+
+#endif /* LIBSPARK_MEMORY_INTERNAL_H_ */
@@ -0,0 +1,614 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "spark/meter.h"
+#include "dispatch/kernels.h"
+#include "memory/memory_internal.h"
+#include "stats/stats_internal.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief spark_meter_f32_init() accepts F32 input in any layout.
+ */
+#define METER_F32_FLAGS (SPARK_FMT_F32 | SPARK_BLOCK_SINK)
+
+/** 100 ms loudness steps in the short-term window (3 s). */
+#define METER_STEPS 30
+
+/** Steps in the momentary window, which is also one gating block (400 ms). */
+#define METER_BLOCK_STEPS 4
+
+/** Gating histogram: 0.1 LU bins from the absolute gate up to +10 LUFS. */
+#define METER_HIST_BINS 800
+#define METER_HIST_FLOOR (-70.0)
+#define METER_HIST_PER_LU 10.0
+
+/** Lowest sample rate the K-weighting filters are designed for. */
+#define METER_MIN_RATE 8000.0f
+
+/**
+ * @brief Bytes of filter input and output kept in L1 between a filter
+ * segment and its metering in spark_sosfilt_f32_execute_metered().
+ */
+#define METER_FUSE_BYTES (16 * 1024)
+
+struct spark_meter_f32_state {
+  const spark_kernels_t *kernels;
+  float kweight[10];        /**< Shelving and highpass stages, {b0, b1, b2, -a1, -a2}. */
+  float *weights;           /**< Per channel loudness weight. */
+  float *kstates;           /**< Per channel: 4 K-weighting states. */
+  float *peak;              /**< Per channel largest magnitude. */
+  double *energy;           /**< Per channel sum of squares since the RMS reset. */
+  double *loudness;         /**< Per channel K-weighted sum of the current step. */
+  uint64_t rms_frames;      /**< Frames summed in @ref energy. */
+  uint32_t step_fill;       /**< Frames in the current step. */
+  uint32_t ring_len;        /**< Completed steps in @ref ring (at most METER_STEPS). */
+  uint32_t ring_pos;        /**< Slot of the next step. */
+  double ring[METER_STEPS]; /**< Weighted mean square of the last steps. */
+  uint32_t *hist_count;     /**< Gating blocks per histogram bin. */
+  double *hist_energy;      /**< Summed mean square of those blocks. */
+};
+
+/**
+ * @brief Lay out the arena; returns its size.
+ *
+ * With @p base NULL only the size is computed; otherwise @p state is carved
+ * from the aligned @p base.
+ */
+static size_t meter_layout(const spark_meter_f32_t *desc,
+                           struct spark_meter_f32_state *state, unsigned char *base)
+{
+  const size_t n_chan = desc->header.input.channels;
+  spark_carve_t carve = {.base = base, .align = SPARK_METER_ALIGN};
+
+  memset(state, 0, sizeof(*state));
+  (void)spark_carve_offset(&carve, sizeof(struct spark_meter_f32_state));
+
+  state->peak = spark_carve(&carve, sizeof(float) * n_chan);
+  state->energy = spark_carve(&carve, sizeof(double) * n_chan);
+
+  if (desc->flags & SPARK_METER_LOUDNESS) {
+    state->weights = spark_carve(&carve, sizeof(float) * n_chan);
+    state->kstates = spark_carve(&carve, sizeof(float) * 4 * n_chan);
+    state->loudness = spark_carve(&carve, sizeof(double) * n_chan);
+    state->hist_count = spark_carve(&carve, sizeof(uint32_t) * METER_HIST_BINS);
+    state->hist_energy = spark_carve(&carve, sizeof(double) * METER_HIST_BINS);
+  }
+
+  return carve.used;
+}
+
+/**
+ * @brief Check a description: a SINK shape, known flags and, for loudness,
+ * a usable sample rate.
+ */
+static int meter_validate(const spark_meter_f32_t *desc)
+{
+  if (!desc)
+    return SPARK_ERR_INVALID_PARAM;
+
+  const spark_buffer_t *in = &desc->header.input;
+  const uint32_t layout = spark_buffer_get_layout(in->flags);
+  const bool known =
+      (layout == SPARK_LAYOUT_INTERLEAVED || layout == SPARK_LAYOUT_PLANAR ||
+       layout == SPARK_LAYOUT_PLANAR_PTR || layout == SPARK_LAYOUT_STRIDED);
+
+  /* Bases are bound at execute time: validate the shape only. */
+  spark_block_t shape = desc->header;
+  shape.input.base = &shape;
+
+  int status = spark_block_validate(
+      &shape, METER_F32_FLAGS | (known ? layout : SPARK_LAYOUT_PLANAR));
+  if (status != SPARK_NOERROR)
+    return status;
+
+  if (desc->flags == 0 || (desc->flags & ~(uint32_t)SPARK_METER_ALL))
+    return SPARK_ERR_INVALID_PARAM;
+
+  if ((desc->flags & SPARK_METER_LOUDNESS) && !(desc->sample_rate >= METER_MIN_RATE))
+    return SPARK_ERR_INVALID_PARAM;
+
+  return SPARK_NOERROR;
+}
+
+/**
+ * @brief Design the BS.1770 K-weighting pair for @p fs.
+ *
+ * The standard tabulates coefficients at 48 kHz only; these are the analog
+ * prototypes they come from (a high shelf of +4 dB above about 1.7 kHz and
+ * a second-order highpass at 38 Hz), bilinear-transformed at @p fs, which
+ * reproduces the table at 48 kHz.
+ */
+static void meter_kweight(float c[10], double fs)
+{
+  const double pi = 3.14159265358979323846;
+
+  /* Pre-filter: high shelf. */
+  const double ks = tan(pi * 1681.974450955533 / fs);
+  const double qs = 0.7071752369554196;
+  const double vh = pow(10.0, 3.999843853973347 / 20.0);
+  const double vb = pow(vh, 0.4996667741545416);
+  const double as = 1.0 + ks / qs + ks * ks;
+
+  c[0] = (float)((vh + vb * ks / qs + ks * ks) / as);
+  c[1] = (float)(2.0 * (ks * ks - vh) / as);
+  c[2] = (float)((vh - vb * ks / qs + ks * ks) / as);
+  c[3] = (float)(-2.0 * (ks * ks - 1.0) / as);
+  c[4] = (float)(-(1.0 - ks / qs + ks * ks) / as);
+
+  /* RLB weighting: highpass with unnormalized numerator {1, -2, 1}. */
+  const double kh = tan(pi * 38.13547087602444 / fs);
+  const double qh = 0.5003270373238773;
+  const double ah = 1.0 + kh / qh + kh * kh;
+
+  c[5] = 1.0f;
+  c[6] = -2.0f;
+  c[7] = 1.0f;
+  c[8] = (float)(-2.0 * (kh * kh - 1.0) / ah);
+  c[9] = (float)(-(1.0 - kh / qh + kh * kh) / ah);
+}
+
+/** Loudness of a weighted mean square, in LUFS. */
+static inline float meter_lufs(double z)
+{
+  return (z > 0.0) ? (float)(-0.691 + 10.0 * log10(z)) : -INFINITY;
+}
+
+/** Mean of the last @p n completed steps. */
+static double meter_recent(const struct spark_meter_f32_state *state, uint32_t n)
+{
+  double sum = 0.0;
+
+  for (uint32_t j = 1; j <= n; ++j)
+    sum += state->ring[(state->ring_pos + METER_STEPS - j) % METER_STEPS];
+
+  return sum / n;
+}
+
+/**
+ * @brief Close a 100 ms step: record its weighted mean square, and enter the
+ * 400 ms gating block it completes in the histogram.
+ */
+static void meter_step(spark_meter_f32_engine_t *self)
+{
+  struct spark_meter_f32_state *state = self->state;
+  double z = 0.0;
+
+  for (uint32_t chan = 0; chan < self->n_chan; ++chan) {
+    z += state->weights[chan] * state->loudness[chan];
+    state->loudness[chan] = 0.0;
+  }
+
+  state->ring[state->ring_pos] = z / self->step;
+  state->ring_pos = (state->ring_pos + 1) % METER_STEPS;
+  if (state->ring_len < METER_STEPS)
+    state->ring_len++;
+  state->step_fill = 0;
+
+  if (state->ring_len < METER_BLOCK_STEPS)
+    return;
+
+  /* Absolute gate: blocks at or below -70 LUFS never count. */
+  const double block = meter_recent(state, METER_BLOCK_STEPS);
+  const double lufs = meter_lufs(block);
+  if (!(lufs > METER_HIST_FLOOR))
+    return;
+
+  size_t bin = (size_t)((lufs - METER_HIST_FLOOR) * METER_HIST_PER_LU);
+  if (bin >= METER_HIST_BINS)
+    bin = METER_HIST_BINS - 1;
+
+  state->hist_count[bin]++;
+  state->hist_energy[bin] += block;
+}
+
+/**
+ * @brief Meter samples `[first, first + count)` of every channel.
+ *
+ * Loudness runs are cut at step boundaries so each step's energy is closed
+ * as soon as its last sample is in.
+ */
+static void meter_run(spark_meter_f32_engine_t *self, const float *input,
+                      const float *const *planes, uint32_t first, uint32_t count)
+{
+  struct spark_meter_f32_state *state = self->state;
+  meter_f32_args_t args = {
+      .input = input,
+      .input_planes = planes,
+      .chan_stride = self->chan_stride,
+      .sample_stride = self->sample_stride,
+      .n_chan = self->n_chan,
+      .peak = state->peak,
+      .energy = state->energy,
+      .states = state->kstates,
+      .loudness = state->loudness,
+  };
+
+  SPARK_STATS_BEGIN();
+
+  state->rms_frames += count;
+
+  if (!(self->flags & SPARK_METER_LOUDNESS)) {
+    args.first = first;
+    args.n_samples = count;
+    state->kernels->meter_f32_lanes(&args);
+  } else {
+    args.kweight = state->kweight;
+
+    for (uint32_t done = 0; done < count;) {
+      const uint32_t left = self->step - state->step_fill;
+      const uint32_t n = (count - done < left) ? (count - done) : left;
+
+      args.first = (size_t)first + done;
+      args.n_samples = n;
+      state->kernels->meter_f32_lanes(&args);
+
+      done += n;
+      state->step_fill += n;
+      if (state->step_fill == self->step)
+        meter_step(self);
+    }
+  }
+
+  SPARK_STATS_END(SPARK_STATS_METER_F32, (uint64_t)self->n_chan * count);
+}
+
+/**
+ * @brief Arena bytes needed by spark_meter_f32_init() for @p desc.
+ *
+ * Includes slack to align an arbitrary arena pointer.
+ *
+ * @param[in] desc Meter description.
+ * @return Arena size in bytes, or 0 if @p desc is invalid.
+ */
+size_t spark_meter_f32_size(const spark_meter_f32_t *desc)
+{
+  if (meter_validate(desc) != SPARK_NOERROR)
+    return 0;
+
+  struct spark_meter_f32_state state;
+  return (SPARK_METER_ALIGN - 1) + meter_layout(desc, &state, NULL);
+}
+
+/**
+ * @brief Build a meter for a fixed block shape.
+ *
+ * Every call reads each sample once and takes all measurements from that
+ * read. Sample peak and mean square are always kept, since they cost next
+ * to nothing on top of the load; ::SPARK_METER_LOUDNESS adds the two
+ * K-weighting biquads per channel, run in SIMD lanes like a SOS cascade
+ * (mono and stereo as scalar chains).
+ *
+ * ### Loudness
+ * Follows ITU-R BS.1770: the K-weighted mean square of each channel is
+ * summed over 100 ms steps (rounded to whole samples), weighted per channel
+ * and kept for the last 3 s. Momentary loudness is the mean of the last 4
+ * steps and short-term loudness of the last 30; integrated loudness gates
+ * the overlapping 400 ms blocks at -70 LUFS and then at 10 LU below their
+ * mean. Blocks are binned at 0.1 LU for the relative gate, so memory stays
+ * fixed however long the programme runs; the gate threshold is resolved to
+ * that bin.
+ *
+ * @param[out] self Engine to initialize.
+ * @param[in] desc Input shape, ::spark_meter_flags, sample rate and weights.
+ * @param[in] arena Caller-owned memory of at least spark_meter_f32_size()
+ *                  bytes. Must outlive @p self.
+ * @param[in] arena_size Size of @p arena in bytes.
+ *
+ * @retval SPARK_NOERROR on success
+ * @retval SPARK_ERR_INVALID_PARAM for NULL arguments, no or unknown flags,
+ *         or loudness below an 8 kHz sample rate
+ * @retval SPARK_ERR_INVALID_SIZE if @p arena is too small
+ * @return Otherwise the error from spark_block_validate().
+ */
+int spark_meter_f32_init(spark_meter_f32_engine_t *self, const spark_meter_f32_t *desc,
+                         void *arena, size_t arena_size)
+{
+  if (!self || !arena)
+    return SPARK_ERR_INVALID_PARAM;
+
+  int status = meter_validate(desc);
+  if (status != SPARK_NOERROR)
+    return status;
+
+  struct spark_meter_f32_state layout;
+  if (arena_size < (SPARK_METER_ALIGN - 1) + meter_layout(desc, &layout, NULL))
+    return SPARK_ERR_INVALID_SIZE;
+
+  unsigned char *base = spark_align_ptr(arena, SPARK_METER_ALIGN);
+  struct spark_meter_f32_state *state = (struct spark_meter_f32_state *)base;
+
+  meter_layout(desc, state, base);
+
+  const spark_buffer_t *in = &desc->header.input;
+  const uint32_t n_chan = in->channels;
+
+  switch (spark_buffer_get_layout(in->flags)) {
+  case SPARK_LAYOUT_INTERLEAVED:
+    self->chan_stride = 1;
+    break;
+  case SPARK_LAYOUT_PLANAR_PTR:
+    self->chan_stride = 0;
+    break;
+  case SPARK_LAYOUT_STRIDED:
+    self->chan_stride = in->channel_stride;
+    break;
+  default:
+    self->chan_stride = in->samples;
+    break;
+  }
+  self->sample_stride = spark_buffer_sample_stride(in);
+  self->planes = (spark_buffer_get_layout(in->flags) == SPARK_LAYOUT_PLANAR_PTR);
+  self->flags = desc->flags;
+  self->n_chan = n_chan;
+  self->block = in->samples;
+  self->step = 0;
+  self->state = state;
+
+  state->kernels = spark_kernels();
+
+  if (desc->flags & SPARK_METER_LOUDNESS) {
+    const double step = floor(0.1 * (double)desc->sample_rate + 0.5);
+
+    self->step = (uint32_t)step;
+    meter_kweight(state->kweight, desc->sample_rate);
+    for (uint32_t chan = 0; chan < n_chan; ++chan)
+      state->weights[chan] = desc->channel_weights ? desc->channel_weights[chan] : 1.0f;
+  }
+
+  spark_meter_f32_reset(self, SPARK_METER_ALL);
+
+  return SPARK_NOERROR;
+}
+
+/**
+ * @brief Clear some or all of the measurements.
+ *
+ * ::SPARK_METER_PEAK restarts the peaks, ::SPARK_METER_RMS the mean squares,
+ * and ::SPARK_METER_LOUDNESS the K-weighting history, the loudness windows
+ * and the integrated loudness. Others are left running.
+ *
+ * @param[in,out] self Engine.
+ * @param[in] flags A combination of ::spark_meter_flags values.
+ */
+void spark_meter_f32_reset(spark_meter_f32_engine_t *self, uint32_t flags)
+{
+  assert(self && self->state);
+
+  struct spark_meter_f32_state *state = self->state;
+  const size_t n_chan = self->n_chan;
+
+  if (flags & SPARK_METER_PEAK)
+    memset(state->peak, 0, sizeof(float) * n_chan);
+
+  if (flags & SPARK_METER_RMS) {
+    memset(state->energy, 0, sizeof(double) * n_chan);
+    state->rms_frames = 0;
+  }
+
+  if ((flags & SPARK_METER_LOUDNESS) && (self->flags & SPARK_METER_LOUDNESS)) {
+    memset(state->kstates, 0, sizeof(float) * 4 * n_chan);
+    memset(state->loudness, 0, sizeof(double) * n_chan);
+    memset(state->hist_count, 0, sizeof(uint32_t) * METER_HIST_BINS);
+    memset(state->hist_energy, 0, sizeof(double) * METER_HIST_BINS);
+    state->step_fill = 0;
+    state->ring_len = 0;
+    state->ring_pos = 0;
+  }
+}
+
+/**
+ * @brief Meter one block.
+ *
+ * @p input must have the shape given at init. Safe for real-time use: no
+ * allocation and no locks.
+ *
+ * @param[in,out] self Engine from spark_meter_f32_init().
+ * @param[in] input Samples in the initialized layout.
+ */
+void spark_meter_f32_execute(spark_meter_f32_engine_t *self, const float *input)
+{
+  assert(self && self->state && input);
+  assert(!self->planes);
+
+  meter_run(self, input, NULL, 0, self->block);
+}
+
+/**
+ * @brief spark_meter_f32_execute() on host channel arrays.
+ *
+ * @param[in,out] self Engine initialized with @ref SPARK_LAYOUT_PLANAR_PTR input.
+ * @param[in] input `n_chan` planes of `block` samples.
+ */
+void spark_meter_f32_execute_planes(spark_meter_f32_engine_t *self,
+                                    const float *const *input)
+{
+  assert(self && self->state && input);
+  assert(self->planes);
+
+  meter_run(self, NULL, input, 0, self->block);
+}
+
+/**
+ * @brief Largest sample magnitude of @p chan since the last peak reset.
+ *
+ * @param[in] self Engine.
+ * @param[in] chan Channel index.
+ * @return Linear peak (0 before any signal).
+ */
+float spark_meter_f32_peak(const spark_meter_f32_engine_t *self, uint32_t chan)
+{
+  assert(self && self->state && chan < self->n_chan);
+
+  return self->state->peak[chan];
+}
+
+/**
+ * @brief RMS level of @p chan since the last RMS reset.
+ *
+ * @param[in] self Engine.
+ * @param[in] chan Channel index.
+ * @return Linear RMS (0 before any sample).
+ */
+float spark_meter_f32_rms(const spark_meter_f32_engine_t *self, uint32_t chan)
+{
+  assert(self && self->state && chan < self->n_chan);
+
+  const struct spark_meter_f32_state *state = self->state;
+  if (state->rms_frames == 0)
+    return 0.0f;
+
+  return (float)sqrt(state->energy[chan] / (double)state->rms_frames);
+}
+
+/**
+ * @brief Read a loudness measurement, in LUFS.
+ *
+ * Momentary and short-term loudness cover the last complete 100 ms steps;
+ * they read -INFINITY until 400 ms and 3 s have been metered. Integrated
+ * loudness reads -INFINITY while no block has passed the gates.
+ *
+ * @param[in] self Engine built with ::SPARK_METER_LOUDNESS.
+ * @param[in] which A ::spark_meter_loudness value.
+ * @return Loudness in LUFS, or -INFINITY.
+ */
+float spark_meter_f32_loudness(const spark_meter_f32_engine_t *self, uint32_t which)
+{
+  assert(self && self->state && (self->flags & SPARK_METER_LOUDNESS));
+
+  const struct spark_meter_f32_state *state = self->state;
+
+  if (which == SPARK_METER_MOMENTARY)
+    return (state->ring_len >= METER_BLOCK_STEPS)
+               ? meter_lufs(meter_recent(state, METER_BLOCK_STEPS))
+               : -INFINITY;
+
+  if (which == SPARK_METER_SHORT_TERM)
+    return (state->ring_len >= METER_STEPS) ? meter_lufs(meter_recent(state, METER_STEPS))
+                                            : -INFINITY;
+
+  assert(which == SPARK_METER_INTEGRATED);
+
+  uint64_t count = 0;
+  double energy = 0.0;
+
+  for (size_t bin = 0; bin < METER_HIST_BINS; ++bin) {
+    count += state->hist_count[bin];
+    energy += state->hist_energy[bin];
+  }
+
+  if (count == 0)
+    return -INFINITY;
+
+  /* Relative gate: keep the bins at or above 10 LU below the ungated mean. */
+  const double gate = meter_lufs(energy / (double)count) - 10.0;
+  const double from = ceil((gate - METER_HIST_FLOOR) * METER_HIST_PER_LU);
+  size_t bin = (from > 0.0) ? (size_t)from : 0;
+
+  count = 0;
+  energy = 0.0;
+  for (; bin < METER_HIST_BINS; ++bin) {
+    count += state->hist_count[bin];
+    energy += state->hist_energy[bin];
+  }
+
+  return count ? meter_lufs(energy / (double)count) : -INFINITY;
+}
+
+/** Samples per filter-and-meter segment: METER_FUSE_BYTES of input and output. */
+static uint32_t meter_fuse_tile(uint32_t n_chan)
+{
+  const uint32_t tile = METER_FUSE_BYTES / (2 * sizeof(float) * n_chan);
+  return (tile < 64) ? 64 : tile & ~63u;
+}
+
+/**
+ * @brief Filter one block and meter the filter's output in the same pass.
+ *
+ * Equivalent to spark_sosfilt_f32_execute() followed by
+ * spark_meter_f32_execute() on @p output, but the block is run in segments
+ * small enough for the filter's input and output to stay in L1, each
+ * metered right after it is filtered, so the meter reads hot data instead
+ * of streaming the whole output from memory a second time.
+ *
+ * @param[in] plan Plan from spark_sosfilt_f32_prepare().
+ * @param[in,out] meter Meter over the same shape and layout as @p plan.
+ * @param[in] input Input samples in the prepared layout.
+ * @param[out] output Output samples in the prepared layout; also metered.
+ */
+void spark_sosfilt_f32_execute_metered(const spark_sosfilt_f32_plan_t *plan,
+                                       spark_meter_f32_engine_t *meter,
+                                       const float *input, float *output)
+{
+  assert(plan && meter && meter->state && input && output);
+  assert(!plan->planes && !meter->planes);
+  assert(plan->n_chan == meter->n_chan && plan->n_samples == meter->block);
+  assert(plan->chan_stride == meter->chan_stride &&
+         plan->sample_stride == meter->sample_stride);
+
+  const uint32_t tile = meter_fuse_tile(plan->n_chan);
+
+  for (uint32_t first = 0; first < plan->n_samples; first += tile) {
+    const uint32_t left = plan->n_samples - first;
+    const uint32_t count = (left < tile) ? left : tile;
+
+    spark_sosfilt_f32_execute_range(plan, input, output, first, count);
+    meter_run(meter, output, NULL, first, count);
+  }
+}
+
+/**
+ * @brief spark_sosfilt_f32_execute_metered() on host channel arrays.
+ *
+ * @param[in] plan Plan from spark_sosfilt_f32_prepare() over plane pointers.
+ * @param[in,out] meter Meter over plane pointers of the same shape.
+ * @param[in] input `n_chan` input planes.
+ * @param[out] output `n_chan` output planes; also metered.
+ */
+void spark_sosfilt_f32_execute_planes_metered(const spark_sosfilt_f32_plan_t *plan,
+                                              spark_meter_f32_engine_t *meter,
+                                              const float *const *input,
+                                              float *const *output)
+{
+  assert(plan && meter && meter->state && input && output);
+  assert(plan->planes && meter->planes);
+  assert(plan->n_chan == meter->n_chan && plan->n_samples == meter->block);
+
+  const uint32_t tile = meter_fuse_tile(plan->n_chan);
+
+  for (uint32_t first = 0; first < plan->n_samples; first += tile) {
+    const uint32_t left = plan->n_samples - first;
+    const uint32_t count = (left < tile) ? left : tile;
+
+    spark_sosfilt_f32_execute_planes_range(plan, input, output, first, count);
+    meter_run(meter, NULL, (const float *const *)output, first, count);
+  }
+}
@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "iir-filter/sosfilt_tile.h"
+#include "meter/meter_kernels.h"
+#include "simd/simd_f32.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Magnitude of every lane. */
+static inline vf32_t meter_abs(vf32_t x)
+{
+  return vf32_max(x, vf32_sub(vf32_zero(), x));
+}
+
+/**
+ * Peak and energy of @p n contiguous samples whose channel repeats every
+ * @p period samples, @p period dividing VF32_LANES, so lane l always holds
+ * channel `chan + l % period`. Squares are summed in float over runs of
+ * SOSFILT_TILE vectors and the runs in double.
+ */
+static void meter_flat(const meter_f32_args_t *args, const float *x, size_t n,
+                       uint32_t period, uint32_t chan)
+{
+  SPARK_ALIGNED(SPARK_SIMD_ALIGN) float lanes[VF32_LANES];
+  double energy[VF32_LANES] = {0};
+  vf32_t peak = vf32_zero();
+  size_t i = 0;
+
+  while (i + VF32_LANES <= n) {
+    const size_t run = SOSFILT_TILE * VF32_LANES;
+    const size_t end = (n - i < run) ? n : i + run;
+    vf32_t e = vf32_zero();
+
+    for (; i + VF32_LANES <= end; i += VF32_LANES) {
+      const vf32_t v = vf32_load(x + i);
+      peak = vf32_max(peak, meter_abs(v));
+      e = vf32_fmadd(v, v, e);
+    }
+
+    vf32_store(lanes, e);
+    for (uint32_t l = 0; l < VF32_LANES; ++l)
+      energy[l] += lanes[l];
+  }
+
+  vf32_store(lanes, peak);
+  for (uint32_t l = 0; l < VF32_LANES; ++l) {
+    const uint32_t c = chan + l % period;
+    if (lanes[l] > args->peak[c])
+      args->peak[c] = lanes[l];
+    args->energy[c] += energy[l];
+  }
+
+  for (; i < n; ++i) {
+    const uint32_t c = chan + (uint32_t)(i % period);
+    const float v = x[i];
+    const float m = (v < 0.0f) ? -v : v;
+    if (m > args->peak[c])
+      args->peak[c] = m;
+    args->energy[c] += (double)v * v;
+  }
+}
+
+/**
+ * tile_gather() for a tile whose unused lanes are already zero: partial
+ * groups copy only their @p n_lanes valid lanes per sample.
+ */
+static inline void meter_gather(float *tile, const float *const *chan, uint32_t n_lanes,
+                                size_t stride, bool adjacent, size_t count)
+{
+  if (n_lanes == VF32_LANES) {
+    tile_gather(tile, chan, n_lanes, stride, adjacent, count);
+    return;
+  }
+
+  if (adjacent) {
+    for (size_t t = 0; t < count; ++t) {
+      const float *x = chan[0] + t * stride;
+      for (uint32_t l = 0; l < n_lanes; ++l)
+        tile[t * VF32_LANES + l] = x[l];
+    }
+    return;
+  }
+
+  for (size_t t = 0; t < count; ++t) {
+    for (uint32_t l = 0; l < n_lanes; ++l)
+      tile[t * VF32_LANES + l] = chan[l][t * stride];
+  }
+}
+
+/** Add lanes `l < n_lanes` of @p v to `acc[l]`. */
+static inline void lanes_add(double *acc, vf32_t v, uint32_t n_lanes)
+{
+  SPARK_ALIGNED(SPARK_SIMD_ALIGN) float lanes[VF32_LANES];
+
+  vf32_store(lanes, v);
+  for (uint32_t l = 0; l < n_lanes; ++l)
+    acc[l] += lanes[l];
+}
+
+/**
+ * One group of up to VF32_LANES channels, one per lane, over tiles of
+ * SOSFILT_TILE samples. With K-weighting both shelving and highpass stages
+ * run per sample in registers next to the peak and energy updates.
+ */
+static void meter_group(const meter_f32_args_t *args, uint32_t chan, uint32_t n_lanes)
+{
+  const size_t stride = args->sample_stride;
+  const size_t at = args->first * stride;
+  const bool adjacent = !args->input_planes && args->chan_stride == 1;
+  const bool kweight = (args->kweight != NULL);
+  const float *src[VF32_LANES];
+  float *st0[VF32_LANES], *st1[VF32_LANES];
+
+  for (uint32_t l = 0; l < n_lanes; ++l) {
+    src[l] = args->input_planes ? args->input_planes[chan + l] + at
+                                : args->input + (chan + l) * args->chan_stride + at;
+    if (kweight) {
+      st0[l] = args->states + (size_t)(chan + l) * 4;
+      st1[l] = st0[l] + 2;
+    }
+  }
+
+  vf32_t c0[5], c1[5];
+  vf32_t s01 = vf32_zero(), s02 = vf32_zero(), s11 = vf32_zero(), s12 = vf32_zero();
+
+  if (kweight) {
+    lane_coeffs(c0, args->kweight, 0, n_lanes, 5);
+    lane_coeffs(c1, args->kweight + 5, 0, n_lanes, 5);
+    lane_states_load(&s01, &s02, st0, n_lanes);
+    lane_states_load(&s11, &s12, st1, n_lanes);
+  }
+
+  SPARK_ALIGNED(SPARK_SIMD_ALIGN) float tile[SOSFILT_TILE * VF32_LANES] = {0};
+  double energy[VF32_LANES] = {0}, loudness[VF32_LANES] = {0};
+  vf32_t peak = vf32_zero();
+
+  for (size_t offset = 0; offset < args->n_samples; offset += SOSFILT_TILE) {
+    const size_t count = (args->n_samples - offset < SOSFILT_TILE)
+                             ? (args->n_samples - offset)
+                             : SOSFILT_TILE;
+    const float *p[VF32_LANES];
+
+    for (uint32_t l = 0; l < n_lanes; ++l)
+      p[l] = src[l] + offset * stride;
+    meter_gather(tile, p, n_lanes, stride, adjacent, count);
+
+    vf32_t e = vf32_zero(), k = vf32_zero();
+
+    if (kweight) {
+      for (size_t t = 0; t < count; ++t) {
+        const vf32_t x = vf32_load(tile + t * VF32_LANES);
+        peak = vf32_max(peak, meter_abs(x));
+        e = vf32_fmadd(x, x, e);
+
+        const vf32_t y = vf32_fmadd(c0[0], x, s01);
+        s01 = vf32_fmadd(c0[1], x, vf32_fmadd(c0[3], y, s02));
+        s02 = vf32_fmadd(c0[2], x, vf32_mul(c0[4], y));
+
+        const vf32_t z = vf32_fmadd(c1[0], y, s11);
+        s11 = vf32_fmadd(c1[1], y, vf32_fmadd(c1[3], z, s12));
+        s12 = vf32_fmadd(c1[2], y, vf32_mul(c1[4], z));
+        k = vf32_fmadd(z, z, k);
+      }
+      lanes_add(loudness, k, n_lanes);
+    } else {
+      for (size_t t = 0; t < count; ++t) {
+        const vf32_t x = vf32_load(tile + t * VF32_LANES);
+        peak = vf32_max(peak, meter_abs(x));
+        e = vf32_fmadd(x, x, e);
+      }
+    }
+    lanes_add(energy, e, n_lanes);
+  }
+
+  SPARK_ALIGNED(SPARK_SIMD_ALIGN) float lanes[VF32_LANES];
+  vf32_store(lanes, peak);
+
+  for (uint32_t l = 0; l < n_lanes; ++l) {
+    if (lanes[l] > args->peak[chan + l])
+      args->peak[chan + l] = lanes[l];
+    args->energy[chan + l] += energy[l];
+    if (kweight)
+      args->loudness[chan + l] += loudness[l];
+  }
+
+  if (kweight) {
+    lane_states_store(st0, s01, s02, n_lanes);
+    lane_states_store(st1, s11, s12, n_lanes);
+  }
+}
+
+/** Running measurements of one channel in meter_scalar(). */
+typedef struct meter_chain {
+  const float *src;
+  float s[4];
+  float peak, e, k;
+  double energy, loudness;
+} meter_chain_t;
+
+/** One sample through a scalar chain: peak, square and both K stages. */
+static SPARK_FORCE_INLINE void meter_chain_step(meter_chain_t *ch, const float *c,
+                                                float x)
+{
+  const float m = (x < 0.0f) ? -x : x;
+  ch->peak = (m > ch->peak) ? m : ch->peak;
+  ch->e += x * x;
+
+  const float y = c[0] * x + ch->s[0];
+  ch->s[0] = c[3] * y + (c[1] * x + ch->s[1]);
+  ch->s[1] = c[2] * x + c[4] * y;
+
+  const float z = c[5] * y + ch->s[2];
+  ch->s[2] = c[8] * z + (c[6] * y + ch->s[3]);
+  ch->s[3] = c[7] * y + c[9] * z;
+  ch->k += z * z;
+}
+
+static SPARK_FORCE_INLINE void meter_chain_load(meter_chain_t *ch,
+                                                const meter_f32_args_t *args,
+                                                uint32_t chan)
+{
+  const size_t at = args->first * args->sample_stride;
+
+  ch->src = args->input_planes ? args->input_planes[chan] + at
+                               : args->input + chan * args->chan_stride + at;
+  for (int k = 0; k < 4; ++k)
+    ch->s[k] = args->states[(size_t)chan * 4 + k];
+  ch->peak = args->peak[chan];
+  ch->energy = 0.0;
+  ch->loudness = 0.0;
+}
+
+static SPARK_FORCE_INLINE void meter_chain_store(const meter_chain_t *ch,
+                                                 const meter_f32_args_t *args,
+                                                 uint32_t chan)
+{
+  for (int k = 0; k < 4; ++k)
+    args->states[(size_t)chan * 4 + k] = ch->s[k];
+  args->peak[chan] = ch->peak;
+  args->energy[chan] += ch->energy;
+  args->loudness[chan] += ch->loudness;
+}
+
+/**
+ * Loudness of mono or stereo as independent scalar chains, for shapes that
+ * would leave most lanes of a vector group empty. The two chains of a
+ * stereo pair overlap, so a frame costs about one chain's latency and needs
+ * no transpose.
+ */
+static void meter_scalar(const meter_f32_args_t *args)
+{
+  const size_t stride = args->sample_stride;
+  const bool stereo = (args->n_chan == 2);
+  const float *c = args->kweight;
+  meter_chain_t a = {0}, b = {0};
+
+  meter_chain_load(&a, args, 0);
+  if (stereo)
+    meter_chain_load(&b, args, 1);
+
+  for (size_t offset = 0; offset < args->n_samples; offset += SOSFILT_TILE) {
+    const size_t end = (args->n_samples - offset < SOSFILT_TILE) ? args->n_samples
+                                                                : offset + SOSFILT_TILE;
+    a.e = a.k = b.e = b.k = 0.0f;
+
+    if (stereo) {
+      for (size_t t = offset; t < end; ++t) {
+        meter_chain_step(&a, c, a.src[t * stride]);
+        meter_chain_step(&b, c, b.src[t * stride]);
+      }
+      b.energy += b.e;
+      b.loudness += b.k;
+    } else {
+      for (size_t t = offset; t < end; ++t)
+        meter_chain_step(&a, c, a.src[t * stride]);
+    }
+    a.energy += a.e;
+    a.loudness += a.k;
+  }
+
+  meter_chain_store(&a, args, 0);
+  if (stereo)
+    meter_chain_store(&b, args, 1);
+}
+
+/**
+ * Without K-weighting, contiguous channels and interleaved frames that tile
+ * a vector are reduced as flat arrays. Loudness of mono, and of stereo on
+ * vectors of 8 lanes or more, runs as scalar chains; everything else goes
+ * through lane groups.
+ */
+void SPARK_ISA_FN(meter_f32_lanes)(const meter_f32_args_t *args)
+{
+  const uint32_t n_chan = args->n_chan;
+
+  if (args->n_samples == 0)
+    return;
+
+  if (!args->kweight) {
+    if (args->sample_stride == 1) {
+      for (uint32_t chan = 0; chan < n_chan; ++chan) {
+        const float *x = args->input_planes
+                             ? args->input_planes[chan] + args->first
+                             : args->input + chan * args->chan_stride + args->first;
+        meter_flat(args, x, args->n_samples, 1, chan);
+      }
+      return;
+    }
+
+    if (!args->input_planes && args->chan_stride == 1 && args->sample_stride == n_chan &&
+        n_chan <= VF32_LANES && VF32_LANES % n_chan == 0) {
+      meter_flat(args, args->input + args->first * n_chan,
+                 (size_t)args->n_samples * n_chan, n_chan, 0);
+      return;
+    }
+  }
+
+  if (args->kweight && (n_chan == 1 || (n_chan == 2 && 2 * 4 <= VF32_LANES))) {
+    meter_scalar(args);
+    return;
+  }
+
+  for (uint32_t chan = 0; chan < n_chan; chan += VF32_LANES) {
+    const uint32_t n_lanes = (n_chan - chan < VF32_LANES) ? (n_chan - chan) : VF32_LANES;
+    meter_group(args, chan, n_lanes);
+  }
+}
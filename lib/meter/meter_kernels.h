@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Internal kernel interface for level metering. Not installed.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_METER_KERNELS_H_
+#define LIBSPARK_METER_KERNELS_H_
+
+#include "dispatch/isa.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Resolved arguments for one metering run.
+ *
+ * Channels are addressed like sosfilt_f32_args_t: by @ref input_planes, or
+ * from @ref input with @ref chan_stride and @ref sample_stride. Every
+ * accumulator is per channel and added to, never cleared, so a block can be
+ * metered in segments.
+ */
+typedef struct meter_f32_args {
+  const float *input;   /**< Base of the input buffer. */
+
+  /** Channel pointers replacing @ref input, or NULL. */
+  const float *const *input_planes;
+
+  size_t chan_stride;   /**< Distance between channel k and k+1. */
+  size_t sample_stride; /**< Distance between sample n and n+1 of a channel. */
+  size_t first;         /**< First sample of the run in every channel. */
+  uint32_t n_chan;      /**< Number of channels. */
+  uint32_t n_samples;   /**< Samples per channel in the run. */
+  float *peak;          /**< Largest magnitude, raised in place. */
+  double *energy;       /**< Sum of squares. */
+
+  /** K-weighting: 2 stages of {b0, b1, b2, -a1, -a2}, or NULL to skip loudness. */
+  const float *kweight;
+  float *states;        /**< 4 K-weighting states per channel. */
+  double *loudness;     /**< Sum of K-weighted squares. */
+} meter_f32_args_t;
+
+#ifdef SPARK_ISA
+/**
+ * @brief Peak, energy and (with K-weighting) loudness energy of a run.
+ *
+ * All measurements come from one read of each sample: the K-weighting
+ * recursion runs on the same vectors the peak and energy are taken from.
+ */
+void SPARK_ISA_FN(meter_f32_lanes)(const meter_f32_args_t *args);
+#endif
+
+#endif /* LIBSPARK_METER_KERNELS_H_ */
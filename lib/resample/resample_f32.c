@@ -0,0 +1,456 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "spark/resample.h"
+#include "dispatch/kernels.h"
+#include "memory/memory_internal.h"
+#include "stats/stats_internal.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/** Phases of the interpolated bank used for ratios with no small L / M. */
+#define RESAMPLE_INTERP_PHASES 512
+
+static const double resample_pi = 3.14159265358979323846;
+
+/**
+ * @brief Kaiser-windowed sinc per quality: taps per phase when upsampling,
+ * window beta, and the cutoff as a fraction of the lower Nyquist rate.
+ */
+static const struct {
+  uint32_t n_taps;
+  double beta;
+  double rolloff;
+} resample_presets[] = {
+    [SPARK_RESAMPLE_LOW] = {16, 4.6, 0.80},
+    [SPARK_RESAMPLE_MEDIUM] = {32, 7.9, 0.90},
+    [SPARK_RESAMPLE_HIGH] = {64, 11.2, 0.93},
+};
+
+struct spark_resample_f32_state {
+  const spark_kernels_t *kernels;
+  float *bank;          /**< n_phases (+ 1 when interpolated) filters of n_taps. */
+  float *window;        /**< Per channel: n_taps - 1 history + block. */
+  size_t window_len;    /**< n_taps - 1 + block. */
+  size_t chan_stride;   /**< Input samples between channel k and k+1. */
+  size_t sample_stride; /**< Input samples between frame n and n+1 (output too). */
+  size_t out_stride;    /**< Output samples between channel k and k+1. */
+  uint32_t step_int;    /**< Whole input samples per output. */
+  uint32_t step_frac;   /**< Fractional step: over n_phases, or over 2^32. */
+  size_t index;         /**< Window index of the next output's first tap. */
+  uint32_t phase;       /**< Phase of the next output. */
+};
+
+/** Resolved ratio and filter size of a description. */
+typedef struct resample_params {
+  uint32_t n_taps;
+  uint32_t n_phases;
+  bool interpolated;
+  uint32_t step_int;
+  uint32_t step_frac;
+  double cutoff;
+  double beta;
+} resample_params_t;
+
+static uint32_t gcd_u32(uint32_t a, uint32_t b)
+{
+  while (b) {
+    const uint32_t t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+/**
+ * @brief Check the rates and quality and size the filter.
+ *
+ * The ratio reduces to L / M; L up to ::SPARK_RESAMPLE_MAX_PHASES is run
+ * exactly with L phases, anything else on an interpolated bank with a
+ * 32.32 fixed-point step.
+ */
+static int resample_params(const spark_resample_f32_t *desc, resample_params_t *params)
+{
+  const uint32_t in_rate = desc->in_rate, out_rate = desc->out_rate;
+
+  if (in_rate == 0 || out_rate == 0 || desc->quality > SPARK_RESAMPLE_HIGH)
+    return SPARK_ERR_INVALID_PARAM;
+  if ((uint64_t)in_rate > (uint64_t)out_rate * SPARK_RESAMPLE_MAX_RATIO ||
+      (uint64_t)out_rate > (uint64_t)in_rate * SPARK_RESAMPLE_MAX_RATIO)
+    return SPARK_ERR_INVALID_PARAM;
+
+  const uint32_t g = gcd_u32(in_rate, out_rate);
+  const uint32_t l = out_rate / g, m = in_rate / g;
+
+  /* Downsampling widens the filter in input samples by the same factor. */
+  const uint32_t base = resample_presets[desc->quality].n_taps;
+  const uint64_t taps = ((uint64_t)base * in_rate + out_rate - 1) / out_rate;
+
+  params->n_taps = in_rate > out_rate ? (uint32_t)((taps + 15) & ~(uint64_t)15) : base;
+  params->cutoff = resample_presets[desc->quality].rolloff *
+                   (in_rate > out_rate ? (double)out_rate / in_rate : 1.0);
+  params->beta = resample_presets[desc->quality].beta;
+  params->interpolated = (l > SPARK_RESAMPLE_MAX_PHASES);
+
+  if (params->interpolated) {
+    const uint64_t step = ((uint64_t)in_rate << 32) / out_rate;
+    params->n_phases = RESAMPLE_INTERP_PHASES;
+    params->step_int = (uint32_t)(step >> 32);
+    params->step_frac = (uint32_t)step;
+  } else {
+    params->n_phases = l;
+    params->step_int = m / l;
+    params->step_frac = m % l;
+  }
+
+  return SPARK_NOERROR;
+}
+
+/**
+ * @brief Check the shape as well as the rates; fills @p params.
+ */
+static int resample_resolve(const spark_resample_f32_t *desc, resample_params_t *params)
+{
+  if (!desc)
+    return SPARK_ERR_INVALID_PARAM;
+
+  const uint32_t layout = spark_buffer_get_layout(desc->header.input.flags);
+  if (layout != SPARK_LAYOUT_PLANAR && layout != SPARK_LAYOUT_INTERLEAVED)
+    return SPARK_ERR_INVALID_INPUT;
+
+  /* Bases are bound at execute time: validate the shape only. */
+  spark_block_t shape = desc->header;
+  shape.input.base = &shape;
+  shape.output.base = &shape;
+
+  int status = spark_block_validate(&shape, SPARK_FMT_F32 | layout | SPARK_BLOCK_CONVERT);
+  if (status != SPARK_NOERROR)
+    return status;
+
+  if (!spark_buffer_check_type(&shape.output, SPARK_FMT_F32, layout))
+    return SPARK_ERR_INVALID_OUTPUT;
+  if (shape.output.channels != shape.input.channels)
+    return SPARK_ERR_INVALID_BLOCK;
+
+  status = resample_params(desc, params);
+  if (status != SPARK_NOERROR)
+    return status;
+
+  if (shape.output.samples < spark_resample_f32_max_output(desc))
+    return SPARK_ERR_INVALID_OUTPUT;
+
+  return SPARK_NOERROR;
+}
+
+static size_t resample_layout(const spark_resample_f32_t *desc,
+                              const resample_params_t *params,
+                              struct spark_resample_f32_state *state, unsigned char *base)
+{
+  const uint32_t rows = params->n_phases + (params->interpolated ? 1 : 0);
+
+  memset(state, 0, sizeof(*state));
+  state->window_len = (size_t)params->n_taps - 1 + desc->header.input.samples;
+
+  spark_carve_t carve = {.base = base, .align = SPARK_RESAMPLE_ALIGN};
+  (void)spark_carve_offset(&carve, sizeof(struct spark_resample_f32_state));
+
+  state->bank = spark_carve_floats(&carve, (size_t)rows * params->n_taps);
+  state->window =
+      spark_carve_floats(&carve, (size_t)desc->header.input.channels * state->window_len);
+
+  return carve.used;
+}
+
+/** Modified Bessel function of the first kind, order 0 (power series). */
+static double bessel_i0(double x)
+{
+  double sum = 1.0, term = 1.0;
+
+  for (int k = 1; k < 64; ++k) {
+    const double f = x / (2.0 * k);
+    term *= f * f;
+    sum += term;
+    if (term < 1e-16 * sum)
+      break;
+  }
+  return sum;
+}
+
+/**
+ * @brief Fill the phase filters: filter r taps the window at offsets
+ * `t = r / n_phases + n_taps / 2 - 1 - j`, each row normalized to unit DC
+ * gain so no phase modulates the level.
+ */
+static void resample_design(float *bank, const resample_params_t *params)
+{
+  const uint32_t n_taps = params->n_taps;
+  const uint32_t rows = params->n_phases + (params->interpolated ? 1 : 0);
+  const double half = n_taps / 2.0;
+  const double norm = 1.0 / bessel_i0(params->beta);
+
+  for (uint32_t r = 0; r < rows; ++r) {
+    const double f = (double)r / params->n_phases;
+    float *row = bank + (size_t)r * n_taps;
+    double sum = 0.0;
+
+    for (uint32_t j = 0; j < n_taps; ++j) {
+      const double t = f + half - 1.0 - j;
+      const double u = t / half;
+      const double z = params->cutoff * t;
+      const double sinc = (z == 0.0) ? 1.0 : sin(resample_pi * z) / (resample_pi * z);
+      const double w = (u * u < 1.0) ? bessel_i0(params->beta * sqrt(1.0 - u * u)) * norm
+                                      : 0.0;
+      const double h = params->cutoff * sinc * w;
+
+      row[j] = (float)h;
+      sum += h;
+    }
+
+    for (uint32_t j = 0; j < n_taps; ++j)
+      row[j] = (float)(row[j] / sum);
+  }
+}
+
+/**
+ * @brief Most frames one call can produce for @p desc.
+ *
+ * Only `header.input.samples` and the rates are read, so this can size
+ * `header.output.samples` before the description is complete.
+ *
+ * @param[in] desc Resampler description.
+ * @return `block * out_rate / in_rate` rounded down, plus 2; 0 if a rate is 0.
+ */
+uint32_t spark_resample_f32_max_output(const spark_resample_f32_t *desc)
+{
+  if (!desc || desc->in_rate == 0 || desc->out_rate == 0)
+    return 0;
+
+  const uint64_t n =
+      (uint64_t)desc->header.input.samples * desc->out_rate / desc->in_rate + 2;
+  return n > UINT32_MAX ? UINT32_MAX : (uint32_t)n;
+}
+
+/**
+ * @brief Arena bytes needed by spark_resample_f32_init() for @p desc.
+ *
+ * Includes slack to align an arbitrary arena pointer.
+ *
+ * @param[in] desc Resampler description.
+ * @return Arena size in bytes, or 0 if @p desc is invalid.
+ */
+size_t spark_resample_f32_size(const spark_resample_f32_t *desc)
+{
+  resample_params_t params;
+
+  if (resample_resolve(desc, &params) != SPARK_NOERROR)
+    return 0;
+
+  struct spark_resample_f32_state state;
+  return (SPARK_RESAMPLE_ALIGN - 1) + resample_layout(desc, &params, &state, NULL);
+}
+
+/**
+ * @brief Build a streaming polyphase sample-rate converter.
+ *
+ * Output sample n is the input evaluated at `n * in_rate / out_rate -
+ * latency` through a Kaiser-windowed sinc, low-passed below the lower of
+ * the two Nyquist rates. With the ratio reduced to L / M (L up to
+ * ::SPARK_RESAMPLE_MAX_PHASES, e.g. 160 / 147 for 44.1 → 48 kHz) every
+ * output uses one of L precomputed phase filters exactly; other ratios
+ * blend the two nearest of 512 phases. Each output is one SIMD inner
+ * product across the taps over a per-channel window of history and the
+ * new block, so consecutive calls stream seamlessly.
+ *
+ * The number of frames per call varies unless `block * out_rate / in_rate`
+ * is a whole number; spark_resample_f32_execute() returns it.
+ *
+ * @param[out] self Resampler to initialize.
+ * @param[in] desc Shape, rates and ::spark_resample_quality.
+ * @param[in] arena Caller-owned memory of at least spark_resample_f32_size()
+ *                  bytes. Must outlive @p self.
+ * @param[in] arena_size Size of @p arena in bytes.
+ *
+ * @retval SPARK_NOERROR on success
+ * @retval SPARK_ERR_INVALID_PARAM for NULL arguments, a zero rate, a ratio
+ *         beyond ::SPARK_RESAMPLE_MAX_RATIO or an unknown quality
+ * @retval SPARK_ERR_INVALID_OUTPUT if the output is not F32 in the input's
+ *         layout or holds fewer than spark_resample_f32_max_output() frames
+ * @retval SPARK_ERR_INVALID_BLOCK if the channel counts differ
+ * @retval SPARK_ERR_INVALID_SIZE if @p arena is too small
+ * @return Otherwise the error from spark_block_validate().
+ */
+int spark_resample_f32_init(spark_resample_f32_engine_t *self,
+                            const spark_resample_f32_t *desc, void *arena,
+                            size_t arena_size)
+{
+  if (!self || !arena)
+    return SPARK_ERR_INVALID_PARAM;
+
+  resample_params_t params;
+  const int status = resample_resolve(desc, &params);
+  if (status != SPARK_NOERROR)
+    return status;
+
+  struct spark_resample_f32_state layout;
+  if (arena_size < (SPARK_RESAMPLE_ALIGN - 1) + resample_layout(desc, &params, &layout, NULL))
+    return SPARK_ERR_INVALID_SIZE;
+
+  unsigned char *base = spark_align_ptr(arena, SPARK_RESAMPLE_ALIGN);
+  struct spark_resample_f32_state *state = (struct spark_resample_f32_state *)base;
+
+  resample_layout(desc, &params, state, base);
+  resample_design(state->bank, &params);
+
+  const bool interleaved =
+      (spark_buffer_get_layout(desc->header.input.flags) == SPARK_LAYOUT_INTERLEAVED);
+  const uint32_t n_chan = desc->header.input.channels;
+  const uint32_t block = desc->header.input.samples;
+
+  state->kernels = spark_kernels();
+  state->chan_stride = interleaved ? 1 : block;
+  state->sample_stride = interleaved ? n_chan : 1;
+  state->out_stride = interleaved ? 1 : desc->header.output.samples;
+  state->step_int = params.step_int;
+  state->step_frac = params.step_frac;
+
+  self->n_chan = n_chan;
+  self->block = block;
+  self->max_output = spark_resample_f32_max_output(desc);
+  self->n_taps = params.n_taps;
+  self->n_phases = params.n_phases;
+  self->interpolated = params.interpolated ? 1 : 0;
+  self->latency = params.n_taps / 2;
+  self->state = state;
+
+  spark_resample_f32_reset(self);
+
+  return SPARK_NOERROR;
+}
+
+/**
+ * @brief Clear the history (silence before the next block) and restart the
+ * output clock at phase 0.
+ *
+ * @param[in,out] self Resampler.
+ */
+void spark_resample_f32_reset(spark_resample_f32_engine_t *self)
+{
+  assert(self && self->state);
+
+  struct spark_resample_f32_state *state = self->state;
+
+  memset(state->window, 0, sizeof(float) * self->n_chan * state->window_len);
+  state->index = 0;
+  state->phase = 0;
+}
+
+/**
+ * @brief Consume one block of input and produce the outputs it completes.
+ *
+ * @param[in,out] self Resampler.
+ * @param[in] input `block` frames, laid out as described at init.
+ * @param[out] output Room for `max_output` frames (planes spaced by the
+ *                    `header.output.samples` given at init).
+ * @return The number of frames written per channel.
+ */
+uint32_t spark_resample_f32_execute(spark_resample_f32_engine_t *self, const float *input,
+                                    float *output)
+{
+  assert(self && self->state && input && output);
+
+  SPARK_STATS_BEGIN();
+
+  struct spark_resample_f32_state *state = self->state;
+  const uint32_t n_taps = self->n_taps;
+  const uint32_t block = self->block;
+  const size_t history = (size_t)n_taps - 1;
+  const size_t step = state->sample_stride;
+
+  for (uint32_t c = 0; c < self->n_chan; ++c) {
+    float *w = state->window + (size_t)c * state->window_len + history;
+    const float *x = input + (size_t)c * state->chan_stride;
+    for (uint32_t t = 0; t < block; ++t)
+      w[t] = x[t * step];
+  }
+
+  /* The output clock is shared by all channels: run it once to count. */
+  size_t index = state->index;
+  uint32_t phase = state->phase;
+  uint32_t n_out = 0;
+
+  while (index + n_taps <= state->window_len) {
+    index += state->step_int;
+    if (self->interpolated) {
+      const uint32_t next = phase + state->step_frac;
+      index += (next < phase);
+      phase = next;
+    } else {
+      phase += state->step_frac;
+      const uint32_t wrap = (phase >= self->n_phases);
+      phase -= wrap * self->n_phases;
+      index += wrap;
+    }
+    ++n_out;
+  }
+
+  assert(n_out <= self->max_output);
+
+  resample_f32_args_t args = {
+      .bank = state->bank,
+      .y_stride = step,
+      .index = state->index,
+      .phase = state->phase,
+      .n_phases = self->n_phases,
+      .step_int = state->step_int,
+      .step_frac = state->step_frac,
+      .n_taps = n_taps,
+      .n_out = n_out,
+  };
+
+  for (uint32_t c = 0; c < self->n_chan; ++c) {
+    float *w = state->window + (size_t)c * state->window_len;
+
+    args.x = w;
+    args.y = output + (size_t)c * state->out_stride;
+    if (self->interpolated)
+      state->kernels->resample_f32_interpolated(&args);
+    else
+      state->kernels->resample_f32_rational(&args);
+
+    memmove(w, w + block, sizeof(float) * history);
+  }
+
+  state->index = index - block;
+  state->phase = phase;
+
+  SPARK_STATS_END(SPARK_STATS_RESAMPLE_F32, (uint64_t)self->n_chan * block);
+
+  return n_out;
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "resample/resample_kernels.h"
+#include "simd/simd_f32.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Partial sums of `c * x` over @p n_taps, two vectors in flight. */
+static inline vf32_t dot(const float *c, const float *x, uint32_t n_taps)
+{
+  vf32_t acc0 = vf32_zero(), acc1 = vf32_zero();
+  uint32_t j = 0;
+
+  for (; j + 2 * VF32_LANES <= n_taps; j += 2 * VF32_LANES) {
+    acc0 = vf32_fmadd(vf32_load(c + j), vf32_load(x + j), acc0);
+    acc1 = vf32_fmadd(vf32_load(c + j + VF32_LANES), vf32_load(x + j + VF32_LANES), acc1);
+  }
+  for (; j < n_taps; j += VF32_LANES)
+    acc0 = vf32_fmadd(vf32_load(c + j), vf32_load(x + j), acc0);
+
+  return vf32_add(acc0, acc1);
+}
+
+void SPARK_ISA_FN(resample_f32_rational)(const resample_f32_args_t *args)
+{
+  const uint32_t n_taps = args->n_taps;
+  const uint32_t n_phases = args->n_phases;
+  size_t index = args->index;
+  uint32_t phase = args->phase;
+  float *y = args->y;
+
+  for (uint32_t n = 0; n < args->n_out; ++n, y += args->y_stride) {
+    *y = vf32_hsum(dot(args->bank + (size_t)phase * n_taps, args->x + index, n_taps));
+
+    /* The wrap follows the L / M pattern, which predicts poorly: keep it branch-free. */
+    phase += args->step_frac;
+    const uint32_t wrap = (phase >= n_phases);
+    phase -= wrap * n_phases;
+    index += args->step_int + wrap;
+  }
+}
+
+/**
+ * The top bits of the 32-bit phase select a filter and the rest weight the
+ * blend with the next one; both sums share the window loads.
+ */
+void SPARK_ISA_FN(resample_f32_interpolated)(const resample_f32_args_t *args)
+{
+  const uint32_t n_taps = args->n_taps;
+  uint32_t bits = 0;
+  while ((1u << bits) < args->n_phases)
+    ++bits;
+
+  const uint32_t shift = 32 - bits;
+  const uint32_t mask = (uint32_t)((1ull << shift) - 1);
+  const float scale = 1.0f / (float)(1ull << shift);
+  size_t index = args->index;
+  uint32_t phase = args->phase;
+  float *y = args->y;
+
+  for (uint32_t n = 0; n < args->n_out; ++n, y += args->y_stride) {
+    const float *c0 = args->bank + (size_t)(phase >> shift) * n_taps;
+    const float *c1 = c0 + n_taps;
+    const float *x = args->x + index;
+    const vf32_t a = vf32_set1((float)(phase & mask) * scale);
+    vf32_t acc0 = vf32_zero(), acc1 = vf32_zero();
+
+    for (uint32_t j = 0; j < n_taps; j += VF32_LANES) {
+      const vf32_t v = vf32_load(x + j);
+      acc0 = vf32_fmadd(vf32_load(c0 + j), v, acc0);
+      acc1 = vf32_fmadd(vf32_load(c1 + j), v, acc1);
+    }
+
+    *y = vf32_hsum(vf32_fmadd(a, vf32_sub(acc1, acc0), acc0));
+
+    const uint32_t next = phase + args->step_frac;
+    index += args->step_int + (next < phase);
+    phase = next;
+  }
+}
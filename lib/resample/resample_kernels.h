@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Internal kernel interface for the polyphase resampler. Not installed.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_RESAMPLE_KERNELS_H_
+#define LIBSPARK_RESAMPLE_KERNELS_H_
+
+#include "dispatch/isa.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief One channel's run of outputs through a polyphase filter bank.
+ *
+ * Output n is the inner product of phase filter `phase_n` with the window
+ * run starting at `index_n`; both advance by the step `step_int +
+ * step_frac / one` per output, where `one` is `n_phases` for exact
+ * ratios and 2^32 for interpolated ones.
+ */
+typedef struct resample_f32_args {
+  const float *bank; /**< Phase filters of n_taps each (n_phases + 1 when interpolated). */
+  const float *x;    /**< One channel's window: history, then the block. */
+  float *y;          /**< First output. */
+  size_t y_stride;   /**< Samples between consecutive outputs. */
+  size_t index;      /**< Window index of the first output's first tap. */
+  uint32_t phase;    /**< Phase of the first output (32-bit fraction when interpolated). */
+  uint32_t n_phases; /**< Phases in the bank (a power of two when interpolated). */
+  uint32_t step_int; /**< Whole window samples per output. */
+  uint32_t step_frac; /**< Fractional step, in units of 1 / n_phases (or 2^-32). */
+  uint32_t n_taps;   /**< Taps per phase, a multiple of 16. */
+  uint32_t n_out;    /**< Outputs to compute. */
+} resample_f32_args_t;
+
+#ifdef SPARK_ISA
+/**
+ * @brief Exact rational ratio: one phase filter per output.
+ */
+void SPARK_ISA_FN(resample_f32_rational)(const resample_f32_args_t *args);
+
+/**
+ * @brief Arbitrary ratio: linear interpolation between adjacent phase filters.
+ */
+void SPARK_ISA_FN(resample_f32_interpolated)(const resample_f32_args_t *args);
+#endif
+
+#endif /* LIBSPARK_RESAMPLE_KERNELS_H_ */
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Internal instruction-set selection shared by the vector abstractions.
+ *
+ * The instruction set is selected from the compiler's target macros, so a
+ * kernel written against simd_f32.h / simd_f64.h adapts to whatever ISA its
+ * translation unit is compiled for. Define SPARK_SIMD_SCALAR to force the
+ * one-lane fallback.
+ *
+ * Not installed; never include from a public header.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_SIMD_H_
+#define LIBSPARK_SIMD_H_
+
+#if defined(SPARK_SIMD_SCALAR)
+# define SPARK_SIMD_NONE 1
+#elif defined(__AVX512F__)
+# define SPARK_SIMD_AVX512 1
+#elif defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+# define SPARK_SIMD_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define SPARK_SIMD_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+# define SPARK_SIMD_NEON 1
+#else
+# define SPARK_SIMD_NONE 1
+#endif
+
+#if defined(SPARK_SIMD_AVX512) || defined(SPARK_SIMD_AVX2) || defined(SPARK_SIMD_SSE2)
+# include <immintrin.h>
+#elif defined(SPARK_SIMD_NEON)
+# include <arm_neon.h>
+#endif
+
+/** Declare a variable aligned to @p n bytes. */
+#if defined(_MSC_VER)
+# define SPARK_ALIGNED(n) __declspec(align(n))
+#else
+# define SPARK_ALIGNED(n) __attribute__((aligned(n)))
+#endif
+
+/** Always inline a helper, so constant arguments specialize its body. */
+#if defined(_MSC_VER)
+# define SPARK_FORCE_INLINE __forceinline
+#else
+# define SPARK_FORCE_INLINE inline __attribute__((always_inline))
+#endif
+
+/** Alignment used for stack tiles and packed storage (one cache line). */
+#define SPARK_SIMD_ALIGN 64
+
+#endif /* LIBSPARK_SIMD_H_ */
@@ -0,0 +1,598 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Internal single-precision vector abstraction (see simd/simd.h).
+ *
+ * vf32_from_i16/i32() convert VF32_LANES integers without scaling;
+ * vf32_to_i16/i32() round to nearest even and expect values already clamped
+ * to the target range. vf32_min/max() follow the minps/maxps operand order
+ * on every ISA: a NaN in the first operand yields the second.
+ *
+ * Not installed; never include from a public header.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_SIMD_F32_H_
+#define LIBSPARK_SIMD_F32_H_
+
+#include "simd/simd.h"
+
+#include <math.h>
+#include <stdint.h>
+
+#if defined(SPARK_SIMD_AVX512)
+
+typedef __m512 vf32_t;
+#define VF32_LANES 16
+
+static inline vf32_t vf32_zero(void)
+{
+  return _mm512_setzero_ps();
+}
+
+static inline vf32_t vf32_set1(float x)
+{
+  return _mm512_set1_ps(x);
+}
+
+static inline vf32_t vf32_load(const float *p)
+{
+  return _mm512_loadu_ps(p);
+}
+
+static inline void vf32_store(float *p, vf32_t v)
+{
+  _mm512_storeu_ps(p, v);
+}
+
+static inline vf32_t vf32_add(vf32_t a, vf32_t b)
+{
+  return _mm512_add_ps(a, b);
+}
+
+static inline vf32_t vf32_sub(vf32_t a, vf32_t b)
+{
+  return _mm512_sub_ps(a, b);
+}
+
+static inline vf32_t vf32_mul(vf32_t a, vf32_t b)
+{
+  return _mm512_mul_ps(a, b);
+}
+
+static inline vf32_t vf32_div(vf32_t a, vf32_t b)
+{
+  return _mm512_div_ps(a, b);
+}
+
+static inline vf32_t vf32_fmadd(vf32_t a, vf32_t b, vf32_t c)
+{
+  return _mm512_fmadd_ps(a, b, c);
+}
+
+static inline vf32_t vf32_min(vf32_t a, vf32_t b)
+{
+  return _mm512_min_ps(a, b);
+}
+
+static inline vf32_t vf32_max(vf32_t a, vf32_t b)
+{
+  return _mm512_max_ps(a, b);
+}
+
+static inline float vf32_hsum(vf32_t v)
+{
+  return _mm512_reduce_add_ps(v);
+}
+
+static inline vf32_t vf32_from_i16(const int16_t *p)
+{
+  return _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_loadu_si256((const __m256i *)p)));
+}
+
+static inline vf32_t vf32_from_i32(const int32_t *p)
+{
+  return _mm512_cvtepi32_ps(_mm512_loadu_si512((const void *)p));
+}
+
+static inline void vf32_to_i16(int16_t *p, vf32_t v)
+{
+  _mm256_storeu_si256((__m256i *)p, _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(v)));
+}
+
+static inline void vf32_to_i32(int32_t *p, vf32_t v)
+{
+  _mm512_storeu_si512((void *)p, _mm512_cvtps_epi32(v));
+}
+
+static inline void vf32_transpose(vf32_t r[16])
+{
+  __m512 t[16], u[16];
+
+  for (int i = 0; i < 8; ++i) {
+    t[2 * i + 0] = _mm512_unpacklo_ps(r[2 * i], r[2 * i + 1]);
+    t[2 * i + 1] = _mm512_unpackhi_ps(r[2 * i], r[2 * i + 1]);
+  }
+  for (int i = 0; i < 4; ++i) {
+    u[4 * i + 0] = _mm512_shuffle_ps(t[4 * i + 0], t[4 * i + 2], 0x44);
+    u[4 * i + 1] = _mm512_shuffle_ps(t[4 * i + 0], t[4 * i + 2], 0xEE);
+    u[4 * i + 2] = _mm512_shuffle_ps(t[4 * i + 1], t[4 * i + 3], 0x44);
+    u[4 * i + 3] = _mm512_shuffle_ps(t[4 * i + 1], t[4 * i + 3], 0xEE);
+  }
+  /* Each u[4b+j] now holds column 4k+j of rows 4b..4b+3 in 128-bit block k. */
+  for (int j = 0; j < 4; ++j) {
+    __m512 v0 = _mm512_shuffle_f32x4(u[j], u[4 + j], 0x44);
+    __m512 v1 = _mm512_shuffle_f32x4(u[j], u[4 + j], 0xEE);
+    __m512 v2 = _mm512_shuffle_f32x4(u[8 + j], u[12 + j], 0x44);
+    __m512 v3 = _mm512_shuffle_f32x4(u[8 + j], u[12 + j], 0xEE);
+    r[0 + j] = _mm512_shuffle_f32x4(v0, v2, 0x88);
+    r[4 + j] = _mm512_shuffle_f32x4(v0, v2, 0xDD);
+    r[8 + j] = _mm512_shuffle_f32x4(v1, v3, 0x88);
+    r[12 + j] = _mm512_shuffle_f32x4(v1, v3, 0xDD);
+  }
+}
+
+#elif defined(SPARK_SIMD_AVX2)
+
+typedef __m256 vf32_t;
+#define VF32_LANES 8
+
+static inline vf32_t vf32_zero(void)
+{
+  return _mm256_setzero_ps();
+}
+
+static inline vf32_t vf32_set1(float x)
+{
+  return _mm256_set1_ps(x);
+}
+
+static inline vf32_t vf32_load(const float *p)
+{
+  return _mm256_loadu_ps(p);
+}
+
+static inline void vf32_store(float *p, vf32_t v)
+{
+  _mm256_storeu_ps(p, v);
+}
+
+static inline vf32_t vf32_add(vf32_t a, vf32_t b)
+{
+  return _mm256_add_ps(a, b);
+}
+
+static inline vf32_t vf32_sub(vf32_t a, vf32_t b)
+{
+  return _mm256_sub_ps(a, b);
+}
+
+static inline vf32_t vf32_mul(vf32_t a, vf32_t b)
+{
+  return _mm256_mul_ps(a, b);
+}
+
+static inline vf32_t vf32_div(vf32_t a, vf32_t b)
+{
+  return _mm256_div_ps(a, b);
+}
+
+static inline vf32_t vf32_fmadd(vf32_t a, vf32_t b, vf32_t c)
+{
+  return _mm256_fmadd_ps(a, b, c);
+}
+
+static inline vf32_t vf32_min(vf32_t a, vf32_t b)
+{
+  return _mm256_min_ps(a, b);
+}
+
+static inline vf32_t vf32_max(vf32_t a, vf32_t b)
+{
+  return _mm256_max_ps(a, b);
+}
+
+static inline float vf32_hsum(vf32_t v)
+{
+  __m128 h = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+  h = _mm_add_ps(h, _mm_movehl_ps(h, h));
+  return _mm_cvtss_f32(_mm_add_ss(h, _mm_shuffle_ps(h, h, 0x55)));
+}
+
+static inline vf32_t vf32_from_i16(const int16_t *p)
+{
+  return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)p)));
+}
+
+static inline vf32_t vf32_from_i32(const int32_t *p)
+{
+  return _mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i *)p));
+}
+
+static inline void vf32_to_i16(int16_t *p, vf32_t v)
+{
+  __m256i i = _mm256_cvtps_epi32(v);
+  __m128i packed = _mm_packs_epi32(_mm256_castsi256_si128(i), _mm256_extracti128_si256(i, 1));
+  _mm_storeu_si128((__m128i *)p, packed);
+}
+
+static inline void vf32_to_i32(int32_t *p, vf32_t v)
+{
+  _mm256_storeu_si256((__m256i *)p, _mm256_cvtps_epi32(v));
+}
+
+static inline void vf32_transpose(vf32_t r[8])
+{
+  __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+  __m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+  __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+  __m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+  __m256 t4 = _mm256_unpacklo_ps(r[4], r[5]);
+  __m256 t5 = _mm256_unpackhi_ps(r[4], r[5]);
+  __m256 t6 = _mm256_unpacklo_ps(r[6], r[7]);
+  __m256 t7 = _mm256_unpackhi_ps(r[6], r[7]);
+
+  __m256 u0 = _mm256_shuffle_ps(t0, t2, 0x44);
+  __m256 u1 = _mm256_shuffle_ps(t0, t2, 0xEE);
+  __m256 u2 = _mm256_shuffle_ps(t1, t3, 0x44);
+  __m256 u3 = _mm256_shuffle_ps(t1, t3, 0xEE);
+  __m256 u4 = _mm256_shuffle_ps(t4, t6, 0x44);
+  __m256 u5 = _mm256_shuffle_ps(t4, t6, 0xEE);
+  __m256 u6 = _mm256_shuffle_ps(t5, t7, 0x44);
+  __m256 u7 = _mm256_shuffle_ps(t5, t7, 0xEE);
+
+  r[0] = _mm256_permute2f128_ps(u0, u4, 0x20);
+  r[1] = _mm256_permute2f128_ps(u1, u5, 0x20);
+  r[2] = _mm256_permute2f128_ps(u2, u6, 0x20);
+  r[3] = _mm256_permute2f128_ps(u3, u7, 0x20);
+  r[4] = _mm256_permute2f128_ps(u0, u4, 0x31);
+  r[5] = _mm256_permute2f128_ps(u1, u5, 0x31);
+  r[6] = _mm256_permute2f128_ps(u2, u6, 0x31);
+  r[7] = _mm256_permute2f128_ps(u3, u7, 0x31);
+}
+
+#elif defined(SPARK_SIMD_SSE2)
+
+typedef __m128 vf32_t;
+#define VF32_LANES 4
+
+static inline vf32_t vf32_zero(void)
+{
+  return _mm_setzero_ps();
+}
+
+static inline vf32_t vf32_set1(float x)
+{
+  return _mm_set1_ps(x);
+}
+
+static inline vf32_t vf32_load(const float *p)
+{
+  return _mm_loadu_ps(p);
+}
+
+static inline void vf32_store(float *p, vf32_t v)
+{
+  _mm_storeu_ps(p, v);
+}
+
+static inline vf32_t vf32_add(vf32_t a, vf32_t b)
+{
+  return _mm_add_ps(a, b);
+}
+
+static inline vf32_t vf32_sub(vf32_t a, vf32_t b)
+{
+  return _mm_sub_ps(a, b);
+}
+
+static inline vf32_t vf32_mul(vf32_t a, vf32_t b)
+{
+  return _mm_mul_ps(a, b);
+}
+
+static inline vf32_t vf32_div(vf32_t a, vf32_t b)
+{
+  return _mm_div_ps(a, b);
+}
+
+static inline vf32_t vf32_fmadd(vf32_t a, vf32_t b, vf32_t c)
+{
+  return _mm_add_ps(_mm_mul_ps(a, b), c);
+}
+
+static inline vf32_t vf32_min(vf32_t a, vf32_t b)
+{
+  return _mm_min_ps(a, b);
+}
+
+static inline vf32_t vf32_max(vf32_t a, vf32_t b)
+{
+  return _mm_max_ps(a, b);
+}
+
+static inline float vf32_hsum(vf32_t v)
+{
+  __m128 h = _mm_add_ps(v, _mm_movehl_ps(v, v));
+  return _mm_cvtss_f32(_mm_add_ss(h, _mm_shuffle_ps(h, h, 0x55)));
+}
+
+static inline vf32_t vf32_from_i16(const int16_t *p)
+{
+  __m128i h = _mm_loadl_epi64((const __m128i *)p);
+  return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(h, h), 16));
+}
+
+static inline vf32_t vf32_from_i32(const int32_t *p)
+{
+  return _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)p));
+}
+
+static inline void vf32_to_i16(int16_t *p, vf32_t v)
+{
+  __m128i i = _mm_cvtps_epi32(v);
+  _mm_storel_epi64((__m128i *)p, _mm_packs_epi32(i, i));
+}
+
+static inline void vf32_to_i32(int32_t *p, vf32_t v)
+{
+  _mm_storeu_si128((__m128i *)p, _mm_cvtps_epi32(v));
+}
+
+static inline void vf32_transpose(vf32_t r[4])
+{
+  _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+}
+
+#elif defined(SPARK_SIMD_NEON)
+
+typedef float32x4_t vf32_t;
+#define VF32_LANES 4
+
+static inline vf32_t vf32_zero(void)
+{
+  return vdupq_n_f32(0.0f);
+}
+
+static inline vf32_t vf32_set1(float x)
+{
+  return vdupq_n_f32(x);
+}
+
+static inline vf32_t vf32_load(const float *p)
+{
+  return vld1q_f32(p);
+}
+
+static inline void vf32_store(float *p, vf32_t v)
+{
+  vst1q_f32(p, v);
+}
+
+static inline vf32_t vf32_add(vf32_t a, vf32_t b)
+{
+  return vaddq_f32(a, b);
+}
+
+static inline vf32_t vf32_sub(vf32_t a, vf32_t b)
+{
+  return vsubq_f32(a, b);
+}
+
+static inline vf32_t vf32_mul(vf32_t a, vf32_t b)
+{
+  return vmulq_f32(a, b);
+}
+
+static inline vf32_t vf32_div(vf32_t a, vf32_t b)
+{
+# if defined(__aarch64__) || defined(_M_ARM64)
+  return vdivq_f32(a, b);
+# else
+  /* Reciprocal estimate refined by two Newton-Raphson steps. */
+  float32x4_t r = vrecpeq_f32(b);
+  r = vmulq_f32(r, vrecpsq_f32(b, r));
+  r = vmulq_f32(r, vrecpsq_f32(b, r));
+  return vmulq_f32(a, r);
+# endif
+}
+
+static inline vf32_t vf32_fmadd(vf32_t a, vf32_t b, vf32_t c)
+{
+# if defined(__aarch64__) || defined(_M_ARM64)
+  return vfmaq_f32(c, a, b);
+# else
+  return vmlaq_f32(c, a, b);
+# endif
+}
+
+/*
+ * vminq/vmaxq propagate NaN; compare and select instead so that, as with
+ * minps/maxps, a NaN in @p a yields @p b.
+ */
+static inline vf32_t vf32_min(vf32_t a, vf32_t b)
+{
+  return vbslq_f32(vcltq_f32(a, b), a, b);
+}
+
+static inline vf32_t vf32_max(vf32_t a, vf32_t b)
+{
+  return vbslq_f32(vcgtq_f32(a, b), a, b);
+}
+
+static inline float vf32_hsum(vf32_t v)
+{
+# if defined(__aarch64__) || defined(_M_ARM64)
+  return vaddvq_f32(v);
+# else
+  float32x2_t h = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+  return vget_lane_f32(vpadd_f32(h, h), 0);
+# endif
+}
+
+static inline vf32_t vf32_from_i16(const int16_t *p)
+{
+  return vcvtq_f32_s32(vmovl_s16(vld1_s16(p)));
+}
+
+static inline vf32_t vf32_from_i32(const int32_t *p)
+{
+  return vcvtq_f32_s32(vld1q_s32(p));
+}
+
+/*
+ * Round to nearest even, as lrintf() does. ARMv7 only truncates, so add and
+ * subtract a signed 2^23 to round in the adder first; magnitudes of 2^23
+ * and above are already integral and pass through.
+ */
+static inline int32x4_t vf32_round_i32(vf32_t v)
+{
+# if defined(__aarch64__) || defined(_M_ARM64)
+  return vcvtnq_s32_f32(v);
+# else
+  uint32x4_t sign = vandq_u32(vreinterpretq_u32_f32(v), vdupq_n_u32(0x80000000u));
+  float32x4_t k = vreinterpretq_f32_u32(vorrq_u32(sign, vdupq_n_u32(0x4B000000u)));
+  float32x4_t r = vsubq_f32(vaddq_f32(v, k), k);
+  uint32x4_t small = vcaltq_f32(v, vdupq_n_f32(8388608.0f));
+  return vcvtq_s32_f32(vbslq_f32(small, r, v));
+# endif
+}
+
+static inline void vf32_to_i16(int16_t *p, vf32_t v)
+{
+  vst1_s16(p, vqmovn_s32(vf32_round_i32(v)));
+}
+
+static inline void vf32_to_i32(int32_t *p, vf32_t v)
+{
+  vst1q_s32(p, vf32_round_i32(v));
+}
+
+static inline void vf32_transpose(vf32_t r[4])
+{
+  float32x4x2_t t0 = vtrnq_f32(r[0], r[1]);
+  float32x4x2_t t1 = vtrnq_f32(r[2], r[3]);
+  r[0] = vcombine_f32(vget_low_f32(t0.val[0]), vget_low_f32(t1.val[0]));
+  r[1] = vcombine_f32(vget_low_f32(t0.val[1]), vget_low_f32(t1.val[1]));
+  r[2] = vcombine_f32(vget_high_f32(t0.val[0]), vget_high_f32(t1.val[0]));
+  r[3] = vcombine_f32(vget_high_f32(t0.val[1]), vget_high_f32(t1.val[1]));
+}
+
+#else /* SPARK_SIMD_NONE */
+
+typedef float vf32_t;
+#define VF32_LANES 1
+
+static inline vf32_t vf32_zero(void)
+{
+  return 0.0f;
+}
+
+static inline vf32_t vf32_set1(float x)
+{
+  return x;
+}
+
+static inline vf32_t vf32_load(const float *p)
+{
+  return *p;
+}
+
+static inline void vf32_store(float *p, vf32_t v)
+{
+  *p = v;
+}
+
+static inline vf32_t vf32_add(vf32_t a, vf32_t b)
+{
+  return a + b;
+}
+
+static inline vf32_t vf32_sub(vf32_t a, vf32_t b)
+{
+  return a - b;
+}
+
+static inline vf32_t vf32_mul(vf32_t a, vf32_t b)
+{
+  return a * b;
+}
+
+static inline vf32_t vf32_div(vf32_t a, vf32_t b)
+{
+  return a / b;
+}
+
+static inline vf32_t vf32_fmadd(vf32_t a, vf32_t b, vf32_t c)
+{
+  return (a * b) + c;
+}
+
+/* Same operand order as minps/maxps: a NaN in @p a yields @p b. */
+static inline vf32_t vf32_min(vf32_t a, vf32_t b)
+{
+  return (a < b) ? a : b;
+}
+
+static inline vf32_t vf32_max(vf32_t a, vf32_t b)
+{
+  return (a > b) ? a : b;
+}
+
+static inline float vf32_hsum(vf32_t v)
+{
+  return v;
+}
+
+static inline vf32_t vf32_from_i16(const int16_t *p)
+{
+  return (float)*p;
+}
+
+static inline vf32_t vf32_from_i32(const int32_t *p)
+{
+  return (float)*p;
+}
+
+static inline void vf32_to_i16(int16_t *p, vf32_t v)
+{
+  *p = (int16_t)lrintf(v);
+}
+
+static inline void vf32_to_i32(int32_t *p, vf32_t v)
+{
+  *p = (int32_t)lrintf(v);
+}
+
+static inline void vf32_transpose(vf32_t r[1])
+{
+  (void)r;
+}
+
+#endif
+
+#endif /* LIBSPARK_SIMD_F32_H_ */
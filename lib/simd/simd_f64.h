@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Internal double-precision vector abstraction (see simd/simd.h).
+ *
+ * Besides the f64 arithmetic, vf64_load_f32() / vf64_store_f32() widen and
+ * narrow VF64_LANES floats so f32 buffers can run on f64 lanes.
+ *
+ * Not installed; never include from a public header.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_SIMD_F64_H_
+#define LIBSPARK_SIMD_F64_H_
+
+#include "simd/simd.h"
+
+#if defined(SPARK_SIMD_AVX512)
+
+typedef __m512d vf64_t;
+#define VF64_LANES 8
+
+static inline vf64_t vf64_zero(void)
+{
+  return _mm512_setzero_pd();
+}
+
+static inline vf64_t vf64_set1(double x)
+{
+  return _mm512_set1_pd(x);
+}
+
+static inline vf64_t vf64_load(const double *p)
+{
+  return _mm512_loadu_pd(p);
+}
+
+static inline void vf64_store(double *p, vf64_t v)
+{
+  _mm512_storeu_pd(p, v);
+}
+
+static inline vf64_t vf64_load_f32(const float *p)
+{
+  return _mm512_cvtps_pd(_mm256_loadu_ps(p));
+}
+
+static inline void vf64_store_f32(float *p, vf64_t v)
+{
+  _mm256_storeu_ps(p, _mm512_cvtpd_ps(v));
+}
+
+static inline vf64_t vf64_add(vf64_t a, vf64_t b)
+{
+  return _mm512_add_pd(a, b);
+}
+
+static inline vf64_t vf64_mul(vf64_t a, vf64_t b)
+{
+  return _mm512_mul_pd(a, b);
+}
+
+static inline vf64_t vf64_fmadd(vf64_t a, vf64_t b, vf64_t c)
+{
+  return _mm512_fmadd_pd(a, b, c);
+}
+
+static inline void vf64_transpose(vf64_t r[8])
+{
+  __m512d t[8];
+
+  for (int i = 0; i < 4; ++i) {
+    t[2 * i + 0] = _mm512_unpacklo_pd(r[2 * i], r[2 * i + 1]);
+    t[2 * i + 1] = _mm512_unpackhi_pd(r[2 * i], r[2 * i + 1]);
+  }
+  /* Each t[2b+j] now holds column 2k+j of rows 2b, 2b+1 in 128-bit block k. */
+  for (int j = 0; j < 2; ++j) {
+    __m512d v0 = _mm512_shuffle_f64x2(t[j], t[2 + j], 0x44);
+    __m512d v1 = _mm512_shuffle_f64x2(t[j], t[2 + j], 0xEE);
+    __m512d v2 = _mm512_shuffle_f64x2(t[4 + j], t[6 + j], 0x44);
+    __m512d v3 = _mm512_shuffle_f64x2(t[4 + j], t[6 + j], 0xEE);
+    r[0 + j] = _mm512_shuffle_f64x2(v0, v2, 0x88);
+    r[2 + j] = _mm512_shuffle_f64x2(v0, v2, 0xDD);
+    r[4 + j] = _mm512_shuffle_f64x2(v1, v3, 0x88);
+    r[6 + j] = _mm512_shuffle_f64x2(v1, v3, 0xDD);
+  }
+}
+
+#elif defined(SPARK_SIMD_AVX2)
+
+typedef __m256d vf64_t;
+#define VF64_LANES 4
+
+static inline vf64_t vf64_zero(void)
+{
+  return _mm256_setzero_pd();
+}
+
+static inline vf64_t vf64_set1(double x)
+{
+  return _mm256_set1_pd(x);
+}
+
+static inline vf64_t vf64_load(const double *p)
+{
+  return _mm256_loadu_pd(p);
+}
+
+static inline void vf64_store(double *p, vf64_t v)
+{
+  _mm256_storeu_pd(p, v);
+}
+
+static inline vf64_t vf64_load_f32(const float *p)
+{
+  return _mm256_cvtps_pd(_mm_loadu_ps(p));
+}
+
+static inline void vf64_store_f32(float *p, vf64_t v)
+{
+  _mm_storeu_ps(p, _mm256_cvtpd_ps(v));
+}
+
+static inline vf64_t vf64_add(vf64_t a, vf64_t b)
+{
+  return _mm256_add_pd(a, b);
+}
+
+static inline vf64_t vf64_mul(vf64_t a, vf64_t b)
+{
+  return _mm256_mul_pd(a, b);
+}
+
+static inline vf64_t vf64_fmadd(vf64_t a, vf64_t b, vf64_t c)
+{
+  return _mm256_fmadd_pd(a, b, c);
+}
+
+static inline void vf64_transpose(vf64_t r[4])
+{
+  __m256d t0 = _mm256_unpacklo_pd(r[0], r[1]);
+  __m256d t1 = _mm256_unpackhi_pd(r[0], r[1]);
+  __m256d t2 = _mm256_unpacklo_pd(r[2], r[3]);
+  __m256d t3 = _mm256_unpackhi_pd(r[2], r[3]);
+
+  r[0] = _mm256_permute2f128_pd(t0, t2, 0x20);
+  r[1] = _mm256_permute2f128_pd(t1, t3, 0x20);
+  r[2] = _mm256_permute2f128_pd(t0, t2, 0x31);
+  r[3] = _mm256_permute2f128_pd(t1, t3, 0x31);
+}
+
+#elif defined(SPARK_SIMD_SSE2)
+
+typedef __m128d vf64_t;
+#define VF64_LANES 2
+
+static inline vf64_t vf64_zero(void)
+{
+  return _mm_setzero_pd();
+}
+
+static inline vf64_t vf64_set1(double x)
+{
+  return _mm_set1_pd(x);
+}
+
+static inline vf64_t vf64_load(const double *p)
+{
+  return _mm_loadu_pd(p);
+}
+
+static inline void vf64_store(double *p, vf64_t v)
+{
+  _mm_storeu_pd(p, v);
+}
+
+static inline vf64_t vf64_load_f32(const float *p)
+{
+  return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64((const __m128i *)p)));
+}
+
+static inline void vf64_store_f32(float *p, vf64_t v)
+{
+  _mm_storel_epi64((__m128i *)p, _mm_castps_si128(_mm_cvtpd_ps(v)));
+}
+
+static inline vf64_t vf64_add(vf64_t a, vf64_t b)
+{
+  return _mm_add_pd(a, b);
+}
+
+static inline vf64_t vf64_mul(vf64_t a, vf64_t b)
+{
+  return _mm_mul_pd(a, b);
+}
+
+static inline vf64_t vf64_fmadd(vf64_t a, vf64_t b, vf64_t c)
+{
+  return _mm_add_pd(_mm_mul_pd(a, b), c);
+}
+
+static inline void vf64_transpose(vf64_t r[2])
+{
+  __m128d t0 = _mm_unpacklo_pd(r[0], r[1]);
+  r[1] = _mm_unpackhi_pd(r[0], r[1]);
+  r[0] = t0;
+}
+
+#elif defined(SPARK_SIMD_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+
+typedef float64x2_t vf64_t;
+#define VF64_LANES 2
+
+static inline vf64_t vf64_zero(void)
+{
+  return vdupq_n_f64(0.0);
+}
+
+static inline vf64_t vf64_set1(double x)
+{
+  return vdupq_n_f64(x);
+}
+
+static inline vf64_t vf64_load(const double *p)
+{
+  return vld1q_f64(p);
+}
+
+static inline void vf64_store(double *p, vf64_t v)
+{
+  vst1q_f64(p, v);
+}
+
+static inline vf64_t vf64_load_f32(const float *p)
+{
+  return vcvt_f64_f32(vld1_f32(p));
+}
+
+static inline void vf64_store_f32(float *p, vf64_t v)
+{
+  vst1_f32(p, vcvt_f32_f64(v));
+}
+
+static inline vf64_t vf64_add(vf64_t a, vf64_t b)
+{
+  return vaddq_f64(a, b);
+}
+
+static inline vf64_t vf64_mul(vf64_t a, vf64_t b)
+{
+  return vmulq_f64(a, b);
+}
+
+static inline vf64_t vf64_fmadd(vf64_t a, vf64_t b, vf64_t c)
+{
+  return vfmaq_f64(c, a, b);
+}
+
+static inline void vf64_transpose(vf64_t r[2])
+{
+  float64x2_t t0 = vzip1q_f64(r[0], r[1]);
+  r[1] = vzip2q_f64(r[0], r[1]);
+  r[0] = t0;
+}
+
+#else /* SPARK_SIMD_NONE, or 32-bit NEON without f64 lanes */
+
+typedef double vf64_t;
+#define VF64_LANES 1
+
+static inline vf64_t vf64_zero(void)
+{
+  return 0.0;
+}
+
+static inline vf64_t vf64_set1(double x)
+{
+  return x;
+}
+
+static inline vf64_t vf64_load(const double *p)
+{
+  return *p;
+}
+
+static inline void vf64_store(double *p, vf64_t v)
+{
+  *p = v;
+}
+
+static inline vf64_t vf64_load_f32(const float *p)
+{
+  return (double)*p;
+}
+
+static inline void vf64_store_f32(float *p, vf64_t v)
+{
+  *p = (float)v;
+}
+
+static inline vf64_t vf64_add(vf64_t a, vf64_t b)
+{
+  return a + b;
+}
+
+static inline vf64_t vf64_mul(vf64_t a, vf64_t b)
+{
+  return a * b;
+}
+
+static inline vf64_t vf64_fmadd(vf64_t a, vf64_t b, vf64_t c)
+{
+  return (a * b) + c;
+}
+
+static inline void vf64_transpose(vf64_t r[1])
+{
+  (void)r;
+}
+
+#endif
+
+#endif /* LIBSPARK_SIMD_F64_H_ */
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "spark/stats.h"
+#include "stats/stats_internal.h"
+
+#include <stdatomic.h>
+#include <string.h>
+
+static const char *const kernel_names[SPARK_STATS_KERNEL_COUNT] = {
+    [SPARK_STATS_SOSFILT_F32] = "sosfilt_f32",
+    [SPARK_STATS_SOSFILT_F64] = "sosfilt_f64",
+    [SPARK_STATS_CONVERT] = "convert",
+    [SPARK_STATS_GRAPH] = "graph",
+    [SPARK_STATS_FIR_F32] = "fir_f32",
+    [SPARK_STATS_RESAMPLE_F32] = "resample_f32",
+    [SPARK_STATS_SVF_F32] = "svf_f32",
+    [SPARK_STATS_LATTICE_F32] = "lattice_f32",
+    [SPARK_STATS_GAIN_F32] = "gain_f32",
+    [SPARK_STATS_METER_F32] = "meter_f32",
+    [SPARK_STATS_FFT_F32] = "fft_f32",
+};
+
+static const uint32_t kernel_types[SPARK_STATS_KERNEL_COUNT] = {
+    [SPARK_STATS_SOSFILT_F32] = SPARK_BLOCK_PROCESS,
+    [SPARK_STATS_SOSFILT_F64] = SPARK_BLOCK_PROCESS,
+    [SPARK_STATS_CONVERT] = SPARK_BLOCK_CONVERT,
+    [SPARK_STATS_GRAPH] = SPARK_BLOCK_PROCESS,
+    [SPARK_STATS_FIR_F32] = SPARK_BLOCK_PROCESS,
+    [SPARK_STATS_RESAMPLE_F32] = SPARK_BLOCK_CONVERT,
+    [SPARK_STATS_SVF_F32] = SPARK_BLOCK_PROCESS,
+    [SPARK_STATS_LATTICE_F32] = SPARK_BLOCK_PROCESS,
+    [SPARK_STATS_GAIN_F32] = SPARK_BLOCK_PROCESS,
+    [SPARK_STATS_METER_F32] = SPARK_BLOCK_SINK,
+    [SPARK_STATS_FFT_F32] = SPARK_BLOCK_CONVERT,
+};
+
+#ifdef SPARK_INSTRUMENT
+
+typedef struct stats_counters {
+  _Alignas(64) atomic_uint_fast64_t calls;
+  atomic_uint_fast64_t samples;
+  atomic_uint_fast64_t ticks;
+  atomic_uint_fast64_t histogram[SPARK_STATS_HIST_BUCKETS];
+} stats_counters_t;
+
+/* Each kernel's counters start on their own cache line. */
+static stats_counters_t counters[SPARK_STATS_KERNEL_COUNT];
+
+static inline unsigned log2_bucket(uint64_t ticks)
+{
+  unsigned b = 0;
+  while (ticks >>= 1)
+    ++b;
+  return (b < SPARK_STATS_HIST_BUCKETS) ? b : SPARK_STATS_HIST_BUCKETS - 1;
+}
+
+/*
+ * Called on the audio thread: wait-free, relaxed increments only. Concurrent
+ * writers (several threads running the same kernel) are counted exactly.
+ */
+void spark_stats_record(int kernel, size_t samples, uint64_t ticks)
+{
+  stats_counters_t *c = &counters[kernel];
+  atomic_fetch_add_explicit(&c->calls, 1, memory_order_relaxed);
+  atomic_fetch_add_explicit(&c->samples, samples, memory_order_relaxed);
+  atomic_fetch_add_explicit(&c->ticks, ticks, memory_order_relaxed);
+  atomic_fetch_add_explicit(&c->histogram[log2_bucket(ticks)], 1, memory_order_relaxed);
+}
+
+#endif /* SPARK_INSTRUMENT */
+
+/**
+ * @brief Report whether the library was built with instrumentation.
+ *
+ * Enable it with `meson setup -Dinstrumentation=true`. Without it, the hooks
+ * compile to nothing and snapshots are all zero.
+ *
+ * @return true if kernels record counters.
+ */
+bool spark_stats_enabled(void)
+{
+#ifdef SPARK_INSTRUMENT
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief Copy every kernel's counters.
+ *
+ * Lock-free and safe to call from any thread while kernels run: each
+ * counter is read atomically, so no count is torn or lost, but counters of
+ * one entry may be a few calls apart. Take two snapshots and subtract them to
+ * measure an interval.
+ *
+ * @param[out] snapshot Receives the counters.
+ */
+void spark_stats_snapshot(spark_stats_snapshot_t *snapshot)
+{
+  if (!snapshot)
+    return;
+
+  memset(snapshot, 0, sizeof(*snapshot));
+  snapshot->enabled = spark_stats_enabled();
+
+  for (int k = 0; k < SPARK_STATS_KERNEL_COUNT; ++k) {
+    spark_stats_entry_t *e = &snapshot->kernels[k];
+    e->block_type = kernel_types[k];
+#ifdef SPARK_INSTRUMENT
+    const stats_counters_t *c = &counters[k];
+    e->calls = atomic_load_explicit(&c->calls, memory_order_relaxed);
+    e->samples = atomic_load_explicit(&c->samples, memory_order_relaxed);
+    e->ticks = atomic_load_explicit(&c->ticks, memory_order_relaxed);
+    for (int b = 0; b < SPARK_STATS_HIST_BUCKETS; ++b)
+      e->histogram[b] = atomic_load_explicit(&c->histogram[b], memory_order_relaxed);
+#endif
+  }
+}
+
+/**
+ * @brief Zero every counter.
+ *
+ * Calls that finish while the reset is in progress may be kept or dropped;
+ * prefer differencing snapshots on a live system.
+ */
+void spark_stats_reset(void)
+{
+#ifdef SPARK_INSTRUMENT
+  for (int k = 0; k < SPARK_STATS_KERNEL_COUNT; ++k) {
+    stats_counters_t *c = &counters[k];
+    atomic_store_explicit(&c->calls, 0, memory_order_relaxed);
+    atomic_store_explicit(&c->samples, 0, memory_order_relaxed);
+    atomic_store_explicit(&c->ticks, 0, memory_order_relaxed);
+    for (int b = 0; b < SPARK_STATS_HIST_BUCKETS; ++b)
+      atomic_store_explicit(&c->histogram[b], 0, memory_order_relaxed);
+  }
+#endif
+}
+
+/**
+ * @brief Name of an instrumented kernel, for logs and reports.
+ *
+ * @param[in] kernel A ::spark_stats_kernel value.
+ * @return A constant string, or "unknown" for an out-of-range value.
+ */
+const char *spark_stats_kernel_name(int kernel)
+{
+  if (kernel < 0 || kernel >= SPARK_STATS_KERNEL_COUNT)
+    return "unknown";
+  return kernel_names[kernel];
+}
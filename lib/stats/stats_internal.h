@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Instrumentation hooks for the kernel entry points. With SPARK_INSTRUMENT
+ * undefined (the default, see the `instrumentation` meson option) the hooks
+ * expand to nothing. Not installed.
+ */
+
+#pragma once
+
+#ifndef LIBSPARK_STATS_INTERNAL_H_
+#define LIBSPARK_STATS_INTERNAL_H_
+
+#include "spark/stats.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef SPARK_INSTRUMENT
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif !defined(__aarch64__)
+#include <time.h>
+#endif
+
+/** Read the tick counter (see ::spark_stats_entry_t). */
+static inline uint64_t spark_stats_ticks(void)
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#elif defined(__aarch64__)
+  uint64_t v;
+  __asm__ volatile("mrs %0, cntvct_el0" : "=r"(v));
+  return v;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/** Add one call of @p samples samples and @p ticks ticks to @p kernel. */
+void spark_stats_record(int kernel, size_t samples, uint64_t ticks);
+
+/** Start timing a call. */
+#define SPARK_STATS_BEGIN() const uint64_t spark_stats_t0_ = spark_stats_ticks()
+
+/** Finish timing a call started by SPARK_STATS_BEGIN() in the same scope. */
+#define SPARK_STATS_END(kernel, samples)                                                 \
+  spark_stats_record((kernel), (samples), spark_stats_ticks() - spark_stats_t0_)
+
+#else
+
+#define SPARK_STATS_BEGIN() ((void)0)
+#define SPARK_STATS_END(kernel, samples) ((void)0)
+
+#endif /* SPARK_INSTRUMENT */
+
+#endif /* LIBSPARK_STATS_INTERNAL_H_ */
@@ -0,0 +1,386 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "spark/stream.h"
+#include "spark/block.h"
+#include "memory/memory_internal.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SPARK_STREAM_MMAN
+#endif
+
+/** Chunk buffers: `in[k & 1]` and `out[k & 1]` belong to chunk k. */
+struct spark_stream_state {
+  unsigned char *in[2];  /**< Raw input chunks (read target, padded tail). */
+  unsigned char *out[2]; /**< Raw output chunks (graph output, write source). */
+  size_t in_frame;       /**< Bytes per input frame. */
+  size_t out_frame;      /**< Bytes per output frame. */
+  size_t chunk;          /**< Frames per chunk (the graph's `samples`). */
+};
+
+/** Input of one run: a mapping, or a stream read chunk by chunk. */
+typedef struct stream_source {
+  FILE *file;                /**< Read from here when @ref map is NULL. */
+  const unsigned char *map;  /**< Mapped file, or NULL. */
+  size_t map_size;           /**< Bytes mapped. */
+  size_t cursor;             /**< Next unread byte of the mapping. */
+} stream_source_t;
+
+/** One pipeline step; the three tasks touch disjoint buffers. */
+typedef struct stream_step {
+  spark_stream_t *self;
+  stream_source_t *source;
+  FILE *output;
+
+  uint32_t read_slot;     /**< Buffer pair the read task fills. */
+  size_t read_frames;     /**< [out] Frames the read task produced. */
+  const void *read_chunk; /**< [out] Where those frames are (buffer or mapping). */
+  bool read_failed;       /**< [out] The read task hit an I/O error. */
+
+  uint32_t run_slot;      /**< Buffer pair of the chunk to process. */
+  const void *run_chunk;  /**< Its input, from the previous read. */
+  size_t run_frames;      /**< Its valid frames; 0 to skip. */
+
+  uint32_t write_slot;    /**< Buffer pair of the chunk to write. */
+  size_t write_frames;    /**< Its valid frames; 0 to skip. */
+  bool write_failed;      /**< [out] The write task hit an I/O error. */
+} stream_step_t;
+
+static inline size_t frame_bytes(const spark_buffer_t *buf)
+{
+  return (size_t)buf->channels * spark_buffer_bytes_per_sample(buf);
+}
+
+/** Raw PCM is interleaved; a mono chunk reads the same in any planar layout. */
+static bool buffer_is_raw(const spark_buffer_t *buf)
+{
+  const uint32_t layout = spark_buffer_get_layout(buf->flags);
+  return frame_bytes(buf) > 0 && buf->samples > 0 &&
+         (layout == SPARK_LAYOUT_INTERLEAVED ||
+          (buf->channels == 1 &&
+           (layout == SPARK_LAYOUT_PLANAR || layout == SPARK_LAYOUT_PLANAR_PTR)));
+}
+
+/**
+ * @brief Arena bytes spark_stream_init() needs for @p graph.
+ *
+ * Two input and two output chunks of the graph's shape, plus bookkeeping.
+ * The graph's own scratch is separate (see spark_graph_init()).
+ *
+ * @param[in] graph Pipeline; only its header shape is read.
+ * @return Bytes, or 0 if @p graph is NULL or its ends are not raw chunks.
+ */
+size_t spark_stream_size(const spark_graph_t *graph)
+{
+  if (!graph || !buffer_is_raw(&graph->header.input) ||
+      !buffer_is_raw(&graph->header.output))
+    return 0;
+
+  const size_t n = graph->header.input.samples;
+  return (SPARK_STREAM_ALIGN - 1) +
+         spark_align_up(sizeof(struct spark_stream_state), SPARK_STREAM_ALIGN) +
+         2 * spark_align_up(n * frame_bytes(&graph->header.input), SPARK_STREAM_ALIGN) +
+         2 * spark_align_up(n * frame_bytes(&graph->header.output), SPARK_STREAM_ALIGN);
+}
+
+/**
+ * @brief Set up a stream over an initialized graph.
+ *
+ * @param[out] self Stream to initialize.
+ * @param[in,out] graph Pipeline, already through spark_graph_init() with its
+ *                scratch. Its header bases are rebound by every chunk.
+ * @param[in] executor Pool of at least two workers to overlap I/O and
+ *            compute, or NULL to run each step serially.
+ * @param[in] flags A combination of ::spark_stream_flags.
+ * @param[in] arena Caller-owned memory of at least spark_stream_size()
+ *            bytes; aligned internally to ::SPARK_STREAM_ALIGN.
+ * @param[in] arena_size Size of @p arena in bytes.
+ *
+ * @retval SPARK_NOERROR on success
+ * @retval SPARK_ERR_INVALID_PARAM for NULL arguments, an unknown flag, or a
+ *         graph without its scratch
+ * @retval SPARK_ERR_INVALID_INPUT / SPARK_ERR_INVALID_OUTPUT if an end of the
+ *         graph is not a raw interleaved chunk
+ * @retval SPARK_ERR_INVALID_BLOCK if the ends differ in frame count
+ * @retval SPARK_ERR_INVALID_SIZE if @p arena is too small
+ */
+int spark_stream_init(spark_stream_t *self, spark_graph_t *graph,
+                      const spark_executor_t *executor, uint32_t flags, void *arena,
+                      size_t arena_size)
+{
+  if (!self || !graph || !arena || (flags & ~(uint32_t)SPARK_STREAM_MMAP))
+    return SPARK_ERR_INVALID_PARAM;
+
+  if (graph->scratch_size > 0 && !graph->scratch)
+    return SPARK_ERR_INVALID_PARAM;
+
+  const spark_buffer_t *in = &graph->header.input;
+  const spark_buffer_t *out = &graph->header.output;
+
+  if (!buffer_is_raw(in))
+    return SPARK_ERR_INVALID_INPUT;
+
+  if (!buffer_is_raw(out))
+    return SPARK_ERR_INVALID_OUTPUT;
+
+  if (in->samples != out->samples)
+    return SPARK_ERR_INVALID_BLOCK;
+
+  if (arena_size < spark_stream_size(graph))
+    return SPARK_ERR_INVALID_SIZE;
+
+  unsigned char *base = spark_align_ptr(arena, SPARK_STREAM_ALIGN);
+  struct spark_stream_state *state = (struct spark_stream_state *)base;
+  base += spark_align_up(sizeof(*state), SPARK_STREAM_ALIGN);
+
+  state->chunk = in->samples;
+  state->in_frame = frame_bytes(in);
+  state->out_frame = frame_bytes(out);
+
+  for (int k = 0; k < 2; ++k) {
+    state->in[k] = base;
+    base += spark_align_up(state->chunk * state->in_frame, SPARK_STREAM_ALIGN);
+  }
+  for (int k = 0; k < 2; ++k) {
+    state->out[k] = base;
+    base += spark_align_up(state->chunk * state->out_frame, SPARK_STREAM_ALIGN);
+  }
+
+  self->graph = graph;
+  self->executor = executor;
+  self->flags = flags;
+  self->frames = 0;
+  self->state = state;
+  return SPARK_NOERROR;
+}
+
+/**
+ * @brief Map the rest of @p file, or leave @p source reading it.
+ */
+static void stream_source_open(stream_source_t *source, FILE *file, uint32_t flags)
+{
+  memset(source, 0, sizeof(*source));
+  source->file = file;
+
+#if defined(SPARK_STREAM_MMAN)
+  struct stat st;
+  const int fd = fileno(file);
+  const off_t at = ftello(file);
+
+  if (!(flags & SPARK_STREAM_MMAP) || fd < 0 || at < 0 || fstat(fd, &st) != 0 ||
+      !S_ISREG(st.st_mode) || st.st_size <= at)
+    return;
+
+  void *p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (p == MAP_FAILED)
+    return;
+
+  posix_madvise(p, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+  source->map = p;
+  source->map_size = (size_t)st.st_size;
+  source->cursor = (size_t)at;
+#else
+  (void)flags;
+#endif
+}
+
+static void stream_source_close(stream_source_t *source)
+{
+#if defined(SPARK_STREAM_MMAN)
+  if (source->map) {
+    /* Leave the stream where a read-based run would have left it. */
+    fseeko(source->file, (off_t)source->cursor, SEEK_SET);
+    munmap((void *)source->map, source->map_size);
+  }
+#endif
+  source->map = NULL;
+}
+
+/**
+ * @brief Read task: next chunk into `in[read_slot]`, or a view of the mapping.
+ *
+ * Whole mapped chunks are used in place; a short final chunk, mapped or
+ * read, is copied or read into the buffer and its tail zero-filled.
+ */
+static void stream_read(stream_step_t *step)
+{
+  const struct spark_stream_state *state = step->self->state;
+  stream_source_t *source = step->source;
+  unsigned char *buf = state->in[step->read_slot];
+  const size_t want = state->chunk * state->in_frame;
+  size_t got;
+
+  if (source->map) {
+    const size_t left = source->map_size - source->cursor;
+    const unsigned char *at = source->map + source->cursor;
+
+    if (left < state->in_frame) {
+      step->read_frames = 0;
+      return;
+    }
+
+    got = (left < want) ? left - left % state->in_frame : want;
+    source->cursor += got;
+
+    if (got == want) {
+#if defined(SPARK_STREAM_MMAN)
+      /* Start paging in the chunk after this one while this one is processed. */
+      if (source->cursor < source->map_size) {
+        const uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+        const uintptr_t next = (uintptr_t)(source->map + source->cursor) & ~(page - 1);
+        const size_t ahead = (left - got < want) ? left - got : want;
+        posix_madvise((void *)next, ahead + page, POSIX_MADV_WILLNEED);
+      }
+#endif
+      step->read_chunk = at;
+      step->read_frames = state->chunk;
+      return;
+    }
+
+    memcpy(buf, at, got);
+  } else {
+    got = fread(buf, 1, want, source->file);
+    if (got < want && ferror(source->file))
+      step->read_failed = true;
+    got -= got % state->in_frame;
+  }
+
+  memset(buf + got, 0, want - got);
+  step->read_chunk = buf;
+  step->read_frames = got / state->in_frame;
+}
+
+static void stream_process(stream_step_t *step)
+{
+  spark_graph_t *graph = step->self->graph;
+
+  graph->header.input.base = (void *)step->run_chunk;
+  graph->header.output.base = step->self->state->out[step->run_slot];
+  spark_graph_run(graph);
+}
+
+static void stream_write(stream_step_t *step)
+{
+  const struct spark_stream_state *state = step->self->state;
+  const size_t bytes = step->write_frames * state->out_frame;
+
+  if (fwrite(state->out[step->write_slot], 1, bytes, step->output) != bytes)
+    step->write_failed = true;
+}
+
+/** Task body for the executor: 0 reads, 1 processes, 2 writes. */
+static void stream_task(void *arg, uint32_t index)
+{
+  stream_step_t *step = (stream_step_t *)arg;
+
+  switch (index) {
+  case 0:
+    if (step->source->map || !feof(step->source->file))
+      stream_read(step);
+    break;
+  case 1:
+    if (step->run_frames > 0)
+      stream_process(step);
+    break;
+  default:
+    if (step->write_frames > 0)
+      stream_write(step);
+    break;
+  }
+}
+
+/**
+ * @brief Filter @p input to @p output through the graph, chunk by chunk.
+ *
+ * Reads raw frames from the current position of @p input until end of
+ * file, and writes the same number of frames to @p output. A trailing
+ * partial frame is dropped. Graph state (filter memories) carries over from
+ * chunk to chunk and from run to run; reset the nodes between files if
+ * needed. The output is not flushed.
+ *
+ * @param[in,out] self Stream from spark_stream_init().
+ * @param[in] input Source of raw input frames.
+ * @param[in] output Destination of raw output frames; not @p input.
+ *
+ * @retval SPARK_NOERROR on success
+ * @retval SPARK_ERR_INVALID_PARAM for NULL arguments or @p input == @p output
+ * @retval SPARK_ERR_IO if a read or write failed; @ref spark_stream_t::frames
+ *         holds the frames written before the failure
+ */
+int spark_stream_run(spark_stream_t *self, FILE *input, FILE *output)
+{
+  if (!self || !self->state || !input || !output || input == output)
+    return SPARK_ERR_INVALID_PARAM;
+
+  const bool overlap = self->executor && self->executor->n_workers >= 2;
+  stream_source_t source;
+  stream_source_open(&source, input, self->flags);
+
+  stream_step_t step = {.self = self, .source = &source, .output = output};
+  bool failed = false;
+
+  /* Prime the pipeline with chunk 0. */
+  stream_read(&step);
+  failed = step.read_failed;
+  self->frames = 0;
+
+  for (uint32_t k = 0; !failed; ++k) {
+    step.run_slot = k & 1;
+    step.run_chunk = step.read_chunk;
+    step.run_frames = step.read_frames;
+    step.read_slot = (k + 1) & 1;
+    step.read_frames = 0;
+
+    if (step.run_frames == 0 && step.write_frames == 0)
+      break;
+
+    if (overlap) {
+      self->executor->parallel_for(self->executor->pool, stream_task, &step, 3);
+    } else {
+      for (uint32_t t = 0; t < 3; ++t)
+        stream_task(&step, t);
+    }
+
+    failed = step.read_failed || step.write_failed;
+    if (!step.write_failed)
+      self->frames += step.write_frames;
+
+    step.write_slot = step.run_slot;
+    step.write_frames = step.run_frames;
+  }
+
+  stream_source_close(&source);
+
+  return failed ? SPARK_ERR_IO : SPARK_NOERROR;
+}
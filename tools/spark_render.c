@@ -0,0 +1,481 @@
+/*
+ * Copyright (c) 2025 Colahall, LLC <about@colahall.io>.
+ *
+ * This File is part of libspark (see https://colahall.io/libspark).
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * “Software”), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Offline renderer: streams raw PCM from a file (or stdin) through convert
+ * → SOS cascade → convert with spark_stream_t, overlapping reads, filtering
+ * and writes. Run without arguments for usage.
+ */
+
+#include "spark/block.h"
+#include "spark/convert.h"
+#include "spark/filter_design.h"
+#include "spark/graph.h"
+#include "spark/iir_filter.h"
+#include "spark/memory.h"
+#include "spark/stream.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <pthread.h>
+#define RENDER_HAVE_THREADS 1
+#else
+#define RENDER_HAVE_THREADS 0
+#endif
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+
+/** Most --eq bands accepted. */
+#define RENDER_MAX_BANDS 32
+
+typedef struct render_opts {
+  const char *input;
+  const char *output;
+  uint32_t channels;
+  double rate;
+  uint32_t in_fmt;
+  uint32_t out_fmt;
+  uint32_t chunk;
+  long skip;
+  double lowpass;
+  double highpass;
+  uint32_t order;
+  spark_biquad_band_t bands[RENDER_MAX_BANDS];
+  uint32_t n_bands;
+  bool dither;
+  bool ftz;
+  bool mmap;
+  bool serial;
+} render_opts_t;
+
+static const struct {
+  const char *name;
+  uint32_t fmt;
+} formats[] = {
+    {"s16", SPARK_FMT_I16},
+    {"s32", SPARK_FMT_I32},
+    {"f32", SPARK_FMT_F32},
+    {"f64", SPARK_FMT_F64},
+};
+
+static const struct {
+  const char *name;
+  uint32_t type;
+} band_types[] = {
+    {"lowpass", SPARK_BIQUAD_LOWPASS},   {"highpass", SPARK_BIQUAD_HIGHPASS},
+    {"bandpass", SPARK_BIQUAD_BANDPASS}, {"notch", SPARK_BIQUAD_NOTCH},
+    {"allpass", SPARK_BIQUAD_ALLPASS},   {"peak", SPARK_BIQUAD_PEAKING},
+    {"lowshelf", SPARK_BIQUAD_LOWSHELF}, {"highshelf", SPARK_BIQUAD_HIGHSHELF},
+};
+
+static void usage(const char *argv0)
+{
+  fprintf(stderr,
+          "usage: %s [options] INPUT OUTPUT   (\"-\" for stdin/stdout)\n"
+          "  --channels N        interleaved channels (2)\n"
+          "  --rate HZ           sample rate for the frequencies below (48000)\n"
+          "  --format FMT        input sample format: s16, s32, f32, f64 (f32)\n"
+          "  --out-format FMT    output sample format (same as input)\n"
+          "  --chunk FRAMES      frames per processing chunk (65536)\n"
+          "  --skip BYTES        leading input bytes to copy through (e.g. 44)\n"
+          "  --lowpass HZ        Butterworth lowpass of --order\n"
+          "  --highpass HZ       Butterworth highpass of --order\n"
+          "  --order N           Butterworth order (4)\n"
+          "  --eq TYPE:HZ:Q:DB   RBJ section, repeatable; TYPE is lowpass, highpass,\n"
+          "                      bandpass, notch, allpass, peak, lowshelf or highshelf\n"
+          "  --dither            TPDF dither when the output is integer\n"
+          "  --ftz               run the filter with flush-to-zero\n"
+          "  --mmap              memory-map a regular input file\n"
+          "  --serial            do not overlap I/O with filtering\n",
+          argv0);
+}
+
+static bool parse_format(const char *val, uint32_t *fmt)
+{
+  for (size_t k = 0; k < ARRAY_SIZE(formats); ++k) {
+    if (strcmp(val, formats[k].name) == 0) {
+      *fmt = formats[k].fmt;
+      return true;
+    }
+  }
+  fprintf(stderr, "unknown format '%s'\n", val);
+  return false;
+}
+
+/** TYPE:HZ:Q:DB, frequency still in Hz (normalized once --rate is known). */
+static bool parse_band(const char *val, spark_biquad_band_t *band)
+{
+  char type[16];
+  double hz, q, db;
+
+  if (sscanf(val, "%15[a-z]:%lf:%lf:%lf", type, &hz, &q, &db) != 4) {
+    fprintf(stderr, "bad --eq '%s' (want TYPE:HZ:Q:DB)\n", val);
+    return false;
+  }
+
+  for (size_t k = 0; k < ARRAY_SIZE(band_types); ++k) {
+    if (strcmp(type, band_types[k].name) == 0) {
+      band->type = band_types[k].type;
+      band->freq = (float)hz;
+      band->q = (float)q;
+      band->gain_db = (float)db;
+      return true;
+    }
+  }
+  fprintf(stderr, "unknown --eq type '%s'\n", type);
+  return false;
+}
+
+static int parse_args(int argc, char **argv, render_opts_t *opts)
+{
+  memset(opts, 0, sizeof(*opts));
+  opts->channels = 2;
+  opts->rate = 48000.0;
+  opts->in_fmt = SPARK_FMT_F32;
+  opts->out_fmt = SPARK_FMT_INVALID;
+  opts->chunk = 65536;
+  opts->order = 4;
+
+  int n_paths = 0;
+
+  for (int i = 1; i < argc; ++i) {
+    const char *arg = argv[i];
+    const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+    bool ok = true;
+
+    if (strcmp(arg, "--dither") == 0) {
+      opts->dither = true;
+      continue;
+    } else if (strcmp(arg, "--ftz") == 0) {
+      opts->ftz = true;
+      continue;
+    } else if (strcmp(arg, "--mmap") == 0) {
+      opts->mmap = true;
+      continue;
+    } else if (strcmp(arg, "--serial") == 0) {
+      opts->serial = true;
+      continue;
+    } else if (strncmp(arg, "--", 2) != 0 || strcmp(arg, "-") == 0) {
+      if (n_paths == 0)
+        opts->input = arg;
+      else if (n_paths == 1)
+        opts->output = arg;
+      ok = (n_paths++ < 2);
+    } else if (!val) {
+      ok = false;
+    } else if (strcmp(arg, "--channels") == 0) {
+      opts->channels = (uint32_t)strtoul(val, NULL, 10);
+      ++i;
+    } else if (strcmp(arg, "--rate") == 0) {
+      opts->rate = strtod(val, NULL);
+      ++i;
+    } else if (strcmp(arg, "--format") == 0) {
+      ok = parse_format(val, &opts->in_fmt);
+      ++i;
+    } else if (strcmp(arg, "--out-format") == 0) {
+      ok = parse_format(val, &opts->out_fmt);
+      ++i;
+    } else if (strcmp(arg, "--chunk") == 0) {
+      opts->chunk = (uint32_t)strtoul(val, NULL, 10);
+      ++i;
+    } else if (strcmp(arg, "--skip") == 0) {
+      opts->skip = strtol(val, NULL, 10);
+      ++i;
+    } else if (strcmp(arg, "--lowpass") == 0) {
+      opts->lowpass = strtod(val, NULL);
+      ++i;
+    } else if (strcmp(arg, "--highpass") == 0) {
+      opts->highpass = strtod(val, NULL);
+      ++i;
+    } else if (strcmp(arg, "--order") == 0) {
+      opts->order = (uint32_t)strtoul(val, NULL, 10);
+      ++i;
+    } else if (strcmp(arg, "--eq") == 0) {
+      ok = (opts->n_bands < RENDER_MAX_BANDS) &&
+           parse_band(val, &opts->bands[opts->n_bands++]);
+      ++i;
+    } else {
+      ok = false;
+    }
+
+    if (!ok) {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (n_paths != 2 || opts->channels == 0 || opts->chunk == 0 || !(opts->rate > 0.0) ||
+      opts->skip < 0) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  if (opts->out_fmt == SPARK_FMT_INVALID)
+    opts->out_fmt = opts->in_fmt;
+
+  return 0;
+}
+
+#if RENDER_HAVE_THREADS
+typedef struct render_task {
+  spark_task_fn fn;
+  void *arg;
+  uint32_t index;
+} render_task_t;
+
+static void *render_thread(void *p)
+{
+  render_task_t *task = (render_task_t *)p;
+  task->fn(task->arg, task->index);
+  return NULL;
+}
+
+/**
+ * @brief Minimal executor: one thread per task beyond the first.
+ *
+ * The stream asks for three tasks per chunk; at chunk sizes worth
+ * overlapping, thread start-up is noise next to the I/O it hides.
+ */
+static void render_parallel_for(void *pool, spark_task_fn fn, void *arg, uint32_t n_tasks)
+{
+  (void)pool;
+  render_task_t tasks[8];
+  pthread_t threads[8];
+  bool started[8] = {false};
+
+  for (uint32_t k = 1; k < n_tasks && k < ARRAY_SIZE(tasks); ++k) {
+    tasks[k] = (render_task_t){fn, arg, k};
+    started[k] = pthread_create(&threads[k], NULL, render_thread, &tasks[k]) == 0;
+    if (!started[k])
+      fn(arg, k);
+  }
+
+  fn(arg, 0);
+
+  for (uint32_t k = 1; k < n_tasks && k < ARRAY_SIZE(tasks); ++k) {
+    if (started[k])
+      pthread_join(threads[k], NULL);
+  }
+}
+#endif
+
+/**
+ * @brief Design the cascade: Butterworth sections first, then the EQ bands.
+ *
+ * @return Sections written, or 0 on a bad frequency or order.
+ */
+static uint32_t design_cascade(const render_opts_t *opts, float *coefficients,
+                               uint32_t max_stages)
+{
+  uint32_t n_stages = 0;
+  const double cut[2] = {opts->lowpass, opts->highpass};
+  const uint32_t response[2] = {SPARK_DESIGN_LOWPASS, SPARK_DESIGN_HIGHPASS};
+
+  for (int k = 0; k < 2; ++k) {
+    if (cut[k] <= 0.0)
+      continue;
+
+    spark_design_prototype_t proto;
+    const float freq = (float)(cut[k] / opts->rate);
+    if (spark_design_prototype_init(&proto, SPARK_DESIGN_BUTTERWORTH, opts->order, 0.0,
+                                    0.0) != SPARK_NOERROR ||
+        n_stages + proto.n_stages > max_stages ||
+        spark_design_iir_f32(&proto, response[k], &freq, 1, coefficients + 5 * n_stages,
+                             SPARK_DESIGN_EXACT) != SPARK_NOERROR) {
+      fprintf(stderr, "cannot design a %s at %g Hz\n", k ? "highpass" : "lowpass",
+              cut[k]);
+      return 0;
+    }
+    n_stages += proto.n_stages;
+  }
+
+  spark_biquad_band_t bands[RENDER_MAX_BANDS];
+  for (uint32_t b = 0; b < opts->n_bands; ++b) {
+    bands[b] = opts->bands[b];
+    bands[b].freq = (float)(bands[b].freq / opts->rate);
+  }
+
+  if (opts->n_bands > 0 &&
+      (n_stages + opts->n_bands > max_stages ||
+       spark_design_biquad_f32(bands, opts->n_bands, coefficients + 5 * n_stages, 0) !=
+           SPARK_NOERROR)) {
+    fprintf(stderr, "bad --eq band\n");
+    return 0;
+  }
+
+  return n_stages + opts->n_bands;
+}
+
+static spark_block_t make_header(uint32_t in_fmt, uint32_t out_fmt, uint32_t type,
+                                 uint32_t channels, uint32_t frames)
+{
+  spark_block_t h;
+  memset(&h, 0, sizeof(h));
+  h.abi_version = SPARK_ABI_VERSION;
+  h.struct_size = sizeof(h);
+  h.input.channels = h.output.channels = channels;
+  h.input.samples = h.output.samples = frames;
+  h.input.flags = in_fmt | SPARK_LAYOUT_INTERLEAVED | type;
+  h.output.flags = out_fmt | SPARK_LAYOUT_INTERLEAVED | type;
+  return h;
+}
+
+/** Copy the first @p n bytes of @p in to @p out unchanged (a file header). */
+static bool copy_prefix(FILE *in, FILE *out, long n)
+{
+  unsigned char buf[4096];
+
+  while (n > 0) {
+    const size_t want = (n < (long)sizeof(buf)) ? (size_t)n : sizeof(buf);
+    if (fread(buf, 1, want, in) != want || fwrite(buf, 1, want, out) != want)
+      return false;
+    n -= (long)want;
+  }
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  render_opts_t opts;
+  if (parse_args(argc, argv, &opts) != 0)
+    return 1;
+
+  float coefficients[5 * SPARK_DESIGN_MAX_STAGES * 3];
+  const uint32_t max_stages = SPARK_DESIGN_MAX_STAGES * 3;
+  const uint32_t n_stages =
+      (opts.lowpass > 0.0 || opts.highpass > 0.0 || opts.n_bands > 0)
+          ? design_cascade(&opts, coefficients, max_stages)
+          : 0;
+  if (n_stages == 0 && (opts.lowpass > 0.0 || opts.highpass > 0.0 || opts.n_bands > 0))
+    return 1;
+
+  /* convert(in → f32) → sosfilt → convert(f32 → out); f32 ends are dropped. */
+  const uint32_t ch = opts.channels;
+  const uint32_t n = opts.chunk;
+  spark_convert_t to_f32 = {
+      make_header(opts.in_fmt, SPARK_FMT_F32, SPARK_BLOCK_CONVERT, ch, n), 0, 0};
+  spark_convert_t from_f32 = {
+      make_header(SPARK_FMT_F32, opts.out_fmt, SPARK_BLOCK_CONVERT, ch, n),
+      opts.dither ? SPARK_CONVERT_DITHER_TPDF : SPARK_CONVERT_DEFAULT, 0};
+  spark_sosfilt_f32_t filter = {
+      make_header(SPARK_FMT_F32, SPARK_FMT_F32, SPARK_BLOCK_PROCESS, ch, n), coefficients,
+      NULL, n_stages, SPARK_SOSFILT_SHARE_SOS | (opts.ftz ? SPARK_SOSFILT_FTZ : 0)};
+
+  spark_graph_node_t nodes[3];
+  uint32_t n_nodes = 0;
+  if (opts.in_fmt != SPARK_FMT_F32)
+    nodes[n_nodes++] = spark_graph_node_convert(&to_f32);
+  if (n_stages > 0)
+    nodes[n_nodes++] = spark_graph_node_sosfilt_f32(&filter);
+  if (opts.out_fmt != SPARK_FMT_F32 || n_nodes == 0)
+    nodes[n_nodes++] = spark_graph_node_convert(&from_f32);
+
+  spark_graph_t graph;
+  memset(&graph, 0, sizeof(graph));
+  graph.header = make_header(opts.in_fmt, opts.out_fmt, SPARK_BLOCK_PROCESS, ch, n);
+  graph.nodes = nodes;
+  graph.n_nodes = n_nodes;
+
+  /* Plan, then take every buffer from one arena reserved up front. */
+  int status = spark_graph_init(&graph, NULL, 0);
+  if (status != SPARK_NOERROR) {
+    fprintf(stderr, "bad pipeline: %s\n", spark_strerror(status));
+    return 1;
+  }
+
+  const size_t states_size = sizeof(float) * 2 * (size_t)ch * (n_stages ? n_stages : 1);
+  const size_t scratch_size = graph.scratch_size;
+  const size_t stream_size = spark_stream_size(&graph);
+
+  spark_arena_t arena;
+  spark_arena_init(&arena, NULL, 0);
+  spark_arena_alloc(&arena, states_size);
+  spark_arena_alloc(&arena, scratch_size);
+  spark_arena_alloc(&arena, stream_size);
+
+  if (spark_arena_reserve(&arena, NULL, arena.used, SPARK_MEMORY_PREFAULT) !=
+      SPARK_NOERROR) {
+    fprintf(stderr, "out of memory\n");
+    return 1;
+  }
+
+  filter.states = spark_arena_alloc(&arena, states_size);
+  memset(filter.states, 0, states_size);
+  void *scratch = spark_arena_alloc(&arena, scratch_size);
+  void *stream_arena = spark_arena_alloc(&arena, stream_size);
+
+#if RENDER_HAVE_THREADS
+  const spark_executor_t executor = {render_parallel_for, NULL, 3};
+  const spark_executor_t *exec = opts.serial ? NULL : &executor;
+#else
+  const spark_executor_t *exec = NULL;
+#endif
+
+  spark_stream_t stream;
+  status = spark_graph_init(&graph, scratch, scratch_size);
+  if (status == SPARK_NOERROR)
+    status = spark_stream_init(&stream, &graph, exec, opts.mmap ? SPARK_STREAM_MMAP : 0,
+                               stream_arena, stream_size);
+  if (status != SPARK_NOERROR) {
+    fprintf(stderr, "setup failed: %s\n", spark_strerror(status));
+    return 1;
+  }
+
+  FILE *in = (strcmp(opts.input, "-") == 0) ? stdin : fopen(opts.input, "rb");
+  FILE *out = (strcmp(opts.output, "-") == 0) ? stdout : fopen(opts.output, "wb");
+  if (!in || !out) {
+    fprintf(stderr, "cannot open '%s'\n", !in ? opts.input : opts.output);
+    return 1;
+  }
+
+  if (!copy_prefix(in, out, opts.skip)) {
+    fprintf(stderr, "cannot copy %ld header bytes\n", opts.skip);
+    return 1;
+  }
+
+  status = spark_stream_run(&stream, in, out);
+  if (fflush(out) != 0)
+    status = SPARK_ERR_IO;
+
+  if (status != SPARK_NOERROR) {
+    perror("spark_render");
+    return 1;
+  }
+
+  fprintf(stderr, "%llu frames\n", (unsigned long long)stream.frames);
+
+  if (in != stdin)
+    fclose(in);
+  if (out != stdout)
+    fclose(out);
+  spark_arena_release(&arena);
+  return 0;
+}